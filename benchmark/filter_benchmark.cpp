@@ -0,0 +1,137 @@
+// 过滤条件求值的基准测试：比较表达式树逐节点调用 Evaluate 与编译后的表达式程序
+// 用法：filter_benchmark [记录数目] [扫描次数]
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "executors/expression_program.h"
+#include "fmt/format.h"
+
+namespace {
+
+using huadb::Arithmetic;
+using huadb::ArithmeticType;
+using huadb::ColumnValue;
+using huadb::Comparison;
+using huadb::ComparisonType;
+using huadb::Const;
+using huadb::Logic;
+using huadb::LogicType;
+using huadb::OperatorExpression;
+using huadb::Record;
+using huadb::Type;
+using huadb::Value;
+
+// 记录格式：(id int, score double, name varchar)
+std::shared_ptr<OperatorExpression> Id() { return std::make_shared<ColumnValue>(0, Type::INT, "id", 4); }
+std::shared_ptr<OperatorExpression> Score() { return std::make_shared<ColumnValue>(1, Type::DOUBLE, "score", 8); }
+std::shared_ptr<OperatorExpression> Name() { return std::make_shared<ColumnValue>(2, Type::VARCHAR, "name", 16); }
+
+template <typename T>
+std::shared_ptr<OperatorExpression> Constant(T value) {
+  return std::make_shared<Const>(Value(value));
+}
+
+std::shared_ptr<OperatorExpression> Compare(ComparisonType type, std::shared_ptr<OperatorExpression> lhs,
+                                            std::shared_ptr<OperatorExpression> rhs) {
+  return std::make_shared<Comparison>(type, std::move(lhs), std::move(rhs));
+}
+
+std::shared_ptr<OperatorExpression> And(std::shared_ptr<OperatorExpression> lhs,
+                                        std::shared_ptr<OperatorExpression> rhs) {
+  return std::make_shared<Logic>(LogicType::AND, std::move(lhs), std::move(rhs));
+}
+
+std::shared_ptr<OperatorExpression> Or(std::shared_ptr<OperatorExpression> lhs,
+                                       std::shared_ptr<OperatorExpression> rhs) {
+  return std::make_shared<Logic>(LogicType::OR, std::move(lhs), std::move(rhs));
+}
+
+std::vector<std::shared_ptr<Record>> MakeRecords(size_t count) {
+  std::mt19937 random(0);
+  std::uniform_int_distribution<int32_t> id_distribution(0, 100000);
+  std::uniform_real_distribution<double> score_distribution(0, 1);
+  std::vector<std::shared_ptr<Record>> records;
+  records.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    auto id = id_distribution(random);
+    records.push_back(std::make_shared<Record>(
+        std::vector<Value>{Value(id), Value(score_distribution(random)), Value("name_" + std::to_string(id % 100))}));
+  }
+  return records;
+}
+
+template <typename Func>
+double Measure(size_t rows, size_t rounds, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < rounds; i++) {
+    func();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return rows * rounds / elapsed.count();
+}
+
+void Benchmark(const char *name, const std::shared_ptr<OperatorExpression> &predicate,
+               const std::vector<std::shared_ptr<Record>> &records, size_t rounds) {
+  size_t tree_matched = 0;
+  auto tree_rate = Measure(records.size(), rounds, [&]() {
+    tree_matched = 0;
+    for (const auto &record : records) {
+      auto value = predicate->Evaluate(record);
+      if (!value.IsNull() && value.GetValue<bool>()) {
+        tree_matched++;
+      }
+    }
+  });
+  huadb::ExpressionProgram program(predicate, true);
+  size_t program_matched = 0;
+  auto program_rate = Measure(records.size(), rounds, [&]() {
+    program_matched = 0;
+    for (const auto &record : records) {
+      if (program.Test(*record)) {
+        program_matched++;
+      }
+    }
+  });
+  fmt::print("{:<10} tree: {:>12.0f} rows/s  program: {:>12.0f} rows/s  speedup: {:.2f}x  matched: {}{}\n", name,
+             tree_rate, program_rate, program_rate / tree_rate, program_matched,
+             tree_matched == program_matched ? "" : fmt::format(" (tree matched {})", tree_matched));
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  size_t record_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+  size_t rounds = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+  auto records = MakeRecords(record_count);
+
+  // id > 50000 and score < 0.5
+  Benchmark("simple", And(Compare(ComparisonType::GREATER, Id(), Constant(50000)),
+                          Compare(ComparisonType::LESS, Score(), Constant(0.5))),
+            records, rounds);
+  // id * 2 + 1 > 100000 and name != 'name_7'
+  Benchmark("arith",
+            And(Compare(ComparisonType::GREATER,
+                        std::make_shared<Arithmetic>(
+                            ArithmeticType::ADD, std::make_shared<Arithmetic>(ArithmeticType::MUL, Id(), Constant(2)),
+                            Constant(1)),
+                        Constant(100000)),
+                Compare(ComparisonType::NOT_EQUAL, Name(), Constant("name_7"))),
+            records, rounds);
+  // (id < 1000 or score > 0.9) and id >= 10 and score != 0.25
+  Benchmark("mixed",
+            And(And(Or(Compare(ComparisonType::LESS, Id(), Constant(1000)),
+                       Compare(ComparisonType::GREATER, Score(), Constant(0.9))),
+                    Compare(ComparisonType::GREATER_EQUAL, Id(), Constant(10))),
+                Compare(ComparisonType::NOT_EQUAL, Score(), Constant(0.25))),
+            records, rounds);
+  // id < 100 and id > 10：选择率很低，短路求值后大部分记录只需计算第一个条件
+  Benchmark("selective", And(Compare(ComparisonType::LESS, Id(), Constant(100)),
+                             Compare(ComparisonType::GREATER, Id(), Constant(10))),
+            records, rounds);
+  return 0;
+}
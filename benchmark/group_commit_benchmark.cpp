@@ -0,0 +1,75 @@
+// 组提交的多线程基准测试：比较不同并发度和 commit_delay 下的提交吞吐量和平均每次刷盘合并的提交数，以及异步提交的吞吐量
+// 用法：group_commit_benchmark [每个线程的事务数] [最大线程数]
+// 在当前目录下的临时目录中运行，结束后删除
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include "fmt/format.h"
+#include "log/log_manager.h"
+#include "storage/disk.h"
+#include "transaction/lock_manager.h"
+#include "transaction/transaction_manager.h"
+
+namespace {
+
+using namespace huadb;
+
+constexpr db_size_t RECORD_SIZE = 64;
+
+void Benchmark(bool synchronous, uint32_t commit_delay, size_t txns_per_thread, size_t max_threads) {
+  for (size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+    std::filesystem::remove_all(BASE_PATH);
+    Disk disk;
+    LockManager lock_manager;
+    TransactionManager transaction_manager(lock_manager, FIRST_XID);
+    LogManager log_manager(disk, transaction_manager, FIRST_LSN);
+    log_manager.SetCommitDelay(commit_delay);
+
+    // 每个事务写一条插入日志后提交
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < thread_count; i++) {
+      threads.emplace_back([&, i]() {
+        char record[RECORD_SIZE] = {};
+        for (size_t j = 0; j < txns_per_thread; j++) {
+          xid_t xid = FIRST_XID + i * txns_per_thread + j;
+          log_manager.AppendInsertLog(xid, PRESERVED_OID, i, j, 0, RECORD_SIZE, record);
+          log_manager.AppendCommitLog(xid, synchronous);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    auto commits = thread_count * txns_per_thread;
+    // 异步提交时由日志写线程定期刷盘，可能还没有刷过盘
+    auto flush_count = std::max(log_manager.GetFlushCount(), 1U);
+    fmt::print("synchronous={:<5} commit_delay={:<6} threads={:<3} commits/s: {:>10.0f}  commits/flush: {:>8.2f}\n",
+               synchronous, commit_delay, thread_count, commits / elapsed.count(),
+               static_cast<double>(commits) / flush_count);
+  }
+  std::filesystem::remove_all(BASE_PATH);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  size_t txns_per_thread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+  size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+  auto directory = std::filesystem::current_path() / "group_commit_benchmark";
+  std::filesystem::create_directories(directory);
+  std::filesystem::current_path(directory);
+  for (uint32_t commit_delay : {0, 100, 1000}) {
+    Benchmark(true, commit_delay, txns_per_thread, max_threads);
+  }
+  Benchmark(false, 0, txns_per_thread, max_threads);
+  std::filesystem::current_path(directory.parent_path());
+  std::filesystem::remove_all(directory);
+  return 0;
+}
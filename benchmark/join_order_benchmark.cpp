@@ -0,0 +1,123 @@
+// 连接顺序枚举的基准测试：比较不同形状的连接图上 DPccp 与贪心算法的优化时间和计划代价
+// 用法：join_order_benchmark [最大关系数] [重复次数]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+#include "optimizer/join_order_enumerator.h"
+#include "optimizer/optimizer.h"
+
+namespace {
+
+using huadb::JoinOrderEnumerator;
+using RelationSet = JoinOrderEnumerator::RelationSet;
+
+// 连接图的边，first 和 second 为关系编号
+using Edges = std::vector<std::pair<size_t, size_t>>;
+
+Edges Chain(size_t n) {
+  Edges edges;
+  for (size_t i = 0; i + 1 < n; i++) {
+    edges.emplace_back(i, i + 1);
+  }
+  return edges;
+}
+
+Edges Cycle(size_t n) {
+  auto edges = Chain(n);
+  if (n > 2) {
+    edges.emplace_back(n - 1, 0);
+  }
+  return edges;
+}
+
+Edges Star(size_t n) {
+  Edges edges;
+  for (size_t i = 1; i < n; i++) {
+    edges.emplace_back(0, i);
+  }
+  return edges;
+}
+
+Edges Clique(size_t n) {
+  Edges edges;
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = i + 1; j < n; j++) {
+      edges.emplace_back(i, j);
+    }
+  }
+  return edges;
+}
+
+// 关系的记录数在 [10, 100000] 内按对数均匀分布，连接条件按主外键连接估计选择率
+JoinOrderEnumerator MakeEnumerator(size_t n, const Edges &edges, std::mt19937 &random) {
+  std::uniform_real_distribution<double> exponent(1, 5);
+  std::vector<double> rows;
+  for (size_t i = 0; i < n; i++) {
+    rows.push_back(std::round(std::pow(10, exponent(random))));
+  }
+  JoinOrderEnumerator enumerator(rows);
+  for (const auto &[lhs, rhs] : edges) {
+    enumerator.AddPredicate((RelationSet(1) << lhs) | (RelationSet(1) << rhs), 1 / std::max(rows[lhs], rows[rhs]));
+  }
+  return enumerator;
+}
+
+// 返回平均每次枚举的微秒数，cost 为最后一次得到的计划代价
+double Measure(size_t rounds, const std::function<double()> &enumerate, double &cost) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < rounds; i++) {
+    cost = enumerate();
+  }
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / rounds;
+}
+
+void Benchmark(const char *shape, const std::function<Edges(size_t)> &make_edges, size_t max_relations,
+               size_t rounds) {
+  for (size_t n = 2; n <= max_relations; n++) {
+    std::mt19937 random(n);
+    auto edges = make_edges(n);
+    double greedy_cost;
+    auto greedy_time = Measure(rounds, [&]() {
+      auto enumerator = MakeEnumerator(n, edges, random);
+      return enumerator.GetNode(enumerator.EnumerateGreedy()).cost_;
+    }, greedy_cost);
+    if (n > huadb::DP_JOIN_RELATIONS_LIMIT) {
+      fmt::print("{:<7} n={:<3} greedy: {:>10.1f} us\n", shape, n, greedy_time);
+      continue;
+    }
+    // 两种算法使用相同的随机数种子，保证连接图上的记录数和选择率一致
+    random.seed(n);
+    size_t pairs = 0;
+    double dp_cost;
+    auto dp_time = Measure(rounds, [&]() {
+      auto enumerator = MakeEnumerator(n, edges, random);
+      auto root = enumerator.EnumerateDP();
+      pairs = enumerator.GetPairCount();
+      return enumerator.GetNode(root).cost_;
+    }, dp_cost);
+    fmt::print("{:<7} n={:<3} dp: {:>10.1f} us  pairs: {:>7}  greedy: {:>8.1f} us  greedy/dp cost: {:.3f}\n", shape, n,
+               dp_time, pairs, greedy_time, greedy_cost / dp_cost);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  size_t max_relations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16;
+  size_t rounds = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10;
+  max_relations = std::min(max_relations, huadb::MAX_JOIN_RELATIONS);
+  Benchmark("chain", Chain, max_relations, rounds);
+  Benchmark("cycle", Cycle, max_relations, rounds);
+  Benchmark("star", Star, max_relations, rounds);
+  Benchmark("clique", Clique, max_relations, rounds);
+  return 0;
+}
@@ -0,0 +1,97 @@
+// 内存有序索引的多线程基准测试：比较乐观锁耦合的 B+ 树与读写锁保护的 std::map
+// 用法：olc_index_benchmark [键的数目] [每个线程的操作数] [最大线程数]
+
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "fmt/format.h"
+#include "index/olc_b_plus_tree.h"
+
+namespace {
+
+// 读写锁保护的 std::map，作为对照
+class LockedMap {
+ public:
+  void Insert(uint64_t key, uint64_t value) {
+    std::unique_lock lock(mutex_);
+    map_[key] = value;
+  }
+  std::optional<uint64_t> Lookup(uint64_t key) const {
+    std::shared_lock lock(mutex_);
+    auto iterator = map_.find(key);
+    if (iterator == map_.end()) {
+      return std::nullopt;
+    }
+    return iterator->second;
+  }
+
+ private:
+  mutable std::shared_mutex mutex_;
+  std::map<uint64_t, uint64_t> map_;
+};
+
+// 多线程执行 func(thread_id)，返回每秒完成的操作数
+template <typename Func>
+double Run(size_t thread_count, size_t ops_per_thread, Func func) {
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < thread_count; i++) {
+    threads.emplace_back(func, i);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return thread_count * ops_per_thread / elapsed.count();
+}
+
+template <typename Index>
+void Benchmark(const char *name, size_t key_count, size_t ops_per_thread, size_t max_threads) {
+  for (size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+    Index index;
+    // 每个线程插入互不相交的键
+    auto keys_per_thread = key_count / thread_count;
+    auto insert_rate = Run(thread_count, keys_per_thread, [&](size_t thread_id) {
+      for (size_t i = 0; i < keys_per_thread; i++) {
+        auto key = i * thread_count + thread_id;
+        index.Insert(key, key * 2);
+      }
+    });
+    size_t missing = 0;
+    std::mutex missing_mutex;
+    auto lookup_rate = Run(thread_count, ops_per_thread, [&](size_t thread_id) {
+      std::mt19937_64 random(thread_id);
+      std::uniform_int_distribution<uint64_t> distribution(0, keys_per_thread * thread_count - 1);
+      size_t local_missing = 0;
+      for (size_t i = 0; i < ops_per_thread; i++) {
+        auto key = distribution(random);
+        auto value = index.Lookup(key);
+        if (!value || *value != key * 2) {
+          local_missing++;
+        }
+      }
+      std::unique_lock lock(missing_mutex);
+      missing += local_missing;
+    });
+    fmt::print("{:<12} threads: {:<3} insert: {:>12.0f} ops/s  lookup: {:>12.0f} ops/s{}\n", name, thread_count,
+               insert_rate, lookup_rate, missing == 0 ? "" : fmt::format("  ({} lookups failed)", missing));
+  }
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  size_t key_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  size_t ops_per_thread = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+  size_t max_threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : std::thread::hardware_concurrency();
+  max_threads = std::max<size_t>(max_threads, 1);
+  Benchmark<huadb::OlcBPlusTree<uint64_t, uint64_t>>("olc_btree", key_count, ops_per_thread, max_threads);
+  Benchmark<LockedMap>("locked_map", key_count, ops_per_thread, max_threads);
+  return 0;
+}
@@ -0,0 +1,103 @@
+// 故障恢复的基准测试：比较不同日志量和重做工作线程数下恢复的耗时，以及即时恢复时数据库可以开始接受查询的时间
+// 用法：recovery_benchmark [最大日志量（MB）] [最大工作线程数]
+// 每次运行重新生成数据：在若干张表上追加整页的索引页面日志，刷盘后清空 buffer pool 模拟故障，再计时恢复
+// 在当前目录下的临时目录中运行，结束后删除
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "fmt/format.h"
+#include "log/log_manager.h"
+#include "storage/buffer_pool.h"
+#include "storage/disk.h"
+#include "transaction/lock_manager.h"
+#include "transaction/transaction_manager.h"
+
+namespace {
+
+using namespace huadb;
+
+constexpr size_t TABLE_COUNT = 4;
+constexpr pageid_t PAGES_PER_TABLE = 256;
+
+struct Result {
+  // Recover 返回、可以开始接受查询的时间（秒）
+  double open_;
+  // 完成全部重做和回滚的时间（秒）
+  double total_;
+  // 重做的页面数
+  uint32_t redo_count_;
+};
+
+Result Benchmark(size_t log_size, size_t redo_workers, bool instant) {
+  std::filesystem::remove_all(BASE_PATH);
+  Disk disk;
+  LockManager lock_manager;
+  TransactionManager transaction_manager(lock_manager, FIRST_XID);
+  LogManager log_manager(disk, transaction_manager, FIRST_LSN);
+  auto buffer_pool = std::make_shared<BufferPool>(disk, log_manager);
+  log_manager.SetBufferPool(buffer_pool);
+  auto catalog = std::make_shared<Catalog>(*buffer_pool, log_manager);
+  log_manager.SetCatalog(catalog);
+  catalog->CreateSystemTables();
+  catalog->CreateDatabase("recovery_benchmark", false);
+  catalog->ChangeDatabase("recovery_benchmark");
+  std::vector<oid_t> oids;
+  for (size_t i = 0; i < TABLE_COUNT; i++) {
+    auto table_name = fmt::format("t{}", i);
+    catalog->CreateTable(table_name, ColumnList({ColumnDefinition("id", Type::INT)}));
+    oids.push_back(catalog->GetTableOid(table_name));
+  }
+  auto db_oid = catalog->GetDatabaseOid(oids[0]);
+
+  // 轮流修改各表的页面，直到日志量达到 log_size
+  xid_t xid = FIRST_XID;
+  std::vector<char> image(DB_PAGE_SIZE);
+  for (size_t i = 0; log_manager.GetNextLSN() < log_size; i++) {
+    image[DB_PAGE_SIZE - 1] = static_cast<char>(i);
+    auto page_id = static_cast<pageid_t>(i / TABLE_COUNT % PAGES_PER_TABLE);
+    log_manager.AppendIndexPageLog(xid, db_oid, oids[i % TABLE_COUNT], {{page_id, image}});
+    if (i % 100 == 99) {
+      log_manager.AppendCommitLog(xid++);
+    }
+  }
+  log_manager.AppendCommitLog(xid);
+  buffer_pool->Clear();
+
+  log_manager.SetRedoWorkers(redo_workers);
+  auto start = std::chrono::steady_clock::now();
+  log_manager.Recover(instant);
+  std::chrono::duration<double> open = std::chrono::steady_clock::now() - start;
+  log_manager.FinishRecovery();
+  std::chrono::duration<double> total = std::chrono::steady_clock::now() - start;
+  return {open.count(), total.count(), log_manager.GetRedoCount()};
+}
+
+void Print(size_t log_size, const char *mode, const Result &result) {
+  fmt::print("log={:<3} MB {:<10} open: {:>8.3f} s  total: {:>8.3f} s  pages/s: {:>10.0f}\n", log_size, mode,
+             result.open_, result.total_, result.redo_count_ / result.total_);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  size_t max_log_size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16;
+  size_t max_workers = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+  auto directory = std::filesystem::current_path() / "recovery_benchmark";
+  std::filesystem::create_directories(directory);
+  std::filesystem::current_path(directory);
+  for (size_t log_size = 1; log_size <= max_log_size; log_size *= 4) {
+    for (size_t workers = 1; workers <= max_workers; workers *= 2) {
+      Print(log_size, fmt::format("workers={}", workers).c_str(), Benchmark(log_size << 20, workers, false));
+    }
+    Print(log_size, "instant", Benchmark(log_size << 20, 1, true));
+  }
+  std::filesystem::remove_all(BASE_PATH);
+  std::filesystem::current_path(directory.parent_path());
+  std::filesystem::remove_all(directory);
+  return 0;
+}
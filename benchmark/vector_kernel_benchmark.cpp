@@ -0,0 +1,211 @@
+// 向量化过滤与算术函数的基准测试：分别使用标量、SSE4.2、AVX2 实现处理连续的列向量，输出每个时钟周期处理的行数
+// 最后比较过滤条件逐行求值与按批向量化求值（含读取列向量的开销）的吞吐量
+// 用法：vector_kernel_benchmark [行数] [重复次数]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/constants.h"
+#include "executors/expression_program.h"
+#include "executors/vector_kernels.h"
+#include "executors/vector_predicate.h"
+#include "fmt/format.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace {
+
+using huadb::ArithmeticType;
+using huadb::ComparisonType;
+using huadb::VectorKernels;
+using InstructionSet = huadb::VectorKernels::InstructionSet;
+
+// 返回每个时钟周期处理的行数；不支持读取时间戳计数器时返回每纳秒处理的行数
+template <typename Func>
+double Measure(size_t rows, size_t rounds, Func func) {
+#if defined(__x86_64__) || defined(__i386__)
+  auto start = __rdtsc();
+  for (size_t i = 0; i < rounds; i++) {
+    func();
+  }
+  return static_cast<double>(rows * rounds) / static_cast<double>(__rdtsc() - start);
+#else
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < rounds; i++) {
+    func();
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return rows * rounds / elapsed.count();
+#endif
+}
+
+struct Columns {
+  std::vector<int32_t> ints_;
+  std::vector<int32_t> ints2_;
+  std::vector<uint32_t> uints_;
+  std::vector<double> doubles_;
+  std::vector<double> doubles2_;
+};
+
+Columns MakeColumns(size_t count) {
+  std::mt19937 random(0);
+  std::uniform_int_distribution<int32_t> int_distribution(0, 100000);
+  std::uniform_real_distribution<double> double_distribution(0, 1);
+  Columns columns;
+  for (size_t i = 0; i < count; i++) {
+    columns.ints_.push_back(int_distribution(random));
+    columns.ints2_.push_back(int_distribution(random) + 1);
+    columns.uints_.push_back(static_cast<uint32_t>(int_distribution(random)));
+    columns.doubles_.push_back(double_distribution(random));
+    columns.doubles2_.push_back(double_distribution(random) + 1);
+  }
+  return columns;
+}
+
+void BenchmarkKernels(const Columns &columns, size_t rounds) {
+  auto count = columns.ints_.size();
+  std::vector<uint64_t> mask(VectorKernels::MaskWords(count));
+  std::vector<uint32_t> selection(count);
+  std::vector<int32_t> int_result(count);
+  std::vector<double> double_result(count);
+  size_t selected = 0;
+
+  struct Case {
+    const char *name_;
+    std::function<void()> func_;
+  };
+  std::vector<Case> cases = {
+      {"int <",
+       [&]() { VectorKernels::Compare(ComparisonType::LESS, columns.ints_.data(), count, 50000, mask.data()); }},
+      {"int <>",
+       [&]() { VectorKernels::Compare(ComparisonType::NOT_EQUAL, columns.ints_.data(), count, 7, mask.data()); }},
+      {"uint >=",
+       [&]() {
+         VectorKernels::Compare(ComparisonType::GREATER_EQUAL, columns.uints_.data(), count, 50000u, mask.data());
+       }},
+      {"double >",
+       [&]() { VectorKernels::Compare(ComparisonType::GREATER, columns.doubles_.data(), count, 0.5, mask.data()); }},
+      {"int between", [&]() { VectorKernels::Between(columns.ints_.data(), count, 1000, 2000, mask.data()); }},
+      {"double between",
+       [&]() { VectorKernels::Between(columns.doubles_.data(), count, 0.25, 0.75, mask.data()); }},
+      {"int +",
+       [&]() {
+         VectorKernels::Compute(ArithmeticType::ADD, columns.ints_.data(), columns.ints2_.data(), count, nullptr,
+                                int_result.data());
+       }},
+      {"int *",
+       [&]() {
+         VectorKernels::Compute(ArithmeticType::MUL, columns.ints_.data(), columns.ints2_.data(), count, nullptr,
+                                int_result.data());
+       }},
+      {"double /",
+       [&]() {
+         VectorKernels::Compute(ArithmeticType::DIV, columns.doubles_.data(), columns.doubles2_.data(), count,
+                                nullptr, double_result.data());
+       }},
+      {"selection", [&]() { selected = VectorKernels::ToSelection(mask.data(), count, selection.data()); }},
+  };
+
+  std::vector<InstructionSet> instruction_sets;
+  fmt::print("{:<16}", "rows/cycle");
+  for (auto instruction_set : {InstructionSet::SCALAR, InstructionSet::SSE4_2, InstructionSet::AVX2}) {
+    if (VectorKernels::IsSupported(instruction_set)) {
+      instruction_sets.push_back(instruction_set);
+      fmt::print("{:>10}", VectorKernels::GetInstructionSetName(instruction_set));
+    }
+  }
+  fmt::print("\n");
+  auto detected = VectorKernels::GetInstructionSet();
+  for (const auto &test_case : cases) {
+    fmt::print("{:<16}", test_case.name_);
+    for (auto instruction_set : instruction_sets) {
+      VectorKernels::SetInstructionSet(instruction_set);
+      // selection 的输入为上一次比较的结果，先生成选择率约 50% 的位图
+      VectorKernels::Compare(ComparisonType::LESS, columns.ints_.data(), count, 50000, mask.data());
+      fmt::print("{:>10.3f}", Measure(count, rounds, test_case.func_));
+    }
+    fmt::print("\n");
+  }
+  VectorKernels::SetInstructionSet(detected);
+  fmt::print("selected: {}\n", selected);
+}
+
+// 过滤条件 id > 50000 and score < 0.5 and id between 1000 and 90000
+void BenchmarkPredicate(const Columns &columns, size_t rounds) {
+  using huadb::ColumnValue;
+  using huadb::Comparison;
+  using huadb::Const;
+  using huadb::Logic;
+  using huadb::LogicType;
+  using huadb::OperatorExpression;
+  using huadb::Record;
+  using huadb::Type;
+  using huadb::Value;
+
+  std::shared_ptr<OperatorExpression> id = std::make_shared<ColumnValue>(0, Type::INT, "id", 4);
+  std::shared_ptr<OperatorExpression> score = std::make_shared<ColumnValue>(1, Type::DOUBLE, "score", 8);
+  auto predicate = std::make_shared<Logic>(
+      LogicType::AND,
+      std::make_shared<Logic>(
+          LogicType::AND,
+          std::make_shared<Comparison>(ComparisonType::GREATER, id, std::make_shared<Const>(Value(50000))),
+          std::make_shared<Comparison>(ComparisonType::LESS, score, std::make_shared<Const>(Value(0.5)))),
+      std::make_shared<Comparison>(
+          ComparisonType::BETWEEN, id,
+          std::make_shared<huadb::List>(std::vector<std::shared_ptr<OperatorExpression>>{
+              std::make_shared<Const>(Value(1000)), std::make_shared<Const>(Value(90000))})));
+
+  std::vector<std::shared_ptr<Record>> records;
+  for (size_t i = 0; i < columns.ints_.size(); i++) {
+    records.push_back(
+        std::make_shared<Record>(std::vector<Value>{Value(columns.ints_[i]), Value(columns.doubles_[i])}));
+  }
+
+  huadb::ExpressionProgram program(predicate, true);
+  size_t program_matched = 0;
+  auto program_rate = Measure(records.size(), rounds, [&]() {
+    program_matched = 0;
+    for (const auto &record : records) {
+      if (program.Test(*record)) {
+        program_matched++;
+      }
+    }
+  });
+
+  auto vector_predicate = huadb::VectorPredicate::Compile(predicate);
+  std::vector<std::shared_ptr<Record>> batch;
+  std::vector<uint32_t> selection;
+  size_t vector_matched = 0;
+  auto vector_rate = Measure(records.size(), rounds, [&]() {
+    vector_matched = 0;
+    for (size_t begin = 0; begin < records.size(); begin += huadb::FILTER_BATCH_SIZE) {
+      auto end = std::min(records.size(), begin + huadb::FILTER_BATCH_SIZE);
+      batch.assign(records.begin() + begin, records.begin() + end);
+      vector_predicate->Select(batch, selection);
+      vector_matched += selection.size();
+    }
+  });
+  fmt::print("predicate       row: {:.3f} rows/cycle  vector: {:.3f} rows/cycle  speedup: {:.2f}x  matched: {}{}\n",
+             program_rate, vector_rate, vector_rate / program_rate, vector_matched,
+             vector_matched == program_matched ? "" : fmt::format(" (row matched {})", program_matched));
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 20;
+  size_t rounds = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+  auto columns = MakeColumns(count);
+  fmt::print("detected instruction set: {}\n",
+             VectorKernels::GetInstructionSetName(VectorKernels::GetInstructionSet()));
+  BenchmarkKernels(columns, rounds);
+  BenchmarkPredicate(columns, rounds);
+  return 0;
+}
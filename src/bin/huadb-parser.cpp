@@ -3,9 +3,11 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "argparse/argparse.hpp"
 #include "common/constants.h"
+#include "fmt/format.h"
 #include "table/table_page.h"
 
 namespace fs = std::filesystem;
@@ -81,34 +83,41 @@ void parse_log(const fs::path &path) {
   file.close();
   file.clear();
 
-  if (!fs::is_regular_file(log_name)) {
-    std::cerr << "File not found: " << log_name << std::endl;
+  if (!fs::is_directory(log_name)) {
+    std::cerr << "Directory not found: " << log_name << std::endl;
     std::exit(1);
   }
-  file.open(log_name, std::fstream::binary);
-  if (file.fail()) {
-    std::cerr << "Failed to open file: " << log_name << std::endl;
-    std::exit(1);
-  }
-  char buffer[huadb::LOG_SEGMENT_SIZE];
+  // 日志段回收后，从 Master Record 记录的 Checkpoint 开始解析
   huadb::lsn_t lsn = huadb::FIRST_LSN;
-  while (!file.eof()) {
-    file.read(buffer, huadb::LOG_SEGMENT_SIZE);
-    if (file.gcount() == 0) {
-      break;
+  auto segment_name = [&](huadb::lsn_t offset) {
+    return log_name / fmt::format("{:016X}", offset / huadb::LOG_SEGMENT_SIZE);
+  };
+  if (!fs::is_regular_file(segment_name(lsn)) && fs::is_regular_file(path / huadb::MASTER_RECORD_NAME)) {
+    std::ifstream master_record(path / huadb::MASTER_RECORD_NAME);
+    master_record >> lsn;
+  }
+  // 读取 [lsn, next_lsn) 的日志
+  std::vector<char> buffer;
+  for (auto offset = lsn - lsn % huadb::LOG_SEGMENT_SIZE; offset < next_lsn; offset += huadb::LOG_SEGMENT_SIZE) {
+    file.open(segment_name(offset), std::fstream::binary);
+    if (file.fail()) {
+      std::cerr << "Failed to open file: " << segment_name(offset) << std::endl;
+      std::exit(1);
     }
+    buffer.resize(buffer.size() + huadb::LOG_SEGMENT_SIZE);
+    file.read(buffer.data() + buffer.size() - huadb::LOG_SEGMENT_SIZE, huadb::LOG_SEGMENT_SIZE);
     if (file.gcount() != huadb::LOG_SEGMENT_SIZE) {
       std::cerr << "Incorrect log segment size" << std::endl;
       std::exit(1);
     }
-    while (lsn < next_lsn) {
-      auto log = huadb::LogRecord::DeserializeFrom(lsn, buffer + lsn);
-      std::cout << log->ToString() << std::endl;
-      lsn += log->GetSize();
-    }
-    if (lsn >= next_lsn) {
-      break;
-    }
+    file.close();
+    file.clear();
+  }
+  auto base = lsn - lsn % huadb::LOG_SEGMENT_SIZE;
+  while (lsn < next_lsn) {
+    auto log = huadb::LogRecord::DeserializeFrom(lsn, buffer.data() + (lsn - base));
+    std::cout << log->ToString() << std::endl;
+    lsn += log->GetSize();
   }
 }
 
@@ -26,7 +26,7 @@ void PlainShell() {
         std::cout << "FLUSH" << std::endl;
       } else if (query.substr(0, 7) == "restart") {
         database.reset();
-        database = std::make_unique<huadb::DatabaseEngine>();
+        database = std::make_unique<huadb::DatabaseEngine>(query.substr(0, 15) == "restart instant");
         connection.reset();
         connection = std::make_unique<huadb::Connection>(*database);
         std::cout << "RESTART" << std::endl;
@@ -90,7 +90,7 @@ void LinenoiseShell() {
         std::cout << "FLUSH" << std::endl;
       } else if (query.substr(0, 7) == "restart") {
         database.reset();
-        database = std::make_unique<huadb::DatabaseEngine>();
+        database = std::make_unique<huadb::DatabaseEngine>(query.substr(0, 15) == "restart instant");
         connection.reset();
         connection = std::make_unique<huadb::Connection>(*database);
         std::cout << "RESTART" << std::endl;
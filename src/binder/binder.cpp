@@ -29,6 +29,7 @@
 #include "catalog/column_definition.h"
 #include "common/exceptions.h"
 #include "common/value.h"
+#include "function/function_registry.h"
 #include "nodes/parsenodes.hpp"
 
 namespace huadb {
@@ -77,6 +78,13 @@ std::unique_ptr<Statement> Binder::BindStatement(duckdb_libpgquery::PGNode *stmt
     case duckdb_libpgquery::T_PGVacuumStmt:
       return BindVacuumStatement(reinterpret_cast<duckdb_libpgquery::PGVacuumStmt *>(stmt));
 
+    case duckdb_libpgquery::T_PGPrepareStmt:
+      return BindPrepareStatement(reinterpret_cast<duckdb_libpgquery::PGPrepareStmt *>(stmt));
+    case duckdb_libpgquery::T_PGExecuteStmt:
+      return BindExecuteStatement(reinterpret_cast<duckdb_libpgquery::PGExecuteStmt *>(stmt));
+    case duckdb_libpgquery::T_PGDeallocateStmt:
+      return BindDeallocateStatement(reinterpret_cast<duckdb_libpgquery::PGDeallocateStmt *>(stmt));
+
     default:
       throw DbException("Unsupported statement type: " + NodeTagToString(stmt->type));
   }
@@ -320,10 +328,18 @@ std::unique_ptr<Statement> Binder::BindExplainStatement(duckdb_libpgquery::PGExp
         explain_options |= ExplainOptions::PLANNER;
       } else if (strcasecmp(elem->defname, "optimizer") == 0) {
         explain_options |= ExplainOptions::OPTIMIZER;
+      } else if (strcasecmp(elem->defname, "costs") == 0) {
+        explain_options |= ExplainOptions::COSTS;
+      } else if (strcasecmp(elem->defname, "analyze") == 0) {
+        explain_options |= ExplainOptions::ANALYZE;
       } else {
         throw DbException("Unknown explain option: " + std::string(elem->defname));
       }
     }
+    // 只指定 costs 或 analyze 时输出优化后的查询计划
+    if ((explain_options & (ExplainOptions::BINDER | ExplainOptions::PLANNER | ExplainOptions::OPTIMIZER)) == 0) {
+      explain_options |= ExplainOptions::OPTIMIZER;
+    }
   } else {
     explain_options = ExplainOptions::BINDER | ExplainOptions::PLANNER | ExplainOptions::OPTIMIZER;
   }
@@ -415,6 +431,44 @@ std::unique_ptr<Statement> Binder::BindVacuumStatement(duckdb_libpgquery::PGVacu
   }
 }
 
+std::unique_ptr<Statement> Binder::BindPrepareStatement(duckdb_libpgquery::PGPrepareStmt *stmt) {
+  switch (stmt->query->type) {
+    case duckdb_libpgquery::T_PGSelectStmt:
+    case duckdb_libpgquery::T_PGInsertStmt:
+    case duckdb_libpgquery::T_PGUpdateStmt:
+    case duckdb_libpgquery::T_PGDeleteStmt:
+      break;
+    default:
+      throw DbException("Only SELECT, INSERT, UPDATE and DELETE can be prepared");
+  }
+  // 参数个数取声明的参数类型个数和查询中出现的最大编号中的较大值，参数类型只用于确定参数个数
+  allow_parameters_ = true;
+  parameter_count_ = stmt->argtypes == nullptr ? 0 : stmt->argtypes->length;
+  auto statement = BindStatement(stmt->query);
+  allow_parameters_ = false;
+  return std::make_unique<PrepareStatement>(stmt->name, std::move(statement), parameter_count_);
+}
+
+std::unique_ptr<Statement> Binder::BindExecuteStatement(duckdb_libpgquery::PGExecuteStmt *stmt) {
+  std::vector<Value> parameters;
+  if (stmt->params != nullptr) {
+    for (const auto &expr : BindExpressionList(stmt->params)) {
+      if (expr->type_ != ExpressionType::CONST) {
+        throw DbException("Only const is supported in EXECUTE");
+      }
+      parameters.push_back(dynamic_cast<const ConstExpression &>(*expr).value_);
+    }
+  }
+  return std::make_unique<ExecuteStatement>(stmt->name, std::move(parameters));
+}
+
+std::unique_ptr<Statement> Binder::BindDeallocateStatement(duckdb_libpgquery::PGDeallocateStmt *stmt) {
+  if (stmt->name == nullptr) {
+    return std::make_unique<DeallocateStatement>(std::nullopt);
+  }
+  return std::make_unique<DeallocateStatement>(stmt->name);
+}
+
 std::unique_ptr<Expression> Binder::BindExpression(duckdb_libpgquery::PGNode *expr) {
   switch (expr->type) {
     case duckdb_libpgquery::T_PGAConst:
@@ -429,6 +483,8 @@ std::unique_ptr<Expression> Binder::BindExpression(duckdb_libpgquery::PGNode *ex
       return BindStarExpression(reinterpret_cast<duckdb_libpgquery::PGAStar *>(expr));
     case duckdb_libpgquery::T_PGFuncCall:
       return BindFuncCallExpression(reinterpret_cast<duckdb_libpgquery::PGFuncCall *>(expr));
+    case duckdb_libpgquery::T_PGCoalesceExpr:
+      return BindCoalesceExpression(reinterpret_cast<duckdb_libpgquery::PGCoalesceExpr *>(expr));
     case duckdb_libpgquery::T_PGBoolExpr:
       return BindBoolExpression(reinterpret_cast<duckdb_libpgquery::PGBoolExpr *>(expr));
     case duckdb_libpgquery::T_PGNullTest:
@@ -437,6 +493,8 @@ std::unique_ptr<Expression> Binder::BindExpression(duckdb_libpgquery::PGNode *ex
       return BindListExpression(reinterpret_cast<duckdb_libpgquery::PGList *>(expr));
     case duckdb_libpgquery::T_PGTypeCast:
       return BindTypeCastExpression(reinterpret_cast<duckdb_libpgquery::PGTypeCast *>(expr));
+    case duckdb_libpgquery::T_PGParamRef:
+      return BindParamRefExpression(reinterpret_cast<duckdb_libpgquery::PGParamRef *>(expr));
     default:
       throw DbException("Unsupported expression type: " + NodeTagToString(expr->type));
   }
@@ -533,8 +591,9 @@ std::unique_ptr<Expression> Binder::BindStarExpression(duckdb_libpgquery::PGASta
 }
 
 std::unique_ptr<Expression> Binder::BindFuncCallExpression(duckdb_libpgquery::PGFuncCall *expr) {
+  // substring、extract 等函数名带有 pg_catalog 前缀，只取最后一部分
   std::string function_name =
-      reinterpret_cast<duckdb_libpgquery::PGValue *>(expr->funcname->head->data.ptr_value)->val.str;
+      reinterpret_cast<duckdb_libpgquery::PGValue *>(expr->funcname->tail->data.ptr_value)->val.str;
   std::transform(function_name.begin(), function_name.end(), function_name.begin(),
                  [](unsigned char character) { return std::tolower(character); });
 
@@ -550,7 +609,7 @@ std::unique_ptr<Expression> Binder::BindFuncCallExpression(duckdb_libpgquery::PG
       function_name == "max") {
     return std::make_unique<AggregateExpression>(std::move(function_name), expr->agg_distinct, std::move(args));
   }
-  if (function_name == "lower" || function_name == "upper" || function_name == "length") {
+  if (FunctionRegistry::GetInstance().Contains(function_name)) {
     if (expr->agg_distinct) {
       throw DbException(fmt::format("DISTINCT specified, but {} is not an aggregate function", function_name));
     }
@@ -559,6 +618,10 @@ std::unique_ptr<Expression> Binder::BindFuncCallExpression(duckdb_libpgquery::PG
   throw DbException("Unsupported function call: " + function_name);
 }
 
+std::unique_ptr<Expression> Binder::BindCoalesceExpression(duckdb_libpgquery::PGCoalesceExpr *expr) {
+  return std::make_unique<FuncCallExpression>("coalesce", BindExpressionList(expr->args));
+}
+
 std::unique_ptr<Expression> Binder::BindBoolExpression(duckdb_libpgquery::PGBoolExpr *expr) {
   switch (expr->boolop) {
     case duckdb_libpgquery::PG_AND_EXPR:
@@ -630,6 +693,17 @@ std::unique_ptr<Expression> Binder::BindTypeCastExpression(duckdb_libpgquery::PG
   return std::make_unique<TypeCastExpression>(TypeUtil::String2Type(type_name), std::move(arg));
 }
 
+std::unique_ptr<Expression> Binder::BindParamRefExpression(duckdb_libpgquery::PGParamRef *expr) {
+  if (!allow_parameters_) {
+    throw DbException("Parameters are only allowed in PREPARE");
+  }
+  if (expr->number <= 0) {
+    throw DbException("Only parameters in the form of $n are supported");
+  }
+  parameter_count_ = std::max(parameter_count_, static_cast<size_t>(expr->number));
+  return std::make_unique<ParameterExpression>(expr->number);
+}
+
 std::vector<std::unique_ptr<OrderBy>> Binder::BindOrderBy(duckdb_libpgquery::PGList *list) {
   auto order_by = std::vector<std::unique_ptr<OrderBy>>();
   for (auto *node = list->head; node != nullptr; node = lnext(node)) {
@@ -56,6 +56,7 @@ struct PGList;
 struct PGTypeCast;
 struct PGColumnRef;
 struct PGFuncCall;
+struct PGCoalesceExpr;
 
 struct PGRangeVar;
 struct PGJoinExpr;
@@ -66,6 +67,11 @@ struct PGVariableSetStmt;
 struct PGVariableShowStmt;
 
 struct PGCopyStmt;
+
+struct PGPrepareStmt;
+struct PGExecuteStmt;
+struct PGDeallocateStmt;
+struct PGParamRef;
 }  // namespace duckdb_libpgquery
 
 namespace huadb {
@@ -110,6 +116,10 @@ class Binder {
 
   std::unique_ptr<Statement> BindVacuumStatement(duckdb_libpgquery::PGVacuumStmt *stmt);
 
+  std::unique_ptr<Statement> BindPrepareStatement(duckdb_libpgquery::PGPrepareStmt *stmt);
+  std::unique_ptr<Statement> BindExecuteStatement(duckdb_libpgquery::PGExecuteStmt *stmt);
+  std::unique_ptr<Statement> BindDeallocateStatement(duckdb_libpgquery::PGDeallocateStmt *stmt);
+
  private:
   static std::string NodeTagToString(duckdb_libpgquery::PGNodeTag tag);
 
@@ -122,10 +132,12 @@ class Binder {
   std::unique_ptr<Expression> BindExprExpression(duckdb_libpgquery::PGAExpr *expr);
   std::unique_ptr<Expression> BindStarExpression(duckdb_libpgquery::PGAStar *expr);
   std::unique_ptr<Expression> BindFuncCallExpression(duckdb_libpgquery::PGFuncCall *expr);
+  std::unique_ptr<Expression> BindCoalesceExpression(duckdb_libpgquery::PGCoalesceExpr *expr);
   std::unique_ptr<Expression> BindBoolExpression(duckdb_libpgquery::PGBoolExpr *expr);
   std::unique_ptr<Expression> BindNullTestExpression(duckdb_libpgquery::PGNullTest *expr);
   std::unique_ptr<Expression> BindListExpression(duckdb_libpgquery::PGList *expr);
   std::unique_ptr<Expression> BindTypeCastExpression(duckdb_libpgquery::PGTypeCast *expr);
+  std::unique_ptr<Expression> BindParamRefExpression(duckdb_libpgquery::PGParamRef *expr);
 
   std::vector<std::unique_ptr<OrderBy>> BindOrderBy(duckdb_libpgquery::PGList *list);
 
@@ -152,6 +164,9 @@ class Binder {
   std::unordered_multimap<std::string, std::string> aliases_;
   std::unordered_set<std::string> table_names_;
   bool adding_alias_ = true;
+  // 绑定 PREPARE 中的查询时才允许出现参数，parameter_count_ 记录参数个数
+  bool allow_parameters_ = false;
+  size_t parameter_count_ = 0;
 };
 
 }  // namespace huadb
@@ -18,6 +18,7 @@ enum class ExpressionType {
   INVALID,
   LIST,
   NULL_TEST,
+  PARAMETER,
   STAR,
   UNARY_OP,
 };
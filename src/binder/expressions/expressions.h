@@ -8,6 +8,7 @@
 #include "binder/expressions/func_call_expression.h"
 #include "binder/expressions/list_expression.h"
 #include "binder/expressions/null_test_expression.h"
+#include "binder/expressions/parameter_expression.h"
 #include "binder/expressions/star_expression.h"
 #include "binder/expressions/type_cast_expression.h"
 #include "binder/expressions/unary_op_expression.h"
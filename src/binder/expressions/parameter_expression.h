@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+#include "binder/expression.h"
+
+namespace huadb {
+
+// 预备语句中的参数 $n，执行时替换为 EXECUTE 给出的第 n 个值
+class ParameterExpression : public Expression {
+ public:
+  explicit ParameterExpression(size_t index) : Expression(ExpressionType::PARAMETER), index_(index) {}
+  std::string ToString() const override { return "$" + std::to_string(index_); }
+  bool HasAggregation() const override { return false; }
+
+  size_t index_;
+};
+
+}  // namespace huadb
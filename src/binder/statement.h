@@ -10,13 +10,16 @@ enum class StatementType {
   CREATE_DATABASE_STATEMENT,
   CREATE_INDEX_STATEMENT,
   CREATE_TABLE_STATEMENT,
+  DEALLOCATE_STATEMENT,
   DELETE_STATEMENT,
   DROP_DATABASE_STATEMENT,
   DROP_INDEX_STATEMENT,
   DROP_TABLE_STATEMENT,
+  EXECUTE_STATEMENT,
   EXPLAIN_STATEMENT,
   INSERT_STATEMENT,
   LOCK_STATEMENT,
+  PREPARE_STATEMENT,
   SELECT_STATEMENT,
   TRANSACTION_STATEMENT,
   UPDATE_STATEMENT,
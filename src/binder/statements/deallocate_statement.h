@@ -0,0 +1,23 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "binder/statement.h"
+#include "fmt/format.h"
+
+namespace huadb {
+
+class DeallocateStatement : public Statement {
+ public:
+  // name 为空时删除所有预备语句（DEALLOCATE ALL）
+  explicit DeallocateStatement(std::optional<std::string> name)
+      : Statement(StatementType::DEALLOCATE_STATEMENT), name_(std::move(name)) {}
+  std::string ToString() const override {
+    return fmt::format("DeallocateStatement: name={}\n", name_.value_or("ALL"));
+  }
+
+  std::optional<std::string> name_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "binder/statement.h"
+#include "common/value.h"
+#include "fmt/format.h"
+#include "fmt/ranges.h"
+
+namespace huadb {
+
+class ExecuteStatement : public Statement {
+ public:
+  ExecuteStatement(std::string name, std::vector<Value> parameters)
+      : Statement(StatementType::EXECUTE_STATEMENT), name_(std::move(name)), parameters_(std::move(parameters)) {}
+  std::string ToString() const override {
+    std::vector<std::string> parameters;
+    for (const auto &parameter : parameters_) {
+      parameters.push_back(parameter.ToString());
+    }
+    return fmt::format("ExecuteStatement: name={}, parameters=[{}]\n", name_, fmt::join(parameters, ", "));
+  }
+
+  std::string name_;
+  std::vector<Value> parameters_;
+};
+
+}  // namespace huadb
@@ -11,6 +11,10 @@ enum ExplainOptions {
   BINDER = 1,
   PLANNER = 2,
   OPTIMIZER = 4,
+  // 在优化后的查询计划中显示估计的代价和记录数
+  COSTS = 8,
+  // 执行查询，并显示各算子实际输出的记录数
+  ANALYZE = 16,
 };
 
 class ExplainStatement : public Statement {
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "binder/statement.h"
+#include "fmt/format.h"
+
+namespace huadb {
+
+class PrepareStatement : public Statement {
+ public:
+  PrepareStatement(std::string name, std::unique_ptr<Statement> statement, size_t parameter_count)
+      : Statement(StatementType::PREPARE_STATEMENT),
+        name_(std::move(name)),
+        statement_(std::move(statement)),
+        parameter_count_(parameter_count) {}
+  std::string ToString() const override {
+    return fmt::format("PrepareStatement: name={}, parameter_count={}\n statement={}\n", name_, parameter_count_,
+                       statement_->ToString());
+  }
+
+  std::string name_;
+  std::unique_ptr<Statement> statement_;
+  size_t parameter_count_;
+};
+
+}  // namespace huadb
@@ -5,13 +5,16 @@
 #include "binder/statements/create_database_statement.h"
 #include "binder/statements/create_index_statement.h"
 #include "binder/statements/create_table_statement.h"
+#include "binder/statements/deallocate_statement.h"
 #include "binder/statements/delete_statement.h"
 #include "binder/statements/drop_database_statement.h"
 #include "binder/statements/drop_index_statement.h"
 #include "binder/statements/drop_table_statement.h"
+#include "binder/statements/execute_statement.h"
 #include "binder/statements/explain_statement.h"
 #include "binder/statements/insert_statement.h"
 #include "binder/statements/lock_statement.h"
+#include "binder/statements/prepare_statement.h"
 #include "binder/statements/select_statement.h"
 #include "binder/statements/transaction_statement.h"
 #include "binder/statements/update_statement.h"
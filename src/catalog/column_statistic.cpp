@@ -0,0 +1,285 @@
+#include "catalog/column_statistic.h"
+
+#include <algorithm>
+
+#include "common/type_util.h"
+
+namespace huadb {
+
+namespace {
+
+// 数值类型转换为 double，用于在直方图的桶内插值
+std::optional<double> ToDouble(const Value &value) {
+  switch (value.GetType()) {
+    case Type::INT:
+      return value.GetValue<int32_t>();
+    case Type::DOUBLE:
+      return value.GetValue<double>();
+    default:
+      return std::nullopt;
+  }
+}
+
+// 跳过上下界的公共前缀后，将随后的几个字节看作小数，用于字符串在桶内插值
+// 进制取三个字符串中出现的最小和最大字节之间的范围，使只含数字等少量字符的字符串也能均匀插值
+void StringsToScalars(const std::string &value, const std::string &low, const std::string &high, double &value_scalar,
+                      double &low_scalar, double &high_scalar) {
+  size_t prefix_size = 0;
+  while (prefix_size < low.size() && prefix_size < high.size() && low[prefix_size] == high[prefix_size]) {
+    prefix_size++;
+  }
+  int min_char = 255;
+  int max_char = 0;
+  for (const auto *str : {&value, &low, &high}) {
+    for (size_t i = prefix_size; i < str->size(); i++) {
+      min_char = std::min<int>(min_char, static_cast<unsigned char>((*str)[i]));
+      max_char = std::max<int>(max_char, static_cast<unsigned char>((*str)[i]));
+    }
+  }
+  if (min_char > max_char) {
+    min_char = max_char = 0;
+  }
+  // 字符串结束按比最小字节更小的值处理
+  double base = max_char - min_char + 2;
+  auto convert = [&](const std::string &str) {
+    double result = 0;
+    double scale = 1;
+    for (size_t i = prefix_size; i < prefix_size + 4; i++) {
+      scale /= base;
+      if (i < str.size()) {
+        result += (static_cast<unsigned char>(str[i]) - min_char + 1) * scale;
+      }
+    }
+    return result;
+  };
+  value_scalar = convert(value);
+  low_scalar = convert(low);
+  high_scalar = convert(high);
+}
+
+bool InRange(const Value &value, const std::optional<Value> &lower, bool lower_inclusive,
+             const std::optional<Value> &upper, bool upper_inclusive) {
+  if (lower && (value.Less(*lower) || (!lower_inclusive && value.Equal(*lower)))) {
+    return false;
+  }
+  if (upper && (value.Greater(*upper) || (!upper_inclusive && value.Equal(*upper)))) {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+ColumnStatistic ColumnStatistic::Build(const std::unordered_map<Value, uint32_t> &frequencies, uint32_t rows,
+                                       uint32_t distinct) {
+  ColumnStatistic statistic;
+  statistic.distinct_ = distinct;
+  if (rows == 0 || frequencies.empty()) {
+    return statistic;
+  }
+  std::vector<std::pair<Value, uint32_t>> entries(frequencies.begin(), frequencies.end());
+  auto type = entries.front().first.GetType();
+  bool ordered = type == Type::INT || type == Type::DOUBLE || type == Type::CHAR || type == Type::VARCHAR;
+  // 按出现次数从高到低排序，次数相同时按值排序，保证结果确定
+  std::sort(entries.begin(), entries.end(), [ordered](const auto &lhs, const auto &rhs) {
+    if (lhs.second != rhs.second) {
+      return lhs.second > rhs.second;
+    }
+    return ordered && lhs.first.Less(rhs.first);
+  });
+
+  // 不同值较少时全部作为高频值；否则只保留出现次数明显高于平均值的值
+  uint64_t total = 0;
+  for (const auto &entry : entries) {
+    total += entry.second;
+  }
+  double average = static_cast<double>(total) / entries.size();
+  size_t mcv_count = 0;
+  if (entries.size() <= STATISTIC_MCV_COUNT) {
+    mcv_count = entries.size();
+  } else {
+    while (mcv_count < STATISTIC_MCV_COUNT && entries[mcv_count].second > 1 &&
+           entries[mcv_count].second > average * 1.25) {
+      mcv_count++;
+    }
+  }
+  for (size_t i = 0; i < mcv_count; i++) {
+    statistic.most_common_values_.push_back(entries[i].first);
+    statistic.most_common_freqs_.push_back(static_cast<double>(entries[i].second) / rows);
+  }
+  if (!ordered || mcv_count == entries.size()) {
+    return statistic;
+  }
+
+  // 其余值从小到大排列，按累计出现次数等分为若干个桶
+  std::vector<std::pair<Value, uint32_t>> rest(entries.begin() + mcv_count, entries.end());
+  std::sort(rest.begin(), rest.end(), [](const auto &lhs, const auto &rhs) { return lhs.first.Less(rhs.first); });
+  uint64_t rest_total = 0;
+  for (const auto &entry : rest) {
+    rest_total += entry.second;
+  }
+  auto buckets = std::min<uint64_t>(STATISTIC_HISTOGRAM_BUCKETS, rest_total - 1);
+  if (buckets == 0) {
+    return statistic;
+  }
+  size_t pos = 0;
+  uint64_t seen = rest[0].second;
+  for (uint64_t i = 0; i <= buckets; i++) {
+    // 第 i 个边界为排序后第 i * (rest_total - 1) / buckets 个值（从 0 开始）
+    auto target = i * (rest_total - 1) / buckets;
+    while (seen <= target) {
+      seen += rest[++pos].second;
+    }
+    statistic.histogram_bounds_.push_back(rest[pos].first);
+  }
+  return statistic;
+}
+
+double ColumnStatistic::EstimateDistinct(const std::unordered_map<Value, uint32_t> &frequencies, double sample_rows,
+                                         double total_rows) {
+  double distinct = frequencies.size();
+  if (sample_rows <= 0 || sample_rows >= total_rows) {
+    return distinct;
+  }
+  // 样本中只出现一次的值越多，未被抽到的值可能越多
+  double once = 0;
+  for (const auto &[value, count] : frequencies) {
+    if (count == 1) {
+      once++;
+    }
+  }
+  auto estimate = sample_rows * distinct / (sample_rows - once + once * sample_rows / total_rows);
+  return std::clamp(estimate, distinct, total_rows);
+}
+
+bool ColumnStatistic::Comparable(const Value &value, bool ordered) const {
+  if (value.IsNull()) {
+    return false;
+  }
+  const Value *sample = nullptr;
+  if (!most_common_values_.empty()) {
+    sample = &most_common_values_.front();
+  } else if (!histogram_bounds_.empty()) {
+    sample = &histogram_bounds_.front();
+  }
+  if (sample == nullptr || sample->GetType() != value.GetType()) {
+    return false;
+  }
+  auto type = value.GetType();
+  if (type == Type::INT || type == Type::DOUBLE || type == Type::CHAR || type == Type::VARCHAR) {
+    return true;
+  }
+  return !ordered && type == Type::BOOL;
+}
+
+double ColumnStatistic::EqualSelectivity(const Value &value) const {
+  for (size_t i = 0; i < most_common_values_.size(); i++) {
+    if (most_common_values_[i].Equal(value)) {
+      return most_common_freqs_[i];
+    }
+  }
+  // 其余记录在高频值以外的不同值上均匀分布
+  if (distinct_ == INVALID_DISTINCT || distinct_ <= most_common_values_.size()) {
+    return 0;
+  }
+  return (1 - MostCommonFrequency()) / (distinct_ - most_common_values_.size());
+}
+
+double ColumnStatistic::RangeSelectivity(const std::optional<Value> &lower, bool lower_inclusive,
+                                         const std::optional<Value> &upper, bool upper_inclusive) const {
+  double selectivity = 0;
+  for (size_t i = 0; i < most_common_values_.size(); i++) {
+    if (InRange(most_common_values_[i], lower, lower_inclusive, upper, upper_inclusive)) {
+      selectivity += most_common_freqs_[i];
+    }
+  }
+  if (histogram_bounds_.size() >= 2) {
+    auto begin = lower ? HistogramFraction(*lower) : 0;
+    auto end = upper ? HistogramFraction(*upper) : 1;
+    selectivity += std::max(0.0, end - begin) * (1 - MostCommonFrequency());
+  }
+  return std::min(selectivity, 1.0);
+}
+
+double ColumnStatistic::JoinSelectivity(const ColumnStatistic &lhs, const ColumnStatistic &rhs) {
+  auto lhs_distinct = std::max<double>(lhs.distinct_, 1);
+  auto rhs_distinct = std::max<double>(rhs.distinct_, 1);
+  if (lhs.most_common_values_.empty() || rhs.most_common_values_.empty() ||
+      lhs.most_common_values_.front().GetType() != rhs.most_common_values_.front().GetType()) {
+    return 1 / std::max(lhs_distinct, rhs_distinct);
+  }
+  // 两侧相同的高频值直接按频率相乘；未匹配的高频值与另一侧的其余值匹配；
+  // 两侧其余值之间假设不同值较少一侧的每个值都能在另一侧找到匹配
+  double matched = 0;
+  double lhs_matched = 0;
+  std::vector<bool> rhs_matched(rhs.most_common_values_.size(), false);
+  for (size_t i = 0; i < lhs.most_common_values_.size(); i++) {
+    for (size_t j = 0; j < rhs.most_common_values_.size(); j++) {
+      if (!rhs_matched[j] && lhs.most_common_values_[i].Equal(rhs.most_common_values_[j])) {
+        matched += lhs.most_common_freqs_[i] * rhs.most_common_freqs_[j];
+        lhs_matched += lhs.most_common_freqs_[i];
+        rhs_matched[j] = true;
+        break;
+      }
+    }
+  }
+  double rhs_matched_freq = 0;
+  for (size_t j = 0; j < rhs.most_common_values_.size(); j++) {
+    if (rhs_matched[j]) {
+      rhs_matched_freq += rhs.most_common_freqs_[j];
+    }
+  }
+  auto lhs_other = std::max(0.0, 1 - lhs.MostCommonFrequency());
+  auto rhs_other = std::max(0.0, 1 - rhs.MostCommonFrequency());
+  auto lhs_rest = std::max(1.0, lhs_distinct - lhs.most_common_values_.size());
+  auto rhs_rest = std::max(1.0, rhs_distinct - rhs.most_common_values_.size());
+  auto lhs_unmatched = lhs.MostCommonFrequency() - lhs_matched;
+  auto rhs_unmatched = rhs.MostCommonFrequency() - rhs_matched_freq;
+  auto selectivity = matched + lhs_unmatched * rhs_other / rhs_rest + rhs_unmatched * lhs_other / lhs_rest +
+                     lhs_other * rhs_other / std::max(lhs_rest, rhs_rest);
+  return std::clamp(selectivity, 0.0, 1.0);
+}
+
+double ColumnStatistic::MostCommonFrequency() const {
+  double frequency = 0;
+  for (auto freq : most_common_freqs_) {
+    frequency += freq;
+  }
+  return frequency;
+}
+
+double ColumnStatistic::HistogramFraction(const Value &value) const {
+  const auto &bounds = histogram_bounds_;
+  auto buckets = bounds.size() - 1;
+  if (!bounds.front().Less(value)) {
+    return 0;
+  }
+  if (!value.Less(bounds.back())) {
+    return 1;
+  }
+  // 找到 value 所在的桶，在桶内线性插值
+  size_t i = 0;
+  while (!value.Less(bounds[i + 1])) {
+    i++;
+  }
+  auto low = ToDouble(bounds[i]);
+  auto high = ToDouble(bounds[i + 1]);
+  auto val = ToDouble(value);
+  if (TypeUtil::IsString(value.GetType())) {
+    double val_scalar;
+    double low_scalar;
+    double high_scalar;
+    StringsToScalars(value.GetValue<std::string>(), bounds[i].GetValue<std::string>(),
+                     bounds[i + 1].GetValue<std::string>(), val_scalar, low_scalar, high_scalar);
+    val = val_scalar;
+    low = low_scalar;
+    high = high_scalar;
+  }
+  double inner = 0.5;
+  if (low && high && val && *high > *low) {
+    inner = std::clamp((*val - *low) / (*high - *low), 0.0, 1.0);
+  }
+  return (i + inner) / buckets;
+}
+
+}  // namespace huadb
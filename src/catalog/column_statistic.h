@@ -0,0 +1,50 @@
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "common/constants.h"
+#include "common/value.h"
+
+namespace huadb {
+
+// ANALYZE 收集的列统计信息
+// 高频值单独记录出现频率；其余非空值按等深直方图记录，相邻边界之间的记录数相同
+struct ColumnStatistic {
+  // 不同值个数
+  uint32_t distinct_ = INVALID_DISTINCT;
+  // 出现次数最多的值，按出现频率从高到低排列
+  std::vector<Value> most_common_values_;
+  // 高频值的记录数占表中全部记录的比例
+  std::vector<double> most_common_freqs_;
+  // 除高频值外其余非空值的等深直方图边界，从小到大排列
+  std::vector<Value> histogram_bounds_;
+
+  // frequencies 为每个非空值在 rows 条记录中的出现次数，distinct 为不同值个数
+  static ColumnStatistic Build(const std::unordered_map<Value, uint32_t> &frequencies, uint32_t rows,
+                               uint32_t distinct);
+
+  // 按 Haas 和 Stokes 的 Duj1 估计量，由 sample_rows 条样本中各值的出现次数估计 total_rows 条记录中的不同值个数
+  static double EstimateDistinct(const std::unordered_map<Value, uint32_t> &frequencies, double sample_rows,
+                                 double total_rows);
+
+  // 统计信息是否可以与 value 比较，类型不同或类型不支持比较大小时不可用
+  bool Comparable(const Value &value, bool ordered) const;
+  // 列等于 value 的记录比例
+  double EqualSelectivity(const Value &value) const;
+  // 列在 [lower, upper] 范围内的记录比例，边界为空时表示该侧不受限制
+  // inclusive 表示是否包含边界值
+  double RangeSelectivity(const std::optional<Value> &lower, bool lower_inclusive, const std::optional<Value> &upper,
+                          bool upper_inclusive) const;
+  // 两列等值连接的选择率，按两侧的高频值逐个匹配
+  static double JoinSelectivity(const ColumnStatistic &lhs, const ColumnStatistic &rhs);
+
+ private:
+  // 高频值的频率之和
+  double MostCommonFrequency() const;
+  // 直方图中小于 value 的值所占的比例
+  double HistogramFraction(const Value &value) const;
+};
+
+}  // namespace huadb
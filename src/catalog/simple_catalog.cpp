@@ -75,6 +75,7 @@ void SimpleCatalog::ChangeDatabase(const std::string &database_name) {
 
 void SimpleCatalog::CreateTable(const std::string &table_name, const ColumnList &column_list, oid_t oid, oid_t db_oid,
                                 bool new_table) {
+  version_++;
   // Step1. 约束检测
   if (db_oid == INVALID_OID) {
     db_oid = current_database_oid_;
@@ -113,6 +114,7 @@ void SimpleCatalog::CreateTable(const std::string &table_name, const ColumnList
 }
 
 void SimpleCatalog::DropTable(const std::string &table_name) {
+  version_++;
   assert(current_database_oid_ != SYSTEM_DATABASE_OID);
   if (!oid_manager_.EntryExists(OidType::TABLE, table_name)) {
     throw DbException("Table \"" + table_name + "\" does not exist");
@@ -132,7 +134,8 @@ void SimpleCatalog::DropTable(const std::string &table_name) {
   db_out << "~" << table_name << " ";
 }
 
-void SimpleCatalog::CreateIndex(const std::string &index_name, const std::string &table_name) {
+void SimpleCatalog::CreateIndex(const std::string &index_name, const std::string &table_name,
+                                const std::vector<std::string> &column_names, uint32_t fill_factor) {
   throw DbException("ChangeIndex not implemented in SimpleCatalog");
 }
 
@@ -140,6 +143,12 @@ void SimpleCatalog::DropIndex(const std::string &index_name) {
   throw DbException("DropIndex not implemented in SimpleCatalog");
 }
 
+std::shared_ptr<Index> SimpleCatalog::GetIndex(oid_t oid) const {
+  throw DbException("GetIndex not implemented in SimpleCatalog");
+}
+
+std::vector<std::shared_ptr<Index>> SimpleCatalog::GetTableIndexes(oid_t table_oid) const { return {}; }
+
 std::vector<std::string> SimpleCatalog::GetTableNames() const {
   std::vector<std::string> table_names;
   for (const auto &[name, _] : name2oid_) {
@@ -162,6 +171,8 @@ oid_t SimpleCatalog::GetTableOid(const std::string &table_name) const {
   return oid_manager_.GetEntryOid(OidType::TABLE, table_name);
 }
 
+std::string SimpleCatalog::GetTableName(oid_t oid) const { return oid_manager_.GetEntryName(oid); }
+
 const ColumnList &SimpleCatalog::GetTableColumnList(oid_t oid) const { return GetTable(oid)->GetColumnList(); }
 
 const ColumnList &SimpleCatalog::GetTableColumnList(const std::string &table_name) const {
@@ -179,8 +190,20 @@ uint32_t SimpleCatalog::GetDistinct(const std::string &table_name, const std::st
   return INVALID_DISTINCT;
 }
 
+const ColumnStatistic *SimpleCatalog::GetColumnStatistic(const std::string &table_name,
+                                                         const std::string &column_name) const {
+  return nullptr;
+}
+
 void SimpleCatalog::SetCardinality(const std::string &table_name, uint32_t cardinality) {}
 
 void SimpleCatalog::SetDistinct(const std::string &table_name, const std::string &column_name, uint32_t distinct) {}
 
+void SimpleCatalog::SetColumnStatistic(const std::string &table_name, const std::string &column_name,
+                                       const ColumnStatistic &statistic) {}
+
+void SimpleCatalog::AddModifications(const std::string &table_name, const TableModifications &modifications) {}
+
+uint32_t SimpleCatalog::GetModifications(const std::string &table_name) const { return 0; }
+
 }  // namespace huadb
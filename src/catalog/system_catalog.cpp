@@ -6,12 +6,105 @@
 #include "common/constants.h"
 #include "common/exceptions.h"
 #include "common/value.h"
+#include "index/index.h"
 #include "table/record.h"
 #include "table/table.h"
 #include "table/table_scan.h"
 
 namespace huadb {
 
+namespace {
+
+// 统计信息中的值按 "长度:字符串" 的形式依次拼接，保证字符串中的任意字符都能正确解析
+std::string EncodeValues(const std::vector<Value> &values) {
+  std::string result;
+  for (const auto &value : values) {
+    auto str = value.ToString();
+    result += std::to_string(str.size()) + ":" + str;
+  }
+  return result;
+}
+
+std::vector<Value> DecodeValues(const std::string &str, Type type) {
+  std::vector<Value> values;
+  size_t pos = 0;
+  while (pos < str.size()) {
+    auto colon = str.find(':', pos);
+    auto length = std::stoul(str.substr(pos, colon - pos));
+    auto text = str.substr(colon + 1, length);
+    pos = colon + 1 + length;
+    switch (type) {
+      case Type::BOOL:
+        values.emplace_back(text == "true");
+        break;
+      case Type::INT:
+        values.emplace_back(static_cast<int32_t>(std::stoi(text)));
+        break;
+      case Type::DOUBLE:
+        values.emplace_back(std::stod(text));
+        break;
+      case Type::CHAR:
+      case Type::VARCHAR:
+        values.emplace_back(std::move(text), type);
+        break;
+      default:
+        throw DbException("Unsupported statistic value type");
+    }
+  }
+  return values;
+}
+
+// 频率按万分比保存，以逗号分隔
+std::string EncodeFrequencies(const std::vector<double> &freqs) {
+  std::string result;
+  for (size_t i = 0; i < freqs.size(); i++) {
+    if (i > 0) {
+      result += ",";
+    }
+    result += std::to_string(static_cast<uint32_t>(freqs[i] * 10000 + 0.5));
+  }
+  return result;
+}
+
+std::vector<double> DecodeFrequencies(const std::string &str) {
+  std::vector<double> freqs;
+  size_t pos = 0;
+  while (pos < str.size()) {
+    auto comma = str.find(',', pos);
+    if (comma == std::string::npos) {
+      comma = str.size();
+    }
+    freqs.push_back(std::stoul(str.substr(pos, comma - pos)) / 10000.0);
+    pos = comma + 1;
+  }
+  return freqs;
+}
+
+// 系统表中各列的长度有限，超出时高频值从频率最低的开始舍弃，直方图减少桶数
+void FitStatistic(ColumnStatistic &statistic, size_t max_values_size, size_t max_bounds_size) {
+  auto &values = statistic.most_common_values_;
+  while (!values.empty() && EncodeValues(values).size() > max_values_size) {
+    values.pop_back();
+    statistic.most_common_freqs_.pop_back();
+  }
+  auto &bounds = statistic.histogram_bounds_;
+  while (!bounds.empty() && EncodeValues(bounds).size() > max_bounds_size) {
+    if (bounds.size() <= 2) {
+      bounds.clear();
+      break;
+    }
+    auto buckets = bounds.size() - 1;
+    auto new_buckets = buckets / 2;
+    std::vector<Value> new_bounds;
+    for (size_t i = 0; i <= new_buckets; i++) {
+      new_bounds.push_back(bounds[(i * buckets + new_buckets / 2) / new_buckets]);
+    }
+    bounds = std::move(new_bounds);
+  }
+}
+
+}  // namespace
+
 SystemCatalog::SystemCatalog(BufferPool &buffer_pool, LogManager &log_manager, oid_t next_oid)
     : buffer_pool_(buffer_pool), log_manager_(log_manager), oid_manager_(next_oid) {}
 
@@ -22,6 +115,7 @@ void SystemCatalog::CreateSystemTables() {
   CreateTable(TABLE_META_NAME, table_meta_schema, TABLE_META_OID, SYSTEM_DATABASE_OID, true);
   CreateTable(DATABASE_META_NAME, database_meta_schema, DATABASE_META_OID, SYSTEM_DATABASE_OID, true);
   CreateTable(STATISTIC_META_NAME, statistic_schema, STATISTIC_META_OID, SYSTEM_DATABASE_OID, true);
+  CreateTable(INDEX_META_NAME, index_meta_schema, INDEX_META_OID, SYSTEM_DATABASE_OID, true);
   // 插入默认数据库
   CreateDatabase(SYSTEM_DATABASE_NAME, false, SYSTEM_DATABASE_OID);
   CreateDatabase(DEFAULT_DATABASE_NAME, false);
@@ -35,6 +129,7 @@ void SystemCatalog::LoadSystemTables() {
   CreateTable(TABLE_META_NAME, table_meta_schema, TABLE_META_OID, SYSTEM_DATABASE_OID, false);
   CreateTable(DATABASE_META_NAME, database_meta_schema, DATABASE_META_OID, SYSTEM_DATABASE_OID, false);
   CreateTable(STATISTIC_META_NAME, statistic_schema, STATISTIC_META_OID, SYSTEM_DATABASE_OID, false);
+  CreateTable(INDEX_META_NAME, index_meta_schema, INDEX_META_OID, SYSTEM_DATABASE_OID, false);
   // 加载数据库信息
   LoadDatabaseMeta();
 
@@ -89,6 +184,14 @@ void SystemCatalog::DropDatabase(const std::string &database_name, bool missing_
       auto table_name = record->GetValue(table_name_idx).GetValue<std::string>();
     }
   }
+  auto index_meta = GetTable(INDEX_META_OID);
+  scan = std::make_shared<TableScan>(buffer_pool_, index_meta, Rid{index_meta->GetFirstPageId(), 0});
+  db_oid_idx = index_meta_schema.GetColumnIndex("db_oid");
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(db_oid_idx).GetValue<oid_t>() == db_oid) {
+      index_meta->DeleteRecord(record->GetRid(), DDL_XID, false);
+    }
+  }
 
   // Step 4. DatabaseMeta 中删除对应项
   bool deleted = false;
@@ -132,6 +235,7 @@ void SystemCatalog::ChangeDatabase(oid_t db_oid) {
 }
 
 void SystemCatalog::ChangeDatabase(const std::string &database_name) {
+  version_++;
   if (!DatabaseExists(database_name)) {
     throw DbException("Database \"" + database_name + "\" does not exist");
   }
@@ -153,6 +257,7 @@ void SystemCatalog::ChangeDatabase(const std::string &database_name) {
   // 加载切换数据库的所有表
   LoadTableMeta();
   LoadStatistics();
+  LoadIndexMeta();
 }
 
 oid_t SystemCatalog::GetDatabaseOid(oid_t table_oid) const {
@@ -173,6 +278,7 @@ oid_t SystemCatalog::GetDatabaseOid(oid_t table_oid) const {
 
 void SystemCatalog::CreateTable(const std::string &table_name, const ColumnList &column_list, oid_t oid, oid_t db_oid,
                                 bool new_table) {
+  version_++;
   // Step 1. 约束检测
   if (db_oid == INVALID_OID) {
     CheckUsingDatabase();
@@ -215,6 +321,7 @@ void SystemCatalog::CreateTable(const std::string &table_name, const ColumnList
 }
 
 void SystemCatalog::DropTable(const std::string &table_name) {
+  version_++;
   // Step 1. 约束检测
   CheckUsingDatabase();
   assert(current_database_oid_ != SYSTEM_DATABASE_OID);
@@ -222,6 +329,10 @@ void SystemCatalog::DropTable(const std::string &table_name) {
     throw DbException("Table \"" + table_name + "\" does not exist");
   }
   oid_t table_oid = oid_manager_.GetEntryOid(OidType::TABLE, table_name);
+  // 删除表上的索引
+  for (const auto &index : GetTableIndexes(table_oid)) {
+    DropIndex(index->GetName());
+  }
   // Step 2. 实际删除表
   // 磁盘中删除对应项
   Disk::RemoveFile(Disk::GetFilePath(current_database_oid_, table_oid));
@@ -244,11 +355,91 @@ void SystemCatalog::DropTable(const std::string &table_name) {
   if (!deleted) {
     throw DbException("Table \"" + table_name + "\" does not exist in table_meta");
   }
+  // Step 5: 删除表的统计信息
+  DropStatistics(table_name);
+}
+
+void SystemCatalog::CreateIndex(const std::string &index_name, const std::string &table_name,
+                                const std::vector<std::string> &column_names, uint32_t fill_factor) {
+  version_++;
+  // Step 1. 约束检测
+  CheckUsingDatabase();
+  if (oid_manager_.EntryExists(OidType::INDEX, index_name)) {
+    throw DbException("Index \"" + index_name + "\" already exists");
+  }
+  if (column_names.size() != 1) {
+    throw DbException("Only single-column indexes are supported");
+  }
+  if (fill_factor < MIN_INDEX_FILL_FACTOR || fill_factor > MAX_INDEX_FILL_FACTOR) {
+    throw DbException("Index fill factor must be between " + std::to_string(MIN_INDEX_FILL_FACTOR) + " and " +
+                      std::to_string(MAX_INDEX_FILL_FACTOR));
+  }
+  oid_t table_oid = GetTableOid(table_name);
+  const auto &column_list = GetTableColumnList(table_oid);
+  auto column_idx = column_list.GetColumnIndex(column_names[0]);
+  const auto &column = column_list.GetColumn(column_idx);
+  auto key_size = Index::KeySize(column.GetType(), column.GetMaxSize());
+  if (key_size > MAX_INDEX_KEY_SIZE) {
+    throw DbException("Column \"" + column_names[0] + "\" is too long to be indexed");
+  }
+  // Step 2. OidManager 添加对应项
+  oid_t oid = oid_manager_.CreateEntry(OidType::INDEX, index_name);
+  // Step 3. 创建索引文件，并加入表中已有的记录
+  Disk::CreateFile(Disk::GetFilePath(current_database_oid_, oid));
+  auto index = std::make_shared<Index>(buffer_pool_, log_manager_, oid, current_database_oid_, index_name,
+                                       table_oid, column_names[0], column_idx, column.GetType(), key_size, true);
+  BuildIndex(*index, column.GetType(), key_size, fill_factor);
+  oid2index_[oid] = std::move(index);
+  // Step 4. IndexMeta 中添加对应记录
+  std::vector<Value> values;
+  values.emplace_back(oid);
+  values.emplace_back(current_database_oid_);
+  values.emplace_back(index_name);
+  values.emplace_back(table_oid);
+  values.emplace_back(column_names[0]);
+  GetTable(INDEX_META_OID)->InsertRecord(std::make_shared<Record>(std::move(values)), DDL_XID, DDL_CID, false);
+}
+
+void SystemCatalog::DropIndex(const std::string &index_name) {
+  version_++;
+  // Step 1. 约束检测
+  CheckUsingDatabase();
+  if (!oid_manager_.EntryExists(OidType::INDEX, index_name)) {
+    throw DbException("Index \"" + index_name + "\" does not exist");
+  }
+  // Step 2. OidManager 删除对应项
+  oid_t index_oid = oid_manager_.DropEntry(OidType::INDEX, index_name);
+  oid2index_.erase(index_oid);
+  Disk::RemoveFile(Disk::GetFilePath(current_database_oid_, index_oid));
+  // Step 3. IndexMeta 删除对应条目
+  auto index_meta = GetTable(INDEX_META_OID);
+  auto scan = std::make_shared<TableScan>(buffer_pool_, index_meta, Rid{index_meta->GetFirstPageId(), 0});
+  auto index_oid_idx = index_meta_schema.GetColumnIndex("index_oid");
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(index_oid_idx).GetValue<oid_t>() == index_oid) {
+      index_meta->DeleteRecord(record->GetRid(), DDL_XID, false);
+      return;
+    }
+  }
+  throw DbException("Index \"" + index_name + "\" does not exist in index_meta");
 }
 
-void SystemCatalog::CreateIndex(const std::string &index_name, const std::string &table_name) {}
+std::shared_ptr<Index> SystemCatalog::GetIndex(oid_t oid) const {
+  if (oid2index_.find(oid) == oid2index_.end()) {
+    throw DbException("Index with oid " + std::to_string(oid) + " does not exist");
+  }
+  return oid2index_.at(oid);
+}
 
-void SystemCatalog::DropIndex(const std::string &index_name) {}
+std::vector<std::shared_ptr<Index>> SystemCatalog::GetTableIndexes(oid_t table_oid) const {
+  std::vector<std::shared_ptr<Index>> indexes;
+  for (const auto &[_, index] : oid2index_) {
+    if (index->GetTableOid() == table_oid) {
+      indexes.push_back(index);
+    }
+  }
+  return indexes;
+}
 
 std::vector<std::string> SystemCatalog::GetTableNames() const {
   if (current_database_oid_ == INVALID_OID) {
@@ -282,6 +473,8 @@ oid_t SystemCatalog::GetTableOid(const std::string &table_name) const {
   return oid_manager_.GetEntryOid(OidType::TABLE, table_name);
 }
 
+std::string SystemCatalog::GetTableName(oid_t oid) const { return oid_manager_.GetEntryName(oid); }
+
 const ColumnList &SystemCatalog::GetTableColumnList(oid_t oid) const { return GetTable(oid)->GetColumnList(); }
 
 const ColumnList &SystemCatalog::GetTableColumnList(const std::string &table_name) const {
@@ -308,6 +501,7 @@ uint32_t SystemCatalog::GetDistinct(const std::string &table_name, const std::st
 }
 
 void SystemCatalog::SetCardinality(const std::string &table_name, uint32_t cardinality) {
+  version_++;
   auto table_meta = GetTable(TABLE_META_OID);
   auto scan = std::make_shared<TableScan>(buffer_pool_, table_meta, Rid{table_meta->GetFirstPageId(), 0});
   auto db_oid_idx = table_meta_schema.GetColumnIndex("db_oid");
@@ -323,6 +517,7 @@ void SystemCatalog::SetCardinality(const std::string &table_name, uint32_t cardi
       record->SetValue(cardinality_idx, Value(cardinality));
       table_meta->UpdateRecordInPlace(*record);
       table2cardinality_[table_name] = cardinality;
+      table2modifications_[table_name] = 0;
       found = true;
     }
   }
@@ -332,6 +527,7 @@ void SystemCatalog::SetCardinality(const std::string &table_name, uint32_t cardi
 }
 
 void SystemCatalog::SetDistinct(const std::string &table_name, const std::string &column_name, uint32_t distinct) {
+  version_++;
   auto statistic = GetTable(STATISTIC_META_OID);
   auto scan = std::make_shared<TableScan>(buffer_pool_, statistic, Rid{statistic->GetFirstPageId(), 0});
   auto table_name_idx = statistic_schema.GetColumnIndex("table_name");
@@ -358,12 +554,100 @@ void SystemCatalog::SetDistinct(const std::string &table_name, const std::string
     values.emplace_back(current_database_oid_);
     values.emplace_back(column_name);
     values.emplace_back(distinct);
+    values.emplace_back("");
+    values.emplace_back("");
+    values.emplace_back("");
     statistic->InsertRecord(std::make_shared<Record>(std::move(values)), DDL_XID, DDL_CID, false);
     col2distinct_[table_name + "." + column_name] = distinct;
   }
+  col2statistic_[table_name + "." + column_name].distinct_ = distinct;
+}
+
+const ColumnStatistic *SystemCatalog::GetColumnStatistic(const std::string &table_name,
+                                                         const std::string &column_name) const {
+  auto iter = col2statistic_.find(table_name + "." + column_name);
+  if (iter == col2statistic_.end()) {
+    return nullptr;
+  }
+  return &iter->second;
+}
+
+void SystemCatalog::SetColumnStatistic(const std::string &table_name, const std::string &column_name,
+                                       const ColumnStatistic &statistic) {
+  version_++;
+  auto fitted = statistic;
+  FitStatistic(fitted, statistic_schema.GetColumn(statistic_schema.GetColumnIndex("most_common_vals")).GetMaxSize(),
+               statistic_schema.GetColumn(statistic_schema.GetColumnIndex("histogram_bounds")).GetMaxSize());
+  // 统计信息长度可变，删除原有记录后重新插入
+  auto statistic_table = GetTable(STATISTIC_META_OID);
+  auto scan = std::make_shared<TableScan>(buffer_pool_, statistic_table, Rid{statistic_table->GetFirstPageId(), 0});
+  auto table_name_idx = statistic_schema.GetColumnIndex("table_name");
+  auto db_oid_idx = statistic_schema.GetColumnIndex("db_oid");
+  auto column_name_idx = statistic_schema.GetColumnIndex("column_name");
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(db_oid_idx).GetValue<oid_t>() == current_database_oid_ &&
+        record->GetValue(table_name_idx).GetValue<std::string>() == table_name &&
+        record->GetValue(column_name_idx).GetValue<std::string>() == column_name) {
+      statistic_table->DeleteRecord(record->GetRid(), DDL_XID, false);
+    }
+  }
+  std::vector<Value> values;
+  values.emplace_back(table_name);
+  values.emplace_back(current_database_oid_);
+  values.emplace_back(column_name);
+  values.emplace_back(fitted.distinct_);
+  values.emplace_back(EncodeValues(fitted.most_common_values_));
+  values.emplace_back(EncodeFrequencies(fitted.most_common_freqs_));
+  values.emplace_back(EncodeValues(fitted.histogram_bounds_));
+  statistic_table->InsertRecord(std::make_shared<Record>(std::move(values)), DDL_XID, DDL_CID, false);
+  col2distinct_[table_name + "." + column_name] = fitted.distinct_;
+  col2statistic_[table_name + "." + column_name] = std::move(fitted);
+}
+
+void SystemCatalog::AddModifications(const std::string &table_name, const TableModifications &modifications) {
+  // 未收集过统计信息的表没有可以增量更新的记录数，只累加修改次数
+  if (GetCardinality(table_name) != INVALID_CARDINALITY) {
+    auto &cardinality = table2cardinality_[table_name];
+    if (cardinality + modifications.inserted_ < modifications.deleted_) {
+      cardinality = 0;
+    } else {
+      cardinality = cardinality + modifications.inserted_ - modifications.deleted_;
+    }
+  }
+  table2modifications_[table_name] += modifications.inserted_ + modifications.updated_ + modifications.deleted_;
+}
+
+uint32_t SystemCatalog::GetModifications(const std::string &table_name) const {
+  if (table2modifications_.find(table_name) == table2modifications_.end()) {
+    return 0;
+  }
+  return table2modifications_.at(table_name);
+}
+
+void SystemCatalog::DropStatistics(const std::string &table_name) {
+  table2cardinality_.erase(table_name);
+  table2modifications_.erase(table_name);
+  auto prefix = table_name + ".";
+  for (auto iter = col2distinct_.begin(); iter != col2distinct_.end();) {
+    iter = iter->first.compare(0, prefix.size(), prefix) == 0 ? col2distinct_.erase(iter) : std::next(iter);
+  }
+  for (auto iter = col2statistic_.begin(); iter != col2statistic_.end();) {
+    iter = iter->first.compare(0, prefix.size(), prefix) == 0 ? col2statistic_.erase(iter) : std::next(iter);
+  }
+  auto statistic = GetTable(STATISTIC_META_OID);
+  auto scan = std::make_shared<TableScan>(buffer_pool_, statistic, Rid{statistic->GetFirstPageId(), 0});
+  auto table_name_idx = statistic_schema.GetColumnIndex("table_name");
+  auto db_oid_idx = statistic_schema.GetColumnIndex("db_oid");
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(db_oid_idx).GetValue<oid_t>() == current_database_oid_ &&
+        record->GetValue(table_name_idx).GetValue<std::string>() == table_name) {
+      statistic->DeleteRecord(record->GetRid(), DDL_XID, false);
+    }
+  }
 }
 
 void SystemCatalog::ExitDatabase() {
+  version_++;
   // 约束检测
   assert(current_database_oid_ != INVALID_OID);
   // 特判：系统表常驻内存，默认不清除系统表
@@ -384,6 +668,10 @@ void SystemCatalog::ExitDatabase() {
     oid_manager_.DropEntry(OidType::TABLE, table_name);
     oid2table_.erase(oid);
   }
+  for (const auto &[oid, _] : oid2index_) {
+    oid_manager_.DropEntry(OidType::INDEX, oid_manager_.GetEntryName(oid));
+  }
+  oid2index_.clear();
   // 设定数据库 id 为无效值
   current_database_oid_ = INVALID_OID;
 }
@@ -400,6 +688,21 @@ bool SystemCatalog::DatabaseExists(const std::string &database_name) const {
 
 void SystemCatalog::DropTable(oid_t oid) { DropTable(oid_manager_.GetEntryName(oid)); }
 
+void SystemCatalog::BuildIndex(Index &index, Type key_type, db_size_t key_size, uint32_t fill_factor) {
+  // 扫描一遍表，对 (key, rid) 进行外部排序，再自底向上建立 B+ 树
+  IndexSorter sorter(key_type, key_size, Disk::GetFilePath(current_database_oid_, index.GetOid()));
+  auto table = GetTable(index.GetTableOid());
+  auto scan = std::make_shared<TableScan>(buffer_pool_, table, Rid{table->GetFirstPageId(), 0});
+  while (auto record = scan->GetNextRecord()) {
+    auto key = record->GetValue(index.GetColumnIndex());
+    if (!key.IsNull()) {
+      sorter.Add(IndexEntry{std::move(key), record->GetRid()});
+    }
+  }
+  sorter.Finish();
+  index.BulkLoad(sorter, fill_factor, DDL_XID);
+}
+
 void SystemCatalog::LoadDatabaseMeta() {
   assert(oid2table_.find(DATABASE_META_OID) != oid2table_.end());
   auto db_meta = GetTable(DATABASE_META_OID);
@@ -447,12 +750,51 @@ void SystemCatalog::LoadStatistics() {
   auto db_oid_idx = statistic_schema.GetColumnIndex("db_oid");
   auto column_name_idx = statistic_schema.GetColumnIndex("column_name");
   auto n_distinct_idx = statistic_schema.GetColumnIndex("n_distinct");
+  auto mcv_idx = statistic_schema.GetColumnIndex("most_common_vals");
+  auto mcf_idx = statistic_schema.GetColumnIndex("most_common_freqs");
+  auto histogram_idx = statistic_schema.GetColumnIndex("histogram_bounds");
   while (auto record = scan->GetNextRecord()) {
     if (record->GetValue(db_oid_idx).GetValue<oid_t>() == current_database_oid_) {
       auto table_name = record->GetValue(table_name_idx).GetValue<std::string>();
       auto column_name = record->GetValue(column_name_idx).GetValue<std::string>();
       auto n_distinct = record->GetValue(n_distinct_idx).GetValue<uint32_t>();
       col2distinct_[table_name + "." + column_name] = n_distinct;
+      // 按列的类型解析高频值和直方图边界
+      auto &statistic = col2statistic_[table_name + "." + column_name];
+      statistic.distinct_ = n_distinct;
+      if (!oid_manager_.EntryExists(OidType::TABLE, table_name)) {
+        continue;
+      }
+      const auto &column_list = GetTableColumnList(table_name);
+      auto type = column_list.GetColumn(column_list.GetColumnIndex(column_name)).GetType();
+      statistic.most_common_values_ = DecodeValues(record->GetValue(mcv_idx).GetValue<std::string>(), type);
+      statistic.most_common_freqs_ = DecodeFrequencies(record->GetValue(mcf_idx).GetValue<std::string>());
+      statistic.histogram_bounds_ = DecodeValues(record->GetValue(histogram_idx).GetValue<std::string>(), type);
+    }
+  }
+}
+
+void SystemCatalog::LoadIndexMeta() {
+  auto index_meta = GetTable(INDEX_META_OID);
+  auto scan = std::make_shared<TableScan>(buffer_pool_, index_meta, Rid{index_meta->GetFirstPageId(), 0});
+  auto index_oid_idx = index_meta_schema.GetColumnIndex("index_oid");
+  auto db_oid_idx = index_meta_schema.GetColumnIndex("db_oid");
+  auto index_name_idx = index_meta_schema.GetColumnIndex("index_name");
+  auto table_oid_idx = index_meta_schema.GetColumnIndex("table_oid");
+  auto column_name_idx = index_meta_schema.GetColumnIndex("column_name");
+  while (auto record = scan->GetNextRecord()) {
+    if (record->GetValue(db_oid_idx).GetValue<oid_t>() == current_database_oid_) {
+      auto oid = record->GetValue(index_oid_idx).GetValue<oid_t>();
+      auto index_name = record->GetValue(index_name_idx).GetValue<std::string>();
+      auto table_oid = record->GetValue(table_oid_idx).GetValue<oid_t>();
+      auto column_name = record->GetValue(column_name_idx).GetValue<std::string>();
+      const auto &column_list = GetTableColumnList(table_oid);
+      auto column_idx = column_list.GetColumnIndex(column_name);
+      const auto &column = column_list.GetColumn(column_idx);
+      oid_manager_.SetEntryOid(OidType::INDEX, index_name, oid);
+      oid2index_[oid] = std::make_shared<Index>(buffer_pool_, log_manager_, oid, current_database_oid_, index_name,
+                                                table_oid, column_name, column_idx, column.GetType(),
+                                                Index::KeySize(column.GetType(), column.GetMaxSize()), false);
     }
   }
 }
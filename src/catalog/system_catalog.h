@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "catalog/column_list.h"
+#include "catalog/column_statistic.h"
 #include "catalog/oid_manager.h"
 #include "common/constants.h"
 
@@ -40,16 +41,24 @@ class SystemCatalog {
                    oid_t db_oid = INVALID_OID, bool new_table = true);
   // 删除表
   void DropTable(const std::string &table_name);
-  // 创建索引
-  void CreateIndex(const std::string &index_name, const std::string &table_name);
+  // 创建索引，目前仅支持单列索引
+  // fill_factor 为批量建立索引时节点的填充率（百分比）
+  void CreateIndex(const std::string &index_name, const std::string &table_name,
+                   const std::vector<std::string> &column_names, uint32_t fill_factor = DEFAULT_INDEX_FILL_FACTOR);
   // 删除索引
   void DropIndex(const std::string &index_name);
+  // 获取索引
+  std::shared_ptr<Index> GetIndex(oid_t oid) const;
+  // 获取表上的所有索引
+  std::vector<std::shared_ptr<Index>> GetTableIndexes(oid_t table_oid) const;
   // 获取当前数据库下所有表名
   std::vector<std::string> GetTableNames() const;
   // 获取表
   std::shared_ptr<Table> GetTable(oid_t oid) const;
   // 获取表oid
   oid_t GetTableOid(const std::string &table_name) const;
+  // 根据表oid获取表名
+  std::string GetTableName(oid_t oid) const;
   // 获取表的schema信息
   const ColumnList &GetTableColumnList(oid_t oid) const;
   const ColumnList &GetTableColumnList(const std::string &table_name) const;
@@ -60,9 +69,19 @@ class SystemCatalog {
   // 获取统计信息
   uint32_t GetCardinality(const std::string &table_name) const;
   uint32_t GetDistinct(const std::string &table_name, const std::string &column_name) const;
+  // 获取列的高频值和直方图，未收集时返回空指针
+  const ColumnStatistic *GetColumnStatistic(const std::string &table_name, const std::string &column_name) const;
   // 设置统计信息
   void SetCardinality(const std::string &table_name, uint32_t cardinality);
   void SetDistinct(const std::string &table_name, const std::string &column_name, uint32_t distinct);
+  void SetColumnStatistic(const std::string &table_name, const std::string &column_name,
+                          const ColumnStatistic &statistic);
+  // 事务提交时按修改的记录数增量更新表的记录数（只更新内存），并累加自上次 ANALYZE 后修改的记录数
+  void AddModifications(const std::string &table_name, const TableModifications &modifications);
+  // 自上次 ANALYZE 后修改的记录数
+  uint32_t GetModifications(const std::string &table_name) const;
+  // 表、索引或统计信息每次变化时递增，用于判断缓存的查询计划是否过期
+  uint64_t GetVersion() const { return version_; }
 
  private:
   // 退出数据库
@@ -73,11 +92,16 @@ class SystemCatalog {
   bool DatabaseExists(const std::string &database_name) const;
   // 根据 oid 删除表
   void DropTable(oid_t oid);
+  // 删除表的统计信息
+  void DropStatistics(const std::string &table_name);
+  // 扫描表中已有的记录，排序后批量建立索引
+  void BuildIndex(Index &index, Type key_type, db_size_t key_size, uint32_t fill_factor);
 
   // 加载系统表
   void LoadDatabaseMeta();
   void LoadTableMeta();
   void LoadStatistics();
+  void LoadIndexMeta();
 
   BufferPool &buffer_pool_;
   LogManager &log_manager_;
@@ -89,8 +113,11 @@ class SystemCatalog {
   std::unordered_map<oid_t, std::shared_ptr<Index>> oid2index_;
   std::unordered_map<std::string, uint32_t> table2cardinality_;
   std::unordered_map<std::string, uint32_t> col2distinct_;
+  std::unordered_map<std::string, ColumnStatistic> col2statistic_;
+  std::unordered_map<std::string, uint32_t> table2modifications_;
 
   oid_t current_database_oid_ = INVALID_OID;
+  uint64_t version_ = 0;
 };
 
 }  // namespace huadb
@@ -13,7 +13,15 @@ ColumnList database_meta_schema({ColumnDefinition("db_oid", Type::UINT),
 ColumnList statistic_schema({ColumnDefinition("table_name", Type::VARCHAR, 32),
                              ColumnDefinition("db_oid", Type::UINT),
                              ColumnDefinition("column_name", Type::VARCHAR, 32),
-                             ColumnDefinition("n_distinct", Type::UINT)});
+                             ColumnDefinition("n_distinct", Type::UINT),
+                             ColumnDefinition("most_common_vals", Type::VARCHAR, 48),
+                             ColumnDefinition("most_common_freqs", Type::VARCHAR, 24),
+                             ColumnDefinition("histogram_bounds", Type::VARCHAR, 48)});
+ColumnList index_meta_schema({ColumnDefinition("index_oid", Type::UINT),
+                              ColumnDefinition("db_oid", Type::UINT),
+                              ColumnDefinition("index_name", Type::VARCHAR, 32),
+                              ColumnDefinition("table_oid", Type::UINT),
+                              ColumnDefinition("column_name", Type::VARCHAR, 32)});
 // clang-format on
 
 }  // namespace huadb
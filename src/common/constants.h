@@ -24,13 +24,55 @@ static constexpr const char *NEXT_LSN_NAME = "next_lsn";
 static constexpr const char *MASTER_RECORD_NAME = "master_record";
 
 static constexpr size_t LOG_SEGMENT_SIZE = (1 << 20);
+// 当前日志段之后预先分配的日志段数，回收的日志段也最多保留这么多
+static constexpr uint64_t LOG_PREALLOCATED_SEGMENTS = 2;
+// 日志缓存大小
+static constexpr size_t LOG_BUFFER_SIZE = LOG_SEGMENT_SIZE;
 static constexpr size_t DB_PAGE_SIZE = (1 << 8);
 static constexpr size_t MAX_RECORD_SIZE = 230;
 // 日志记录最长长度
-static constexpr size_t MAX_LOG_SIZE = sizeof(enum_t) + sizeof(xid_t) + sizeof(lsn_t) + sizeof(oid_t) + sizeof(oid_t) +
-                                       sizeof(pageid_t) + sizeof(slotid_t) + sizeof(db_size_t) + sizeof(db_size_t) +
-                                       MAX_RECORD_SIZE + sizeof(lsn_t);
+static constexpr size_t MAX_LOG_SIZE = sizeof(enum_t) + sizeof(uint32_t) + sizeof(xid_t) + sizeof(lsn_t) +
+                                       sizeof(oid_t) + sizeof(oid_t) + sizeof(pageid_t) + sizeof(slotid_t) +
+                                       sizeof(db_size_t) + sizeof(db_size_t) + MAX_RECORD_SIZE + sizeof(lsn_t);
 static constexpr size_t BUFFER_SIZE = 5;
+// Block Nested Loop Join 外表块大小（字节），预留一个页面给内表、一个页面给输出
+static constexpr size_t JOIN_BLOCK_SIZE = (BUFFER_SIZE - 2) * DB_PAGE_SIZE;
+// 向量化过滤时每批读取的记录数目
+static constexpr size_t FILTER_BATCH_SIZE = 1024;
+// 建立索引时外部排序的内存缓冲区大小（字节）和每趟归并的路数
+static constexpr size_t INDEX_SORT_BUFFER_SIZE = BUFFER_SIZE * DB_PAGE_SIZE;
+static constexpr size_t INDEX_SORT_FAN_IN = BUFFER_SIZE - 1;
+// 代价模型中哈希表和排序可以使用的内存大小（字节），超出时按写出到磁盘估计代价
+static constexpr size_t WORK_MEMORY_SIZE = BUFFER_SIZE * DB_PAGE_SIZE;
+// 批量建立索引时节点的默认填充率（百分比）及允许的范围
+static constexpr uint32_t DEFAULT_INDEX_FILL_FACTOR = 90;
+static constexpr uint32_t MIN_INDEX_FILL_FACTOR = 10;
+static constexpr uint32_t MAX_INDEX_FILL_FACTOR = 100;
+
+// 组提交时日志写线程等待更多事务提交的默认时间及上限（微秒）
+static constexpr uint32_t DEFAULT_COMMIT_DELAY = 0;
+static constexpr uint32_t MAX_COMMIT_DELAY = 100000;
+// 日志写线程定期刷盘的间隔（毫秒），异步提交的事务在一个间隔左右内刷盘
+static constexpr uint32_t DEFAULT_WAL_WRITER_DELAY = 200;
+static constexpr uint32_t MIN_WAL_WRITER_DELAY = 1;
+static constexpr uint32_t MAX_WAL_WRITER_DELAY = 10000;
+// 后台检查点的间隔（秒），为 0 时关闭；默认关闭，以免写回脏页影响磁盘访问计数
+static constexpr uint32_t DEFAULT_CHECKPOINT_TIMEOUT = 0;
+static constexpr uint32_t MAX_CHECKPOINT_TIMEOUT = 86400;
+// 检查点写回脏页的时间占检查点间隔的比例
+static constexpr double DEFAULT_CHECKPOINT_COMPLETION_TARGET = 0.9;
+static constexpr double MIN_CHECKPOINT_COMPLETION_TARGET = 0.01;
+static constexpr double MAX_CHECKPOINT_COMPLETION_TARGET = 1;
+// 故障恢复时并行重做的默认工作线程数
+static constexpr size_t DEFAULT_REDO_WORKERS = 4;
+// 并行重做时同一张表中连续 REDO_PARTITION_PAGES 个页面分给同一个工作线程，新建页面的日志通常只涉及一个工作线程
+static constexpr uint32_t REDO_PARTITION_PAGES = 16;
+// 重做时每次顺序读取 REDO_READ_SEGMENTS 个日志段大小的日志，解析后立即分发，不将全部日志读入内存
+static constexpr size_t REDO_READ_SEGMENTS = 4;
+// 已分发但尚未重做的日志超过该数量时，恢复线程等待工作线程追上
+static constexpr size_t REDO_MAX_PENDING_LOGS = 4096;
+// 即时恢复时每条语句执行前重做的页面组个数
+static constexpr size_t LAZY_REDO_BATCH_GROUPS = 16;
 
 static constexpr lsn_t FIRST_LSN = 0;
 static constexpr lsn_t NULL_LSN = -1;
@@ -54,15 +96,37 @@ static constexpr oid_t TEMP_DATABASE_OID = 2;
 static constexpr oid_t TABLE_META_OID = 501;
 static constexpr oid_t DATABASE_META_OID = 502;
 static constexpr oid_t STATISTIC_META_OID = 503;
+static constexpr oid_t INDEX_META_OID = 504;
 
 static constexpr uint32_t INVALID_CARDINALITY = -1;
 static constexpr uint32_t INVALID_DISTINCT = -1;
+// ANALYZE 为每列保存的高频值个数上限和等深直方图的桶数
+static constexpr size_t STATISTIC_MCV_COUNT = 4;
+static constexpr size_t STATISTIC_HISTOGRAM_BUCKETS = 8;
+// ANALYZE 默认采样的记录数及允许的范围
+static constexpr uint32_t DEFAULT_ANALYZE_SAMPLE_ROWS = 3000;
+static constexpr uint32_t MIN_ANALYZE_SAMPLE_ROWS = 10;
+static constexpr uint32_t MAX_ANALYZE_SAMPLE_ROWS = 1000000;
+// ANALYZE 估计不同值个数的默认相对标准误差，以及 HyperLogLog 精度的范围
+// 误差的范围覆盖 HyperLogLog 精度的范围（精度 16 时误差约 0.004，精度 4 时约 0.26）
+static constexpr double DEFAULT_ANALYZE_DISTINCT_ERROR = 0.02;
+static constexpr double MIN_ANALYZE_DISTINCT_ERROR = 0.001;
+static constexpr double MAX_ANALYZE_DISTINCT_ERROR = 0.5;
+static constexpr uint32_t MIN_HLL_PRECISION = 4;
+static constexpr uint32_t MAX_HLL_PRECISION = 16;
+// 自上次 ANALYZE 后修改的记录数超过 阈值 + 比例 * 表的记录数 时自动重新收集统计信息
+static constexpr uint32_t DEFAULT_AUTOANALYZE_THRESHOLD = 50;
+static constexpr double DEFAULT_AUTOANALYZE_SCALE_FACTOR = 0.1;
+static constexpr double MAX_AUTOANALYZE_SCALE_FACTOR = 100;
+// 查询计划缓存最多保存的计划个数
+static constexpr size_t PLAN_CACHE_SIZE = 256;
 
 static constexpr const char *SYSTEM_DATABASE_NAME = "system";
 
 static constexpr const char *TABLE_META_NAME = "huadb_table";
 static constexpr const char *DATABASE_META_NAME = "huadb_database";
 static constexpr const char *STATISTIC_META_NAME = "huadb_statistic";
+static constexpr const char *INDEX_META_NAME = "huadb_index";
 
 static constexpr const char *DEFAULT_DATABASE_NAME = "huadb";
 
@@ -0,0 +1,58 @@
+#include "common/hyper_log_log.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/constants.h"
+#include "common/exceptions.h"
+
+namespace huadb {
+
+HyperLogLog::HyperLogLog(uint32_t precision) : precision_(precision) {
+  if (precision < MIN_HLL_PRECISION || precision > MAX_HLL_PRECISION) {
+    throw DbException("HyperLogLog precision must be between " + std::to_string(MIN_HLL_PRECISION) + " and " +
+                      std::to_string(MAX_HLL_PRECISION));
+  }
+  registers_.resize(1 << precision, 0);
+}
+
+void HyperLogLog::Add(uint64_t hash) {
+  // splitmix64 的混合函数
+  hash ^= hash >> 30;
+  hash *= 0xbf58476d1ce4e5b9ULL;
+  hash ^= hash >> 27;
+  hash *= 0x94d049bb133111ebULL;
+  hash ^= hash >> 31;
+  auto bucket = hash >> (64 - precision_);
+  // 剩余位左对齐后第一个 1 的位置，剩余位全为 0 时取最大值
+  auto rest = hash << precision_;
+  uint8_t rank = rest == 0 ? 64 - precision_ + 1 : __builtin_clzll(rest) + 1;
+  registers_[bucket] = std::max(registers_[bucket], rank);
+}
+
+double HyperLogLog::Estimate() const {
+  double m = registers_.size();
+  double sum = 0;
+  size_t zeros = 0;
+  for (auto reg : registers_) {
+    sum += std::ldexp(1.0, -reg);
+    if (reg == 0) {
+      zeros++;
+    }
+  }
+  double alpha = 0.7213 / (1 + 1.079 / m);
+  double estimate = alpha * m * m / sum;
+  // 基数较小时大量桶为空，按线性计数估计更准确
+  if (estimate <= 2.5 * m && zeros > 0) {
+    estimate = m * std::log(m / zeros);
+  }
+  return estimate;
+}
+
+uint32_t HyperLogLog::PrecisionForError(double error) {
+  auto buckets = std::pow(1.04 / error, 2);
+  auto precision = static_cast<uint32_t>(std::ceil(std::log2(buckets)));
+  return std::clamp(precision, MIN_HLL_PRECISION, MAX_HLL_PRECISION);
+}
+
+}  // namespace huadb
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace huadb {
+
+// HyperLogLog 基数估计：按哈希值的前 precision 位分桶，每个桶记录剩余位中第一个 1 出现的最大位置
+// 占用 2^precision 字节，估计值的相对标准误差约为 1.04 / sqrt(2^precision)
+class HyperLogLog {
+ public:
+  explicit HyperLogLog(uint32_t precision);
+
+  // 加入一个值的哈希值，哈希值会再经过一次混合，使分布较差的哈希函数也能均匀分桶
+  void Add(uint64_t hash);
+  // 估计加入的不同值个数
+  double Estimate() const;
+
+  // 相对标准误差不超过 error 所需的最小精度
+  static uint32_t PrecisionForError(double error);
+
+ private:
+  uint32_t precision_;
+  std::vector<uint8_t> registers_;
+};
+
+}  // namespace huadb
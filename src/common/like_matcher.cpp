@@ -0,0 +1,164 @@
+#include "common/like_matcher.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace huadb {
+
+LikeMatcher::LikeMatcher(const std::string &pattern) {
+  bool has_any_char = false;
+  size_t pos = 0;
+  while (pos < pattern.size()) {
+    auto code_point = NextCodePoint(pattern, pos);
+    if (code_point == '%') {
+      // 连续的 % 等价于一个 %
+      if (tokens_.empty() || tokens_.back().type_ != TokenType::ANY_STRING) {
+        tokens_.push_back({TokenType::ANY_STRING, 0});
+      }
+    } else if (code_point == '_') {
+      has_any_char = true;
+      tokens_.push_back({TokenType::ANY_CHAR, 0});
+    } else {
+      tokens_.push_back({TokenType::CHAR, code_point});
+    }
+  }
+
+  // % 和 _ 均为 ASCII 字符，不会出现在多字节字符的编码中，因此可以直接按字节拆分模式
+  prefix_ = pattern.substr(0, pattern.find_first_of("%_"));
+  auto first = pattern.find_first_not_of('%');
+  if (has_any_char) {
+    kind_ = Kind::GENERAL;
+  } else if (first == std::string::npos) {
+    kind_ = pattern.empty() ? Kind::EXACT : Kind::ANY;
+  } else {
+    auto last = pattern.find_last_not_of('%');
+    literal_ = pattern.substr(first, last - first + 1);
+    bool leading = first > 0;
+    bool trailing = last + 1 < pattern.size();
+    if (literal_.find('%') != std::string::npos) {
+      kind_ = Kind::GENERAL;
+    } else if (leading && trailing) {
+      kind_ = Kind::CONTAINS;
+    } else if (leading) {
+      kind_ = Kind::SUFFIX;
+    } else if (trailing) {
+      kind_ = Kind::PREFIX;
+    } else {
+      kind_ = Kind::EXACT;
+    }
+  }
+  if (kind_ != Kind::GENERAL) {
+    tokens_.clear();
+  }
+}
+
+bool LikeMatcher::Match(std::string_view str) const {
+  switch (kind_) {
+    case Kind::EXACT:
+      return str == literal_;
+    case Kind::PREFIX:
+      return str.size() >= literal_.size() && str.compare(0, literal_.size(), literal_) == 0;
+    case Kind::SUFFIX:
+      return str.size() >= literal_.size() &&
+             str.compare(str.size() - literal_.size(), literal_.size(), literal_) == 0;
+    case Kind::CONTAINS:
+      return str.find(literal_) != std::string_view::npos;
+    case Kind::ANY:
+      return true;
+    case Kind::GENERAL:
+      return MatchNfa(str);
+  }
+  return false;
+}
+
+LikeMatcher::Kind LikeMatcher::GetKind() const { return kind_; }
+
+const std::string &LikeMatcher::GetLiteral() const { return literal_; }
+
+const std::string &LikeMatcher::GetPrefix() const { return prefix_; }
+
+std::optional<std::string> LikeMatcher::PrefixUpperBound(const std::string &prefix) {
+  // 去掉末尾无法加一的字节，再将最后一个字节加一
+  std::string bound = prefix;
+  while (!bound.empty() && static_cast<unsigned char>(bound.back()) == 0xFF) {
+    bound.pop_back();
+  }
+  if (bound.empty()) {
+    return std::nullopt;
+  }
+  bound.back() = static_cast<char>(static_cast<unsigned char>(bound.back()) + 1);
+  return bound;
+}
+
+bool LikeMatcher::MatchNfa(std::string_view str) const {
+  // 状态 i 表示已经匹配了前 i 个 token，状态 tokens_.size() 为接受状态
+  std::vector<bool> current(tokens_.size() + 1, false);
+  std::vector<bool> next(tokens_.size() + 1, false);
+  AddState(current, 0);
+  size_t pos = 0;
+  while (pos < str.size()) {
+    auto code_point = NextCodePoint(str, pos);
+    std::fill(next.begin(), next.end(), false);
+    bool alive = false;
+    for (size_t state = 0; state < tokens_.size(); state++) {
+      if (!current[state]) {
+        continue;
+      }
+      const auto &token = tokens_[state];
+      if (token.type_ == TokenType::ANY_STRING) {
+        AddState(next, state);
+        alive = true;
+      } else if (token.type_ == TokenType::ANY_CHAR || token.code_point_ == code_point) {
+        AddState(next, state + 1);
+        alive = true;
+      }
+    }
+    if (!alive) {
+      return false;
+    }
+    std::swap(current, next);
+  }
+  return current[tokens_.size()];
+}
+
+void LikeMatcher::AddState(std::vector<bool> &states, size_t state) const {
+  while (!states[state]) {
+    states[state] = true;
+    if (state == tokens_.size() || tokens_[state].type_ != TokenType::ANY_STRING) {
+      break;
+    }
+    state++;
+  }
+}
+
+uint32_t LikeMatcher::NextCodePoint(std::string_view str, size_t &pos) {
+  auto lead = static_cast<unsigned char>(str[pos]);
+  size_t length = 1;
+  uint32_t code_point = lead;
+  if (lead >= 0xF0) {
+    length = 4;
+    code_point = lead & 0x07;
+  } else if (lead >= 0xE0) {
+    length = 3;
+    code_point = lead & 0x0F;
+  } else if (lead >= 0xC0) {
+    length = 2;
+    code_point = lead & 0x1F;
+  }
+  if (length == 1 || pos + length > str.size()) {
+    pos++;
+    return lead;
+  }
+  for (size_t i = 1; i < length; i++) {
+    auto byte = static_cast<unsigned char>(str[pos + i]);
+    if ((byte & 0xC0) != 0x80) {
+      pos++;
+      return lead;
+    }
+    code_point = (code_point << 6) | (byte & 0x3F);
+  }
+  pos += length;
+  return code_point;
+}
+
+}  // namespace huadb
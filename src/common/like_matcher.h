@@ -0,0 +1,50 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace huadb {
+
+// LIKE 模式匹配器：构造时分析模式，匹配时不再解析模式
+// % 匹配任意长度的字符串，_ 匹配一个字符（按 UTF-8 编码的字符计算），其余字符按原样匹配
+// 只含 % 的前缀、后缀、包含模式直接比较字节，其余模式通过 NFA 匹配
+class LikeMatcher {
+ public:
+  enum class Kind { EXACT, PREFIX, SUFFIX, CONTAINS, ANY, GENERAL };
+
+  explicit LikeMatcher(const std::string &pattern);
+
+  bool Match(std::string_view str) const;
+
+  Kind GetKind() const;
+  // EXACT 时为整个模式，PREFIX 时为 % 之前的前缀，SUFFIX 和 CONTAINS 时为不含 % 的部分
+  const std::string &GetLiteral() const;
+  // 第一个通配符之前的部分，匹配的字符串都以此为前缀，可以转换为范围条件
+  const std::string &GetPrefix() const;
+
+  // 以 prefix 为前缀的字符串均小于返回值；不存在这样的上界时返回 std::nullopt
+  static std::optional<std::string> PrefixUpperBound(const std::string &prefix);
+
+ private:
+  // NFA 的状态：匹配一个字符，匹配任意一个字符，或匹配任意长度的字符串
+  enum class TokenType { CHAR, ANY_CHAR, ANY_STRING };
+  struct Token {
+    TokenType type_;
+    uint32_t code_point_;
+  };
+
+  bool MatchNfa(std::string_view str) const;
+  // 将 state 及其通过 ANY_STRING 可以直接到达的状态加入集合
+  void AddState(std::vector<bool> &states, size_t state) const;
+  // 解码 str 中 pos 处的 UTF-8 字符并移动 pos，非法编码按单个字节处理
+  static uint32_t NextCodePoint(std::string_view str, size_t &pos);
+
+  Kind kind_;
+  std::string literal_;
+  std::string prefix_;
+  std::vector<Token> tokens_;
+};
+
+}  // namespace huadb
@@ -32,6 +32,13 @@ struct Slot {
   db_size_t size_;
 };
 
+// 一张表被插入、更新、删除的记录数
+struct TableModifications {
+  uint32_t inserted_ = 0;
+  uint32_t updated_ = 0;
+  uint32_t deleted_ = 0;
+};
+
 }  // namespace huadb
 
 namespace std {
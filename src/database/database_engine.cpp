@@ -1,23 +1,78 @@
 #include "database/database_engine.h"
 
 #include <exception>
+#include <limits>
+#include <type_traits>
 
 #include "binder/binder.h"
 #include "binder/statements/statements.h"
 #include "common/constants.h"
+#include "common/hyper_log_log.h"
 #include "common/exceptions.h"
 #include "common/result_writer.h"
 #include "common/string_util.h"
 #include "database/connection.h"
 #include "executors/executor_context.h"
 #include "executors/executor_factory.h"
+#include "fmt/format.h"
+#include "nodes/parsenodes.hpp"
 #include "operators/expressions/column_value.h"
 #include "postgres_parser.hpp"
 #include "table/record.h"
+#include "table/table_sampler.h"
 
 namespace huadb {
 
-DatabaseEngine::DatabaseEngine() {
+namespace {
+
+// 一次提交多条语句时，取出 stmt 对应的 SQL 文本
+std::string GetStatementSql(const std::string &sql, duckdb_libpgquery::PGNode *stmt) {
+  if (stmt->type != duckdb_libpgquery::T_PGRawStmt) {
+    return sql;
+  }
+  auto *raw_stmt = reinterpret_cast<duckdb_libpgquery::PGRawStmt *>(stmt);
+  if (raw_stmt->stmt_location < 0 || static_cast<size_t>(raw_stmt->stmt_location) >= sql.size()) {
+    return sql;
+  }
+  // stmt_len 为 0 表示语句一直到 SQL 文本末尾
+  if (raw_stmt->stmt_len <= 0) {
+    return sql.substr(raw_stmt->stmt_location);
+  }
+  return sql.substr(raw_stmt->stmt_location, raw_stmt->stmt_len);
+}
+
+// stmt 之后剩余的 SQL 文本
+std::string GetRemainingSql(const std::string &sql, duckdb_libpgquery::PGNode *stmt) {
+  if (stmt->type != duckdb_libpgquery::T_PGRawStmt) {
+    return "";
+  }
+  auto *raw_stmt = reinterpret_cast<duckdb_libpgquery::PGRawStmt *>(stmt);
+  if (raw_stmt->stmt_location < 0 || raw_stmt->stmt_len <= 0) {
+    return "";
+  }
+  auto end = static_cast<size_t>(raw_stmt->stmt_location) + raw_stmt->stmt_len;
+  return end < sql.size() ? sql.substr(end) : "";
+}
+
+// 只缓存 DML 语句的查询计划
+bool IsCacheable(duckdb_libpgquery::PGNode *stmt) {
+  if (stmt->type == duckdb_libpgquery::T_PGRawStmt) {
+    stmt = reinterpret_cast<duckdb_libpgquery::PGRawStmt *>(stmt)->stmt;
+  }
+  switch (stmt->type) {
+    case duckdb_libpgquery::T_PGSelectStmt:
+    case duckdb_libpgquery::T_PGInsertStmt:
+    case duckdb_libpgquery::T_PGUpdateStmt:
+    case duckdb_libpgquery::T_PGDeleteStmt:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+DatabaseEngine::DatabaseEngine(bool instant_recovery) {
   // 数据库是否正常关闭
   bool normal_shutdown = true;
   disk_ = std::make_unique<Disk>();
@@ -43,6 +98,7 @@ DatabaseEngine::DatabaseEngine() {
   }
   buffer_pool_ = std::make_shared<BufferPool>(*disk_, *log_manager_);
   log_manager_->SetBufferPool(buffer_pool_);
+  checkpointer_ = std::make_unique<Checkpointer>(*buffer_pool_, *log_manager_);
 
   catalog_ = std::make_unique<Catalog>(*buffer_pool_, *log_manager_, oid);
   log_manager_->SetCatalog(catalog_);
@@ -57,7 +113,7 @@ DatabaseEngine::DatabaseEngine() {
   current_db_ = DEFAULT_DATABASE_NAME;
 
   if (!normal_shutdown) {
-    Recover();
+    Recover(instant_recovery);
   }
 }
 
@@ -106,26 +162,50 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
   }
 
   // 使用 PostgresParser 解析 SQL
-  duckdb::PostgresParser parser;
-  parser.Parse(sql);
-  if (!parser.success) {
-    throw DbException(parser.error_message);
+  auto parser = std::make_unique<duckdb::PostgresParser>();
+  parser->Parse(sql);
+  if (!parser->success) {
+    throw DbException(parser->error_message);
   }
-  if (parser.parse_tree == nullptr) {
+  if (parser->parse_tree == nullptr) {
     return;
   }
 
   // 将解析得到的语法树转换为语句节点
   std::vector<duckdb_libpgquery::PGNode *> statement_nodes;
-  for (auto *node = parser.parse_tree->head; node != nullptr; node = lnext(node)) {
+  for (auto *node = parser->parse_tree->head; node != nullptr; node = lnext(node)) {
     statement_nodes.push_back(reinterpret_cast<duckdb_libpgquery::PGNode *>(node->data.ptr_value));
   }
 
-  // Binder 负责语义分析，如检查查询涉及的表是否存在，如存在则绑定表的元数据
-  Binder binder(*catalog_);
   for (auto *stmt : statement_nodes) {
-    auto statement = binder.BindStatement(stmt);
-    if (statement->type_ == StatementType::TRANSACTION_STATEMENT) {
+    // 即时恢复时，语句之间逐批重做尚未访问的页面
+    log_manager_->RecoverStep();
+    // 语句之间由检查点进程按进度写回脏页
+    checkpointer_->Step();
+    auto statement_sql = GetStatementSql(sql, stmt);
+    // SELECT、INSERT、UPDATE、DELETE 先按规范化的 SQL 文本查找计划缓存，命中时跳过绑定和计划生成
+    std::string cache_key;
+    std::shared_ptr<Operator> plan = nullptr;
+    if (enable_plan_cache_ && IsCacheable(stmt)) {
+      cache_key = PlanCache::Normalize(statement_sql);
+      plan = plan_cache_.Get(cache_key, catalog_->GetVersion());
+    }
+    std::unique_ptr<Statement> statement = nullptr;
+    if (plan == nullptr) {
+      // Binder 负责语义分析，如检查查询涉及的表是否存在，如存在则绑定表的元数据
+      // 每条语句使用单独的 Binder，避免前一条语句中的表名和别名影响后续语句
+      Binder binder(*catalog_);
+      statement = binder.BindStatement(stmt);
+    }
+    // 预备语句过期时需要重新解析 PREPARE 语句，而解析器的状态是线程内全局的，不能嵌套解析
+    // 因此先释放当前的语法树，执行完本条语句后再重新解析剩余的语句
+    std::optional<std::string> remaining_sql;
+    if (statement != nullptr && statement->type_ == StatementType::EXECUTE_STATEMENT &&
+        IsPreparedStatementStale(connection, dynamic_cast<ExecuteStatement &>(*statement).name_)) {
+      remaining_sql = GetRemainingSql(sql, stmt);
+      parser.reset();
+    }
+    if (statement != nullptr && statement->type_ == StatementType::TRANSACTION_STATEMENT) {
       const auto &transaction_statement = dynamic_cast<TransactionStatement &>(*statement);
       switch (transaction_statement.type_) {
         case TransactionType::BEGIN:
@@ -143,157 +223,22 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
       }
       continue;
     }
-    if (statement->type_ == StatementType::CHECKPOINT_STATEMENT) {
+    if (statement != nullptr && statement->type_ == StatementType::CHECKPOINT_STATEMENT) {
       Checkpoint();
       WriteOneCell("CHECKPOINT", writer);
       continue;
     }
 
-    bool is_modification_sql = false;
     // 如果该语句不在事务块内，则自动开启一个事务
     if (!InTransaction(connection)) {
       Begin(connection);
       auto_transaction_set_.insert(&connection);
     }
     try {
-      switch (statement->type_) {
-        // 对于 DDL 查询，直接调用对应的函数
-        case StatementType::CREATE_DATABASE_STATEMENT: {
-          if (CheckInTransaction(connection)) {
-            throw DbException("Cannot execute DDL statement within a transaction block");
-          }
-          const auto &create_database_statement = dynamic_cast<CreateDatabaseStatement &>(*statement);
-          CreateDatabase(create_database_statement.database_, false, writer);
-          break;
-        }
-        case StatementType::CREATE_TABLE_STATEMENT: {
-          if (CheckInTransaction(connection)) {
-            throw DbException("Cannot execute DDL statement within a transaction block");
-          }
-          const auto &create_table_statement = dynamic_cast<CreateTableStatement &>(*statement);
-          CreateTable(create_table_statement.table_, ColumnList(create_table_statement.columns_), writer);
-          break;
-        }
-        case StatementType::CREATE_INDEX_STATEMENT: {
-          if (CheckInTransaction(connection)) {
-            throw DbException("Cannot execute DDL statement within a transaction block");
-          }
-          const auto &create_index_statement = dynamic_cast<CreateIndexStatement &>(*statement);
-          CreateIndex(create_index_statement.index_name_, create_index_statement.table_name_,
-                      create_index_statement.column_names_, writer);
-          break;
-        }
-        case StatementType::DROP_DATABASE_STATEMENT: {
-          if (CheckInTransaction(connection)) {
-            throw DbException("Cannot execute DDL statement within a transaction block");
-          }
-          const auto &drop_database_statement = dynamic_cast<DropDatabaseStatement &>(*statement);
-          DropDatabase(drop_database_statement.database_, drop_database_statement.missing_ok_, writer);
-          break;
-        }
-        case StatementType::DROP_TABLE_STATEMENT: {
-          if (CheckInTransaction(connection)) {
-            throw DbException("Cannot execute DDL statement within a transaction block");
-          }
-          const auto &drop_table_statement = dynamic_cast<DropTableStatement &>(*statement);
-          DropTable(drop_table_statement.table_, writer);
-          break;
-        }
-        case StatementType::DROP_INDEX_STATEMENT: {
-          if (CheckInTransaction(connection)) {
-            throw DbException("Cannot execute DDL statement within a transaction block");
-          }
-          const auto &drop_index_statement = dynamic_cast<DropIndexStatement &>(*statement);
-          DropIndex(drop_index_statement.index_name_, writer);
-          break;
-        }
-        case StatementType::EXPLAIN_STATEMENT: {
-          const auto &explain_statement = dynamic_cast<ExplainStatement &>(*statement);
-          Explain(explain_statement, writer);
-          break;
-        }
-        case StatementType::LOCK_STATEMENT: {
-          const auto &lock_statement = dynamic_cast<LockStatement &>(*statement);
-          Lock(xids_[&connection], lock_statement, writer);
-          break;
-        }
-        case StatementType::VARIABLE_SET_STATEMENT: {
-          const auto &variable_set_statement = dynamic_cast<VariableSetStatement &>(*statement);
-          VariableSet(connection, variable_set_statement, writer);
-          break;
-        }
-        case StatementType::VARIABLE_SHOW_STATEMENT: {
-          const auto &variable_show_statement = dynamic_cast<VariableShowStatement &>(*statement);
-          VariableShow(connection, variable_show_statement, writer);
-          break;
-        }
-        case StatementType::ANALYZE_STATEMENT: {
-          const auto &analyze_statement = dynamic_cast<AnalyzeStatement &>(*statement);
-          Analyze(analyze_statement, writer);
-          break;
-        }
-        case StatementType::VACUUM_STATEMENT: {
-          const auto &vacuum_statement = dynamic_cast<VacuumStatement &>(*statement);
-          Vacuum(vacuum_statement, writer);
-          break;
-        }
-        case StatementType::UPDATE_STATEMENT:
-        case StatementType::DELETE_STATEMENT:
-          is_modification_sql = true;
-        // 对于 DML 查询，需要生成查询计划并执行
-        default: {
-          try {
-            // 生成查询计划
-            Planner planner(force_join_);
-            auto plan = planner.PlanQuery(*statement);
-
-            if (enable_optimizer_) {
-              // 查询计划优化
-              Optimizer optimizer(*catalog_, join_order_algorithm_, enable_projection_pushdown_);
-              plan = optimizer.Optimize(plan);
-            }
-
-            // 得到优化后的查询计划后，打印表头
-            auto column_list = plan->OutputColumns();
-            writer.BeginTable();
-            writer.BeginHeader();
-            for (size_t i = 0; i < column_list.Length(); i++) {
-              writer.WriteHeaderCell(column_list.GetColumn(i).name_);
-            }
-            writer.EndHeader();
-
-            // 生成查询上下文信息，如查询属于哪个事务，隔离级别等
-            IsolationLevel isolation_level = DEFAULT_ISOLATION_LEVEL;
-            if (isolation_levels_.find(&connection) != isolation_levels_.end()) {
-              isolation_level = isolation_levels_[&connection];
-            }
-            auto executor_context = std::make_unique<ExecutorContext>(
-                *buffer_pool_, *catalog_, *transaction_manager_, *lock_manager_, xids_[&connection], isolation_level,
-                transaction_manager_->GetCidAndIncrement(xids_[&connection]), is_modification_sql);
-
-            // 根据查询上下文和查询计划，生成执行器
-            auto executor = ExecutorFactory::CreateExecutor(*executor_context, plan);
-            executor->Init();
-            size_t record_count = 0;
-            while (auto record = executor->Next()) {
-              writer.BeginRow();
-              for (const auto &value : record->GetValues()) {
-                writer.WriteCell(value.ToString());
-              }
-              writer.EndRow();
-              record_count++;
-            }
-            writer.EndTable();
-            writer.WriteRowCount(record_count);
-          } catch (DbException &e) {
-            if (auto_transaction_set_.find(&connection) != auto_transaction_set_.end()) {
-              Rollback(connection);
-              auto_transaction_set_.erase(&connection);
-            }
-            throw e;
-          }
-          break;
-        }
+      if (plan != nullptr) {
+        ExecutePlan(connection, plan, writer);
+      } else {
+        ExecuteBoundStatement(connection, *statement, statement_sql, cache_key, writer);
       }
     } catch (DbException &e) {
       if (auto_transaction_set_.find(&connection) != auto_transaction_set_.end()) {
@@ -304,10 +249,171 @@ void DatabaseEngine::ExecuteSql(const std::string &sql, ResultWriter &writer, co
     }
     // 如果事务是自动开启的，查询结束后需要自动提交
     if (auto_transaction_set_.find(&connection) != auto_transaction_set_.end()) {
-      Commit(connection);
       auto_transaction_set_.erase(&connection);
+      Commit(connection);
+    }
+    if (remaining_sql.has_value()) {
+      if (!remaining_sql->empty()) {
+        ExecuteSql(*remaining_sql, writer, connection);
+      }
+      return;
+    }
+  }
+}
+
+void DatabaseEngine::ExecuteBoundStatement(const Connection &connection, Statement &statement,
+                                           const std::string &sql, const std::string &cache_key, ResultWriter &writer) {
+  switch (statement.type_) {
+    // 对于 DDL 查询，直接调用对应的函数
+    case StatementType::CREATE_DATABASE_STATEMENT: {
+      if (CheckInTransaction(connection)) {
+        throw DbException("Cannot execute DDL statement within a transaction block");
+      }
+      const auto &create_database_statement = dynamic_cast<CreateDatabaseStatement &>(statement);
+      CreateDatabase(create_database_statement.database_, false, writer);
+      break;
+    }
+    case StatementType::CREATE_TABLE_STATEMENT: {
+      if (CheckInTransaction(connection)) {
+        throw DbException("Cannot execute DDL statement within a transaction block");
+      }
+      const auto &create_table_statement = dynamic_cast<CreateTableStatement &>(statement);
+      CreateTable(create_table_statement.table_, ColumnList(create_table_statement.columns_), writer);
+      break;
+    }
+    case StatementType::CREATE_INDEX_STATEMENT: {
+      if (CheckInTransaction(connection)) {
+        throw DbException("Cannot execute DDL statement within a transaction block");
+      }
+      const auto &create_index_statement = dynamic_cast<CreateIndexStatement &>(statement);
+      CreateIndex(create_index_statement.index_name_, create_index_statement.table_name_,
+                  create_index_statement.column_names_, writer);
+      break;
+    }
+    case StatementType::DROP_DATABASE_STATEMENT: {
+      if (CheckInTransaction(connection)) {
+        throw DbException("Cannot execute DDL statement within a transaction block");
+      }
+      const auto &drop_database_statement = dynamic_cast<DropDatabaseStatement &>(statement);
+      DropDatabase(drop_database_statement.database_, drop_database_statement.missing_ok_, writer);
+      break;
+    }
+    case StatementType::DROP_TABLE_STATEMENT: {
+      if (CheckInTransaction(connection)) {
+        throw DbException("Cannot execute DDL statement within a transaction block");
+      }
+      const auto &drop_table_statement = dynamic_cast<DropTableStatement &>(statement);
+      DropTable(drop_table_statement.table_, writer);
+      break;
+    }
+    case StatementType::DROP_INDEX_STATEMENT: {
+      if (CheckInTransaction(connection)) {
+        throw DbException("Cannot execute DDL statement within a transaction block");
+      }
+      const auto &drop_index_statement = dynamic_cast<DropIndexStatement &>(statement);
+      DropIndex(drop_index_statement.index_name_, writer);
+      break;
+    }
+    case StatementType::EXPLAIN_STATEMENT: {
+      const auto &explain_statement = dynamic_cast<ExplainStatement &>(statement);
+      Explain(connection, explain_statement, writer);
+      break;
+    }
+    case StatementType::LOCK_STATEMENT: {
+      const auto &lock_statement = dynamic_cast<LockStatement &>(statement);
+      Lock(xids_[&connection], lock_statement, writer);
+      break;
+    }
+    case StatementType::VARIABLE_SET_STATEMENT: {
+      const auto &variable_set_statement = dynamic_cast<VariableSetStatement &>(statement);
+      VariableSet(connection, variable_set_statement, writer);
+      break;
+    }
+    case StatementType::VARIABLE_SHOW_STATEMENT: {
+      const auto &variable_show_statement = dynamic_cast<VariableShowStatement &>(statement);
+      VariableShow(connection, variable_show_statement, writer);
+      break;
+    }
+    case StatementType::ANALYZE_STATEMENT: {
+      const auto &analyze_statement = dynamic_cast<AnalyzeStatement &>(statement);
+      Analyze(analyze_statement, writer);
+      break;
+    }
+    case StatementType::VACUUM_STATEMENT: {
+      const auto &vacuum_statement = dynamic_cast<VacuumStatement &>(statement);
+      Vacuum(vacuum_statement, writer);
+      break;
+    }
+    case StatementType::PREPARE_STATEMENT: {
+      auto &prepare_statement = dynamic_cast<PrepareStatement &>(statement);
+      Prepare(connection, prepare_statement, sql, writer);
+      break;
+    }
+    case StatementType::EXECUTE_STATEMENT: {
+      const auto &execute_statement = dynamic_cast<ExecuteStatement &>(statement);
+      Execute(connection, execute_statement, writer);
+      break;
+    }
+    case StatementType::DEALLOCATE_STATEMENT: {
+      const auto &deallocate_statement = dynamic_cast<DeallocateStatement &>(statement);
+      Deallocate(connection, deallocate_statement, writer);
+      break;
+    }
+    // 对于 DML 查询，需要生成查询计划并执行
+    default: {
+      auto plan = PlanStatement(statement, {});
+      if (!cache_key.empty()) {
+        plan_cache_.Put(cache_key, plan, catalog_->GetVersion());
+      }
+      ExecutePlan(connection, plan, writer);
+      break;
+    }
+  }
+}
+
+std::shared_ptr<Operator> DatabaseEngine::PlanStatement(const Statement &statement, std::vector<Value> parameters) {
+  // 生成查询计划
+  Planner planner(force_join_, std::move(parameters));
+  auto plan = planner.PlanQuery(statement);
+
+  if (enable_optimizer_) {
+    // 查询计划优化
+    Optimizer optimizer(*catalog_, join_order_algorithm_, enable_projection_pushdown_, enable_hash_join_,
+                        enable_merge_join_);
+    plan = optimizer.Optimize(plan);
+  }
+  return plan;
+}
+
+void DatabaseEngine::ExecutePlan(const Connection &connection, std::shared_ptr<Operator> plan,
+                                 ResultWriter &writer) {
+  // 得到优化后的查询计划后，打印表头
+  auto column_list = plan->OutputColumns();
+  writer.BeginTable();
+  writer.BeginHeader();
+  for (size_t i = 0; i < column_list.Length(); i++) {
+    writer.WriteHeaderCell(column_list.GetColumn(i).name_);
+  }
+  writer.EndHeader();
+
+  // 生成查询上下文信息，如查询属于哪个事务，隔离级别等
+  bool is_modification_sql = plan->GetType() == OperatorType::UPDATE || plan->GetType() == OperatorType::DELETE;
+  auto executor_context = CreateExecutorContext(connection, is_modification_sql);
+
+  // 根据查询上下文和查询计划，生成执行器
+  auto executor = ExecutorFactory::CreateExecutor(*executor_context, plan);
+  executor->Init();
+  size_t record_count = 0;
+  while (auto record = executor->Next()) {
+    writer.BeginRow();
+    for (const auto &value : record->GetValues()) {
+      writer.WriteCell(value.ToString());
     }
+    writer.EndRow();
+    record_count++;
   }
+  writer.EndTable();
+  writer.WriteRowCount(record_count);
 }
 
 void DatabaseEngine::Crash() {
@@ -372,6 +478,8 @@ void DatabaseEngine::DropDatabase(const std::string &db_name, bool missing_ok, R
 }
 
 void DatabaseEngine::CloseDatabase() {
+  // 正常关闭后不再恢复，需先完成即时恢复
+  log_manager_->FinishRecovery();
   buffer_pool_->Flush();
   log_manager_->Flush();
   log_manager_->Checkpoint();
@@ -430,12 +538,12 @@ void DatabaseEngine::DropTable(const std::string &table_name, ResultWriter &writ
 
 void DatabaseEngine::CreateIndex(const std::string &index_name, const std::string &table_name,
                                  const std::vector<std::string> &column_names, ResultWriter &writer) {
-  // Not implemented yet
+  catalog_->CreateIndex(index_name, table_name, column_names, index_fill_factor_);
   WriteOneCell("CREATE INDEX", writer);
 }
 
 void DatabaseEngine::DropIndex(const std::string &index_name, ResultWriter &writer) {
-  // Not implemented yet
+  catalog_->DropIndex(index_name);
   WriteOneCell("DROP INDEX", writer);
 }
 
@@ -443,9 +551,8 @@ void DatabaseEngine::Begin(const Connection &connection) {
   if (InTransaction(connection)) {
     throw DbException("There is already a transaction in progress");
   } else {
-    auto xid = transaction_manager_->Begin();
-    xids_[&connection] = xid;
-    log_manager_->AppendBeginLog(xid);
+    // 开启事务时只分配 xid 和快照，事务第一次修改数据时才写 Begin 日志
+    xids_[&connection] = transaction_manager_->Begin();
   }
 }
 
@@ -453,9 +560,14 @@ void DatabaseEngine::Commit(const Connection &connection) {
   if (!InTransaction(connection)) {
     throw DbException("There is no transaction in process");
   } else {
-    log_manager_->AppendCommitLog(xids_[&connection]);
-    transaction_manager_->Commit(xids_[&connection]);
+    auto xid = xids_[&connection];
+    auto modifications = transaction_manager_->GetModifications(xid);
+    auto iter = synchronous_commits_.find(&connection);
+    log_manager_->AppendCommitLog(xid, iter == synchronous_commits_.end() || iter->second);
+    transaction_manager_->Commit(xid);
     xids_.erase(&connection);
+    // 事务已经提交，统计信息的维护在事务状态清理完成后进行，其失败不影响提交
+    UpdateStatistics(modifications);
   }
 }
 
@@ -470,9 +582,36 @@ void DatabaseEngine::Rollback(const Connection &connection) {
   }
 }
 
+void DatabaseEngine::UpdateStatistics(const std::unordered_map<oid_t, TableModifications> &modifications) {
+  if (modifications.empty()) {
+    return;
+  }
+  for (const auto &[oid, table_modifications] : modifications) {
+    // 事务中删除的表无需维护统计信息
+    if (!catalog_->TableExists(oid)) {
+      continue;
+    }
+    try {
+      auto table_name = catalog_->GetTableName(oid);
+      catalog_->AddModifications(table_name, table_modifications);
+      if (!enable_autoanalyze_) {
+        continue;
+      }
+      // 修改的记录数超过 autoanalyze_threshold_ + autoanalyze_scale_factor_ * 表的记录数 时重新采样
+      auto cardinality = catalog_->GetCardinality(table_name);
+      double rows = cardinality == INVALID_CARDINALITY ? 0 : cardinality;
+      if (catalog_->GetModifications(table_name) > autoanalyze_threshold_ + autoanalyze_scale_factor_ * rows) {
+        AnalyzeTable(table_name, {});
+      }
+    } catch (const DbException &) {
+      // 自动 ANALYZE 失败时保留修改计数，之后的提交会再次尝试
+    }
+  }
+}
+
 void DatabaseEngine::Checkpoint() { log_manager_->Checkpoint(); }
 
-void DatabaseEngine::Recover() { log_manager_->Recover(); }
+void DatabaseEngine::Recover(bool instant) { log_manager_->Recover(instant); }
 
 void DatabaseEngine::Lock(xid_t xid, const LockStatement &stmt, ResultWriter &writer) {
   LockType lock_type;
@@ -488,7 +627,23 @@ void DatabaseEngine::Lock(xid_t xid, const LockStatement &stmt, ResultWriter &wr
   }
 }
 
-void DatabaseEngine::Explain(const ExplainStatement &stmt, ResultWriter &writer) {
+namespace {
+
+// 在节点描述之后附加估计的代价和记录数，以及实际输出的记录数
+void AnnotatePlan(Operator &plan, const std::unordered_map<const Operator *, size_t> *row_counts) {
+  plan.annotation_ = fmt::format(" (cost={:.2f} rows={:.0f})", plan.estimated_cost_, plan.estimated_rows_);
+  if (row_counts != nullptr) {
+    auto iter = row_counts->find(&plan);
+    plan.annotation_ += fmt::format(" (actual rows={})", iter == row_counts->end() ? 0 : iter->second);
+  }
+  for (const auto &child : plan.children_) {
+    AnnotatePlan(*child, row_counts);
+  }
+}
+
+}  // namespace
+
+void DatabaseEngine::Explain(const Connection &connection, const ExplainStatement &stmt, ResultWriter &writer) {
   std::string output;
   if ((stmt.options_ & ExplainOptions::BINDER) != 0) {
     output += "===Binder===\n";
@@ -504,10 +659,30 @@ void DatabaseEngine::Explain(const ExplainStatement &stmt, ResultWriter &writer)
   }
 
   if (enable_optimizer_) {
-    Optimizer optimizer(*catalog_, join_order_algorithm_, enable_projection_pushdown_);
+    Optimizer optimizer(*catalog_, join_order_algorithm_, enable_projection_pushdown_, enable_hash_join_,
+                        enable_merge_join_);
     plan = optimizer.Optimize(plan);
   }
 
+  if ((stmt.options_ & (ExplainOptions::COSTS | ExplainOptions::ANALYZE)) != 0) {
+    CostModel(*catalog_).Estimate(plan);
+    if ((stmt.options_ & ExplainOptions::ANALYZE) != 0) {
+      // 执行查询计划并丢弃结果，只统计各算子输出的记录数
+      bool is_modification_sql = stmt.statement_->type_ == StatementType::UPDATE_STATEMENT ||
+                                 stmt.statement_->type_ == StatementType::DELETE_STATEMENT;
+      std::unordered_map<const Operator *, size_t> row_counts;
+      auto executor_context = CreateExecutorContext(connection, is_modification_sql);
+      executor_context->SetRowCounts(&row_counts);
+      auto executor = ExecutorFactory::CreateExecutor(*executor_context, plan);
+      executor->Init();
+      while (executor->Next() != nullptr) {
+      }
+      AnnotatePlan(*plan, &row_counts);
+    } else {
+      AnnotatePlan(*plan, nullptr);
+    }
+  }
+
   if ((stmt.options_ & ExplainOptions::OPTIMIZER) != 0) {
     output += "===Optimizer===\n";
     output += plan->ToString();
@@ -519,6 +694,8 @@ void DatabaseEngine::Explain(const ExplainStatement &stmt, ResultWriter &writer)
 void DatabaseEngine::VariableSet(const Connection &connection, const VariableSetStatement &stmt, ResultWriter &writer) {
   if (stmt.variable_ == "isolation_level") {
     isolation_levels_[&connection] = String2IsolationLevel(stmt.value_);
+  } else if (stmt.variable_ == "synchronous_commit") {
+    synchronous_commits_[&connection] = String2Bool(stmt.value_);
   } else if (stmt.variable_ == "join_order_algorithm") {
     join_order_algorithm_ = String2JoinOrderAlgorithm(stmt.value_);
   } else if (stmt.variable_ == "force_join") {
@@ -527,9 +704,43 @@ void DatabaseEngine::VariableSet(const Connection &connection, const VariableSet
     enable_optimizer_ = String2Bool(stmt.value_);
   } else if (stmt.variable_ == "enable_projection_pushdown") {
     enable_projection_pushdown_ = String2Bool(stmt.value_);
+  } else if (stmt.variable_ == "enable_hash_join") {
+    enable_hash_join_ = String2Bool(stmt.value_);
+  } else if (stmt.variable_ == "enable_merge_join") {
+    enable_merge_join_ = String2Bool(stmt.value_);
+  } else if (stmt.variable_ == "index_fill_factor") {
+    index_fill_factor_ = ParseNumericSetting(stmt.value_, stmt.variable_, MIN_INDEX_FILL_FACTOR, MAX_INDEX_FILL_FACTOR);
+  } else if (stmt.variable_ == "analyze_sample_rows") {
+    analyze_sample_rows_ =
+        ParseNumericSetting(stmt.value_, stmt.variable_, MIN_ANALYZE_SAMPLE_ROWS, MAX_ANALYZE_SAMPLE_ROWS);
+  } else if (stmt.variable_ == "analyze_distinct_error") {
+    analyze_distinct_error_ =
+        ParseNumericSetting(stmt.value_, stmt.variable_, MIN_ANALYZE_DISTINCT_ERROR, MAX_ANALYZE_DISTINCT_ERROR);
+  } else if (stmt.variable_ == "autoanalyze") {
+    enable_autoanalyze_ = String2Bool(stmt.value_);
+  } else if (stmt.variable_ == "autoanalyze_threshold") {
+    autoanalyze_threshold_ =
+        ParseNumericSetting(stmt.value_, stmt.variable_, uint32_t{0}, std::numeric_limits<uint32_t>::max());
+  } else if (stmt.variable_ == "autoanalyze_scale_factor") {
+    autoanalyze_scale_factor_ = ParseNumericSetting(stmt.value_, stmt.variable_, 0.0, MAX_AUTOANALYZE_SCALE_FACTOR);
+  } else if (stmt.variable_ == "enable_plan_cache") {
+    enable_plan_cache_ = String2Bool(stmt.value_);
+  } else if (stmt.variable_ == "commit_delay") {
+    log_manager_->SetCommitDelay(ParseNumericSetting(stmt.value_, stmt.variable_, uint32_t{0}, MAX_COMMIT_DELAY));
+  } else if (stmt.variable_ == "wal_writer_delay") {
+    log_manager_->SetWalWriterDelay(
+        ParseNumericSetting(stmt.value_, stmt.variable_, MIN_WAL_WRITER_DELAY, MAX_WAL_WRITER_DELAY));
+  } else if (stmt.variable_ == "checkpoint_timeout") {
+    checkpointer_->SetTimeout(ParseNumericSetting(stmt.value_, stmt.variable_, uint32_t{0}, MAX_CHECKPOINT_TIMEOUT));
+  } else if (stmt.variable_ == "checkpoint_completion_target") {
+    checkpointer_->SetCompletionTarget(ParseNumericSetting(stmt.value_, stmt.variable_,
+                                                           MIN_CHECKPOINT_COMPLETION_TARGET,
+                                                           MAX_CHECKPOINT_COMPLETION_TARGET));
   } else if (stmt.variable_ == "deadlock") {
     lock_manager_->SetDeadLockType(String2DeadlockType(stmt.value_));
   }
+  // 变量可能影响计划的生成，如连接顺序算法和可选的连接算法，缓存的计划全部作废
+  plan_cache_.Clear();
   client_variables_[&connection][stmt.variable_] = stmt.value_;
   WriteOneCell("SET", writer);
 }
@@ -547,6 +758,18 @@ void DatabaseEngine::VariableShow(const Connection &connection, const VariableSh
     result = std::to_string(disk_->GetAccessCount());
   } else if (stmt.variable_ == "redo_count") {
     result = std::to_string(log_manager_->GetRedoCount());
+  } else if (stmt.variable_ == "log_flush_count") {
+    result = std::to_string(log_manager_->GetFlushCount());
+  } else if (stmt.variable_ == "log_segment_count") {
+    result = std::to_string(log_manager_->GetLogSegmentCount());
+  } else if (stmt.variable_ == "pending_redo_pages") {
+    result = std::to_string(log_manager_->GetPendingRedoPageCount());
+  } else if (stmt.variable_ == "checkpoint_count") {
+    result = std::to_string(checkpointer_->GetCheckpointCount());
+  } else if (stmt.variable_ == "plan_cache_hits") {
+    result = std::to_string(plan_cache_.GetHitCount());
+  } else if (stmt.variable_ == "plan_cache_misses") {
+    result = std::to_string(plan_cache_.GetMissCount());
   } else {
     if (client_variables_.find(&connection) == client_variables_.end() ||
         client_variables_.at(&connection).find(stmt.variable_) == client_variables_.at(&connection).end()) {
@@ -585,34 +808,65 @@ void DatabaseEngine::Analyze(const AnalyzeStatement &stmt, ResultWriter &writer)
     }
   }
   for (const auto &table_name : table_names) {
-    auto oid = catalog_->GetTableOid(table_name);
-    auto table = catalog_->GetTable(oid);
-    if (stmt.columns_.empty()) {
-      auto column_list = catalog_->GetTableColumnList(table_name);
-      columns.clear();
-      for (size_t i = 0; i < column_list.Length(); i++) {
-        auto col_type = column_list.GetColumn(i).type_;
-        auto col_name = column_list.GetColumn(i).name_;
-        auto col_size = column_list.GetColumn(i).GetMaxSize();
-        columns.emplace_back(i, col_type, col_name, col_size, true);
+    AnalyzeTable(table_name, columns);
+  }
+  WriteOneCell("Analyze", writer);
+}
+
+void DatabaseEngine::AnalyzeTable(const std::string &table_name, std::vector<ColumnValue> columns) {
+  auto oid = catalog_->GetTableOid(table_name);
+  auto table = catalog_->GetTable(oid);
+  if (columns.empty()) {
+    auto column_list = catalog_->GetTableColumnList(table_name);
+    for (size_t i = 0; i < column_list.Length(); i++) {
+      auto col_type = column_list.GetColumn(i).type_;
+      auto col_name = column_list.GetColumn(i).name_;
+      auto col_size = column_list.GetColumn(i).GetMaxSize();
+      columns.emplace_back(i, col_type, col_name, col_size, true);
+    }
+  }
+  // 采样的页面和记录数不超过 analyze_sample_rows_；读到的每条记录加入各列的 HyperLogLog，内存与表的大小无关
+  TableSampler sampler(*buffer_pool_, table, analyze_sample_rows_, oid);
+  auto precision = HyperLogLog::PrecisionForError(analyze_distinct_error_);
+  std::vector<HyperLogLog> sketches(columns.size(), HyperLogLog(precision));
+  std::vector<bool> has_null(columns.size(), false);
+  sampler.Run([&](const Record &record) {
+    for (size_t i = 0; i < columns.size(); i++) {
+      auto value = record.GetValue(columns[i].GetColumnIndex());
+      if (value.IsNull()) {
+        has_null[i] = true;
+      } else {
+        sketches[i].Add(std::hash<Value>()(value));
       }
     }
-    auto scan = std::make_unique<TableScan>(*buffer_pool_, table, Rid{table->GetFirstPageId(), 0});
-    uint32_t record_count = 0;
-    std::vector<std::unordered_set<Value>> value_set;
-    value_set.resize(columns.size());
-    while (auto record = scan->GetNextRecord()) {
-      for (size_t i = 0; i < columns.size(); i++) {
-        value_set[i].insert(record->GetValue(columns[i].GetColumnIndex()));
+  });
+  const auto &sample = sampler.GetSample();
+  auto total_rows = std::round(sampler.EstimateRows());
+  catalog_->SetCardinality(table_name, total_rows);
+  for (size_t i = 0; i < columns.size(); i++) {
+    // 统计样本中每列各个非空值的出现次数，用于计算高频值和直方图
+    std::unordered_map<Value, uint32_t> frequencies;
+    for (const auto &record : sample) {
+      auto value = record->GetValue(columns[i].GetColumnIndex());
+      if (!value.IsNull()) {
+        frequencies[std::move(value)]++;
       }
-      record_count++;
     }
-    catalog_->SetCardinality(table_name, record_count);
-    for (size_t i = 0; i < columns.size(); i++) {
-      catalog_->SetDistinct(table_name, columns[i].name_, value_set[i].size());
+    // 样本包含读到的全部记录时直接计数；读取了全部页面时使用 HyperLogLog 的估计；
+    // 否则由样本外推，且不少于读到的记录中的不同值个数
+    double distinct;
+    if (sample.size() == sampler.GetRowsRead() && sampler.IsFullScan()) {
+      distinct = frequencies.size();
+    } else if (sampler.IsFullScan()) {
+      distinct = std::round(sketches[i].Estimate());
+    } else {
+      distinct = std::max(ColumnStatistic::EstimateDistinct(frequencies, sample.size(), total_rows),
+                          std::round(sketches[i].Estimate()));
     }
+    distinct = std::min(distinct, total_rows) + (has_null[i] ? 1 : 0);
+    catalog_->SetColumnStatistic(table_name, columns[i].name_,
+                                 ColumnStatistic::Build(frequencies, sample.size(), distinct));
   }
-  WriteOneCell("Analyze", writer);
 }
 
 void DatabaseEngine::Vacuum(const VacuumStatement &stmt, ResultWriter &writer) {
@@ -620,6 +874,80 @@ void DatabaseEngine::Vacuum(const VacuumStatement &stmt, ResultWriter &writer) {
   WriteOneCell("Vacuum", writer);
 }
 
+void DatabaseEngine::Prepare(const Connection &connection, PrepareStatement &stmt, const std::string &sql,
+                             ResultWriter &writer) {
+  auto &prepared_statements = prepared_statements_[&connection];
+  if (prepared_statements.find(stmt.name_) != prepared_statements.end()) {
+    throw DbException("Prepared statement \"" + stmt.name_ + "\" already exists");
+  }
+  prepared_statements[stmt.name_] = {sql, std::move(stmt.statement_), stmt.parameter_count_, catalog_->GetVersion()};
+  WriteOneCell("PREPARE", writer);
+}
+
+bool DatabaseEngine::IsPreparedStatementStale(const Connection &connection, const std::string &name) const {
+  auto iter = prepared_statements_.find(&connection);
+  if (iter == prepared_statements_.end() || iter->second.find(name) == iter->second.end()) {
+    return false;
+  }
+  return iter->second.at(name).version_ != catalog_->GetVersion();
+}
+
+void DatabaseEngine::Execute(const Connection &connection, const ExecuteStatement &stmt, ResultWriter &writer) {
+  auto &prepared_statements = prepared_statements_[&connection];
+  auto iter = prepared_statements.find(stmt.name_);
+  if (iter == prepared_statements.end()) {
+    throw DbException("Prepared statement \"" + stmt.name_ + "\" does not exist");
+  }
+  auto &prepared = iter->second;
+  if (prepared.version_ != catalog_->GetVersion()) {
+    // 表、索引或统计信息变化后，用保存的 SQL 文本重新绑定，保证语句引用的表和列仍然有效
+    // ExecuteSql 在此之前已经释放了当前的语法树
+    duckdb::PostgresParser parser;
+    parser.Parse(prepared.sql_);
+    if (!parser.success || parser.parse_tree == nullptr) {
+      throw DbException("Failed to parse prepared statement \"" + stmt.name_ + "\"");
+    }
+    Binder binder(*catalog_);
+    auto statement =
+        binder.BindStatement(reinterpret_cast<duckdb_libpgquery::PGNode *>(parser.parse_tree->head->data.ptr_value));
+    auto &prepare_statement = dynamic_cast<PrepareStatement &>(*statement);
+    prepared.statement_ = std::move(prepare_statement.statement_);
+    prepared.parameter_count_ = prepare_statement.parameter_count_;
+    prepared.version_ = catalog_->GetVersion();
+  }
+  if (stmt.parameters_.size() != prepared.parameter_count_) {
+    throw DbException(fmt::format("Wrong number of parameters for prepared statement \"{}\": expected {}, got {}",
+                                  stmt.name_, prepared.parameter_count_, stmt.parameters_.size()));
+  }
+  // 每次执行都按参数的实际值生成计划，常量对索引选择和选择率估计仍然可见，只跳过解析和绑定
+  ExecutePlan(connection, PlanStatement(*prepared.statement_, stmt.parameters_), writer);
+}
+
+void DatabaseEngine::Deallocate(const Connection &connection, const DeallocateStatement &stmt, ResultWriter &writer) {
+  auto &prepared_statements = prepared_statements_[&connection];
+  if (!stmt.name_.has_value()) {
+    prepared_statements.clear();
+    WriteOneCell("DEALLOCATE ALL", writer);
+    return;
+  }
+  if (prepared_statements.erase(*stmt.name_) == 0) {
+    throw DbException("Prepared statement \"" + *stmt.name_ + "\" does not exist");
+  }
+  WriteOneCell("DEALLOCATE", writer);
+}
+
+std::unique_ptr<ExecutorContext> DatabaseEngine::CreateExecutorContext(const Connection &connection,
+                                                                       bool is_modification_sql) {
+  IsolationLevel isolation_level = DEFAULT_ISOLATION_LEVEL;
+  if (isolation_levels_.find(&connection) != isolation_levels_.end()) {
+    isolation_level = isolation_levels_[&connection];
+  }
+  return std::make_unique<ExecutorContext>(*buffer_pool_, *catalog_, *transaction_manager_, *lock_manager_,
+                                           xids_[&connection], isolation_level,
+                                           transaction_manager_->GetCidAndIncrement(xids_[&connection]),
+                                           is_modification_sql);
+}
+
 void DatabaseEngine::WriteOneCell(const std::string &str, ResultWriter &writer) const {
   writer.BeginTable(true);
   writer.BeginRow();
@@ -685,4 +1013,29 @@ bool DatabaseEngine::String2Bool(const std::string &str) {
   throw DbException("Unknown boolean value " + str);
 }
 
+template <typename T>
+T DatabaseEngine::ParseNumericSetting(const std::string &str, const std::string &name, T min, T max) {
+  // 整数统一按有符号 64 位解析，负数不会像 stoul 那样被转换为很大的正数
+  using Parsed = std::conditional_t<std::is_floating_point_v<T>, double, int64_t>;
+  Parsed value;
+  size_t pos = 0;
+  try {
+    if constexpr (std::is_floating_point_v<T>) {
+      value = std::stod(str, &pos);
+    } else {
+      value = std::stoll(str, &pos);
+    }
+  } catch (const std::logic_error &) {
+    throw DbException("Unknown " + name + " " + str);
+  }
+  if (pos != str.size()) {
+    throw DbException("Unknown " + name + " " + str);
+  }
+  // NaN 与任何值比较都为 false，同样会被拒绝
+  if (!(value >= static_cast<Parsed>(min) && value <= static_cast<Parsed>(max))) {
+    throw DbException(fmt::format("{} must be between {} and {}", name, min, max));
+  }
+  return static_cast<T>(value);
+}
+
 }  // namespace huadb
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -8,8 +9,11 @@
 #include "catalog/catalog.h"
 #include "catalog/column_definition.h"
 #include "common/types.h"
+#include "log/checkpointer.h"
 #include "log/log_manager.h"
+#include "operators/expressions/column_value.h"
 #include "optimizer/optimizer.h"
+#include "planner/plan_cache.h"
 #include "planner/planner.h"
 #include "storage/buffer_pool.h"
 #include "storage/disk.h"
@@ -19,6 +23,7 @@
 namespace huadb {
 
 class Connection;
+class ExecutorContext;
 class ResultWriter;
 class ExplainStatement;
 class LockStatement;
@@ -26,10 +31,15 @@ class VariableSetStatement;
 class VariableShowStatement;
 class AnalyzeStatement;
 class VacuumStatement;
+class Statement;
+class PrepareStatement;
+class ExecuteStatement;
+class DeallocateStatement;
 
 class DatabaseEngine {
  public:
-  DatabaseEngine();
+  // instant_recovery 为 true 时，数据库未正常关闭则使用即时恢复，脏页在第一次访问时重做
+  explicit DatabaseEngine(bool instant_recovery = false);
   ~DatabaseEngine();
 
   const std::string &GetCurrentDatabase() const;
@@ -64,26 +74,48 @@ class DatabaseEngine {
 
   void Begin(const Connection &connection);
   void Commit(const Connection &connection);
+  // 事务提交后更新修改过的表的统计信息，修改的记录数超过阈值时重新 ANALYZE，不抛出 DbException
+  void UpdateStatistics(const std::unordered_map<oid_t, TableModifications> &modifications);
 
   void Checkpoint();
-  void Recover();
+  void Recover(bool instant);
 
-  void Explain(const ExplainStatement &stmt, ResultWriter &writer);
+  void Explain(const Connection &connection, const ExplainStatement &stmt, ResultWriter &writer);
   void Lock(xid_t xid, const LockStatement &stmt, ResultWriter &writer);
 
   void VariableSet(const Connection &connection, const VariableSetStatement &stmt, ResultWriter &writer);
   void VariableShow(const Connection &connection, const VariableShowStatement &stmt, ResultWriter &writer) const;
 
   void Analyze(const AnalyzeStatement &stmt, ResultWriter &writer);
+  // 采样并收集表中 columns 的统计信息，columns 为空时收集所有列
+  void AnalyzeTable(const std::string &table_name, std::vector<ColumnValue> columns);
   void Vacuum(const VacuumStatement &stmt, ResultWriter &writer);
 
+  // 执行绑定后的语句，cache_key 非空时将 DML 语句生成的计划放入计划缓存
+  void ExecuteBoundStatement(const Connection &connection, Statement &statement, const std::string &sql,
+                             const std::string &cache_key, ResultWriter &writer);
+  // 生成并优化查询计划，parameters 为预备语句参数的值
+  std::shared_ptr<Operator> PlanStatement(const Statement &statement, std::vector<Value> parameters);
+  void ExecutePlan(const Connection &connection, std::shared_ptr<Operator> plan, ResultWriter &writer);
+
+  void Prepare(const Connection &connection, PrepareStatement &stmt, const std::string &sql, ResultWriter &writer);
+  // 表结构或统计信息变化后，预备语句需要重新绑定
+  bool IsPreparedStatementStale(const Connection &connection, const std::string &name) const;
+  void Execute(const Connection &connection, const ExecuteStatement &stmt, ResultWriter &writer);
+  void Deallocate(const Connection &connection, const DeallocateStatement &stmt, ResultWriter &writer);
+
   void WriteOneCell(const std::string &str, ResultWriter &writer) const;
+  // 生成查询上下文信息，如查询属于哪个事务，隔离级别等
+  std::unique_ptr<ExecutorContext> CreateExecutorContext(const Connection &connection, bool is_modification_sql);
 
   static IsolationLevel String2IsolationLevel(const std::string &str);
   static ForceJoin String2ForceJoin(const std::string &str);
   static JoinOrderAlgorithm String2JoinOrderAlgorithm(const std::string &str);
   static DeadlockType String2DeadlockType(const std::string &str);
   static bool String2Bool(const std::string &str);
+  // 解析数值类型的变量 name，取值须在 [min, max] 内
+  template <typename T>
+  static T ParseNumericSetting(const std::string &str, const std::string &name, T min, T max);
 
   std::string current_db_;
 
@@ -92,17 +124,45 @@ class DatabaseEngine {
   std::unique_ptr<Disk> disk_;
   std::unique_ptr<TransactionManager> transaction_manager_;
   std::unique_ptr<LogManager> log_manager_;
+  std::unique_ptr<Checkpointer> checkpointer_;
   std::unique_ptr<LockManager> lock_manager_;
 
   std::unordered_map<const Connection *, std::unordered_map<std::string, std::string>> client_variables_;
   std::unordered_map<const Connection *, xid_t> xids_;
   std::unordered_map<const Connection *, IsolationLevel> isolation_levels_;
+  // 各连接是否同步提交，异步提交时不等待提交日志刷盘
+  std::unordered_map<const Connection *, bool> synchronous_commits_;
   std::unordered_set<const Connection *> auto_transaction_set_;
 
+  // 预备语句，保存绑定后的语句，EXECUTE 时跳过解析和绑定
+  struct PreparedStatement {
+    // PREPARE 语句的 SQL 文本，表结构或统计信息变化后用于重新绑定
+    std::string sql_;
+    std::unique_ptr<Statement> statement_;
+    size_t parameter_count_;
+    // 绑定时 catalog 的版本
+    uint64_t version_;
+  };
+  std::unordered_map<const Connection *, std::unordered_map<std::string, PreparedStatement>> prepared_statements_;
+  // 所有连接共享的查询计划缓存
+  PlanCache plan_cache_;
+  bool enable_plan_cache_ = true;
+
   ForceJoin force_join_ = ForceJoin::NONE;
   JoinOrderAlgorithm join_order_algorithm_ = DEFAULT_JOIN_ORDER_ALGORITHM;
   bool enable_optimizer_ = true;
   bool enable_projection_pushdown_ = false;
+  // 代价模型可以选择的连接算法，Hash Join 和 Sort Merge Join 的执行器完成后再开启
+  bool enable_hash_join_ = false;
+  bool enable_merge_join_ = false;
+  uint32_t index_fill_factor_ = DEFAULT_INDEX_FILL_FACTOR;
+  // ANALYZE 采样的记录数和估计不同值个数的相对标准误差
+  uint32_t analyze_sample_rows_ = DEFAULT_ANALYZE_SAMPLE_ROWS;
+  double analyze_distinct_error_ = DEFAULT_ANALYZE_DISTINCT_ERROR;
+  // 事务提交后自动重新收集修改较多的表的统计信息；ANALYZE 会读取表的页面，默认关闭以免影响磁盘访问计数
+  bool enable_autoanalyze_ = false;
+  uint32_t autoanalyze_threshold_ = DEFAULT_AUTOANALYZE_THRESHOLD;
+  double autoanalyze_scale_factor_ = DEFAULT_AUTOANALYZE_SCALE_FACTOR;
 
   bool crashed_ = false;
 };
@@ -19,8 +19,14 @@ std::shared_ptr<Record> DeleteExecutor::Next() {
     // 通过 context_ 获取正确的锁，加锁失败时抛出异常
     // LAB 3 BEGIN
     table_->DeleteRecord(record->GetRid(), context_.GetXid(), true);
+    // 索引修改只能重做不能撤销，因此不删除索引项：事务回滚后恢复的记录仍能通过索引找到
+    // 已删除记录的索引项在回表时根据可见性过滤
     count++;
   }
+  // 记录修改的记录数，事务提交时更新表的统计信息
+  TableModifications modifications;
+  modifications.deleted_ = count;
+  context_.GetTransactionManager().AddModifications(context_.GetXid(), plan_->GetTableOid(), modifications);
   finished_ = true;
   return std::make_shared<Record>(std::vector{Value(count)});
 }
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include "catalog/catalog.h"
 #include "transaction/lock_manager.h"
 #include "transaction/transaction_manager.h"
 
 namespace huadb {
 
+class Operator;
+
 class ExecutorContext {
  public:
   ExecutorContext(BufferPool &buffer_pool, Catalog &catalog, TransactionManager &transaction_manager,
@@ -28,6 +33,18 @@ class ExecutorContext {
   IsolationLevel GetIsolationLevel() const { return isolation_level_; }
   cid_t GetCid() const { return cid_; }
   bool IsModificationSql() const { return is_modification_sql_; }
+  // 读取表中记录前调用，返回判断记录可见性所需的活跃事务集合
+  // 顺序扫描、索引扫描和索引连接读取表记录时均通过此函数加锁
+  std::unordered_set<xid_t> PrepareTableRead(oid_t table_oid) const {
+    std::unordered_set<xid_t> active_xids;
+    // 根据隔离级别，获取活跃事务的 xid（通过 transaction_manager_ 获取需要的信息）
+    // 通过 lock_manager_ 获取正确的锁，加锁失败时抛出异常
+    // LAB 3 BEGIN
+    return active_xids;
+  }
+  // EXPLAIN (ANALYZE) 时记录各算子实际输出的记录数，为 nullptr 时不记录
+  std::unordered_map<const Operator *, size_t> *GetRowCounts() const { return row_counts_; }
+  void SetRowCounts(std::unordered_map<const Operator *, size_t> *row_counts) { row_counts_ = row_counts; }
 
  private:
   BufferPool &buffer_pool_;
@@ -38,6 +55,7 @@ class ExecutorContext {
   IsolationLevel isolation_level_;
   cid_t cid_;
   bool is_modification_sql_;
+  std::unordered_map<const Operator *, size_t> *row_counts_ = nullptr;
 };
 
 }  // namespace huadb
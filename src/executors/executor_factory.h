@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "executors/aggregate_executor.h"
 #include "executors/delete_executor.h"
@@ -9,6 +10,8 @@
 #include "executors/executor_factory.h"
 #include "executors/filter_executor.h"
 #include "executors/hash_join_executor.h"
+#include "executors/index_nested_loop_join_executor.h"
+#include "executors/index_scan_executor.h"
 #include "executors/insert_executor.h"
 #include "executors/limit_executor.h"
 #include "executors/lock_rows_executor.h"
@@ -16,6 +19,7 @@
 #include "executors/nested_loop_join_executor.h"
 #include "executors/orderby_executor.h"
 #include "executors/projection_executor.h"
+#include "executors/row_count_executor.h"
 #include "executors/seqscan_executor.h"
 #include "executors/update_executor.h"
 #include "executors/values_executor.h"
@@ -24,12 +28,28 @@ namespace huadb {
 
 class ExecutorFactory {
  public:
-  static std::unique_ptr<Executor> CreateExecutor(ExecutorContext &context, std::shared_ptr<const Operator> plan) {
+  // row_limit: 上层 Limit 最多需要的记录数，只经过逐条输出的算子向下传递
+  static std::unique_ptr<Executor> CreateExecutor(ExecutorContext &context, std::shared_ptr<const Operator> plan,
+                                                  std::optional<size_t> row_limit = std::nullopt) {
+    auto executor = CreateOperatorExecutor(context, plan, row_limit);
+    if (context.GetRowCounts() != nullptr) {
+      return std::make_unique<RowCountExecutor>(context, *plan, std::move(executor));
+    }
+    return executor;
+  }
+
+ private:
+  static std::unique_ptr<Executor> CreateOperatorExecutor(ExecutorContext &context, std::shared_ptr<const Operator> plan,
+                                                          std::optional<size_t> row_limit) {
     switch (plan->GetType()) {
       case OperatorType::SEQSCAN: {
         auto seqscan_operator = std::dynamic_pointer_cast<const SeqScanOperator>(plan);
         return std::make_unique<SeqScanExecutor>(context, std::move(seqscan_operator));
       }
+      case OperatorType::INDEXSCAN: {
+        auto index_scan_operator = std::dynamic_pointer_cast<const IndexScanOperator>(plan);
+        return std::make_unique<IndexScanExecutor>(context, std::move(index_scan_operator));
+      }
       case OperatorType::INSERT: {
         auto insert_operator = std::dynamic_pointer_cast<const InsertOperator>(plan);
         auto child = CreateExecutor(context, plan->GetChildren()[0]);
@@ -47,7 +67,7 @@ class ExecutorFactory {
       }
       case OperatorType::PROJECTION: {
         auto projection_operator = std::dynamic_pointer_cast<const ProjectionOperator>(plan);
-        auto child = CreateExecutor(context, plan->GetChildren()[0]);
+        auto child = CreateExecutor(context, plan->GetChildren()[0], row_limit);
         return std::make_unique<ProjectionExecutor>(context, std::move(projection_operator), std::move(child));
       }
       case OperatorType::VALUES: {
@@ -75,14 +95,24 @@ class ExecutorFactory {
         return std::make_unique<HashJoinExecutor>(context, std::move(hash_join_operator), std::move(left),
                                                   std::move(right));
       }
+      case OperatorType::INDEXNESTEDLOOP: {
+        auto index_nested_loop_operator = std::dynamic_pointer_cast<const IndexNestedLoopJoinOperator>(plan);
+        auto outer = CreateExecutor(context, plan->GetChildren()[0]);
+        return std::make_unique<IndexNestedLoopJoinExecutor>(context, std::move(index_nested_loop_operator),
+                                                             std::move(outer));
+      }
       case OperatorType::FILTER: {
         auto filter_operator = std::dynamic_pointer_cast<const FilterOperator>(plan);
         auto child = CreateExecutor(context, plan->GetChildren()[0]);
-        return std::make_unique<FilterExecutor>(context, std::move(filter_operator), std::move(child));
+        return std::make_unique<FilterExecutor>(context, std::move(filter_operator), std::move(child), row_limit);
       }
       case OperatorType::LIMIT: {
         auto limit_operator = std::dynamic_pointer_cast<const LimitOperator>(plan);
-        auto child = CreateExecutor(context, plan->GetChildren()[0]);
+        std::optional<size_t> child_limit;
+        if (limit_operator->limit_count_) {
+          child_limit = size_t{*limit_operator->limit_count_} + limit_operator->limit_offset_.value_or(0);
+        }
+        auto child = CreateExecutor(context, plan->GetChildren()[0], child_limit);
         return std::make_unique<LimitExecutor>(context, std::move(limit_operator), std::move(child));
       }
       case OperatorType::ORDERBY: {
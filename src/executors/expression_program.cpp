@@ -0,0 +1,557 @@
+#include "executors/expression_program.h"
+
+#include <cstring>
+
+namespace huadb {
+
+namespace {
+
+template <typename T>
+T ApplyArithmetic(ArithmeticType type, T lhs, T rhs) {
+  switch (type) {
+    case ArithmeticType::ADD:
+      return lhs + rhs;
+    case ArithmeticType::SUB:
+      return lhs - rhs;
+    case ArithmeticType::MUL:
+      return lhs * rhs;
+    case ArithmeticType::DIV:
+      return lhs / rhs;
+    default:
+      throw DbException("Unknown arithmetic type");
+  }
+}
+
+template <typename T, typename U>
+bool ApplyComparison(ComparisonType type, T lhs, U rhs) {
+  switch (type) {
+    case ComparisonType::EQUAL:
+      return lhs == rhs;
+    case ComparisonType::NOT_EQUAL:
+      return lhs != rhs;
+    case ComparisonType::LESS:
+      return lhs < rhs;
+    case ComparisonType::LESS_EQUAL:
+      return lhs <= rhs;
+    case ComparisonType::GREATER:
+      return lhs > rhs;
+    case ComparisonType::GREATER_EQUAL:
+      return lhs >= rhs;
+    default:
+      throw DbException("Unknown comparison type");
+  }
+}
+
+bool IsSimpleComparison(ComparisonType type) {
+  switch (type) {
+    case ComparisonType::EQUAL:
+    case ComparisonType::NOT_EQUAL:
+    case ComparisonType::LESS:
+    case ComparisonType::LESS_EQUAL:
+    case ComparisonType::GREATER:
+    case ComparisonType::GREATER_EQUAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsNumeric(Type type) { return type == Type::INT || type == Type::DOUBLE; }
+
+// 不持有所有权的 shared_ptr，仅用于调用尚未编译的表达式
+std::shared_ptr<const Record> Borrow(const Record &record) {
+  return std::shared_ptr<const Record>(std::shared_ptr<const Record>(), &record);
+}
+
+}  // namespace
+
+ExpressionProgram::ExpressionProgram(const std::shared_ptr<OperatorExpression> &expr, bool predicate) {
+  result_ = Compile(expr, predicate);
+  call_results_.resize(calls_.size());
+}
+
+Value ExpressionProgram::Evaluate(const Record &record) {
+  Run(record, record, false);
+  return ToValue(registers_[result_]);
+}
+
+Value ExpressionProgram::EvaluateJoin(const Record &left, const Record &right) {
+  Run(left, right, true);
+  return ToValue(registers_[result_]);
+}
+
+bool ExpressionProgram::Test(const Record &record) {
+  Run(record, record, false);
+  return IsTrue();
+}
+
+bool ExpressionProgram::TestJoin(const Record &left, const Record &right) {
+  Run(left, right, true);
+  return IsTrue();
+}
+
+size_t ExpressionProgram::InstructionCount() const { return instructions_.size(); }
+
+uint32_t ExpressionProgram::Compile(const std::shared_ptr<OperatorExpression> &expr, bool predicate) {
+  switch (expr->GetExprType()) {
+    case OperatorExpressionType::CONST: {
+      auto reg = NewRegister();
+      constants_.push_back(std::dynamic_pointer_cast<Const>(expr)->value_);
+      Load(registers_[reg], constants_.back());
+      return reg;
+    }
+    case OperatorExpressionType::COLUMN_VALUE: {
+      auto column = std::dynamic_pointer_cast<ColumnValue>(expr);
+      return Emit(column->IsLeft() ? OpCode::LOAD_LEFT : OpCode::LOAD_RIGHT, 0, 0, column->GetColumnIndex());
+    }
+    case OperatorExpressionType::ARITHMETIC: {
+      auto arithmetic = std::dynamic_pointer_cast<huadb::Arithmetic>(expr);
+      auto lhs = Compile(expr->children_[0], false);
+      auto rhs = Compile(expr->children_[1], false);
+      auto lhs_type = InferType(*expr->children_[0]);
+      auto rhs_type = InferType(*expr->children_[1]);
+      auto op = OpCode::ARITH;
+      if (lhs_type == Type::INT && rhs_type == Type::INT) {
+        op = OpCode::ARITH_INT;
+      } else if (lhs_type == Type::DOUBLE && rhs_type == Type::DOUBLE) {
+        op = OpCode::ARITH_DOUBLE;
+      }
+      return Emit(op, lhs, rhs, static_cast<uint32_t>(arithmetic->GetArithmeticType()));
+    }
+    case OperatorExpressionType::COMPARISON: {
+      auto comparison = std::dynamic_pointer_cast<Comparison>(expr);
+      auto type = comparison->GetComparisonType();
+      if (!IsSimpleComparison(type)) {
+        break;
+      }
+      auto lhs = Compile(expr->children_[0], false);
+      auto rhs = Compile(expr->children_[1], false);
+      auto lhs_type = InferType(*expr->children_[0]);
+      auto rhs_type = InferType(*expr->children_[1]);
+      auto op = OpCode::CMP;
+      if (lhs_type == Type::INT && rhs_type == Type::INT) {
+        op = OpCode::CMP_INT;
+      } else if (IsNumeric(lhs_type) && IsNumeric(rhs_type)) {
+        op = OpCode::CMP_DOUBLE;
+      }
+      return Emit(op, lhs, rhs, static_cast<uint32_t>(type));
+    }
+    case OperatorExpressionType::LOGIC: {
+      auto logic = std::dynamic_pointer_cast<huadb::Logic>(expr);
+      switch (logic->GetLogicType()) {
+        case LogicType::NOT:
+          return Emit(OpCode::NOT, Compile(expr->children_[0], false), 0, 0);
+        case LogicType::AND: {
+          if (!predicate) {
+            auto lhs = Compile(expr->children_[0], false);
+            auto rhs = Compile(expr->children_[1], false);
+            return Emit(OpCode::AND, lhs, rhs, 0);
+          }
+          // 只判断真假时，左侧不为 true 则结果一定不为 true，无需计算右侧
+          auto lhs = Compile(expr->children_[0], true);
+          auto dst = NewRegister();
+          auto jump = instructions_.size();
+          instructions_.push_back({OpCode::AND_JUMP, dst, lhs, 0, 0});
+          auto rhs = Compile(expr->children_[1], true);
+          instructions_.push_back({OpCode::AND, dst, lhs, rhs, 0});
+          instructions_[jump].arg_ = instructions_.size();
+          return dst;
+        }
+        case LogicType::OR: {
+          // 空值与 true 的 OR 结果为空值，因此左右两侧都需要准确求值
+          auto lhs = Compile(expr->children_[0], false);
+          auto rhs = Compile(expr->children_[1], false);
+          return Emit(OpCode::OR, lhs, rhs, 0);
+        }
+      }
+      break;
+    }
+    case OperatorExpressionType::NULL_TEST: {
+      auto null_test = std::dynamic_pointer_cast<NullTest>(expr);
+      return Emit(null_test->is_null_ ? OpCode::IS_NULL : OpCode::IS_NOT_NULL, Compile(null_test->arg_, false), 0, 0);
+    }
+    case OperatorExpressionType::TYPE_CAST: {
+      auto type_cast = std::dynamic_pointer_cast<TypeCast>(expr);
+      if (type_cast->cast_type_ == Type::BOOL) {
+        return Emit(OpCode::CAST_BOOL, Compile(type_cast->arg_, false), 0, 0);
+      }
+      break;
+    }
+    case OperatorExpressionType::FUNC_CALL: {
+      auto func_call = std::dynamic_pointer_cast<FuncCall>(expr);
+      FunctionCall call{func_call->GetOverload().scalar_, {}, std::vector<Value>(func_call->args_.size()), Value()};
+      for (const auto &arg : func_call->args_) {
+        call.arg_registers_.push_back(Compile(arg, false));
+      }
+      functions_.push_back(std::move(call));
+      return Emit(OpCode::FUNC, 0, 0, functions_.size() - 1);
+    }
+    default:
+      break;
+  }
+  calls_.push_back(expr);
+  return Emit(OpCode::CALL, 0, 0, calls_.size() - 1);
+}
+
+Type ExpressionProgram::InferType(const OperatorExpression &expr) {
+  switch (expr.GetExprType()) {
+    case OperatorExpressionType::CONST:
+    case OperatorExpressionType::COLUMN_VALUE:
+    case OperatorExpressionType::FUNC_CALL:
+      return expr.GetValueType();
+    case OperatorExpressionType::ARITHMETIC: {
+      auto lhs_type = InferType(*expr.children_[0]);
+      if (IsNumeric(lhs_type) && lhs_type == InferType(*expr.children_[1])) {
+        return lhs_type;
+      }
+      return Type::NULL_TYPE;
+    }
+    default:
+      return Type::NULL_TYPE;
+  }
+}
+
+uint32_t ExpressionProgram::NewRegister() {
+  registers_.emplace_back();
+  return registers_.size() - 1;
+}
+
+uint32_t ExpressionProgram::Emit(OpCode op, uint32_t lhs, uint32_t rhs, uint32_t arg) {
+  auto dst = NewRegister();
+  instructions_.push_back({op, dst, lhs, rhs, arg});
+  return dst;
+}
+
+void ExpressionProgram::Run(const Record &left, const Record &right, bool join) {
+  const auto &left_values = left.GetValues();
+  const auto &right_values = right.GetValues();
+  for (size_t pc = 0; pc < instructions_.size(); pc++) {
+    const auto &ins = instructions_[pc];
+    auto &dst = registers_[ins.dst_];
+    switch (ins.op_) {
+      case OpCode::LOAD_LEFT:
+        Load(dst, left_values[ins.arg_]);
+        break;
+      case OpCode::LOAD_RIGHT:
+        Load(dst, right_values[ins.arg_]);
+        break;
+      case OpCode::ARITH_INT: {
+        // 类型与编译时推断的一致时直接计算，否则交给通用实现处理空值和类型错误
+        const auto &lhs = registers_[ins.lhs_];
+        const auto &rhs = registers_[ins.rhs_];
+        if (!lhs.is_null_ && !rhs.is_null_ && lhs.type_ == Type::INT && rhs.type_ == Type::INT) {
+          dst.type_ = Type::INT;
+          dst.is_null_ = false;
+          dst.ref_ = nullptr;
+          dst.val_.int_ = ApplyArithmetic(static_cast<ArithmeticType>(ins.arg_), lhs.val_.int_, rhs.val_.int_);
+        } else {
+          ExecArithmetic(ins);
+        }
+        break;
+      }
+      case OpCode::ARITH_DOUBLE: {
+        const auto &lhs = registers_[ins.lhs_];
+        const auto &rhs = registers_[ins.rhs_];
+        if (!lhs.is_null_ && !rhs.is_null_ && lhs.type_ == Type::DOUBLE && rhs.type_ == Type::DOUBLE) {
+          dst.type_ = Type::DOUBLE;
+          dst.is_null_ = false;
+          dst.ref_ = nullptr;
+          dst.val_.double_ =
+              ApplyArithmetic(static_cast<ArithmeticType>(ins.arg_), lhs.val_.double_, rhs.val_.double_);
+        } else {
+          ExecArithmetic(ins);
+        }
+        break;
+      }
+      case OpCode::ARITH:
+        ExecArithmetic(ins);
+        break;
+      case OpCode::CMP_INT: {
+        const auto &lhs = registers_[ins.lhs_];
+        const auto &rhs = registers_[ins.rhs_];
+        if (!lhs.is_null_ && !rhs.is_null_ && lhs.type_ == Type::INT && rhs.type_ == Type::INT) {
+          dst.type_ = Type::BOOL;
+          dst.is_null_ = false;
+          dst.ref_ = nullptr;
+          dst.val_.bool_ = ApplyComparison(static_cast<ComparisonType>(ins.arg_), lhs.val_.int_, rhs.val_.int_);
+        } else {
+          ExecCompare(ins);
+        }
+        break;
+      }
+      case OpCode::CMP_DOUBLE: {
+        const auto &lhs = registers_[ins.lhs_];
+        const auto &rhs = registers_[ins.rhs_];
+        if (!lhs.is_null_ && !rhs.is_null_ && IsNumeric(lhs.type_) && IsNumeric(rhs.type_)) {
+          auto lhs_value = lhs.type_ == Type::INT ? lhs.val_.int_ : lhs.val_.double_;
+          auto rhs_value = rhs.type_ == Type::INT ? rhs.val_.int_ : rhs.val_.double_;
+          dst.type_ = Type::BOOL;
+          dst.is_null_ = false;
+          dst.ref_ = nullptr;
+          dst.val_.bool_ = ApplyComparison(static_cast<ComparisonType>(ins.arg_), lhs_value, rhs_value);
+        } else {
+          ExecCompare(ins);
+        }
+        break;
+      }
+      case OpCode::CMP:
+        ExecCompare(ins);
+        break;
+      case OpCode::AND:
+      case OpCode::OR:
+      case OpCode::NOT:
+        ExecLogic(ins);
+        break;
+      case OpCode::AND_JUMP: {
+        const auto &lhs = registers_[ins.lhs_];
+        if (lhs.is_null_ || (lhs.type_ == Type::BOOL && !lhs.val_.bool_)) {
+          dst.type_ = Type::BOOL;
+          dst.is_null_ = false;
+          dst.ref_ = nullptr;
+          dst.val_.bool_ = false;
+          pc = ins.arg_ - 1;
+        }
+        break;
+      }
+      case OpCode::IS_NULL:
+      case OpCode::IS_NOT_NULL: {
+        bool is_null = registers_[ins.lhs_].is_null_;
+        dst.type_ = Type::BOOL;
+        dst.is_null_ = false;
+        dst.ref_ = nullptr;
+        dst.val_.bool_ = ins.op_ == OpCode::IS_NULL ? is_null : !is_null;
+        break;
+      }
+      case OpCode::CAST_BOOL:
+        ExecCastBool(ins);
+        break;
+      case OpCode::FUNC:
+        ExecFunction(ins);
+        break;
+      case OpCode::CALL:
+        ExecCall(ins, left, right, join);
+        break;
+    }
+  }
+}
+
+void ExpressionProgram::Load(Register &reg, const Value &value) {
+  reg.type_ = value.GetType();
+  reg.is_null_ = value.IsNull();
+  reg.ref_ = &value;
+  if (reg.is_null_) {
+    return;
+  }
+  switch (reg.type_) {
+    case Type::BOOL:
+      reg.val_.bool_ = value.GetValue<bool>();
+      break;
+    case Type::INT:
+      reg.val_.int_ = value.GetValue<int32_t>();
+      break;
+    case Type::UINT:
+      reg.val_.uint_ = value.GetValue<uint32_t>();
+      break;
+    case Type::DOUBLE:
+      reg.val_.double_ = value.GetValue<double>();
+      break;
+    default:
+      break;
+  }
+}
+
+Value ExpressionProgram::ToValue(const Register &reg) {
+  if (reg.ref_ != nullptr) {
+    return *reg.ref_;
+  }
+  if (reg.is_null_) {
+    return Value();
+  }
+  switch (reg.type_) {
+    case Type::BOOL:
+      return Value(reg.val_.bool_);
+    case Type::INT:
+      return Value(reg.val_.int_);
+    case Type::UINT:
+      return Value(reg.val_.uint_);
+    case Type::DOUBLE:
+      return Value(reg.val_.double_);
+    default:
+      throw DbException("Unreachable code");
+  }
+}
+
+bool ExpressionProgram::IsTrue() const {
+  const auto &reg = registers_[result_];
+  if (reg.is_null_) {
+    return false;
+  }
+  if (reg.type_ != Type::BOOL) {
+    throw DbException("Type mismatch (expected bool)");
+  }
+  return reg.val_.bool_;
+}
+
+void ExpressionProgram::ExecArithmetic(const Instruction &ins) {
+  auto &dst = registers_[ins.dst_];
+  const auto &lhs = registers_[ins.lhs_];
+  const auto &rhs = registers_[ins.rhs_];
+  auto type = static_cast<ArithmeticType>(ins.arg_);
+  dst.ref_ = nullptr;
+  if (lhs.is_null_ || rhs.is_null_) {
+    dst.type_ = Type::NULL_TYPE;
+    dst.is_null_ = true;
+    return;
+  }
+  switch (lhs.type_) {
+    case Type::INT:
+      if (rhs.type_ != Type::INT) {
+        throw DbException("Type mismatch (expected int)");
+      }
+      dst.val_.int_ = ApplyArithmetic(type, lhs.val_.int_, rhs.val_.int_);
+      break;
+    case Type::DOUBLE:
+      if (rhs.type_ != Type::DOUBLE) {
+        throw DbException("Type mismatch (expected double)");
+      }
+      dst.val_.double_ = ApplyArithmetic(type, lhs.val_.double_, rhs.val_.double_);
+      break;
+    default:
+      throw DbException("Type unsupported for arithmetic operation");
+  }
+  dst.type_ = lhs.type_;
+  dst.is_null_ = false;
+}
+
+void ExpressionProgram::ExecCompare(const Instruction &ins) {
+  auto &dst = registers_[ins.dst_];
+  const auto &lhs = registers_[ins.lhs_];
+  const auto &rhs = registers_[ins.rhs_];
+  auto type = static_cast<ComparisonType>(ins.arg_);
+  dst.ref_ = nullptr;
+  if (lhs.is_null_ || rhs.is_null_) {
+    dst.type_ = Type::NULL_TYPE;
+    dst.is_null_ = true;
+    return;
+  }
+  bool result;
+  switch (lhs.type_) {
+    case Type::INT:
+    case Type::DOUBLE: {
+      if (!IsNumeric(rhs.type_)) {
+        throw DbException("Type unsupported for comparison operation");
+      }
+      if (lhs.type_ == Type::INT && rhs.type_ == Type::INT) {
+        result = ApplyComparison(type, lhs.val_.int_, rhs.val_.int_);
+      } else {
+        auto lhs_value = lhs.type_ == Type::INT ? lhs.val_.int_ : lhs.val_.double_;
+        auto rhs_value = rhs.type_ == Type::INT ? rhs.val_.int_ : rhs.val_.double_;
+        result = ApplyComparison(type, lhs_value, rhs_value);
+      }
+      break;
+    }
+    case Type::CHAR:
+    case Type::VARCHAR: {
+      if (!TypeUtil::IsString(rhs.type_)) {
+        throw DbException("Type mismatch (expected char/varchar)");
+      }
+      // 寄存器引用记录中的字符串，比较时不复制
+      int order = std::strcmp(lhs.ref_->GetValue<const char *>(), rhs.ref_->GetValue<const char *>());
+      result = ApplyComparison(type, order, 0);
+      break;
+    }
+    default:
+      throw DbException("Type unsupported for comparison operation");
+  }
+  dst.type_ = Type::BOOL;
+  dst.is_null_ = false;
+  dst.val_.bool_ = result;
+}
+
+void ExpressionProgram::ExecLogic(const Instruction &ins) {
+  auto &dst = registers_[ins.dst_];
+  const auto &lhs = registers_[ins.lhs_];
+  dst.ref_ = nullptr;
+  if (ins.op_ == OpCode::NOT) {
+    if (lhs.is_null_) {
+      dst.type_ = Type::NULL_TYPE;
+      dst.is_null_ = true;
+      return;
+    }
+    if (lhs.type_ != Type::BOOL) {
+      throw DbException("Type unsupported for Not operation");
+    }
+    dst.type_ = Type::BOOL;
+    dst.is_null_ = false;
+    dst.val_.bool_ = !lhs.val_.bool_;
+    return;
+  }
+  const auto &rhs = registers_[ins.rhs_];
+  if (lhs.is_null_ || rhs.is_null_) {
+    dst.type_ = Type::NULL_TYPE;
+    dst.is_null_ = true;
+    return;
+  }
+  if (lhs.type_ != Type::BOOL) {
+    throw DbException("Type unsupported for logic operation");
+  }
+  if (rhs.type_ != Type::BOOL) {
+    throw DbException("Type mismatch (expected bool)");
+  }
+  dst.type_ = Type::BOOL;
+  dst.is_null_ = false;
+  dst.val_.bool_ = ins.op_ == OpCode::AND ? (lhs.val_.bool_ && rhs.val_.bool_) : (lhs.val_.bool_ || rhs.val_.bool_);
+}
+
+void ExpressionProgram::ExecCastBool(const Instruction &ins) {
+  auto &dst = registers_[ins.dst_];
+  const auto &arg = registers_[ins.lhs_];
+  dst.ref_ = nullptr;
+  if (arg.is_null_) {
+    dst.type_ = Type::NULL_TYPE;
+    dst.is_null_ = true;
+    return;
+  }
+  switch (arg.type_) {
+    case Type::BOOL:
+      dst.val_.bool_ = arg.val_.bool_;
+      break;
+    case Type::CHAR:
+    case Type::VARCHAR: {
+      const char *str = arg.ref_->GetValue<const char *>();
+      if (std::strcmp(str, "t") == 0) {
+        dst.val_.bool_ = true;
+      } else if (std::strcmp(str, "f") == 0) {
+        dst.val_.bool_ = false;
+      } else {
+        throw DbException(std::string("Unknown str in CastAsBool: ") + str);
+      }
+      break;
+    }
+    default:
+      throw DbException("Type unsupported for CastAsBool operation");
+  }
+  dst.type_ = Type::BOOL;
+  dst.is_null_ = false;
+}
+
+void ExpressionProgram::ExecFunction(const Instruction &ins) {
+  auto &call = functions_[ins.arg_];
+  for (size_t i = 0; i < call.arg_registers_.size(); i++) {
+    call.args_[i] = ToValue(registers_[call.arg_registers_[i]]);
+  }
+  call.result_ = call.scalar_(call.args_);
+  Load(registers_[ins.dst_], call.result_);
+}
+
+void ExpressionProgram::ExecCall(const Instruction &ins, const Record &left, const Record &right, bool join) {
+  auto &expr = calls_[ins.arg_];
+  if (join) {
+    call_results_[ins.arg_] = expr->EvaluateJoin(Borrow(left), Borrow(right));
+  } else {
+    call_results_[ins.arg_] = expr->Evaluate(Borrow(left));
+  }
+  Load(registers_[ins.dst_], call_results_[ins.arg_]);
+}
+
+}  // namespace huadb
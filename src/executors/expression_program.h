@@ -0,0 +1,118 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "operators/expressions/expressions.h"
+#include "table/record.h"
+
+namespace huadb {
+
+// 表达式程序：执行前将表达式树编译为一段线性指令，执行时不再进行虚函数调用，也不复制 Value
+// 每个表达式节点对应一个寄存器，指令按后序排列；列值直接从记录中读取，常量在编译时写入寄存器
+// 函数调用的参数同样编译为寄存器，通过 FUNC 指令直接调用计划阶段选择的函数实现
+// 暂不支持编译的表达式（LIKE、IN 等）作为整体通过 CALL 指令调用其 Evaluate 函数
+class ExpressionProgram {
+ public:
+  // predicate 为 true 时，表达式的结果只用于判断真假（如过滤条件、连接条件），此时 AND 可以短路求值
+  explicit ExpressionProgram(const std::shared_ptr<OperatorExpression> &expr, bool predicate = false);
+  // 寄存器中保存了指向常量的指针，不允许复制
+  ExpressionProgram(const ExpressionProgram &) = delete;
+  ExpressionProgram &operator=(const ExpressionProgram &) = delete;
+
+  // 对单条记录求值
+  Value Evaluate(const Record &record);
+  // 对连接的两条记录求值
+  Value EvaluateJoin(const Record &left, const Record &right);
+  // 判断结果是否为 true，空值视为 false
+  bool Test(const Record &record);
+  bool TestJoin(const Record &left, const Record &right);
+
+  // 指令数目，用于测试和基准测试
+  size_t InstructionCount() const;
+
+ private:
+  enum class OpCode : uint8_t {
+    LOAD_LEFT,
+    LOAD_RIGHT,
+    ARITH_INT,
+    ARITH_DOUBLE,
+    ARITH,
+    CMP_INT,
+    CMP_DOUBLE,
+    CMP,
+    AND,
+    OR,
+    NOT,
+    // lhs 不为 true 时将 dst 置为 false 并跳转到 arg_
+    AND_JUMP,
+    IS_NULL,
+    IS_NOT_NULL,
+    CAST_BOOL,
+    FUNC,
+    CALL
+  };
+
+  struct Instruction {
+    OpCode op_;
+    uint32_t dst_;
+    uint32_t lhs_;
+    uint32_t rhs_;
+    // 列下标、运算类型、跳转位置、FUNC 调用的函数下标或 CALL 调用的表达式下标
+    uint32_t arg_;
+  };
+
+  // 寄存器：定长类型直接保存值，字符串、列表以及需要原样输出的值通过 ref_ 引用
+  struct Register {
+    Type type_ = Type::NULL_TYPE;
+    bool is_null_ = true;
+    union {
+      bool bool_;
+      int32_t int_;
+      uint32_t uint_;
+      double double_;
+    } val_{};
+    const Value *ref_ = nullptr;
+  };
+
+  // FUNC 指令调用的函数：参数所在的寄存器，以及复用的参数和结果
+  struct FunctionCall {
+    ScalarFunction scalar_;
+    std::vector<uint32_t> arg_registers_;
+    std::vector<Value> args_;
+    Value result_;
+  };
+
+  // 编译表达式，返回结果所在的寄存器
+  uint32_t Compile(const std::shared_ptr<OperatorExpression> &expr, bool predicate);
+  // 推断表达式的值类型，无法确定时返回 NULL_TYPE
+  static Type InferType(const OperatorExpression &expr);
+  uint32_t NewRegister();
+  uint32_t Emit(OpCode op, uint32_t lhs, uint32_t rhs, uint32_t arg);
+
+  void Run(const Record &left, const Record &right, bool join);
+  static void Load(Register &reg, const Value &value);
+  static Value ToValue(const Register &reg);
+  // 检查求值结果是否为 true
+  bool IsTrue() const;
+
+  void ExecArithmetic(const Instruction &ins);
+  void ExecCompare(const Instruction &ins);
+  void ExecLogic(const Instruction &ins);
+  void ExecCastBool(const Instruction &ins);
+  void ExecFunction(const Instruction &ins);
+  void ExecCall(const Instruction &ins, const Record &left, const Record &right, bool join);
+
+  std::vector<Instruction> instructions_;
+  std::vector<Register> registers_;
+  // 常量的值，寄存器通过 ref_ 引用，因此使用 deque 保证地址不变
+  std::deque<Value> constants_;
+  std::vector<FunctionCall> functions_;
+  // CALL 指令调用的表达式及其结果
+  std::vector<std::shared_ptr<OperatorExpression>> calls_;
+  std::vector<Value> call_results_;
+  uint32_t result_ = 0;
+};
+
+}  // namespace huadb
@@ -1,21 +1,64 @@
 #include "executors/filter_executor.h"
 
+#include <algorithm>
+
 namespace huadb {
 
 FilterExecutor::FilterExecutor(ExecutorContext &context, std::shared_ptr<const FilterOperator> plan,
-                               std::shared_ptr<Executor> child)
-    : Executor(context, {std::move(child)}), plan_(std::move(plan)) {}
+                               std::shared_ptr<Executor> child, std::optional<size_t> row_limit)
+    : Executor(context, {std::move(child)}),
+      plan_(std::move(plan)),
+      predicate_(plan_->predicate_, true),
+      vector_predicate_(VectorPredicate::Compile(plan_->predicate_)),
+      row_limit_(row_limit) {}
 
-void FilterExecutor::Init() { children_[0]->Init(); }
+void FilterExecutor::Init() {
+  children_[0]->Init();
+  batch_.clear();
+  selection_.clear();
+  position_ = 0;
+  returned_ = 0;
+}
 
 std::shared_ptr<Record> FilterExecutor::Next() {
+  if (vector_predicate_ != nullptr) {
+    while (position_ == selection_.size()) {
+      if (!NextBatch()) {
+        return nullptr;
+      }
+    }
+    returned_++;
+    return batch_[selection_[position_++]];
+  }
   while (auto record = children_[0]->Next()) {
-    auto value = plan_->predicate_->Evaluate(record);
-    if (!value.IsNull() && value.GetValue<bool>()) {
+    if (predicate_.Test(*record)) {
       return record;
     }
   }
   return nullptr;
 }
 
+bool FilterExecutor::NextBatch() {
+  batch_.clear();
+  // 每批读取的记录全部满足条件时恰好凑够 Limit 所需的记录数，因此不会比逐条过滤多读记录
+  size_t batch_size = FILTER_BATCH_SIZE;
+  if (row_limit_) {
+    batch_size = std::clamp(*row_limit_ - std::min(*row_limit_, returned_), size_t{1}, FILTER_BATCH_SIZE);
+  }
+  while (batch_.size() < batch_size) {
+    auto record = children_[0]->Next();
+    if (record == nullptr) {
+      break;
+    }
+    batch_.push_back(std::move(record));
+  }
+  position_ = 0;
+  if (batch_.empty()) {
+    selection_.clear();
+    return false;
+  }
+  vector_predicate_->Select(batch_, selection_);
+  return true;
+}
+
 }  // namespace huadb
@@ -1,19 +1,36 @@
 #pragma once
 
+#include <optional>
+
 #include "executors/executor.h"
+#include "executors/expression_program.h"
+#include "executors/vector_predicate.h"
 #include "operators/filter_operator.h"
 
 namespace huadb {
 
 class FilterExecutor : public Executor {
  public:
-  FilterExecutor(ExecutorContext &context, std::shared_ptr<const FilterOperator> plan, std::shared_ptr<Executor> child);
+  // row_limit: 上层 Limit 最多需要的记录数，为空时不限制
+  FilterExecutor(ExecutorContext &context, std::shared_ptr<const FilterOperator> plan, std::shared_ptr<Executor> child,
+                 std::optional<size_t> row_limit = std::nullopt);
   void Init() override;
   std::shared_ptr<Record> Next() override;
 
  private:
+  // 从子算子读取一批记录并计算选择向量，子算子没有更多记录时返回 false
+  bool NextBatch();
+
   std::shared_ptr<const FilterOperator> plan_;
-  std::shared_ptr<Table> table_;
+  ExpressionProgram predicate_;
+  // 过滤条件可以向量化时不为空，此时按批读取记录
+  std::unique_ptr<VectorPredicate> vector_predicate_;
+  std::vector<std::shared_ptr<Record>> batch_;
+  std::vector<uint32_t> selection_;
+  size_t position_ = 0;
+  // 有 Limit 时每批最多读取尚需返回的记录数，避免读取 Limit 不需要的记录
+  std::optional<size_t> row_limit_;
+  size_t returned_ = 0;
 };
 
 }  // namespace huadb
@@ -0,0 +1,131 @@
+#include "executors/index_nested_loop_join_executor.h"
+
+#include <algorithm>
+
+namespace huadb {
+
+IndexNestedLoopJoinExecutor::IndexNestedLoopJoinExecutor(ExecutorContext &context,
+                                                         std::shared_ptr<const IndexNestedLoopJoinOperator> plan,
+                                                         std::shared_ptr<Executor> outer)
+    : Executor(context, {std::move(outer)}), plan_(std::move(plan)) {}
+
+void IndexNestedLoopJoinExecutor::Init() {
+  children_[0]->Init();
+  index_ = context_.GetCatalog().GetIndex(plan_->index_oid_);
+  auto inner_table = context_.GetCatalog().GetTable(plan_->inner_->GetTableOid());
+  inner_scan_ = std::make_unique<TableScan>(context_.GetBufferPool(), std::move(inner_table), Rid{NULL_PAGE_ID, 0});
+  preserve_outer_ = (plan_->join_type_ == JoinType::LEFT && plan_->outer_is_left_) ||
+                    (plan_->join_type_ == JoinType::RIGHT && !plan_->outer_is_left_);
+  // 重新扫描时清空上一次扫描的状态，外表子节点已经重新初始化
+  outer_batch_.clear();
+  outer_matched_.clear();
+  outer_finished_ = false;
+  matches_.clear();
+  match_pos_ = 0;
+  unmatched_pos_ = 0;
+  last_inner_ = nullptr;
+  LoadOuterBatch();
+}
+
+std::shared_ptr<Record> IndexNestedLoopJoinExecutor::Next() {
+  while (true) {
+    while (match_pos_ < matches_.size()) {
+      const auto &[pos, rid] = matches_[match_pos_++];
+      auto inner = FetchInner(rid);
+      if (inner == nullptr) {
+        continue;
+      }
+      outer_matched_[pos] = true;
+      return Combine(*outer_batch_[pos], *inner);
+    }
+    if (preserve_outer_) {
+      while (unmatched_pos_ < outer_batch_.size()) {
+        auto pos = unmatched_pos_++;
+        if (!outer_matched_[pos]) {
+          return PadOuter(*outer_batch_[pos]);
+        }
+      }
+    }
+    if (!LoadOuterBatch()) {
+      return nullptr;
+    }
+  }
+}
+
+bool IndexNestedLoopJoinExecutor::LoadOuterBatch() {
+  outer_batch_.clear();
+  matches_.clear();
+  match_pos_ = 0;
+  unmatched_pos_ = 0;
+  size_t batch_size = 0;
+  while (!outer_finished_ && batch_size < JOIN_BLOCK_SIZE) {
+    auto record = children_[0]->Next();
+    if (record == nullptr) {
+      outer_finished_ = true;
+      break;
+    }
+    batch_size += record->GetSize();
+    outer_batch_.push_back(std::move(record));
+  }
+  outer_matched_.assign(outer_batch_.size(), false);
+  if (outer_batch_.empty()) {
+    return false;
+  }
+
+  // 按连接键排序，相同的键只查找一次索引
+  std::vector<std::pair<Value, size_t>> keys;
+  for (size_t i = 0; i < outer_batch_.size(); i++) {
+    auto key = plan_->outer_key_->Evaluate(outer_batch_[i]);
+    if (!key.IsNull()) {
+      keys.emplace_back(std::move(key), i);
+    }
+  }
+  std::stable_sort(keys.begin(), keys.end(),
+                   [](const auto &lhs, const auto &rhs) { return lhs.first.Less(rhs.first); });
+  std::vector<Rid> rids;
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (i == 0 || !keys[i - 1].first.Equal(keys[i].first)) {
+      rids = index_->ScanKey(keys[i].first);
+    }
+    for (const auto &rid : rids) {
+      matches_.emplace_back(keys[i].second, rid);
+    }
+  }
+  // 按 rid 排序，顺序读取内表页面
+  std::stable_sort(matches_.begin(), matches_.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.second.page_id_ < rhs.second.page_id_ ||
+           (lhs.second.page_id_ == rhs.second.page_id_ && lhs.second.slot_id_ < rhs.second.slot_id_);
+  });
+  return true;
+}
+
+std::shared_ptr<Record> IndexNestedLoopJoinExecutor::FetchInner(const Rid &rid) {
+  if (last_inner_ != nullptr && last_inner_->GetRid().page_id_ == rid.page_id_ &&
+      last_inner_->GetRid().slot_id_ == rid.slot_id_) {
+    return last_inner_;
+  }
+  auto active_xids = context_.PrepareTableRead(plan_->inner_->GetTableOid());
+  auto record = inner_scan_->GetRecord(rid, context_.GetXid(), context_.GetIsolationLevel(), context_.GetCid(),
+                                       active_xids);
+  if (record != nullptr) {
+    last_inner_ = record;
+  }
+  return record;
+}
+
+std::shared_ptr<Record> IndexNestedLoopJoinExecutor::Combine(const Record &outer, const Record &inner) const {
+  if (plan_->outer_is_left_) {
+    auto record = std::make_shared<Record>(outer);
+    record->Append(inner);
+    return record;
+  }
+  auto record = std::make_shared<Record>(inner);
+  record->Append(outer);
+  return record;
+}
+
+std::shared_ptr<Record> IndexNestedLoopJoinExecutor::PadOuter(const Record &outer) const {
+  return Combine(outer, Record(std::vector<Value>(plan_->inner_->OutputColumns().Length())));
+}
+
+}  // namespace huadb
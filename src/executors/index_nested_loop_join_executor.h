@@ -0,0 +1,50 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "executors/executor.h"
+#include "index/index.h"
+#include "operators/index_nested_loop_join_operator.h"
+#include "table/table.h"
+#include "table/table_scan.h"
+
+namespace huadb {
+
+// Index Nested Loop Join：每次读入一批外表记录，按连接键排序后对每个不同的键查找一次索引
+// 查找到的内表 rid 按页面排序后再读取，使内表页面的访问尽量顺序进行
+class IndexNestedLoopJoinExecutor : public Executor {
+ public:
+  IndexNestedLoopJoinExecutor(ExecutorContext &context, std::shared_ptr<const IndexNestedLoopJoinOperator> plan,
+                              std::shared_ptr<Executor> outer);
+  void Init() override;
+  std::shared_ptr<Record> Next() override;
+
+ private:
+  // 读入下一批外表记录并完成索引查找，外表读完时返回 false
+  bool LoadOuterBatch();
+  // 根据 rid 读取内表记录，记录不可见时返回空指针
+  std::shared_ptr<Record> FetchInner(const Rid &rid);
+  // 按原连接的左右顺序拼接记录
+  std::shared_ptr<Record> Combine(const Record &outer, const Record &inner) const;
+  // 生成内表一侧为空值的连接结果，用于外连接
+  std::shared_ptr<Record> PadOuter(const Record &outer) const;
+
+  std::shared_ptr<const IndexNestedLoopJoinOperator> plan_;
+  std::shared_ptr<Index> index_;
+  std::unique_ptr<TableScan> inner_scan_;
+  bool preserve_outer_ = false;
+
+  // 当前批次的外表记录，以及每条记录是否找到匹配
+  std::vector<std::shared_ptr<Record>> outer_batch_;
+  std::vector<bool> outer_matched_;
+  bool outer_finished_ = false;
+  // 当前批次的匹配结果：(外表记录下标, 内表 rid)，按 rid 排序
+  std::vector<std::pair<size_t, Rid>> matches_;
+  size_t match_pos_ = 0;
+  size_t unmatched_pos_ = 0;
+  // 最近一次读取的内表记录，相邻的匹配项可能指向同一条记录
+  std::shared_ptr<Record> last_inner_;
+};
+
+}  // namespace huadb
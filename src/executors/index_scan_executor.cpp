@@ -0,0 +1,51 @@
+#include "executors/index_scan_executor.h"
+
+namespace huadb {
+
+IndexScanExecutor::IndexScanExecutor(ExecutorContext &context, std::shared_ptr<const IndexScanOperator> plan)
+    : Executor(context, {}), plan_(std::move(plan)) {}
+
+void IndexScanExecutor::Init() {
+  index_ = context_.GetCatalog().GetIndex(plan_->index_oid_);
+  auto table = context_.GetCatalog().GetTable(plan_->GetTableOid());
+  scan_ = std::make_unique<TableScan>(context_.GetBufferPool(), std::move(table), Rid{NULL_PAGE_ID, 0});
+  if (plan_->lower_) {
+    iterator_.emplace(index_->LowerBound(plan_->lower_->value_));
+  } else {
+    iterator_.emplace(index_->Begin());
+  }
+  finished_ = false;
+}
+
+std::shared_ptr<Record> IndexScanExecutor::Next() {
+  while (!finished_) {
+    auto entry = iterator_->Next();
+    if (!entry || PastUpper(entry->key_)) {
+      finished_ = true;
+      break;
+    }
+    if (plan_->lower_ && !plan_->lower_->inclusive_ && entry->key_.Equal(plan_->lower_->value_)) {
+      continue;
+    }
+    // 索引项可能指向已删除或对当前事务不可见的记录，回表时按可见性过滤
+    auto active_xids = context_.PrepareTableRead(plan_->GetTableOid());
+    auto record = scan_->GetRecord(entry->rid_, context_.GetXid(), context_.GetIsolationLevel(), context_.GetCid(),
+                                   active_xids);
+    if (record != nullptr) {
+      return record;
+    }
+  }
+  return nullptr;
+}
+
+bool IndexScanExecutor::PastUpper(const Value &key) const {
+  if (!plan_->upper_) {
+    return false;
+  }
+  if (plan_->upper_->inclusive_) {
+    return key.Greater(plan_->upper_->value_);
+  }
+  return !key.Less(plan_->upper_->value_);
+}
+
+}  // namespace huadb
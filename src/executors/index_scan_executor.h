@@ -0,0 +1,32 @@
+#pragma once
+
+#include <optional>
+
+#include "executors/executor.h"
+#include "index/index.h"
+#include "operators/index_scan_operator.h"
+#include "table/table.h"
+#include "table/table_scan.h"
+
+namespace huadb {
+
+// 沿 B+ 树叶节点按键值顺序遍历范围内的索引项，再根据 rid 读取表中的记录
+class IndexScanExecutor : public Executor {
+ public:
+  IndexScanExecutor(ExecutorContext &context, std::shared_ptr<const IndexScanOperator> plan);
+
+  void Init() override;
+  std::shared_ptr<Record> Next() override;
+
+ private:
+  // 判断索引项是否超出上界
+  bool PastUpper(const Value &key) const;
+
+  std::shared_ptr<const IndexScanOperator> plan_;
+  std::shared_ptr<Index> index_;
+  std::unique_ptr<TableScan> scan_;
+  std::optional<BPlusTreeIterator> iterator_;
+  bool finished_ = false;
+};
+
+}  // namespace huadb
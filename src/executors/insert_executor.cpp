@@ -10,6 +10,7 @@ void InsertExecutor::Init() {
   children_[0]->Init();
   table_ = context_.GetCatalog().GetTable(plan_->GetTableOid());
   column_list_ = context_.GetCatalog().GetTableColumnList(plan_->GetTableOid());
+  indexes_ = context_.GetCatalog().GetTableIndexes(plan_->GetTableOid());
 }
 
 std::shared_ptr<Record> InsertExecutor::Next() {
@@ -27,9 +28,16 @@ std::shared_ptr<Record> InsertExecutor::Next() {
     auto table_record = std::make_shared<Record>(std::move(values));
     // 通过 context_ 获取正确的锁，加锁失败时抛出异常
     // LAB 3 BEGIN
-    auto rid = table_->InsertRecord(std::move(table_record), context_.GetXid(), context_.GetCid(), true);
+    auto rid = table_->InsertRecord(table_record, context_.GetXid(), context_.GetCid(), true);
+    for (const auto &index : indexes_) {
+      index->Insert(table_record->GetValue(index->GetColumnIndex()), rid, context_.GetXid());
+    }
     count++;
   }
+  // 记录修改的记录数，事务提交时更新表的统计信息
+  TableModifications modifications;
+  modifications.inserted_ = count;
+  context_.GetTransactionManager().AddModifications(context_.GetXid(), plan_->GetTableOid(), modifications);
   finished_ = true;
   return std::make_shared<Record>(std::vector{Value(count)});
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "executors/executor.h"
+#include "index/index.h"
 #include "operators/insert_operator.h"
 #include "table/table.h"
 
@@ -15,6 +16,8 @@ class InsertExecutor : public Executor {
  private:
   std::shared_ptr<const InsertOperator> plan_;
   std::shared_ptr<Table> table_;
+  // 表上需要同步维护的索引
+  std::vector<std::shared_ptr<Index>> indexes_;
   ColumnList column_list_;
   bool finished_ = false;
 };
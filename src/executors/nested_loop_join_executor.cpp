@@ -5,19 +5,155 @@ namespace huadb {
 NestedLoopJoinExecutor::NestedLoopJoinExecutor(ExecutorContext &context,
                                                std::shared_ptr<const NestedLoopJoinOperator> plan,
                                                std::shared_ptr<Executor> left, std::shared_ptr<Executor> right)
-    : Executor(context, {std::move(left), std::move(right)}), plan_(std::move(plan)) {}
+    : Executor(context, {std::move(left), std::move(right)}),
+      plan_(std::move(plan)),
+      join_condition_(plan_->join_condition_, true) {}
 
 void NestedLoopJoinExecutor::Init() {
   children_[0]->Init();
   children_[1]->Init();
+  // 基本表可以直接重新扫描，其余算子（如连接、过滤等）的结果需要物化，避免重复计算
+  materialize_inner_ = plan_->children_[1]->GetType() != OperatorType::SEQSCAN;
+  // 重新扫描时清空上一次扫描的状态，子节点已经重新初始化，物化的内表也需要重新读取
+  outer_finished_ = false;
+  inner_materialized_ = false;
+  inner_buffer_.clear();
+  inner_record_ = nullptr;
+  inner_pos_ = 0;
+  inner_matched_.clear();
+  emitting_inner_unmatched_ = false;
+  if (!LoadOuterBlock() && (plan_->join_type_ == JoinType::RIGHT || plan_->join_type_ == JoinType::FULL)) {
+    emitting_inner_unmatched_ = true;
+  }
 }
 
 std::shared_ptr<Record> NestedLoopJoinExecutor::Next() {
-  // 从 NestedLoopJoinOperator 中获取连接条件
-  // 使用 OperatorExpression 的 EvaluateJoin 函数判断是否满足 join 条件
-  // 使用 Record 的 Append 函数进行记录的连接
-  // LAB 4 BEGIN
-  return nullptr;
+  bool left_outer = plan_->join_type_ == JoinType::LEFT || plan_->join_type_ == JoinType::FULL;
+  bool right_outer = plan_->join_type_ == JoinType::RIGHT || plan_->join_type_ == JoinType::FULL;
+  while (true) {
+    if (emitting_inner_unmatched_) {
+      // 外表已经读完，输出所有未匹配的内表记录
+      while (auto inner = NextInner()) {
+        auto inner_idx = inner_pos_ - 1;
+        if (inner_idx >= inner_matched_.size() || !inner_matched_[inner_idx]) {
+          return PadInner(*inner);
+        }
+      }
+      return nullptr;
+    }
+    if (outer_block_.empty()) {
+      return nullptr;
+    }
+    if (inner_record_ == nullptr) {
+      inner_record_ = NextInner();
+      block_pos_ = 0;
+      if (inner_record_ == nullptr) {
+        // 内表扫描完成，输出当前块中未匹配的外表记录
+        if (left_outer) {
+          while (unmatched_pos_ < outer_block_.size()) {
+            auto pos = unmatched_pos_++;
+            if (!outer_matched_[pos]) {
+              return PadOuter(*outer_block_[pos]);
+            }
+          }
+        }
+        if (!LoadOuterBlock()) {
+          if (right_outer) {
+            emitting_inner_unmatched_ = true;
+            RewindInner();
+            continue;
+          }
+          return nullptr;
+        }
+        RewindInner();
+        continue;
+      }
+    }
+    // 当前内表记录与外表块中的记录逐一比较
+    while (block_pos_ < outer_block_.size()) {
+      auto pos = block_pos_++;
+      if (Match(*outer_block_[pos], *inner_record_)) {
+        outer_matched_[pos] = true;
+        if (right_outer) {
+          auto inner_idx = inner_pos_ - 1;
+          if (inner_idx >= inner_matched_.size()) {
+            inner_matched_.resize(inner_idx + 1, false);
+          }
+          inner_matched_[inner_idx] = true;
+        }
+        auto record = std::make_shared<Record>(*outer_block_[pos]);
+        record->Append(*inner_record_);
+        return record;
+      }
+    }
+    inner_record_ = nullptr;
+  }
+}
+
+bool NestedLoopJoinExecutor::LoadOuterBlock() {
+  outer_block_.clear();
+  outer_matched_.clear();
+  block_pos_ = 0;
+  unmatched_pos_ = 0;
+  size_t block_size = 0;
+  while (!outer_finished_ && block_size < JOIN_BLOCK_SIZE) {
+    auto record = children_[0]->Next();
+    if (record == nullptr) {
+      outer_finished_ = true;
+      break;
+    }
+    block_size += record->GetSize();
+    outer_block_.push_back(std::move(record));
+  }
+  outer_matched_.resize(outer_block_.size(), false);
+  return !outer_block_.empty();
+}
+
+void NestedLoopJoinExecutor::RewindInner() {
+  inner_pos_ = 0;
+  inner_record_ = nullptr;
+  if (!materialize_inner_) {
+    children_[1]->Init();
+  }
+}
+
+std::shared_ptr<Record> NestedLoopJoinExecutor::NextInner() {
+  std::shared_ptr<Record> record;
+  if (!materialize_inner_) {
+    record = children_[1]->Next();
+  } else if (inner_materialized_) {
+    if (inner_pos_ < inner_buffer_.size()) {
+      record = inner_buffer_[inner_pos_];
+    }
+  } else {
+    // 第一次扫描内表时将记录写入临时缓冲区
+    record = children_[1]->Next();
+    if (record != nullptr) {
+      inner_buffer_.push_back(record);
+    } else {
+      inner_materialized_ = true;
+    }
+  }
+  if (record != nullptr) {
+    inner_pos_++;
+  }
+  return record;
+}
+
+bool NestedLoopJoinExecutor::Match(const Record &outer, const Record &inner) {
+  return join_condition_.TestJoin(outer, inner);
+}
+
+std::shared_ptr<Record> NestedLoopJoinExecutor::PadOuter(const Record &outer) const {
+  auto record = std::make_shared<Record>(outer);
+  record->Append(Record(std::vector<Value>(plan_->children_[1]->OutputColumns().Length())));
+  return record;
+}
+
+std::shared_ptr<Record> NestedLoopJoinExecutor::PadInner(const Record &inner) const {
+  auto record = std::make_shared<Record>(std::vector<Value>(plan_->children_[0]->OutputColumns().Length()));
+  record->Append(inner);
+  return record;
 }
 
 }  // namespace huadb
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <vector>
+
 #include "executors/executor.h"
+#include "executors/expression_program.h"
 #include "operators/nested_loop_join_operator.h"
 
 namespace huadb {
 
+// Block Nested Loop Join：每次从外表（左孩子）读入 JOIN_BLOCK_SIZE 字节的记录，再对内表（右孩子）完整扫描一遍
+// 内表为基本表时直接重新扫描；否则在第一次扫描时物化到临时缓冲区中，后续块从缓冲区读取
 class NestedLoopJoinExecutor : public Executor {
  public:
   NestedLoopJoinExecutor(ExecutorContext &context, std::shared_ptr<const NestedLoopJoinOperator> plan,
@@ -13,7 +18,40 @@ class NestedLoopJoinExecutor : public Executor {
   std::shared_ptr<Record> Next() override;
 
  private:
+  // 读入下一个外表块，外表读完时返回 false
+  bool LoadOuterBlock();
+  // 将内表游标移动到开头
+  void RewindInner();
+  // 获取下一条内表记录，同时记录其在内表中的位置
+  std::shared_ptr<Record> NextInner();
+  // 判断两条记录是否满足连接条件
+  bool Match(const Record &outer, const Record &inner);
+  // 生成一侧为空值的连接结果，用于外连接
+  std::shared_ptr<Record> PadOuter(const Record &outer) const;
+  std::shared_ptr<Record> PadInner(const Record &inner) const;
+
   std::shared_ptr<const NestedLoopJoinOperator> plan_;
+  ExpressionProgram join_condition_;
+
+  // 当前外表块，以及块内每条记录是否找到匹配
+  std::vector<std::shared_ptr<Record>> outer_block_;
+  std::vector<bool> outer_matched_;
+  bool outer_finished_ = false;
+
+  // 内表不是基本表时，将其物化到内存中
+  bool materialize_inner_ = false;
+  bool inner_materialized_ = false;
+  std::vector<std::shared_ptr<Record>> inner_buffer_;
+  // 当前内表记录及其在内表中的位置
+  std::shared_ptr<Record> inner_record_;
+  size_t inner_pos_ = 0;
+  // 右外连接或全外连接时，记录内表每条记录是否找到匹配
+  std::vector<bool> inner_matched_;
+
+  // 外表块内的扫描位置，以及输出未匹配外表记录的位置
+  size_t block_pos_ = 0;
+  size_t unmatched_pos_ = 0;
+  bool emitting_inner_unmatched_ = false;
 };
 
 }  // namespace huadb
@@ -4,7 +4,11 @@ namespace huadb {
 
 ProjectionExecutor::ProjectionExecutor(ExecutorContext &context, std::shared_ptr<const ProjectionOperator> plan,
                                        std::shared_ptr<Executor> child)
-    : Executor(context, {std::move(child)}), plan_(std::move(plan)) {}
+    : Executor(context, {std::move(child)}), plan_(std::move(plan)) {
+  for (const auto &expr : plan_->exprs_) {
+    exprs_.push_back(std::make_unique<ExpressionProgram>(expr));
+  }
+}
 
 void ProjectionExecutor::Init() { children_[0]->Init(); }
 
@@ -14,8 +18,9 @@ std::shared_ptr<Record> ProjectionExecutor::Next() {
     return nullptr;
   }
   std::vector<Value> values;
-  for (const auto &expr : plan_->exprs_) {
-    values.push_back(expr->Evaluate(record));
+  values.reserve(exprs_.size());
+  for (auto &expr : exprs_) {
+    values.push_back(expr->Evaluate(*record));
   }
   return std::make_unique<Record>(std::move(values), record->GetRid());
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "executors/executor.h"
+#include "executors/expression_program.h"
 #include "operators/projection_operator.h"
 
 namespace huadb {
@@ -14,6 +15,7 @@ class ProjectionExecutor : public Executor {
 
  private:
   std::shared_ptr<const ProjectionOperator> plan_;
+  std::vector<std::unique_ptr<ExpressionProgram>> exprs_;
 };
 
 }  // namespace huadb
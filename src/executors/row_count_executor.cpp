@@ -0,0 +1,18 @@
+#include "executors/row_count_executor.h"
+
+namespace huadb {
+
+RowCountExecutor::RowCountExecutor(ExecutorContext &context, const Operator &plan, std::shared_ptr<Executor> child)
+    : Executor(context, {std::move(child)}), row_count_((*context.GetRowCounts())[&plan]) {}
+
+void RowCountExecutor::Init() { children_[0]->Init(); }
+
+std::shared_ptr<Record> RowCountExecutor::Next() {
+  auto record = children_[0]->Next();
+  if (record != nullptr) {
+    row_count_++;
+  }
+  return record;
+}
+
+}  // namespace huadb
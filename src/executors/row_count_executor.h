@@ -0,0 +1,20 @@
+#pragma once
+
+#include "executors/executor.h"
+#include "operators/operator.h"
+
+namespace huadb {
+
+// 统计子执行器输出的记录数，记录在 ExecutorContext 中，用于 EXPLAIN (ANALYZE)
+// 子执行器被重新初始化时（如 Nested Loop Join 重新扫描内表）继续累加
+class RowCountExecutor : public Executor {
+ public:
+  RowCountExecutor(ExecutorContext &context, const Operator &plan, std::shared_ptr<Executor> child);
+  void Init() override;
+  std::shared_ptr<Record> Next() override;
+
+ private:
+  size_t &row_count_;
+};
+
+}  // namespace huadb
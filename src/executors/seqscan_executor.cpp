@@ -11,10 +11,7 @@ void SeqScanExecutor::Init() {
 }
 
 std::shared_ptr<Record> SeqScanExecutor::Next() {
-  std::unordered_set<xid_t> active_xids;
-  // 根据隔离级别，获取活跃事务的 xid（通过 context_ 获取需要的信息）
-  // 通过 context_ 获取正确的锁，加锁失败时抛出异常
-  // LAB 3 BEGIN
+  auto active_xids = context_.PrepareTableRead(plan_->GetTableOid());
   return scan_->GetNextRecord(context_.GetXid(), context_.GetIsolationLevel(), context_.GetCid(), active_xids);
 }
 
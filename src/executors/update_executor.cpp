@@ -4,11 +4,16 @@ namespace huadb {
 
 UpdateExecutor::UpdateExecutor(ExecutorContext &context, std::shared_ptr<const UpdateOperator> plan,
                                std::shared_ptr<Executor> child)
-    : Executor(context, {std::move(child)}), plan_(std::move(plan)) {}
+    : Executor(context, {std::move(child)}), plan_(std::move(plan)) {
+  for (const auto &expr : plan_->update_exprs_) {
+    update_exprs_.push_back(std::make_unique<ExpressionProgram>(expr));
+  }
+}
 
 void UpdateExecutor::Init() {
   children_[0]->Init();
   table_ = context_.GetCatalog().GetTable(plan_->GetTableOid());
+  indexes_ = context_.GetCatalog().GetTableIndexes(plan_->GetTableOid());
 }
 
 std::shared_ptr<Record> UpdateExecutor::Next() {
@@ -18,15 +23,24 @@ std::shared_ptr<Record> UpdateExecutor::Next() {
   uint32_t count = 0;
   while (auto record = children_[0]->Next()) {
     std::vector<Value> values;
-    for (const auto &expr : plan_->update_exprs_) {
-      values.push_back(expr->Evaluate(record));
+    values.reserve(update_exprs_.size());
+    for (auto &expr : update_exprs_) {
+      values.push_back(expr->Evaluate(*record));
     }
     auto new_record = std::make_shared<Record>(std::move(values));
     // 通过 context_ 获取正确的锁，加锁失败时抛出异常
     // LAB 3 BEGIN
     auto rid = table_->UpdateRecord(record->GetRid(), context_.GetXid(), context_.GetCid(), new_record, true);
+    // 旧记录的索引项保留，理由同 DeleteExecutor
+    for (const auto &index : indexes_) {
+      index->Insert(new_record->GetValue(index->GetColumnIndex()), rid, context_.GetXid());
+    }
     count++;
   }
+  // 记录修改的记录数，事务提交时更新表的统计信息
+  TableModifications modifications;
+  modifications.updated_ = count;
+  context_.GetTransactionManager().AddModifications(context_.GetXid(), plan_->GetTableOid(), modifications);
   finished_ = true;
   return std::make_shared<Record>(std::vector{Value(count)});
 }
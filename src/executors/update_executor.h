@@ -1,6 +1,8 @@
 #pragma once
 
 #include "executors/executor.h"
+#include "executors/expression_program.h"
+#include "index/index.h"
 #include "operators/update_operator.h"
 
 namespace huadb {
@@ -14,7 +16,10 @@ class UpdateExecutor : public Executor {
 
  private:
   std::shared_ptr<const UpdateOperator> plan_;
+  std::vector<std::unique_ptr<ExpressionProgram>> update_exprs_;
   std::shared_ptr<Table> table_;
+  // 表上需要同步维护的索引
+  std::vector<std::shared_ptr<Index>> indexes_;
   bool finished_ = false;
 };
 
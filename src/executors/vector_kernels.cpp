@@ -0,0 +1,706 @@
+#include "executors/vector_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <type_traits>
+
+#include "common/exceptions.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HUADB_VECTOR_X86
+#include <immintrin.h>
+#endif
+
+namespace huadb {
+
+namespace {
+
+template <ComparisonType TYPE>
+using ComparisonTag = std::integral_constant<ComparisonType, TYPE>;
+
+template <ArithmeticType TYPE>
+using ArithmeticTag = std::integral_constant<ArithmeticType, TYPE>;
+
+// 将运行时的比较类型转换为编译期常量，使每种比较生成单独的循环
+template <typename Func>
+void DispatchComparison(ComparisonType type, Func &&func) {
+  switch (type) {
+    case ComparisonType::EQUAL:
+      return func(ComparisonTag<ComparisonType::EQUAL>());
+    case ComparisonType::NOT_EQUAL:
+      return func(ComparisonTag<ComparisonType::NOT_EQUAL>());
+    case ComparisonType::LESS:
+      return func(ComparisonTag<ComparisonType::LESS>());
+    case ComparisonType::LESS_EQUAL:
+      return func(ComparisonTag<ComparisonType::LESS_EQUAL>());
+    case ComparisonType::GREATER:
+      return func(ComparisonTag<ComparisonType::GREATER>());
+    case ComparisonType::GREATER_EQUAL:
+      return func(ComparisonTag<ComparisonType::GREATER_EQUAL>());
+    default:
+      throw DbException("Comparison type unsupported by vector kernels");
+  }
+}
+
+template <typename Func>
+void DispatchArithmetic(ArithmeticType type, Func &&func) {
+  switch (type) {
+    case ArithmeticType::ADD:
+      return func(ArithmeticTag<ArithmeticType::ADD>());
+    case ArithmeticType::SUB:
+      return func(ArithmeticTag<ArithmeticType::SUB>());
+    case ArithmeticType::MUL:
+      return func(ArithmeticTag<ArithmeticType::MUL>());
+    case ArithmeticType::DIV:
+      return func(ArithmeticTag<ArithmeticType::DIV>());
+    default:
+      throw DbException("Unknown arithmetic type");
+  }
+}
+
+// 整数比较只有相等和大于两种指令，<>、<=、>= 通过对 =、>、< 的结果取反得到
+constexpr bool IsInverted(ComparisonType type) {
+  return type == ComparisonType::NOT_EQUAL || type == ComparisonType::LESS_EQUAL ||
+         type == ComparisonType::GREATER_EQUAL;
+}
+
+// 标量实现，同时用于向量实现中不足 64 行的尾部
+namespace scalar {
+
+template <ComparisonType TYPE, typename T>
+bool Test(T lhs, T rhs) {
+  if constexpr (TYPE == ComparisonType::EQUAL) {
+    return lhs == rhs;
+  } else if constexpr (TYPE == ComparisonType::NOT_EQUAL) {
+    return lhs != rhs;
+  } else if constexpr (TYPE == ComparisonType::LESS) {
+    return lhs < rhs;
+  } else if constexpr (TYPE == ComparisonType::LESS_EQUAL) {
+    return lhs <= rhs;
+  } else if constexpr (TYPE == ComparisonType::GREATER) {
+    return lhs > rhs;
+  } else {
+    return lhs >= rhs;
+  }
+}
+
+// 整数运算按补码回绕，与向量指令的结果一致
+template <ArithmeticType TYPE, typename T>
+T Apply(T lhs, T rhs) {
+  if constexpr (std::is_signed_v<T> && std::is_integral_v<T> && TYPE != ArithmeticType::DIV) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(Apply<TYPE, U>(static_cast<U>(lhs), static_cast<U>(rhs)));
+  } else if constexpr (TYPE == ArithmeticType::ADD) {
+    return lhs + rhs;
+  } else if constexpr (TYPE == ArithmeticType::SUB) {
+    return lhs - rhs;
+  } else if constexpr (TYPE == ArithmeticType::MUL) {
+    return lhs * rhs;
+  } else {
+    return lhs / rhs;
+  }
+}
+
+// 从第 begin 行（64 的倍数）开始逐行计算
+template <ComparisonType TYPE, typename T>
+void CompareFrom(const T *data, size_t begin, size_t count, T constant, uint64_t *mask) {
+  for (size_t i = begin; i < count; i += 64) {
+    size_t end = std::min(count, i + 64);
+    uint64_t word = 0;
+    for (size_t j = i; j < end; j++) {
+      word |= static_cast<uint64_t>(Test<TYPE>(data[j], constant)) << (j - i);
+    }
+    mask[i / 64] = word;
+  }
+}
+
+template <typename T>
+void BetweenFrom(const T *data, size_t begin, size_t count, T low, T high, uint64_t *mask) {
+  for (size_t i = begin; i < count; i += 64) {
+    size_t end = std::min(count, i + 64);
+    uint64_t word = 0;
+    for (size_t j = i; j < end; j++) {
+      word |= static_cast<uint64_t>(low <= data[j] && data[j] <= high) << (j - i);
+    }
+    mask[i / 64] = word;
+  }
+}
+
+template <ArithmeticType TYPE, typename T>
+void ComputeFrom(const T *lhs, const T *rhs, size_t begin, size_t count, T *result) {
+  for (size_t i = begin; i < count; i++) {
+    result[i] = Apply<TYPE>(lhs[i], rhs[i]);
+  }
+}
+
+template <typename T>
+void Compare(ComparisonType type, const T *data, size_t count, T constant, uint64_t *mask) {
+  DispatchComparison(type, [&](auto tag) { CompareFrom<decltype(tag)::value>(data, 0, count, constant, mask); });
+}
+
+template <typename T>
+void Between(const T *data, size_t count, T low, T high, uint64_t *mask) {
+  BetweenFrom(data, 0, count, low, high, mask);
+}
+
+template <typename T>
+void Compute(ArithmeticType type, const T *lhs, const T *rhs, size_t count, T *result) {
+  DispatchArithmetic(type, [&](auto tag) { ComputeFrom<decltype(tag)::value>(lhs, rhs, 0, count, result); });
+}
+
+}  // namespace scalar
+
+#ifdef HUADB_VECTOR_X86
+
+// 各指令集的实现分别编译，运行时根据 CPU 支持的指令集选择
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+namespace avx2 {
+
+// 8 个 32 位有符号整数的比较结果，每行一位
+template <ComparisonType TYPE>
+inline uint64_t CompareInt8(__m256i value, __m256i constant) {
+  __m256i result;
+  if constexpr (TYPE == ComparisonType::EQUAL || TYPE == ComparisonType::NOT_EQUAL) {
+    result = _mm256_cmpeq_epi32(value, constant);
+  } else if constexpr (TYPE == ComparisonType::LESS || TYPE == ComparisonType::GREATER_EQUAL) {
+    result = _mm256_cmpgt_epi32(constant, value);
+  } else {
+    result = _mm256_cmpgt_epi32(value, constant);
+  }
+  uint64_t bits = _mm256_movemask_ps(_mm256_castsi256_ps(result));
+  return IsInverted(TYPE) ? ~bits & 0xFF : bits;
+}
+
+template <ComparisonType TYPE>
+constexpr int DoublePredicate() {
+  if constexpr (TYPE == ComparisonType::EQUAL) {
+    return _CMP_EQ_OQ;
+  } else if constexpr (TYPE == ComparisonType::NOT_EQUAL) {
+    return _CMP_NEQ_UQ;
+  } else if constexpr (TYPE == ComparisonType::LESS) {
+    return _CMP_LT_OQ;
+  } else if constexpr (TYPE == ComparisonType::LESS_EQUAL) {
+    return _CMP_LE_OQ;
+  } else if constexpr (TYPE == ComparisonType::GREATER) {
+    return _CMP_GT_OQ;
+  } else {
+    return _CMP_GE_OQ;
+  }
+}
+
+// 无符号整数将符号位取反后按有符号整数比较
+template <typename T>
+inline __m256i SignFlip() {
+  return _mm256_set1_epi32(std::is_unsigned_v<T> ? std::numeric_limits<int32_t>::min() : 0);
+}
+
+template <typename T>
+inline __m256i LoadInt(const T *data, __m256i flip) {
+  return _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data)), flip);
+}
+
+template <ComparisonType TYPE, typename T>
+void CompareInt(const T *data, size_t count, T constant, uint64_t *mask) {
+  const __m256i flip = SignFlip<T>();
+  const __m256i value = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int32_t>(constant)), flip);
+  size_t full = count / 64 * 64;
+  for (size_t i = 0; i < full; i += 64) {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += 8) {
+      word |= CompareInt8<TYPE>(LoadInt(data + i + j, flip), value) << j;
+    }
+    mask[i / 64] = word;
+  }
+  scalar::CompareFrom<TYPE>(data, full, count, constant, mask);
+}
+
+template <typename T>
+void Compare(ComparisonType type, const T *data, size_t count, T constant, uint64_t *mask) {
+  DispatchComparison(type, [&](auto tag) { CompareInt<decltype(tag)::value>(data, count, constant, mask); });
+}
+
+template <ComparisonType TYPE>
+void CompareDouble(const double *data, size_t count, double constant, uint64_t *mask) {
+  // 比较谓词必须为立即数
+  constexpr int PREDICATE = DoublePredicate<TYPE>();
+  const __m256d value = _mm256_set1_pd(constant);
+  size_t full = count / 64 * 64;
+  for (size_t i = 0; i < full; i += 64) {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += 4) {
+      __m256d result = _mm256_cmp_pd(_mm256_loadu_pd(data + i + j), value, PREDICATE);
+      word |= static_cast<uint64_t>(_mm256_movemask_pd(result)) << j;
+    }
+    mask[i / 64] = word;
+  }
+  scalar::CompareFrom<TYPE>(data, full, count, constant, mask);
+}
+
+template <>
+void Compare(ComparisonType type, const double *data, size_t count, double constant, uint64_t *mask) {
+  DispatchComparison(type, [&](auto tag) { CompareDouble<decltype(tag)::value>(data, count, constant, mask); });
+}
+
+template <typename T>
+void Between(const T *data, size_t count, T low, T high, uint64_t *mask) {
+  const __m256i flip = SignFlip<T>();
+  const __m256i low_value = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int32_t>(low)), flip);
+  const __m256i high_value = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int32_t>(high)), flip);
+  size_t full = count / 64 * 64;
+  for (size_t i = 0; i < full; i += 64) {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += 8) {
+      __m256i value = LoadInt(data + i + j, flip);
+      __m256i outside =
+          _mm256_or_si256(_mm256_cmpgt_epi32(low_value, value), _mm256_cmpgt_epi32(value, high_value));
+      word |= (~static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(outside))) & 0xFF) << j;
+    }
+    mask[i / 64] = word;
+  }
+  scalar::BetweenFrom(data, full, count, low, high, mask);
+}
+
+template <>
+void Between(const double *data, size_t count, double low, double high, uint64_t *mask) {
+  const __m256d low_value = _mm256_set1_pd(low);
+  const __m256d high_value = _mm256_set1_pd(high);
+  size_t full = count / 64 * 64;
+  for (size_t i = 0; i < full; i += 64) {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += 4) {
+      __m256d value = _mm256_loadu_pd(data + i + j);
+      __m256d inside =
+          _mm256_and_pd(_mm256_cmp_pd(value, low_value, _CMP_GE_OQ), _mm256_cmp_pd(value, high_value, _CMP_LE_OQ));
+      word |= static_cast<uint64_t>(_mm256_movemask_pd(inside)) << j;
+    }
+    mask[i / 64] = word;
+  }
+  scalar::BetweenFrom(data, full, count, low, high, mask);
+}
+
+template <ArithmeticType TYPE>
+void ComputeInt(const int32_t *lhs, const int32_t *rhs, size_t count, int32_t *result) {
+  size_t full = count / 8 * 8;
+  for (size_t i = 0; i < full; i += 8) {
+    __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i));
+    __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i));
+    __m256i value;
+    if constexpr (TYPE == ArithmeticType::ADD) {
+      value = _mm256_add_epi32(left, right);
+    } else if constexpr (TYPE == ArithmeticType::SUB) {
+      value = _mm256_sub_epi32(left, right);
+    } else {
+      value = _mm256_mullo_epi32(left, right);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i), value);
+  }
+  scalar::ComputeFrom<TYPE>(lhs, rhs, full, count, result);
+}
+
+template <ArithmeticType TYPE>
+void ComputeDouble(const double *lhs, const double *rhs, size_t count, double *result) {
+  size_t full = count / 4 * 4;
+  for (size_t i = 0; i < full; i += 4) {
+    __m256d left = _mm256_loadu_pd(lhs + i);
+    __m256d right = _mm256_loadu_pd(rhs + i);
+    __m256d value;
+    if constexpr (TYPE == ArithmeticType::ADD) {
+      value = _mm256_add_pd(left, right);
+    } else if constexpr (TYPE == ArithmeticType::SUB) {
+      value = _mm256_sub_pd(left, right);
+    } else if constexpr (TYPE == ArithmeticType::MUL) {
+      value = _mm256_mul_pd(left, right);
+    } else {
+      value = _mm256_div_pd(left, right);
+    }
+    _mm256_storeu_pd(result + i, value);
+  }
+  scalar::ComputeFrom<TYPE>(lhs, rhs, full, count, result);
+}
+
+void ComputeInts(ArithmeticType type, const int32_t *lhs, const int32_t *rhs, size_t count, int32_t *result) {
+  DispatchArithmetic(type, [&](auto tag) {
+    if constexpr (decltype(tag)::value == ArithmeticType::DIV) {
+      scalar::ComputeFrom<decltype(tag)::value>(lhs, rhs, 0, count, result);
+    } else {
+      ComputeInt<decltype(tag)::value>(lhs, rhs, count, result);
+    }
+  });
+}
+
+void ComputeDoubles(ArithmeticType type, const double *lhs, const double *rhs, size_t count, double *result) {
+  DispatchArithmetic(type, [&](auto tag) { ComputeDouble<decltype(tag)::value>(lhs, rhs, count, result); });
+}
+
+}  // namespace avx2
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("sse4.2")
+
+namespace sse42 {
+
+// 4 个 32 位有符号整数的比较结果，每行一位
+template <ComparisonType TYPE>
+inline uint64_t CompareInt4(__m128i value, __m128i constant) {
+  __m128i result;
+  if constexpr (TYPE == ComparisonType::EQUAL || TYPE == ComparisonType::NOT_EQUAL) {
+    result = _mm_cmpeq_epi32(value, constant);
+  } else if constexpr (TYPE == ComparisonType::LESS || TYPE == ComparisonType::GREATER_EQUAL) {
+    result = _mm_cmpgt_epi32(constant, value);
+  } else {
+    result = _mm_cmpgt_epi32(value, constant);
+  }
+  uint64_t bits = _mm_movemask_ps(_mm_castsi128_ps(result));
+  return IsInverted(TYPE) ? ~bits & 0xF : bits;
+}
+
+// 2 个双精度浮点数的比较结果，每行一位
+template <ComparisonType TYPE>
+inline uint64_t CompareDouble2(__m128d value, __m128d constant) {
+  __m128d result;
+  if constexpr (TYPE == ComparisonType::EQUAL) {
+    result = _mm_cmpeq_pd(value, constant);
+  } else if constexpr (TYPE == ComparisonType::NOT_EQUAL) {
+    result = _mm_cmpneq_pd(value, constant);
+  } else if constexpr (TYPE == ComparisonType::LESS) {
+    result = _mm_cmplt_pd(value, constant);
+  } else if constexpr (TYPE == ComparisonType::LESS_EQUAL) {
+    result = _mm_cmple_pd(value, constant);
+  } else if constexpr (TYPE == ComparisonType::GREATER) {
+    result = _mm_cmpgt_pd(value, constant);
+  } else {
+    result = _mm_cmpge_pd(value, constant);
+  }
+  return _mm_movemask_pd(result);
+}
+
+template <typename T>
+inline __m128i SignFlip() {
+  return _mm_set1_epi32(std::is_unsigned_v<T> ? std::numeric_limits<int32_t>::min() : 0);
+}
+
+template <typename T>
+inline __m128i LoadInt(const T *data, __m128i flip) {
+  return _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data)), flip);
+}
+
+template <ComparisonType TYPE, typename T>
+void CompareInt(const T *data, size_t count, T constant, uint64_t *mask) {
+  const __m128i flip = SignFlip<T>();
+  const __m128i value = _mm_xor_si128(_mm_set1_epi32(static_cast<int32_t>(constant)), flip);
+  size_t full = count / 64 * 64;
+  for (size_t i = 0; i < full; i += 64) {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += 4) {
+      word |= CompareInt4<TYPE>(LoadInt(data + i + j, flip), value) << j;
+    }
+    mask[i / 64] = word;
+  }
+  scalar::CompareFrom<TYPE>(data, full, count, constant, mask);
+}
+
+template <typename T>
+void Compare(ComparisonType type, const T *data, size_t count, T constant, uint64_t *mask) {
+  DispatchComparison(type, [&](auto tag) { CompareInt<decltype(tag)::value>(data, count, constant, mask); });
+}
+
+template <ComparisonType TYPE>
+void CompareDouble(const double *data, size_t count, double constant, uint64_t *mask) {
+  const __m128d value = _mm_set1_pd(constant);
+  size_t full = count / 64 * 64;
+  for (size_t i = 0; i < full; i += 64) {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += 2) {
+      word |= CompareDouble2<TYPE>(_mm_loadu_pd(data + i + j), value) << j;
+    }
+    mask[i / 64] = word;
+  }
+  scalar::CompareFrom<TYPE>(data, full, count, constant, mask);
+}
+
+template <>
+void Compare(ComparisonType type, const double *data, size_t count, double constant, uint64_t *mask) {
+  DispatchComparison(type, [&](auto tag) { CompareDouble<decltype(tag)::value>(data, count, constant, mask); });
+}
+
+template <typename T>
+void Between(const T *data, size_t count, T low, T high, uint64_t *mask) {
+  const __m128i flip = SignFlip<T>();
+  const __m128i low_value = _mm_xor_si128(_mm_set1_epi32(static_cast<int32_t>(low)), flip);
+  const __m128i high_value = _mm_xor_si128(_mm_set1_epi32(static_cast<int32_t>(high)), flip);
+  size_t full = count / 64 * 64;
+  for (size_t i = 0; i < full; i += 64) {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += 4) {
+      __m128i value = LoadInt(data + i + j, flip);
+      __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(low_value, value), _mm_cmpgt_epi32(value, high_value));
+      word |= (~static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(outside))) & 0xF) << j;
+    }
+    mask[i / 64] = word;
+  }
+  scalar::BetweenFrom(data, full, count, low, high, mask);
+}
+
+template <>
+void Between(const double *data, size_t count, double low, double high, uint64_t *mask) {
+  const __m128d low_value = _mm_set1_pd(low);
+  const __m128d high_value = _mm_set1_pd(high);
+  size_t full = count / 64 * 64;
+  for (size_t i = 0; i < full; i += 64) {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += 2) {
+      __m128d value = _mm_loadu_pd(data + i + j);
+      __m128d inside = _mm_and_pd(_mm_cmpge_pd(value, low_value), _mm_cmple_pd(value, high_value));
+      word |= static_cast<uint64_t>(_mm_movemask_pd(inside)) << j;
+    }
+    mask[i / 64] = word;
+  }
+  scalar::BetweenFrom(data, full, count, low, high, mask);
+}
+
+template <ArithmeticType TYPE>
+void ComputeInt(const int32_t *lhs, const int32_t *rhs, size_t count, int32_t *result) {
+  size_t full = count / 4 * 4;
+  for (size_t i = 0; i < full; i += 4) {
+    __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs + i));
+    __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs + i));
+    __m128i value;
+    if constexpr (TYPE == ArithmeticType::ADD) {
+      value = _mm_add_epi32(left, right);
+    } else if constexpr (TYPE == ArithmeticType::SUB) {
+      value = _mm_sub_epi32(left, right);
+    } else {
+      value = _mm_mullo_epi32(left, right);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(result + i), value);
+  }
+  scalar::ComputeFrom<TYPE>(lhs, rhs, full, count, result);
+}
+
+template <ArithmeticType TYPE>
+void ComputeDouble(const double *lhs, const double *rhs, size_t count, double *result) {
+  size_t full = count / 2 * 2;
+  for (size_t i = 0; i < full; i += 2) {
+    __m128d left = _mm_loadu_pd(lhs + i);
+    __m128d right = _mm_loadu_pd(rhs + i);
+    __m128d value;
+    if constexpr (TYPE == ArithmeticType::ADD) {
+      value = _mm_add_pd(left, right);
+    } else if constexpr (TYPE == ArithmeticType::SUB) {
+      value = _mm_sub_pd(left, right);
+    } else if constexpr (TYPE == ArithmeticType::MUL) {
+      value = _mm_mul_pd(left, right);
+    } else {
+      value = _mm_div_pd(left, right);
+    }
+    _mm_storeu_pd(result + i, value);
+  }
+  scalar::ComputeFrom<TYPE>(lhs, rhs, full, count, result);
+}
+
+void ComputeInts(ArithmeticType type, const int32_t *lhs, const int32_t *rhs, size_t count, int32_t *result) {
+  DispatchArithmetic(type, [&](auto tag) {
+    if constexpr (decltype(tag)::value == ArithmeticType::DIV) {
+      scalar::ComputeFrom<decltype(tag)::value>(lhs, rhs, 0, count, result);
+    } else {
+      ComputeInt<decltype(tag)::value>(lhs, rhs, count, result);
+    }
+  });
+}
+
+void ComputeDoubles(ArithmeticType type, const double *lhs, const double *rhs, size_t count, double *result) {
+  DispatchArithmetic(type, [&](auto tag) { ComputeDouble<decltype(tag)::value>(lhs, rhs, count, result); });
+}
+
+}  // namespace sse42
+
+#pragma GCC pop_options
+
+#endif
+
+// 各指令集的函数表
+struct KernelTable {
+  void (*compare_int_)(ComparisonType, const int32_t *, size_t, int32_t, uint64_t *);
+  void (*compare_uint_)(ComparisonType, const uint32_t *, size_t, uint32_t, uint64_t *);
+  void (*compare_double_)(ComparisonType, const double *, size_t, double, uint64_t *);
+  void (*between_int_)(const int32_t *, size_t, int32_t, int32_t, uint64_t *);
+  void (*between_uint_)(const uint32_t *, size_t, uint32_t, uint32_t, uint64_t *);
+  void (*between_double_)(const double *, size_t, double, double, uint64_t *);
+  void (*compute_int_)(ArithmeticType, const int32_t *, const int32_t *, size_t, int32_t *);
+  void (*compute_double_)(ArithmeticType, const double *, const double *, size_t, double *);
+};
+
+const KernelTable SCALAR_KERNELS = {
+    scalar::Compare<int32_t>, scalar::Compare<uint32_t>, scalar::Compare<double>, scalar::Between<int32_t>,
+    scalar::Between<uint32_t>, scalar::Between<double>,  scalar::Compute<int32_t>, scalar::Compute<double>};
+
+#ifdef HUADB_VECTOR_X86
+const KernelTable SSE4_2_KERNELS = {
+    sse42::Compare<int32_t>,  sse42::Compare<uint32_t>, sse42::Compare<double>, sse42::Between<int32_t>,
+    sse42::Between<uint32_t>, sse42::Between<double>,   sse42::ComputeInts,     sse42::ComputeDoubles};
+
+const KernelTable AVX2_KERNELS = {
+    avx2::Compare<int32_t>,  avx2::Compare<uint32_t>, avx2::Compare<double>, avx2::Between<int32_t>,
+    avx2::Between<uint32_t>, avx2::Between<double>,   avx2::ComputeInts,     avx2::ComputeDoubles};
+#endif
+
+VectorKernels::InstructionSet DetectInstructionSet() {
+  if (VectorKernels::IsSupported(VectorKernels::InstructionSet::AVX2)) {
+    return VectorKernels::InstructionSet::AVX2;
+  }
+  if (VectorKernels::IsSupported(VectorKernels::InstructionSet::SSE4_2)) {
+    return VectorKernels::InstructionSet::SSE4_2;
+  }
+  return VectorKernels::InstructionSet::SCALAR;
+}
+
+std::atomic<VectorKernels::InstructionSet> &CurrentInstructionSet() {
+  static std::atomic<VectorKernels::InstructionSet> instruction_set(DetectInstructionSet());
+  return instruction_set;
+}
+
+const KernelTable &GetKernels() {
+#ifdef HUADB_VECTOR_X86
+  switch (CurrentInstructionSet().load(std::memory_order_relaxed)) {
+    case VectorKernels::InstructionSet::AVX2:
+      return AVX2_KERNELS;
+    case VectorKernels::InstructionSet::SSE4_2:
+      return SSE4_2_KERNELS;
+    default:
+      break;
+  }
+#endif
+  return SCALAR_KERNELS;
+}
+
+bool IsValid(const uint64_t *valid, size_t row) { return valid == nullptr || ((valid[row / 64] >> (row % 64)) & 1); }
+
+}  // namespace
+
+VectorKernels::InstructionSet VectorKernels::GetInstructionSet() {
+  return CurrentInstructionSet().load(std::memory_order_relaxed);
+}
+
+void VectorKernels::SetInstructionSet(InstructionSet instruction_set) {
+  if (!IsSupported(instruction_set)) {
+    throw DbException(std::string("Instruction set not supported: ") + GetInstructionSetName(instruction_set));
+  }
+  CurrentInstructionSet().store(instruction_set, std::memory_order_relaxed);
+}
+
+bool VectorKernels::IsSupported(InstructionSet instruction_set) {
+  switch (instruction_set) {
+    case InstructionSet::SCALAR:
+      return true;
+#ifdef HUADB_VECTOR_X86
+    case InstructionSet::SSE4_2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("sse4.2");
+    case InstructionSet::AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+const char *VectorKernels::GetInstructionSetName(InstructionSet instruction_set) {
+  switch (instruction_set) {
+    case InstructionSet::SCALAR:
+      return "scalar";
+    case InstructionSet::SSE4_2:
+      return "sse4.2";
+    case InstructionSet::AVX2:
+      return "avx2";
+  }
+  return "unknown";
+}
+
+void VectorKernels::Compare(ComparisonType type, const int32_t *data, size_t count, int32_t constant,
+                            uint64_t *mask) {
+  GetKernels().compare_int_(type, data, count, constant, mask);
+}
+
+void VectorKernels::Compare(ComparisonType type, const uint32_t *data, size_t count, uint32_t constant,
+                            uint64_t *mask) {
+  GetKernels().compare_uint_(type, data, count, constant, mask);
+}
+
+void VectorKernels::Compare(ComparisonType type, const double *data, size_t count, double constant, uint64_t *mask) {
+  GetKernels().compare_double_(type, data, count, constant, mask);
+}
+
+void VectorKernels::Between(const int32_t *data, size_t count, int32_t low, int32_t high, uint64_t *mask) {
+  GetKernels().between_int_(data, count, low, high, mask);
+}
+
+void VectorKernels::Between(const uint32_t *data, size_t count, uint32_t low, uint32_t high, uint64_t *mask) {
+  GetKernels().between_uint_(data, count, low, high, mask);
+}
+
+void VectorKernels::Between(const double *data, size_t count, double low, double high, uint64_t *mask) {
+  GetKernels().between_double_(data, count, low, high, mask);
+}
+
+void VectorKernels::Compute(ArithmeticType type, const int32_t *lhs, const int32_t *rhs, size_t count,
+                            const uint64_t *valid, int32_t *result) {
+  if (type != ArithmeticType::DIV) {
+    GetKernels().compute_int_(type, lhs, rhs, count, result);
+    return;
+  }
+  // 整数除法没有对应的向量指令，逐行计算，跳过空值所在的行
+  for (size_t i = 0; i < count; i++) {
+    if (!IsValid(valid, i)) {
+      result[i] = 0;
+    } else if (rhs[i] == 0) {
+      throw DbException("Division by zero");
+    } else if (rhs[i] == -1) {
+      result[i] = scalar::Apply<ArithmeticType::SUB>(0, lhs[i]);
+    } else {
+      result[i] = lhs[i] / rhs[i];
+    }
+  }
+}
+
+void VectorKernels::Compute(ArithmeticType type, const double *lhs, const double *rhs, size_t count,
+                            const uint64_t *valid, double *result) {
+  GetKernels().compute_double_(type, lhs, rhs, count, result);
+}
+
+void VectorKernels::And(const uint64_t *lhs, const uint64_t *rhs, size_t words, uint64_t *result) {
+  for (size_t i = 0; i < words; i++) {
+    result[i] = lhs[i] & rhs[i];
+  }
+}
+
+void VectorKernels::Or(const uint64_t *lhs, const uint64_t *rhs, size_t words, uint64_t *result) {
+  for (size_t i = 0; i < words; i++) {
+    result[i] = lhs[i] | rhs[i];
+  }
+}
+
+void VectorKernels::AndNot(const uint64_t *lhs, const uint64_t *rhs, size_t words, uint64_t *result) {
+  for (size_t i = 0; i < words; i++) {
+    result[i] = lhs[i] & ~rhs[i];
+  }
+}
+
+size_t VectorKernels::ToSelection(const uint64_t *mask, size_t count, uint32_t *selection) {
+  size_t selected = 0;
+  for (size_t i = 0; i < MaskWords(count); i++) {
+    auto word = mask[i];
+    while (word != 0) {
+      selection[selected++] = i * 64 + __builtin_ctzll(word);
+      word &= word - 1;
+    }
+  }
+  return selected;
+}
+
+}  // namespace huadb
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "operators/expressions/arithmetic.h"
+#include "operators/expressions/comparison.h"
+
+namespace huadb {
+
+// 列向量上的过滤与算术运算函数
+// 结果位图中第 i 行对应 mask[i / 64] 的第 i % 64 位，超出 count 的位均为 0
+// 首次调用时根据 CPU 支持的指令集选择 AVX2、SSE4.2 或标量实现
+class VectorKernels {
+ public:
+  enum class InstructionSet { SCALAR, SSE4_2, AVX2 };
+
+  // 当前使用的指令集
+  static InstructionSet GetInstructionSet();
+  // 切换指令集，用于测试和基准测试；CPU 不支持时抛出异常
+  static void SetInstructionSet(InstructionSet instruction_set);
+  static bool IsSupported(InstructionSet instruction_set);
+  static const char *GetInstructionSetName(InstructionSet instruction_set);
+
+  // 保存 count 行所需的 64 位字数目
+  static size_t MaskWords(size_t count) { return (count + 63) / 64; }
+
+  // 比较：mask 第 i 位为 data[i] op constant，op 只能为 =、<>、<、<=、>、>=
+  static void Compare(ComparisonType type, const int32_t *data, size_t count, int32_t constant, uint64_t *mask);
+  static void Compare(ComparisonType type, const uint32_t *data, size_t count, uint32_t constant, uint64_t *mask);
+  static void Compare(ComparisonType type, const double *data, size_t count, double constant, uint64_t *mask);
+
+  // BETWEEN：mask 第 i 位为 low <= data[i] <= high
+  static void Between(const int32_t *data, size_t count, int32_t low, int32_t high, uint64_t *mask);
+  static void Between(const uint32_t *data, size_t count, uint32_t low, uint32_t high, uint64_t *mask);
+  static void Between(const double *data, size_t count, double low, double high, uint64_t *mask);
+
+  // 算术运算：result[i] = lhs[i] op rhs[i]
+  // 整数除法只计算 valid 中为 1 的行（valid 为 nullptr 时计算全部行），除数为 0 时抛出异常
+  static void Compute(ArithmeticType type, const int32_t *lhs, const int32_t *rhs, size_t count,
+                      const uint64_t *valid, int32_t *result);
+  static void Compute(ArithmeticType type, const double *lhs, const double *rhs, size_t count, const uint64_t *valid,
+                      double *result);
+
+  // 位图运算，words 为 64 位字数目
+  static void And(const uint64_t *lhs, const uint64_t *rhs, size_t words, uint64_t *result);
+  static void Or(const uint64_t *lhs, const uint64_t *rhs, size_t words, uint64_t *result);
+  // result = lhs & ~rhs
+  static void AndNot(const uint64_t *lhs, const uint64_t *rhs, size_t words, uint64_t *result);
+
+  // 将位图转换为选择向量（为 1 的行下标，按升序排列），返回选中的行数
+  static size_t ToSelection(const uint64_t *mask, size_t count, uint32_t *selection);
+};
+
+}  // namespace huadb
@@ -0,0 +1,377 @@
+#include "executors/vector_predicate.h"
+
+#include <algorithm>
+
+#include "executors/vector_kernels.h"
+
+namespace huadb {
+
+namespace {
+
+bool IsNumeric(Type type) { return type == Type::INT || type == Type::UINT || type == Type::DOUBLE; }
+
+bool IsSimpleComparison(ComparisonType type) {
+  switch (type) {
+    case ComparisonType::EQUAL:
+    case ComparisonType::NOT_EQUAL:
+    case ComparisonType::LESS:
+    case ComparisonType::LESS_EQUAL:
+    case ComparisonType::GREATER:
+    case ComparisonType::GREATER_EQUAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// 交换比较的左右两侧
+ComparisonType Flip(ComparisonType type) {
+  switch (type) {
+    case ComparisonType::LESS:
+      return ComparisonType::GREATER;
+    case ComparisonType::LESS_EQUAL:
+      return ComparisonType::GREATER_EQUAL;
+    case ComparisonType::GREATER:
+      return ComparisonType::LESS;
+    case ComparisonType::GREATER_EQUAL:
+      return ComparisonType::LESS_EQUAL;
+    default:
+      return type;
+  }
+}
+
+// 非空的数值常量
+const Value *GetNumericConst(const std::shared_ptr<OperatorExpression> &expr) {
+  auto constant = std::dynamic_pointer_cast<Const>(expr);
+  if (constant == nullptr || constant->value_.IsNull() || !IsNumeric(constant->value_.GetType())) {
+    return nullptr;
+  }
+  return &constant->value_;
+}
+
+void SetBit(std::vector<uint64_t> &mask, size_t row) { mask[row / 64] |= uint64_t(1) << (row % 64); }
+
+}  // namespace
+
+std::unique_ptr<VectorPredicate> VectorPredicate::Compile(const std::shared_ptr<OperatorExpression> &expr) {
+  std::unique_ptr<VectorPredicate> predicate(new VectorPredicate());
+  if (!predicate->CompilePredicate(expr)) {
+    return nullptr;
+  }
+  return predicate;
+}
+
+void VectorPredicate::Select(const std::vector<std::shared_ptr<Record>> &records, std::vector<uint32_t> &selection) {
+  auto count = records.size();
+  auto words = VectorKernels::MaskWords(count);
+  all_ones_.assign(words, ~uint64_t(0));
+  if (count % 64 != 0) {
+    all_ones_.back() = (uint64_t(1) << (count % 64)) - 1;
+  }
+  for (auto &node : nodes_) {
+    switch (node.type_) {
+      case NodeType::COLUMN:
+        EvaluateColumn(node, records);
+        break;
+      case NodeType::CONST:
+        EvaluateConst(node, count);
+        break;
+      case NodeType::ARITHMETIC:
+        EvaluateArithmetic(node, count);
+        break;
+      case NodeType::COMPARE:
+        EvaluateCompare(node, count);
+        break;
+      case NodeType::BETWEEN:
+        EvaluateBetween(node, count);
+        break;
+      case NodeType::NULL_TEST:
+      case NodeType::AND:
+      case NodeType::OR:
+      case NodeType::NOT:
+        EvaluateLogic(node, count);
+        break;
+    }
+  }
+  selection.resize(count);
+  selection.resize(VectorKernels::ToSelection(nodes_.back().true_.data(), count, selection.data()));
+}
+
+std::optional<size_t> VectorPredicate::CompilePredicate(const std::shared_ptr<OperatorExpression> &expr) {
+  switch (expr->GetExprType()) {
+    case OperatorExpressionType::COMPARISON: {
+      auto comparison = std::dynamic_pointer_cast<Comparison>(expr);
+      auto type = comparison->GetComparisonType();
+      if (type == ComparisonType::BETWEEN || type == ComparisonType::NOT_BETWEEN) {
+        auto list = std::dynamic_pointer_cast<List>(comparison->children_[1]);
+        if (list == nullptr || list->exprs_.size() != 2) {
+          return std::nullopt;
+        }
+        auto value = CompileValue(comparison->children_[0]);
+        auto low = GetNumericConst(list->exprs_[0]);
+        auto high = GetNumericConst(list->exprs_[1]);
+        if (!value || low == nullptr || high == nullptr || nodes_[*value].value_type_ == Type::UINT) {
+          return std::nullopt;
+        }
+        auto value_type = nodes_[*value].value_type_;
+        if (low->GetType() != value_type || high->GetType() != value_type) {
+          return std::nullopt;
+        }
+        Node node{NodeType::BETWEEN, value_type, *value};
+        node.negated_ = type == ComparisonType::NOT_BETWEEN;
+        node.low_ = *low;
+        node.high_ = *high;
+        return AddNode(std::move(node));
+      }
+      if (!IsSimpleComparison(type)) {
+        return std::nullopt;
+      }
+      // 常量在左侧时交换左右两侧
+      auto lhs = comparison->children_[0];
+      auto rhs = comparison->children_[1];
+      if (GetNumericConst(lhs) != nullptr && GetNumericConst(rhs) == nullptr) {
+        std::swap(lhs, rhs);
+        type = Flip(type);
+      }
+      auto constant = GetNumericConst(rhs);
+      auto value = CompileValue(lhs);
+      if (constant == nullptr || !value || constant->GetType() != nodes_[*value].value_type_) {
+        return std::nullopt;
+      }
+      Node node{NodeType::COMPARE, constant->GetType(), *value};
+      node.comparison_ = type;
+      node.low_ = *constant;
+      return AddNode(std::move(node));
+    }
+    case OperatorExpressionType::NULL_TEST: {
+      auto null_test = std::dynamic_pointer_cast<NullTest>(expr);
+      auto value = CompileValue(null_test->arg_);
+      if (!value) {
+        return std::nullopt;
+      }
+      Node node{NodeType::NULL_TEST, Type::BOOL, *value};
+      node.negated_ = !null_test->is_null_;
+      return AddNode(std::move(node));
+    }
+    case OperatorExpressionType::LOGIC: {
+      auto logic = std::dynamic_pointer_cast<Logic>(expr);
+      auto lhs = CompilePredicate(logic->children_[0]);
+      if (!lhs) {
+        return std::nullopt;
+      }
+      if (logic->GetLogicType() == LogicType::NOT) {
+        return AddNode({NodeType::NOT, Type::BOOL, *lhs});
+      }
+      auto rhs = CompilePredicate(logic->children_[1]);
+      if (!rhs) {
+        return std::nullopt;
+      }
+      return AddNode({logic->GetLogicType() == LogicType::AND ? NodeType::AND : NodeType::OR, Type::BOOL, *lhs, *rhs});
+    }
+    default:
+      return std::nullopt;
+  }
+}
+
+std::optional<size_t> VectorPredicate::CompileValue(const std::shared_ptr<OperatorExpression> &expr) {
+  switch (expr->GetExprType()) {
+    case OperatorExpressionType::COLUMN_VALUE: {
+      // 非数值类型的列只读取是否为空值，用于 IS [NOT] NULL
+      auto column = std::dynamic_pointer_cast<ColumnValue>(expr);
+      Node node{NodeType::COLUMN, column->GetValueType()};
+      node.column_ = column->GetColumnIndex();
+      return AddNode(std::move(node));
+    }
+    case OperatorExpressionType::CONST: {
+      auto constant = GetNumericConst(expr);
+      if (constant == nullptr) {
+        return std::nullopt;
+      }
+      Node node{NodeType::CONST, constant->GetType()};
+      node.low_ = *constant;
+      return AddNode(std::move(node));
+    }
+    case OperatorExpressionType::ARITHMETIC: {
+      auto arithmetic = std::dynamic_pointer_cast<Arithmetic>(expr);
+      auto lhs = CompileValue(arithmetic->children_[0]);
+      auto rhs = CompileValue(arithmetic->children_[1]);
+      if (!lhs || !rhs) {
+        return std::nullopt;
+      }
+      auto value_type = nodes_[*lhs].value_type_;
+      if ((value_type != Type::INT && value_type != Type::DOUBLE) || nodes_[*rhs].value_type_ != value_type) {
+        return std::nullopt;
+      }
+      Node node{NodeType::ARITHMETIC, value_type, *lhs, *rhs};
+      node.arithmetic_ = arithmetic->GetArithmeticType();
+      return AddNode(std::move(node));
+    }
+    default:
+      return std::nullopt;
+  }
+}
+
+size_t VectorPredicate::AddNode(Node node) {
+  nodes_.push_back(std::move(node));
+  return nodes_.size() - 1;
+}
+
+void VectorPredicate::EvaluateColumn(Node &node, const std::vector<std::shared_ptr<Record>> &records) {
+  auto count = records.size();
+  node.valid_.assign(VectorKernels::MaskWords(count), 0);
+  switch (node.value_type_) {
+    case Type::INT:
+      node.ints_.resize(count);
+      break;
+    case Type::UINT:
+      node.uints_.resize(count);
+      break;
+    case Type::DOUBLE:
+      node.doubles_.resize(count);
+      break;
+    default:
+      break;
+  }
+  for (size_t i = 0; i < count; i++) {
+    const auto &value = records[i]->GetValues()[node.column_];
+    if (value.IsNull()) {
+      // 空值所在的行只需保证数据可以安全参与计算
+      switch (node.value_type_) {
+        case Type::INT:
+          node.ints_[i] = 0;
+          break;
+        case Type::UINT:
+          node.uints_[i] = 0;
+          break;
+        case Type::DOUBLE:
+          node.doubles_[i] = 0;
+          break;
+        default:
+          break;
+      }
+      continue;
+    }
+    SetBit(node.valid_, i);
+    switch (node.value_type_) {
+      case Type::INT:
+        node.ints_[i] = value.GetValue<int32_t>();
+        break;
+      case Type::UINT:
+        node.uints_[i] = value.GetValue<uint32_t>();
+        break;
+      case Type::DOUBLE:
+        node.doubles_[i] = value.GetValue<double>();
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+void VectorPredicate::EvaluateConst(Node &node, size_t count) {
+  node.valid_ = all_ones_;
+  switch (node.value_type_) {
+    case Type::INT:
+      node.ints_.assign(count, node.low_.GetValue<int32_t>());
+      break;
+    case Type::UINT:
+      node.uints_.assign(count, node.low_.GetValue<uint32_t>());
+      break;
+    default:
+      node.doubles_.assign(count, node.low_.GetValue<double>());
+      break;
+  }
+}
+
+void VectorPredicate::EvaluateArithmetic(Node &node, size_t count) {
+  const auto &lhs = nodes_[node.lhs_];
+  const auto &rhs = nodes_[node.rhs_];
+  node.valid_.resize(lhs.valid_.size());
+  VectorKernels::And(lhs.valid_.data(), rhs.valid_.data(), node.valid_.size(), node.valid_.data());
+  if (node.value_type_ == Type::INT) {
+    node.ints_.resize(count);
+    VectorKernels::Compute(node.arithmetic_, lhs.ints_.data(), rhs.ints_.data(), count, node.valid_.data(),
+                           node.ints_.data());
+  } else {
+    node.doubles_.resize(count);
+    VectorKernels::Compute(node.arithmetic_, lhs.doubles_.data(), rhs.doubles_.data(), count, node.valid_.data(),
+                           node.doubles_.data());
+  }
+}
+
+void VectorPredicate::EvaluateCompare(Node &node, size_t count) {
+  const auto &value = nodes_[node.lhs_];
+  node.valid_ = value.valid_;
+  node.true_.resize(node.valid_.size());
+  switch (node.value_type_) {
+    case Type::INT:
+      VectorKernels::Compare(node.comparison_, value.ints_.data(), count, node.low_.GetValue<int32_t>(),
+                             node.true_.data());
+      break;
+    case Type::UINT:
+      VectorKernels::Compare(node.comparison_, value.uints_.data(), count, node.low_.GetValue<uint32_t>(),
+                             node.true_.data());
+      break;
+    default:
+      VectorKernels::Compare(node.comparison_, value.doubles_.data(), count, node.low_.GetValue<double>(),
+                             node.true_.data());
+      break;
+  }
+  VectorKernels::And(node.true_.data(), node.valid_.data(), node.true_.size(), node.true_.data());
+}
+
+void VectorPredicate::EvaluateBetween(Node &node, size_t count) {
+  const auto &value = nodes_[node.lhs_];
+  node.valid_ = value.valid_;
+  node.true_.resize(node.valid_.size());
+  if (node.value_type_ == Type::INT) {
+    VectorKernels::Between(value.ints_.data(), count, node.low_.GetValue<int32_t>(), node.high_.GetValue<int32_t>(),
+                           node.true_.data());
+  } else {
+    VectorKernels::Between(value.doubles_.data(), count, node.low_.GetValue<double>(),
+                           node.high_.GetValue<double>(), node.true_.data());
+  }
+  if (node.negated_) {
+    VectorKernels::AndNot(node.valid_.data(), node.true_.data(), node.true_.size(), node.true_.data());
+  } else {
+    VectorKernels::And(node.true_.data(), node.valid_.data(), node.true_.size(), node.true_.data());
+  }
+}
+
+void VectorPredicate::EvaluateLogic(Node &node, size_t count) {
+  // 与逐行求值一致：任一操作数为空值时结果为空值
+  const auto &lhs = nodes_[node.lhs_];
+  auto words = all_ones_.size();
+  node.true_.resize(words);
+  switch (node.type_) {
+    case NodeType::NULL_TEST:
+      node.valid_ = all_ones_;
+      if (node.negated_) {
+        node.true_ = lhs.valid_;
+      } else {
+        VectorKernels::AndNot(all_ones_.data(), lhs.valid_.data(), words, node.true_.data());
+      }
+      break;
+    case NodeType::NOT:
+      node.valid_ = lhs.valid_;
+      VectorKernels::AndNot(lhs.valid_.data(), lhs.true_.data(), words, node.true_.data());
+      break;
+    case NodeType::AND:
+    case NodeType::OR: {
+      const auto &rhs = nodes_[node.rhs_];
+      node.valid_.resize(words);
+      VectorKernels::And(lhs.valid_.data(), rhs.valid_.data(), words, node.valid_.data());
+      if (node.type_ == NodeType::AND) {
+        VectorKernels::And(lhs.true_.data(), rhs.true_.data(), words, node.true_.data());
+      } else {
+        VectorKernels::Or(lhs.true_.data(), rhs.true_.data(), words, node.true_.data());
+        VectorKernels::And(node.true_.data(), node.valid_.data(), words, node.true_.data());
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+}  // namespace huadb
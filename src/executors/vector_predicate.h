@@ -0,0 +1,70 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "operators/expressions/expressions.h"
+#include "table/record.h"
+
+namespace huadb {
+
+// 向量化的过滤条件：将一批记录中用到的列读取为连续的列向量，通过 VectorKernels 按列计算过滤条件，
+// 结果为满足条件的记录下标（选择向量），由上层算子按下标输出记录
+// 支持 INT、UINT、DOUBLE 类型的列、常量及其算术运算与常量的比较、BETWEEN、IS [NOT] NULL，以及 AND、OR、NOT 的组合
+class VectorPredicate {
+ public:
+  // 过滤条件中含有不支持的表达式时返回 nullptr，此时应逐行求值
+  static std::unique_ptr<VectorPredicate> Compile(const std::shared_ptr<OperatorExpression> &expr);
+
+  // 计算 records 中满足条件（结果为 true）的记录下标，按升序写入 selection
+  void Select(const std::vector<std::shared_ptr<Record>> &records, std::vector<uint32_t> &selection);
+
+ private:
+  enum class NodeType { COLUMN, CONST, ARITHMETIC, COMPARE, BETWEEN, NULL_TEST, AND, OR, NOT };
+
+  // 节点按后序排列，求值时依次计算
+  // 数值节点（COLUMN、CONST、ARITHMETIC）的结果为列向量，条件节点的结果为 true 位图；两者均带有非空位图 valid_
+  struct Node {
+    NodeType type_;
+    // 数值节点的类型，或比较的操作数类型
+    Type value_type_ = Type::NULL_TYPE;
+    size_t lhs_ = 0;
+    size_t rhs_ = 0;
+    // COLUMN 的列下标
+    size_t column_ = 0;
+    ComparisonType comparison_ = ComparisonType::EQUAL;
+    ArithmeticType arithmetic_ = ArithmeticType::ADD;
+    // NOT BETWEEN 或 IS NOT NULL
+    bool negated_ = false;
+    // CONST 的值、比较的常量或 BETWEEN 的下界，以及 BETWEEN 的上界
+    Value low_;
+    Value high_;
+
+    std::vector<int32_t> ints_;
+    std::vector<uint32_t> uints_;
+    std::vector<double> doubles_;
+    std::vector<uint64_t> valid_;
+    std::vector<uint64_t> true_;
+  };
+
+  VectorPredicate() = default;
+
+  // 编译条件表达式或数值表达式，返回结果所在的节点下标；不支持时返回 std::nullopt
+  std::optional<size_t> CompilePredicate(const std::shared_ptr<OperatorExpression> &expr);
+  std::optional<size_t> CompileValue(const std::shared_ptr<OperatorExpression> &expr);
+  size_t AddNode(Node node);
+
+  void EvaluateColumn(Node &node, const std::vector<std::shared_ptr<Record>> &records);
+  void EvaluateConst(Node &node, size_t count);
+  void EvaluateArithmetic(Node &node, size_t count);
+  void EvaluateCompare(Node &node, size_t count);
+  void EvaluateBetween(Node &node, size_t count);
+  void EvaluateLogic(Node &node, size_t count);
+
+  std::vector<Node> nodes_;
+  // 长度为当前批次大小、全部为 1 的位图
+  std::vector<uint64_t> all_ones_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,292 @@
+#include <cmath>
+#include <cstdio>
+
+#include "common/exceptions.h"
+#include "common/string_util.h"
+#include "fmt/format.h"
+#include "function/function_registry.h"
+
+namespace huadb {
+
+namespace {
+
+// 单参数函数：由类型确定的运算 Op 生成标量实现和批量实现，参数为空值时结果为空值
+template <typename T, typename R, R (*Op)(T)>
+Value Unary(const std::vector<Value> &args) {
+  if (args[0].IsNull()) {
+    return Value();
+  }
+  return Value(Op(args[0].GetValue<T>()));
+}
+
+template <typename T, typename R, R (*Op)(T)>
+void UnaryBatch(const std::vector<std::vector<Value>> &args, std::vector<Value> &result) {
+  const auto &input = args[0];
+  result.clear();
+  result.reserve(input.size());
+  for (const auto &value : input) {
+    result.push_back(value.IsNull() ? Value() : Value(Op(value.GetValue<T>())));
+  }
+}
+
+// 多参数函数：任一参数为空值时结果为空值，否则调用 Kernel
+template <Value (*Kernel)(const std::vector<Value> &)>
+Value Strict(const std::vector<Value> &args) {
+  for (const auto &arg : args) {
+    if (arg.IsNull()) {
+      return Value();
+    }
+  }
+  return Kernel(args);
+}
+
+template <Value (*Kernel)(const std::vector<Value> &)>
+void StrictBatch(const std::vector<std::vector<Value>> &args, std::vector<Value> &result) {
+  size_t count = args.empty() ? 0 : args[0].size();
+  result.clear();
+  result.reserve(count);
+  std::vector<Value> row(args.size());
+  for (size_t i = 0; i < count; i++) {
+    for (size_t j = 0; j < args.size(); j++) {
+      row[j] = args[j][i];
+    }
+    result.push_back(Strict<Kernel>(row));
+  }
+}
+
+// UTF-8 编码中，除首字节外的字节形如 10xxxxxx
+bool IsContinuationByte(char byte) { return (static_cast<unsigned char>(byte) & 0xC0) == 0x80; }
+
+std::string Lower(std::string str) { return StringUtil::Lower(str); }
+
+std::string Upper(std::string str) { return StringUtil::Upper(str); }
+
+// 字符数目（按 UTF-8 编码的字符计算）
+int32_t Length(std::string str) {
+  int32_t length = 0;
+  for (char byte : str) {
+    if (!IsContinuationByte(byte)) {
+      length++;
+    }
+  }
+  return length;
+}
+
+int32_t AbsInt(int32_t value) {
+  // INT32_MIN 的绝对值超出 int32_t 的表示范围
+  if (value == INT32_MIN) {
+    throw DbException("integer out of range");
+  }
+  return value < 0 ? -value : value;
+}
+
+double AbsDouble(double value) { return std::fabs(value); }
+
+int32_t RoundInt(int32_t value) { return value; }
+
+double RoundDouble(double value) { return std::round(value); }
+
+Value RoundDigits(const std::vector<Value> &args) {
+  double value = args[0].GetValue<double>();
+  double scale = std::pow(10.0, args[1].GetValue<int32_t>());
+  if (std::isinf(scale)) {
+    throw DbException("integer out of range");
+  }
+  // 保留的位数超过 double 的精度时无需舍入；舍入到的位数高于 double 的范围时结果为 0
+  if (std::isinf(value * scale)) {
+    return Value(value);
+  }
+  if (scale == 0) {
+    return Value(0.0);
+  }
+  return Value(std::round(value * scale) / scale);
+}
+
+// substring(str, start[, count])：位置从 1 开始，按字符计算；start 小于 1 时，count 仍从 start 开始计算
+Value Substring(const std::vector<Value> &args) {
+  auto str = args[0].GetValue<std::string>();
+  int64_t start = args[1].GetValue<int32_t>();
+  int64_t end = INT64_MAX;
+  if (args.size() > 2) {
+    int64_t count = args[2].GetValue<int32_t>();
+    if (count < 0) {
+      throw DbException("negative substring length not allowed");
+    }
+    end = start + count;
+  }
+  std::string result;
+  int64_t position = 0;
+  for (char byte : str) {
+    if (!IsContinuationByte(byte)) {
+      position++;
+    }
+    if (position >= start && position < end) {
+      result.push_back(byte);
+    }
+  }
+  return Value(std::move(result));
+}
+
+// 返回第一个非空参数
+Value Coalesce(const std::vector<Value> &args) {
+  for (const auto &arg : args) {
+    if (!arg.IsNull()) {
+      return arg;
+    }
+  }
+  return Value();
+}
+
+void CoalesceBatch(const std::vector<std::vector<Value>> &args, std::vector<Value> &result) {
+  size_t count = args.empty() ? 0 : args[0].size();
+  result.assign(count, Value());
+  for (size_t i = 0; i < count; i++) {
+    for (const auto &arg : args) {
+      if (!arg[i].IsNull()) {
+        result[i] = arg[i];
+        break;
+      }
+    }
+  }
+}
+
+// 系统中没有日期类型，日期函数处理形如 YYYY-MM-DD 或 YYYY-MM-DD HH:MM:SS 的字符串
+struct Date {
+  int32_t year_;
+  int32_t month_;
+  int32_t day_;
+  int32_t hour_ = 0;
+  int32_t minute_ = 0;
+  int32_t second_ = 0;
+};
+
+bool IsLeapYear(int32_t year) { return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0; }
+
+int32_t DaysInMonth(int32_t year, int32_t month) {
+  static constexpr int32_t DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return month == 2 && IsLeapYear(year) ? 29 : DAYS[month - 1];
+}
+
+bool IsValidDate(const Date &date) {
+  return date.month_ >= 1 && date.month_ <= 12 && date.day_ >= 1 &&
+         date.day_ <= DaysInMonth(date.year_, date.month_) && date.hour_ >= 0 && date.hour_ < 24 &&
+         date.minute_ >= 0 && date.minute_ < 60 && date.second_ >= 0 && date.second_ < 60;
+}
+
+Date ParseDate(const std::string &str) {
+  Date date{};
+  int consumed = 0;
+  int fields = std::sscanf(str.c_str(), "%d-%d-%d%n", &date.year_, &date.month_, &date.day_, &consumed);
+  if (fields == 3 && static_cast<size_t>(consumed) < str.size()) {
+    int time_consumed = 0;
+    fields += std::sscanf(str.c_str() + consumed, " %d:%d:%d%n", &date.hour_, &date.minute_, &date.second_,
+                          &time_consumed);
+    consumed += time_consumed;
+  }
+  if ((fields != 3 && fields != 6) || static_cast<size_t>(consumed) != str.size() || !IsValidDate(date)) {
+    throw DbException("invalid input syntax for type date: " + str);
+  }
+  return date;
+}
+
+// 距 1970-01-01 的天数
+int64_t DaysFromCivil(int32_t year, int32_t month, int32_t day) {
+  year -= month <= 2 ? 1 : 0;
+  int64_t era = (year >= 0 ? year : year - 399) / 400;
+  int64_t year_of_era = year - era * 400;
+  int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468;
+}
+
+// date_part(field, date)：field 为 year、month、day、hour、minute、second、dow（周日为 0）或 doy
+Value DatePart(const std::vector<Value> &args) {
+  auto field = StringUtil::Lower(args[0].GetValue<std::string>());
+  auto date = ParseDate(args[1].GetValue<std::string>());
+  if (field == "year") {
+    return Value(date.year_);
+  } else if (field == "month") {
+    return Value(date.month_);
+  } else if (field == "day") {
+    return Value(date.day_);
+  } else if (field == "hour") {
+    return Value(date.hour_);
+  } else if (field == "minute") {
+    return Value(date.minute_);
+  } else if (field == "second") {
+    return Value(date.second_);
+  } else if (field == "dow") {
+    auto days = DaysFromCivil(date.year_, date.month_, date.day_);
+    return Value(static_cast<int32_t>(((days + 4) % 7 + 7) % 7));
+  } else if (field == "doy") {
+    auto days = DaysFromCivil(date.year_, date.month_, date.day_) - DaysFromCivil(date.year_, 1, 1);
+    return Value(static_cast<int32_t>(days + 1));
+  }
+  throw DbException("unit \"" + field + "\" not recognized for date_part");
+}
+
+// make_date(year, month, day)：返回 YYYY-MM-DD 格式的字符串
+Value MakeDate(const std::vector<Value> &args) {
+  Date date{args[0].GetValue<int32_t>(), args[1].GetValue<int32_t>(), args[2].GetValue<int32_t>()};
+  if (!IsValidDate(date)) {
+    throw DbException(fmt::format("date field value out of range: {}-{}-{}", date.year_, date.month_, date.day_));
+  }
+  return Value(fmt::format("{:04}-{:02}-{:02}", date.year_, date.month_, date.day_));
+}
+
+}  // namespace
+
+void RegisterBuiltinFunctions(FunctionRegistry &registry) {
+  constexpr auto STRING = Type::VARCHAR;
+  constexpr auto INT = Type::INT;
+  constexpr auto DOUBLE = Type::DOUBLE;
+
+  // 字符串函数
+  registry.Register("lower", {{STRING},
+                              false,
+                              STRING,
+                              Unary<std::string, std::string, Lower>,
+                              UnaryBatch<std::string, std::string, Lower>});
+  registry.Register("upper", {{STRING},
+                              false,
+                              STRING,
+                              Unary<std::string, std::string, Upper>,
+                              UnaryBatch<std::string, std::string, Upper>});
+  registry.Register("length", {{STRING},
+                               false,
+                               INT,
+                               Unary<std::string, int32_t, Length>,
+                               UnaryBatch<std::string, int32_t, Length>});
+  registry.Register("substring", {{STRING, INT}, false, STRING, Strict<Substring>, StrictBatch<Substring>});
+  registry.Register("substring", {{STRING, INT, INT}, false, STRING, Strict<Substring>, StrictBatch<Substring>});
+
+  // 数学函数
+  registry.Register("abs", {{INT}, false, INT, Unary<int32_t, int32_t, AbsInt>, UnaryBatch<int32_t, int32_t, AbsInt>});
+  registry.Register("abs", {{DOUBLE},
+                            false,
+                            DOUBLE,
+                            Unary<double, double, AbsDouble>,
+                            UnaryBatch<double, double, AbsDouble>});
+  registry.Register("round", {{INT},
+                              false,
+                              INT,
+                              Unary<int32_t, int32_t, RoundInt>,
+                              UnaryBatch<int32_t, int32_t, RoundInt>});
+  registry.Register("round", {{DOUBLE},
+                              false,
+                              DOUBLE,
+                              Unary<double, double, RoundDouble>,
+                              UnaryBatch<double, double, RoundDouble>});
+  registry.Register("round", {{DOUBLE, INT}, false, DOUBLE, Strict<RoundDigits>, StrictBatch<RoundDigits>});
+
+  // 条件函数，参数需为同一类型
+  for (auto type : {INT, DOUBLE, STRING, Type::BOOL}) {
+    registry.Register("coalesce", {{type}, true, type, Coalesce, CoalesceBatch});
+  }
+
+  // 日期函数
+  registry.Register("date_part", {{STRING, STRING}, false, INT, Strict<DatePart>, StrictBatch<DatePart>});
+  registry.Register("make_date", {{INT, INT, INT}, false, STRING, Strict<MakeDate>, StrictBatch<MakeDate>});
+}
+
+}  // namespace huadb
@@ -0,0 +1,60 @@
+#include "function/function_registry.h"
+
+#include <algorithm>
+
+#include "common/exceptions.h"
+#include "common/type_util.h"
+#include "fmt/format.h"
+#include "fmt/ranges.h"
+
+namespace huadb {
+
+const FunctionRegistry &FunctionRegistry::GetInstance() {
+  static const FunctionRegistry registry;
+  return registry;
+}
+
+FunctionRegistry::FunctionRegistry() { RegisterBuiltinFunctions(*this); }
+
+const FunctionOverload &FunctionRegistry::Resolve(const std::string &name, const std::vector<Type> &arg_types) const {
+  auto iterator = functions_.find(name);
+  if (iterator == functions_.end()) {
+    throw DbException("Unknown function name " + name);
+  }
+  for (const auto &overload : iterator->second) {
+    if (Matches(overload, arg_types)) {
+      return overload;
+    }
+  }
+  std::vector<std::string> type_names;
+  for (auto type : arg_types) {
+    type_names.push_back(TypeUtil::Type2String(type));
+  }
+  throw DbException(fmt::format("Argument mismatch for function {}({})", name, fmt::join(type_names, ", ")));
+}
+
+bool FunctionRegistry::Contains(const std::string &name) const { return functions_.count(name) > 0; }
+
+void FunctionRegistry::Register(const std::string &name, FunctionOverload overload) {
+  functions_[name].push_back(std::move(overload));
+}
+
+bool FunctionRegistry::Matches(const FunctionOverload &overload, const std::vector<Type> &arg_types) {
+  const auto &params = overload.arg_types_;
+  if (overload.variadic_ ? arg_types.size() < params.size() : arg_types.size() != params.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < arg_types.size(); i++) {
+    auto param = params[std::min(i, params.size() - 1)];
+    auto type = arg_types[i];
+    if (TypeUtil::IsString(type)) {
+      type = Type::VARCHAR;
+    }
+    if (type != Type::NULL_TYPE && type != param) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace huadb
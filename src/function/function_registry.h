@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/value.h"
+
+namespace huadb {
+
+// 标量实现：根据一行的参数计算结果
+using ScalarFunction = Value (*)(const std::vector<Value> &args);
+// 批量实现：args[i] 为一批记录的第 i 个参数，每行的结果依次写入 result
+using BatchFunction = void (*)(const std::vector<std::vector<Value>> &args, std::vector<Value> &result);
+
+// 函数的一个重载
+struct FunctionOverload {
+  // 参数类型，CHAR 与 VARCHAR 均用 VARCHAR 表示
+  std::vector<Type> arg_types_;
+  // 为 true 时最后一个参数可以重复任意次
+  bool variadic_;
+  Type return_type_;
+  ScalarFunction scalar_;
+  BatchFunction batch_;
+};
+
+// 内置函数注册表：计划阶段根据函数名和参数类型选择重载，执行时直接调用函数指针
+class FunctionRegistry {
+ public:
+  static const FunctionRegistry &GetInstance();
+
+  // 选择与参数类型匹配的第一个重载，不存在时抛出异常；类型为 NULL_TYPE 的参数（NULL 常量）可以匹配任意类型
+  const FunctionOverload &Resolve(const std::string &name, const std::vector<Type> &arg_types) const;
+  // 判断是否存在该名称的函数
+  bool Contains(const std::string &name) const;
+
+  void Register(const std::string &name, FunctionOverload overload);
+
+ private:
+  FunctionRegistry();
+
+  static bool Matches(const FunctionOverload &overload, const std::vector<Type> &arg_types);
+
+  std::unordered_map<std::string, std::vector<FunctionOverload>> functions_;
+};
+
+// 注册所有内置函数，实现见 builtin_functions.cpp
+void RegisterBuiltinFunctions(FunctionRegistry &registry);
+
+}  // namespace huadb
@@ -0,0 +1,503 @@
+#include "index/b_plus_tree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "common/exceptions.h"
+
+namespace huadb {
+
+BPlusTreeIterator::BPlusTreeIterator(const BPlusTree &tree, std::vector<IndexEntry> entries, size_t pos,
+                                     pageid_t next_page_id)
+    : tree_(tree), entries_(std::move(entries)), pos_(pos), next_page_id_(next_page_id) {}
+
+std::optional<IndexEntry> BPlusTreeIterator::Next() {
+  while (pos_ >= entries_.size()) {
+    if (next_page_id_ == NULL_PAGE_ID) {
+      return std::nullopt;
+    }
+    auto node = tree_.ReadNode(next_page_id_);
+    entries_ = std::move(node.entries_);
+    pos_ = 0;
+    next_page_id_ = node.next_page_id_;
+  }
+  return entries_[pos_++];
+}
+
+BPlusTree::BPlusTree(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, Type key_type,
+                     db_size_t key_size)
+    : buffer_pool_(buffer_pool),
+      log_manager_(log_manager),
+      oid_(oid),
+      db_oid_(db_oid),
+      key_type_(key_type),
+      key_size_(key_size) {
+  if (key_size_ > MAX_INDEX_KEY_SIZE) {
+    throw DbException("Index key size " + std::to_string(key_size_) + " exceeds the maximum " +
+                      std::to_string(MAX_INDEX_KEY_SIZE));
+  }
+}
+
+void BPlusTree::Init(xid_t xid) {
+  pending_pages_.clear();
+  Meta meta{BPLUS_TREE_META_PAGE_ID + 1, BPLUS_TREE_META_PAGE_ID + 1, NULL_PAGE_ID};
+  pending_pages_[BPLUS_TREE_META_PAGE_ID].is_new_ = true;
+  auto root_page_id = AllocatePage(meta);
+  WriteNode(root_page_id, BPlusTreeNode());
+  WriteMeta(meta);
+  Apply(xid);
+}
+
+void BPlusTree::Insert(const Value &key, const Rid &rid, xid_t xid) {
+  if (key.IsNull()) {
+    return;
+  }
+  if (TypeUtil::IsString(key_type_) && key.GetSize() + sizeof(db_size_t) > key_size_) {
+    throw DbException("Index key too long: " + key.ToString());
+  }
+  pending_pages_.clear();
+  IndexEntry entry{key, rid};
+  auto meta = ReadMeta();
+  // 从根节点向下查找叶节点，记录经过的内部节点
+  std::vector<pageid_t> path;
+  auto page_id = meta.root_page_id_;
+  auto node = ReadNode(page_id);
+  while (node.type_ == BPlusTreePageType::INTERNAL) {
+    path.push_back(page_id);
+    page_id = node.children_[ChildIndex(node, entry)];
+    node = ReadNode(page_id);
+  }
+  auto pos = std::lower_bound(node.entries_.begin(), node.entries_.end(), entry, EntryLess);
+  node.entries_.insert(pos, std::move(entry));
+  if (node.entries_.size() <= LeafCapacity()) {
+    WriteNode(page_id, node);
+  } else {
+    // 叶节点分裂，后一半索引项移动到新的右兄弟节点
+    auto mid = node.entries_.size() / 2;
+    BPlusTreeNode right;
+    right.entries_.assign(node.entries_.begin() + mid, node.entries_.end());
+    node.entries_.erase(node.entries_.begin() + mid, node.entries_.end());
+    auto right_page_id = AllocatePage(meta);
+    right.next_page_id_ = node.next_page_id_;
+    node.next_page_id_ = right_page_id;
+    WriteNode(page_id, node);
+    WriteNode(right_page_id, right);
+    InsertIntoParent(meta, path, page_id, right.entries_.front(), right_page_id);
+    WriteMeta(meta);
+  }
+  Apply(xid);
+}
+
+bool BPlusTree::Delete(const Value &key, const Rid &rid, xid_t xid) {
+  if (key.IsNull()) {
+    return false;
+  }
+  pending_pages_.clear();
+  IndexEntry entry{key, rid};
+  auto meta = ReadMeta();
+  std::vector<pageid_t> path;
+  auto page_id = meta.root_page_id_;
+  auto node = ReadNode(page_id);
+  while (node.type_ == BPlusTreePageType::INTERNAL) {
+    path.push_back(page_id);
+    page_id = node.children_[ChildIndex(node, entry)];
+    node = ReadNode(page_id);
+  }
+  auto pos = std::lower_bound(node.entries_.begin(), node.entries_.end(), entry, EntryLess);
+  if (pos == node.entries_.end() || EntryLess(entry, *pos)) {
+    return false;
+  }
+  node.entries_.erase(pos);
+  WriteNode(page_id, node);
+  if (!path.empty() && node.entries_.size() < LeafCapacity() / 2) {
+    Rebalance(meta, path, page_id, std::move(node));
+    WriteMeta(meta);
+  }
+  Apply(xid);
+  return true;
+}
+
+void BPlusTree::BulkLoad(const std::function<std::optional<IndexEntry>()> &next_entry, size_t count,
+                         uint32_t fill_factor, xid_t xid) {
+  pending_pages_.clear();
+  auto meta = ReadMeta();
+  if (count == 0) {
+    return;
+  }
+  // 每一层的节点数由该层的项数和填充率决定，各节点的项数尽量平均，保证最后一个节点不会过小
+  // 一层中的每个节点记录其最小的索引项（作为上层的分隔项）和页面号
+  std::vector<std::pair<IndexEntry, pageid_t>> level;
+  auto leaf_fill = std::max<size_t>(1, LeafCapacity() * fill_factor / 100);
+  auto leaf_count = (count + leaf_fill - 1) / leaf_fill;
+  // 空树的根节点作为第一个叶节点，之后的叶节点依次分配
+  auto page_id = meta.root_page_id_;
+  for (size_t i = 0; i < leaf_count; i++) {
+    BPlusTreeNode leaf;
+    auto size = count / leaf_count + (i < count % leaf_count ? 1 : 0);
+    for (size_t j = 0; j < size; j++) {
+      auto entry = next_entry();
+      if (!entry) {
+        throw DbException("Index bulk load ended early");
+      }
+      leaf.entries_.push_back(std::move(*entry));
+    }
+    auto next_page_id = i + 1 < leaf_count ? AllocatePage(meta) : NULL_PAGE_ID;
+    leaf.next_page_id_ = next_page_id;
+    WriteNode(page_id, leaf);
+    level.emplace_back(leaf.entries_.front(), page_id);
+    page_id = next_page_id;
+    if (pending_pages_.size() >= BULK_LOAD_LOG_PAGES) {
+      Apply(xid);
+    }
+  }
+  // 内部节点至少包含两个孩子
+  auto internal_fill = std::max<size_t>(3, (InternalCapacity() + 1) * fill_factor / 100);
+  while (level.size() > 1) {
+    std::vector<std::pair<IndexEntry, pageid_t>> upper;
+    auto node_count = (level.size() + internal_fill - 1) / internal_fill;
+    size_t pos = 0;
+    for (size_t i = 0; i < node_count; i++) {
+      BPlusTreeNode node;
+      node.type_ = BPlusTreePageType::INTERNAL;
+      auto size = level.size() / node_count + (i < level.size() % node_count ? 1 : 0);
+      for (size_t j = 0; j < size; j++, pos++) {
+        if (j > 0) {
+          node.entries_.push_back(level[pos].first);
+        }
+        node.children_.push_back(level[pos].second);
+      }
+      auto node_page_id = AllocatePage(meta);
+      WriteNode(node_page_id, node);
+      upper.emplace_back(level[pos - size].first, node_page_id);
+      if (pending_pages_.size() >= BULK_LOAD_LOG_PAGES) {
+        Apply(xid);
+      }
+    }
+    level = std::move(upper);
+  }
+  meta.root_page_id_ = level.front().second;
+  WriteMeta(meta);
+  Apply(xid);
+}
+
+BPlusTreeIterator BPlusTree::Begin() const {
+  auto node = ReadNode(ReadMeta().root_page_id_);
+  while (node.type_ == BPlusTreePageType::INTERNAL) {
+    node = ReadNode(node.children_.front());
+  }
+  return {*this, std::move(node.entries_), 0, node.next_page_id_};
+}
+
+BPlusTreeIterator BPlusTree::LowerBound(const Value &key) const {
+  // 使用最小的 rid 查找，定位到键值为 key 的第一个索引项
+  IndexEntry entry{key, Rid{0, 0}};
+  auto node = ReadNode(ReadMeta().root_page_id_);
+  while (node.type_ == BPlusTreePageType::INTERNAL) {
+    node = ReadNode(node.children_[ChildIndex(node, entry)]);
+  }
+  auto pos = std::lower_bound(node.entries_.begin(), node.entries_.end(), entry, EntryLess) - node.entries_.begin();
+  return {*this, std::move(node.entries_), static_cast<size_t>(pos), node.next_page_id_};
+}
+
+uint32_t BPlusTree::GetHeight() const {
+  uint32_t height = 1;
+  auto node = ReadNode(ReadMeta().root_page_id_);
+  while (node.type_ == BPlusTreePageType::INTERNAL) {
+    node = ReadNode(node.children_.front());
+    height++;
+  }
+  return height;
+}
+
+size_t BPlusTree::LeafCapacity() const {
+  return (DB_PAGE_SIZE - BPLUS_TREE_HEADER_SIZE) / (key_size_ + sizeof(pageid_t) + sizeof(slotid_t));
+}
+
+size_t BPlusTree::InternalCapacity() const {
+  return (DB_PAGE_SIZE - BPLUS_TREE_HEADER_SIZE - sizeof(pageid_t)) /
+         (key_size_ + sizeof(pageid_t) + sizeof(slotid_t) + sizeof(pageid_t));
+}
+
+BPlusTree::Meta BPlusTree::ReadMeta() const {
+  // 元信息页面在每次操作时读取，保证故障恢复重做的页面内容可见
+  auto data = ReadPage(BPLUS_TREE_META_PAGE_ID);
+  Meta meta{};
+  size_t offset = sizeof(lsn_t);
+  memcpy(&meta.root_page_id_, data.data() + offset, sizeof(pageid_t));
+  offset += sizeof(pageid_t);
+  memcpy(&meta.page_count_, data.data() + offset, sizeof(pageid_t));
+  offset += sizeof(pageid_t);
+  memcpy(&meta.free_page_id_, data.data() + offset, sizeof(pageid_t));
+  return meta;
+}
+
+void BPlusTree::WriteMeta(const Meta &meta) {
+  auto &pending = pending_pages_[BPLUS_TREE_META_PAGE_ID];
+  pending.data_.assign(DB_PAGE_SIZE, 0);
+  size_t offset = sizeof(lsn_t);
+  memcpy(pending.data_.data() + offset, &meta.root_page_id_, sizeof(pageid_t));
+  offset += sizeof(pageid_t);
+  memcpy(pending.data_.data() + offset, &meta.page_count_, sizeof(pageid_t));
+  offset += sizeof(pageid_t);
+  memcpy(pending.data_.data() + offset, &meta.free_page_id_, sizeof(pageid_t));
+}
+
+BPlusTreeNode BPlusTree::ReadNode(pageid_t page_id) const {
+  auto data = ReadPage(page_id);
+  BPlusTreeNode node;
+  uint16_t type, count;
+  size_t offset = sizeof(lsn_t);
+  memcpy(&type, data.data() + offset, sizeof(type));
+  offset += sizeof(type);
+  memcpy(&count, data.data() + offset, sizeof(count));
+  offset += sizeof(count);
+  memcpy(&node.next_page_id_, data.data() + offset, sizeof(pageid_t));
+  offset += sizeof(pageid_t);
+  node.type_ = static_cast<BPlusTreePageType>(type);
+  bool is_internal = node.type_ == BPlusTreePageType::INTERNAL;
+  if (is_internal) {
+    pageid_t child;
+    memcpy(&child, data.data() + offset, sizeof(child));
+    offset += sizeof(child);
+    node.children_.push_back(child);
+  }
+  node.entries_.reserve(count);
+  for (uint16_t i = 0; i < count; i++) {
+    IndexEntry entry{Value(key_type_, key_size_), Rid{}};
+    entry.key_.DeserializeFrom(data.data() + offset);
+    offset += key_size_;
+    memcpy(&entry.rid_.page_id_, data.data() + offset, sizeof(pageid_t));
+    offset += sizeof(pageid_t);
+    memcpy(&entry.rid_.slot_id_, data.data() + offset, sizeof(slotid_t));
+    offset += sizeof(slotid_t);
+    node.entries_.push_back(std::move(entry));
+    if (is_internal) {
+      pageid_t child;
+      memcpy(&child, data.data() + offset, sizeof(child));
+      offset += sizeof(child);
+      node.children_.push_back(child);
+    }
+  }
+  return node;
+}
+
+void BPlusTree::WriteNode(pageid_t page_id, const BPlusTreeNode &node) {
+  auto &pending = pending_pages_[page_id];
+  pending.data_.assign(DB_PAGE_SIZE, 0);
+  char *data = pending.data_.data();
+  auto type = static_cast<uint16_t>(node.type_);
+  auto count = static_cast<uint16_t>(node.entries_.size());
+  size_t offset = sizeof(lsn_t);
+  memcpy(data + offset, &type, sizeof(type));
+  offset += sizeof(type);
+  memcpy(data + offset, &count, sizeof(count));
+  offset += sizeof(count);
+  memcpy(data + offset, &node.next_page_id_, sizeof(pageid_t));
+  offset += sizeof(pageid_t);
+  bool is_internal = node.type_ == BPlusTreePageType::INTERNAL;
+  if (is_internal) {
+    memcpy(data + offset, &node.children_[0], sizeof(pageid_t));
+    offset += sizeof(pageid_t);
+  }
+  for (size_t i = 0; i < node.entries_.size(); i++) {
+    node.entries_[i].key_.SerializeTo(data + offset);
+    offset += key_size_;
+    memcpy(data + offset, &node.entries_[i].rid_.page_id_, sizeof(pageid_t));
+    offset += sizeof(pageid_t);
+    memcpy(data + offset, &node.entries_[i].rid_.slot_id_, sizeof(slotid_t));
+    offset += sizeof(slotid_t);
+    if (is_internal) {
+      memcpy(data + offset, &node.children_[i + 1], sizeof(pageid_t));
+      offset += sizeof(pageid_t);
+    }
+  }
+  assert(offset <= DB_PAGE_SIZE);
+}
+
+std::vector<char> BPlusTree::ReadPage(pageid_t page_id) const {
+  auto pending = pending_pages_.find(page_id);
+  if (pending != pending_pages_.end()) {
+    return pending->second.data_;
+  }
+  auto page = buffer_pool_.GetPage(db_oid_, oid_, page_id);
+  return {page->GetData(), page->GetData() + DB_PAGE_SIZE};
+}
+
+pageid_t BPlusTree::AllocatePage(Meta &meta) {
+  if (meta.free_page_id_ != NULL_PAGE_ID) {
+    auto page_id = meta.free_page_id_;
+    meta.free_page_id_ = ReadNode(page_id).next_page_id_;
+    return page_id;
+  }
+  auto page_id = meta.page_count_++;
+  pending_pages_[page_id].is_new_ = true;
+  return page_id;
+}
+
+void BPlusTree::FreePage(Meta &meta, pageid_t page_id) {
+  BPlusTreeNode node;
+  node.type_ = BPlusTreePageType::FREE;
+  node.next_page_id_ = meta.free_page_id_;
+  WriteNode(page_id, node);
+  meta.free_page_id_ = page_id;
+}
+
+void BPlusTree::InsertIntoParent(Meta &meta, std::vector<pageid_t> &path, pageid_t left_page_id,
+                                 IndexEntry separator, pageid_t right_page_id) {
+  while (true) {
+    if (path.empty()) {
+      // 根节点分裂，树高加一
+      BPlusTreeNode root;
+      root.type_ = BPlusTreePageType::INTERNAL;
+      root.entries_.push_back(std::move(separator));
+      root.children_ = {left_page_id, right_page_id};
+      auto root_page_id = AllocatePage(meta);
+      WriteNode(root_page_id, root);
+      meta.root_page_id_ = root_page_id;
+      return;
+    }
+    auto parent_page_id = path.back();
+    path.pop_back();
+    auto parent = ReadNode(parent_page_id);
+    auto idx = std::find(parent.children_.begin(), parent.children_.end(), left_page_id) - parent.children_.begin();
+    parent.entries_.insert(parent.entries_.begin() + idx, std::move(separator));
+    parent.children_.insert(parent.children_.begin() + idx + 1, right_page_id);
+    if (parent.entries_.size() <= InternalCapacity()) {
+      WriteNode(parent_page_id, parent);
+      return;
+    }
+    // 内部节点分裂，中间的索引项上移到父节点
+    auto mid = parent.entries_.size() / 2;
+    BPlusTreeNode sibling;
+    sibling.type_ = BPlusTreePageType::INTERNAL;
+    sibling.entries_.assign(parent.entries_.begin() + mid + 1, parent.entries_.end());
+    sibling.children_.assign(parent.children_.begin() + mid + 1, parent.children_.end());
+    separator = std::move(parent.entries_[mid]);
+    parent.entries_.erase(parent.entries_.begin() + mid, parent.entries_.end());
+    parent.children_.erase(parent.children_.begin() + mid + 1, parent.children_.end());
+    auto sibling_page_id = AllocatePage(meta);
+    WriteNode(parent_page_id, parent);
+    WriteNode(sibling_page_id, sibling);
+    left_page_id = parent_page_id;
+    right_page_id = sibling_page_id;
+  }
+}
+
+void BPlusTree::Rebalance(Meta &meta, std::vector<pageid_t> &path, pageid_t page_id, BPlusTreeNode node) {
+  while (!path.empty()) {
+    bool is_leaf = node.type_ == BPlusTreePageType::LEAF;
+    auto capacity = is_leaf ? LeafCapacity() : InternalCapacity();
+    if (node.entries_.size() >= capacity / 2) {
+      return;
+    }
+    auto parent_page_id = path.back();
+    path.pop_back();
+    auto parent = ReadNode(parent_page_id);
+    size_t idx = std::find(parent.children_.begin(), parent.children_.end(), page_id) - parent.children_.begin();
+    // 优先与左兄弟处理，sep_idx 为两个节点之间的分隔项下标
+    size_t sep_idx = idx > 0 ? idx - 1 : idx;
+    auto left_page_id = parent.children_[sep_idx];
+    auto right_page_id = parent.children_[sep_idx + 1];
+    auto left = left_page_id == page_id ? std::move(node) : ReadNode(left_page_id);
+    auto right = right_page_id == page_id ? std::move(node) : ReadNode(right_page_id);
+
+    if (left.entries_.size() + right.entries_.size() + (is_leaf ? 0 : 1) <= capacity) {
+      // 合并到左节点，释放右节点
+      if (is_leaf) {
+        left.next_page_id_ = right.next_page_id_;
+      } else {
+        left.entries_.push_back(parent.entries_[sep_idx]);
+        left.children_.insert(left.children_.end(), right.children_.begin(), right.children_.end());
+      }
+      left.entries_.insert(left.entries_.end(), right.entries_.begin(), right.entries_.end());
+      WriteNode(left_page_id, left);
+      FreePage(meta, right_page_id);
+      parent.entries_.erase(parent.entries_.begin() + sep_idx);
+      parent.children_.erase(parent.children_.begin() + sep_idx + 1);
+      if (path.empty() && parent.entries_.empty()) {
+        // 根节点只剩一个孩子，树高减一
+        meta.root_page_id_ = left_page_id;
+        FreePage(meta, parent_page_id);
+        return;
+      }
+      WriteNode(parent_page_id, parent);
+      page_id = parent_page_id;
+      node = std::move(parent);
+      continue;
+    }
+
+    // 兄弟节点的索引项较多，借一个索引项
+    if (left_page_id == page_id) {
+      if (is_leaf) {
+        left.entries_.push_back(right.entries_.front());
+      } else {
+        left.entries_.push_back(parent.entries_[sep_idx]);
+        left.children_.push_back(right.children_.front());
+        parent.entries_[sep_idx] = right.entries_.front();
+        right.children_.erase(right.children_.begin());
+      }
+      right.entries_.erase(right.entries_.begin());
+      if (is_leaf) {
+        parent.entries_[sep_idx] = right.entries_.front();
+      }
+    } else {
+      if (is_leaf) {
+        right.entries_.insert(right.entries_.begin(), left.entries_.back());
+        parent.entries_[sep_idx] = right.entries_.front();
+      } else {
+        right.entries_.insert(right.entries_.begin(), parent.entries_[sep_idx]);
+        right.children_.insert(right.children_.begin(), left.children_.back());
+        parent.entries_[sep_idx] = left.entries_.back();
+        left.children_.pop_back();
+      }
+      left.entries_.pop_back();
+    }
+    WriteNode(left_page_id, left);
+    WriteNode(right_page_id, right);
+    WriteNode(parent_page_id, parent);
+    return;
+  }
+}
+
+size_t BPlusTree::ChildIndex(const BPlusTreeNode &node, const IndexEntry &entry) {
+  // 分隔项为右子树中最小的索引项
+  return std::upper_bound(node.entries_.begin(), node.entries_.end(), entry, EntryLess) - node.entries_.begin();
+}
+
+bool BPlusTree::EntryLess(const IndexEntry &lhs, const IndexEntry &rhs) {
+  if (lhs.key_.Less(rhs.key_)) {
+    return true;
+  }
+  if (rhs.key_.Less(lhs.key_)) {
+    return false;
+  }
+  return lhs.rid_.page_id_ < rhs.rid_.page_id_ ||
+         (lhs.rid_.page_id_ == rhs.rid_.page_id_ && lhs.rid_.slot_id_ < rhs.rid_.slot_id_);
+}
+
+void BPlusTree::Apply(xid_t xid) {
+  // 已分配但尚未写入内容的页面（批量建立索引时预先分配的右兄弟）留待下次写回
+  std::vector<std::pair<pageid_t, std::vector<char>>> images;
+  for (const auto &[page_id, pending] : pending_pages_) {
+    if (!pending.data_.empty()) {
+      images.emplace_back(page_id, pending.data_);
+    }
+  }
+  auto lsn = log_manager_.AppendIndexPageLog(xid, db_oid_, oid_, std::move(images));
+  for (auto iterator = pending_pages_.begin(); iterator != pending_pages_.end();) {
+    auto &[page_id, pending] = *iterator;
+    if (pending.data_.empty()) {
+      iterator++;
+      continue;
+    }
+    memcpy(pending.data_.data(), &lsn, sizeof(lsn));
+    auto page = pending.is_new_ ? buffer_pool_.NewPage(db_oid_, oid_, page_id)
+                                : buffer_pool_.GetPage(db_oid_, oid_, page_id);
+    memcpy(page->GetData(), pending.data_.data(), DB_PAGE_SIZE);
+    page->SetDirty();
+    iterator = pending_pages_.erase(iterator);
+  }
+}
+
+}  // namespace huadb
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "common/constants.h"
+#include "common/value.h"
+#include "log/log_manager.h"
+#include "storage/buffer_pool.h"
+
+namespace huadb {
+
+// 节点页面格式：page_lsn(8) + page_type(2) + count(2) + next_page_id(4) = 16
+static constexpr db_size_t BPLUS_TREE_HEADER_SIZE =
+    sizeof(lsn_t) + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(pageid_t);
+// 内部节点的每个孩子需要 4 字节，索引项为 (key, rid)
+// 要求内部节点至少容纳 3 个索引项，据此限制索引键的最大长度
+static constexpr db_size_t MAX_INDEX_KEY_SIZE =
+    (DB_PAGE_SIZE - BPLUS_TREE_HEADER_SIZE - sizeof(pageid_t)) / 3 - sizeof(pageid_t) - sizeof(slotid_t) -
+    sizeof(pageid_t);
+// 批量建立索引时，每条日志最多包含的页面数目
+static constexpr size_t BULK_LOAD_LOG_PAGES = 4;
+// 元信息页面固定为 0 号页面
+static constexpr pageid_t BPLUS_TREE_META_PAGE_ID = 0;
+
+// 索引项：键值及其对应记录的 rid，二者共同决定索引项在 B+ 树中的顺序
+struct IndexEntry {
+  Value key_;
+  Rid rid_;
+};
+
+enum class BPlusTreePageType : uint16_t { LEAF, INTERNAL, FREE };
+
+// B+ 树节点在内存中的表示，读写页面时与页面内容相互转换
+// 叶节点的 next_page_id_ 指向右侧的叶节点，空闲页面的 next_page_id_ 指向下一个空闲页面
+struct BPlusTreeNode {
+  BPlusTreePageType type_ = BPlusTreePageType::LEAF;
+  pageid_t next_page_id_ = NULL_PAGE_ID;
+  std::vector<IndexEntry> entries_;
+  // 内部节点的孩子，数目为 entries_.size() + 1
+  std::vector<pageid_t> children_;
+};
+
+class BPlusTree;
+
+// 按键值顺序遍历叶节点，每次将一个叶节点的索引项读入内存
+class BPlusTreeIterator {
+ public:
+  BPlusTreeIterator(const BPlusTree &tree, std::vector<IndexEntry> entries, size_t pos, pageid_t next_page_id);
+
+  // 返回下一个索引项，遍历结束时返回 std::nullopt
+  std::optional<IndexEntry> Next();
+
+ private:
+  const BPlusTree &tree_;
+  std::vector<IndexEntry> entries_;
+  size_t pos_;
+  pageid_t next_page_id_;
+};
+
+// 存储在 buffer pool 页面中的 B+ 树，0 号页面保存根节点位置、页面数目和空闲页面链表
+// 每次修改先在内存中完成，涉及的所有页面（包括分裂与合并产生的页面）以整页镜像的形式写入同一条日志，再写回页面
+class BPlusTree {
+ public:
+  BPlusTree(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, Type key_type,
+            db_size_t key_size);
+
+  // 初始化新建索引的元信息页面和根节点
+  void Init(xid_t xid);
+  // 插入索引项
+  void Insert(const Value &key, const Rid &rid, xid_t xid);
+  // 删除索引项，不存在时返回 false
+  bool Delete(const Value &key, const Rid &rid, xid_t xid);
+  // 在刚初始化的空树上自底向上批量建立索引，next_entry 按顺序返回共 count 个索引项
+  // 先从左到右按填充率 fill_factor（百分比）写满叶节点，再逐层建立内部节点
+  void BulkLoad(const std::function<std::optional<IndexEntry>()> &next_entry, size_t count, uint32_t fill_factor,
+                xid_t xid);
+
+  // 定位到第一个索引项
+  BPlusTreeIterator Begin() const;
+  // 定位到第一个键值不小于 key 的索引项
+  BPlusTreeIterator LowerBound(const Value &key) const;
+
+  // 获取树高，只有根节点时为 1
+  uint32_t GetHeight() const;
+
+  // 叶节点和内部节点最多容纳的索引项数目
+  size_t LeafCapacity() const;
+  size_t InternalCapacity() const;
+
+  // 索引项的顺序：先比较键值，键值相同时比较 rid
+  static bool EntryLess(const IndexEntry &lhs, const IndexEntry &rhs);
+
+ private:
+  friend class BPlusTreeIterator;
+
+  struct Meta {
+    pageid_t root_page_id_;
+    pageid_t page_count_;
+    pageid_t free_page_id_;
+  };
+  // 尚未写回的页面镜像
+  struct PendingPage {
+    bool is_new_ = false;
+    std::vector<char> data_;
+  };
+
+  Meta ReadMeta() const;
+  void WriteMeta(const Meta &meta);
+  BPlusTreeNode ReadNode(pageid_t page_id) const;
+  void WriteNode(pageid_t page_id, const BPlusTreeNode &node);
+  // 读取页面内容，优先读取尚未写回的页面镜像
+  std::vector<char> ReadPage(pageid_t page_id) const;
+
+  // 分配新页面，优先复用空闲页面
+  pageid_t AllocatePage(Meta &meta);
+  // 将页面加入空闲链表
+  void FreePage(Meta &meta, pageid_t page_id);
+
+  // 分裂后将分隔项插入父节点，path 为从根节点到分裂节点父节点的路径
+  void InsertIntoParent(Meta &meta, std::vector<pageid_t> &path, pageid_t left_page_id, IndexEntry separator,
+                        pageid_t right_page_id);
+  // 删除后节点过小时与兄弟节点重新分配或合并，path 为从根节点到 page_id 父节点的路径
+  void Rebalance(Meta &meta, std::vector<pageid_t> &path, pageid_t page_id, BPlusTreeNode node);
+
+  // 查找 entry 所在的孩子下标
+  static size_t ChildIndex(const BPlusTreeNode &node, const IndexEntry &entry);
+
+  // 将所有修改的页面写入一条日志，再写回 buffer pool
+  void Apply(xid_t xid);
+
+  BufferPool &buffer_pool_;
+  LogManager &log_manager_;
+  oid_t oid_;
+  oid_t db_oid_;
+  Type key_type_;
+  db_size_t key_size_;
+
+  std::map<pageid_t, PendingPage> pending_pages_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,85 @@
+#include "index/index.h"
+
+#include <algorithm>
+
+#include "common/type_util.h"
+
+namespace huadb {
+
+Index::Index(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, std::string name,
+             oid_t table_oid, std::string column_name, size_t column_idx, Type key_type, db_size_t key_size,
+             bool new_index)
+    : oid_(oid),
+      name_(std::move(name)),
+      table_oid_(table_oid),
+      column_name_(std::move(column_name)),
+      column_idx_(column_idx),
+      tree_(buffer_pool, log_manager, oid, db_oid, key_type, key_size) {
+  if (new_index) {
+    tree_.Init(DDL_XID);
+  }
+}
+
+void Index::Insert(const Value &key, const Rid &rid, xid_t xid) {
+  if (key.IsNull()) {
+    return;
+  }
+  tree_.Insert(key, rid, xid);
+}
+
+void Index::Delete(const Value &key, const Rid &rid, xid_t xid) {
+  if (key.IsNull()) {
+    return;
+  }
+  tree_.Delete(key, rid, xid);
+}
+
+void Index::BulkLoad(IndexSorter &sorter, uint32_t fill_factor, xid_t xid) {
+  tree_.BulkLoad([&sorter]() { return sorter.Next(); }, sorter.Count(), fill_factor, xid);
+}
+
+std::vector<Rid> Index::ScanKey(const Value &key) const {
+  std::vector<Rid> rids;
+  if (key.IsNull()) {
+    return rids;
+  }
+  // 相同键值的索引项按 rid 排序，依次读取直到键值不同
+  auto iterator = tree_.LowerBound(key);
+  while (auto entry = iterator.Next()) {
+    if (!entry->key_.Equal(key)) {
+      break;
+    }
+    rids.push_back(entry->rid_);
+  }
+  return rids;
+}
+
+BPlusTreeIterator Index::Begin() const { return tree_.Begin(); }
+
+BPlusTreeIterator Index::LowerBound(const Value &key) const { return tree_.LowerBound(key); }
+
+oid_t Index::GetOid() const { return oid_; }
+
+const std::string &Index::GetName() const { return name_; }
+
+oid_t Index::GetTableOid() const { return table_oid_; }
+
+const std::string &Index::GetColumnName() const { return column_name_; }
+
+size_t Index::GetColumnIndex() const { return column_idx_; }
+
+uint32_t Index::GetHeight() const { return tree_.GetHeight(); }
+
+size_t Index::LeafCapacity() const { return tree_.LeafCapacity(); }
+
+size_t Index::InternalCapacity() const { return tree_.InternalCapacity(); }
+
+db_size_t Index::KeySize(Type key_type, db_size_t max_size) {
+  // 字符串需要额外保存长度
+  if (TypeUtil::IsString(key_type)) {
+    return max_size + sizeof(db_size_t);
+  }
+  return TypeUtil::TypeSize(key_type);
+}
+
+}  // namespace huadb
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/types.h"
+#include "common/value.h"
+#include "index/b_plus_tree.h"
+#include "index/index_sorter.h"
+
+namespace huadb {
+
+// 单列二级索引，索引项保存在 B+ 树中，每个索引单独使用一个文件
+class Index {
+ public:
+  Index(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t db_oid, std::string name, oid_t table_oid,
+        std::string column_name, size_t column_idx, Type key_type, db_size_t key_size, bool new_index);
+
+  // 插入索引项，空值不加入索引
+  void Insert(const Value &key, const Rid &rid, xid_t xid);
+  // 删除索引项
+  void Delete(const Value &key, const Rid &rid, xid_t xid);
+  // 在空索引上根据排序完成的索引项批量建立 B+ 树
+  void BulkLoad(IndexSorter &sorter, uint32_t fill_factor, xid_t xid);
+  // 查找键值等于 key 的所有记录，结果按 rid 排序
+  std::vector<Rid> ScanKey(const Value &key) const;
+
+  // 从第一个索引项开始遍历
+  BPlusTreeIterator Begin() const;
+  // 从第一个键值不小于 key 的索引项开始遍历
+  BPlusTreeIterator LowerBound(const Value &key) const;
+
+  oid_t GetOid() const;
+  const std::string &GetName() const;
+  oid_t GetTableOid() const;
+  const std::string &GetColumnName() const;
+  // 索引列在表中的下标
+  size_t GetColumnIndex() const;
+  // B+ 树高度
+  uint32_t GetHeight() const;
+  // 叶节点和内部节点最多容纳的索引项个数，不读取页面
+  size_t LeafCapacity() const;
+  size_t InternalCapacity() const;
+
+  // 计算索引键在页面中占用的字节数
+  static db_size_t KeySize(Type key_type, db_size_t max_size);
+
+ private:
+  oid_t oid_;
+  std::string name_;
+  oid_t table_oid_;
+  std::string column_name_;
+  size_t column_idx_;
+  BPlusTree tree_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,155 @@
+#include "index/index_sorter.h"
+
+#include <algorithm>
+
+#include "storage/disk.h"
+
+namespace huadb {
+
+IndexSorter::IndexSorter(Type key_type, db_size_t key_size, std::string path_prefix)
+    : key_type_(key_type), key_size_(key_size), path_prefix_(std::move(path_prefix)) {}
+
+IndexSorter::~IndexSorter() {
+  readers_.clear();
+  for (const auto &path : run_paths_) {
+    Disk::RemoveFile(path);
+  }
+}
+
+void IndexSorter::Add(IndexEntry entry) {
+  size_t entry_size = key_size_ + sizeof(pageid_t) + sizeof(slotid_t);
+  if (buffer_bytes_ + entry_size > INDEX_SORT_BUFFER_SIZE) {
+    SpillRun();
+  }
+  buffer_.push_back(std::move(entry));
+  buffer_bytes_ += entry_size;
+  count_++;
+}
+
+void IndexSorter::Finish() {
+  std::sort(buffer_.begin(), buffer_.end(), BPlusTree::EntryLess);
+  buffer_pos_ = 0;
+  if (runs_.empty()) {
+    // 所有索引项都在内存中，无需读写临时文件
+    return;
+  }
+  if (!buffer_.empty()) {
+    SpillRun();
+  }
+  // 多趟归并，直到剩余的段数不超过归并路数
+  while (runs_.size() > INDEX_SORT_FAN_IN) {
+    std::vector<std::string> merged;
+    for (size_t i = 0; i < runs_.size(); i += INDEX_SORT_FAN_IN) {
+      auto end = std::min(runs_.size(), i + INDEX_SORT_FAN_IN);
+      std::vector<std::string> group(runs_.begin() + i, runs_.begin() + end);
+      if (group.size() == 1) {
+        merged.push_back(group.front());
+        continue;
+      }
+      auto path = NewRunPath();
+      MergeRuns(group, path);
+      merged.push_back(path);
+    }
+    runs_ = std::move(merged);
+  }
+  for (const auto &run : runs_) {
+    readers_.push_back(OpenRun(run));
+  }
+}
+
+std::optional<IndexEntry> IndexSorter::Next() {
+  if (readers_.empty()) {
+    if (buffer_pos_ >= buffer_.size()) {
+      return std::nullopt;
+    }
+    return buffer_[buffer_pos_++];
+  }
+  auto min = SelectMin(readers_);
+  if (min < 0) {
+    return std::nullopt;
+  }
+  auto entry = std::move(*readers_[min]->current_);
+  Advance(*readers_[min]);
+  return entry;
+}
+
+size_t IndexSorter::Count() const { return count_; }
+
+size_t IndexSorter::RunCount() const { return run_count_; }
+
+void IndexSorter::SpillRun() {
+  std::sort(buffer_.begin(), buffer_.end(), BPlusTree::EntryLess);
+  auto path = NewRunPath();
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  for (const auto &entry : buffer_) {
+    WriteEntry(out, entry);
+  }
+  runs_.push_back(path);
+  run_count_++;
+  buffer_.clear();
+  buffer_bytes_ = 0;
+}
+
+void IndexSorter::MergeRuns(const std::vector<std::string> &runs, const std::string &path) {
+  std::vector<std::unique_ptr<RunReader>> readers;
+  for (const auto &run : runs) {
+    readers.push_back(OpenRun(run));
+  }
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  for (auto min = SelectMin(readers); min >= 0; min = SelectMin(readers)) {
+    WriteEntry(out, *readers[min]->current_);
+    Advance(*readers[min]);
+  }
+  // 归并完成的段不再需要
+  readers.clear();
+  for (const auto &run : runs) {
+    Disk::RemoveFile(run);
+  }
+}
+
+std::unique_ptr<IndexSorter::RunReader> IndexSorter::OpenRun(const std::string &path) {
+  auto reader = std::make_unique<RunReader>();
+  reader->in_.open(path, std::ios::binary);
+  Advance(*reader);
+  return reader;
+}
+
+void IndexSorter::Advance(RunReader &reader) {
+  std::vector<char> data(key_size_ + sizeof(pageid_t) + sizeof(slotid_t));
+  if (!reader.in_.read(data.data(), data.size())) {
+    reader.current_ = std::nullopt;
+    return;
+  }
+  IndexEntry entry{Value(key_type_, key_size_), Rid{}};
+  entry.key_.DeserializeFrom(data.data());
+  memcpy(&entry.rid_.page_id_, data.data() + key_size_, sizeof(pageid_t));
+  memcpy(&entry.rid_.slot_id_, data.data() + key_size_ + sizeof(pageid_t), sizeof(slotid_t));
+  reader.current_ = std::move(entry);
+}
+
+int IndexSorter::SelectMin(const std::vector<std::unique_ptr<RunReader>> &readers) {
+  int min = -1;
+  for (size_t i = 0; i < readers.size(); i++) {
+    if (readers[i]->current_ &&
+        (min < 0 || BPlusTree::EntryLess(*readers[i]->current_, *readers[min]->current_))) {
+      min = static_cast<int>(i);
+    }
+  }
+  return min;
+}
+
+std::string IndexSorter::NewRunPath() {
+  auto path = path_prefix_ + ".sort." + std::to_string(next_run_id_++);
+  run_paths_.push_back(path);
+  return path;
+}
+
+void IndexSorter::WriteEntry(std::ofstream &out, const IndexEntry &entry) const {
+  std::vector<char> data(key_size_ + sizeof(pageid_t) + sizeof(slotid_t), 0);
+  entry.key_.SerializeTo(data.data());
+  memcpy(data.data() + key_size_, &entry.rid_.page_id_, sizeof(pageid_t));
+  memcpy(data.data() + key_size_ + sizeof(pageid_t), &entry.rid_.slot_id_, sizeof(slotid_t));
+  out.write(data.data(), data.size());
+}
+
+}  // namespace huadb
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "index/b_plus_tree.h"
+
+namespace huadb {
+
+// 建立索引时使用的外部排序：索引项在内存缓冲区满时排序后写入临时文件形成有序段，
+// 结束时每次归并 INDEX_SORT_FAN_IN 个有序段，直到剩余的段可以一趟归并输出
+class IndexSorter {
+ public:
+  // path_prefix 为临时文件路径前缀
+  IndexSorter(Type key_type, db_size_t key_size, std::string path_prefix);
+  ~IndexSorter();
+
+  // 添加索引项
+  void Add(IndexEntry entry);
+  // 添加完成，准备按顺序输出
+  void Finish();
+  // 按 (key, rid) 顺序返回下一个索引项，输出结束时返回 std::nullopt
+  std::optional<IndexEntry> Next();
+
+  // 索引项总数
+  size_t Count() const;
+  // 生成的有序段数目（不包括中间归并生成的段）
+  size_t RunCount() const;
+
+ private:
+  // 顺序读取一个有序段
+  struct RunReader {
+    std::ifstream in_;
+    std::optional<IndexEntry> current_;
+  };
+
+  // 将内存中的索引项排序后写入新的有序段
+  void SpillRun();
+  // 将 runs 中的有序段归并到 path 对应的新段中
+  void MergeRuns(const std::vector<std::string> &runs, const std::string &path);
+  // 打开有序段并读取第一项
+  std::unique_ptr<RunReader> OpenRun(const std::string &path);
+  void Advance(RunReader &reader);
+  // 在各段当前项中选择最小的一项，全部读完时返回 -1
+  static int SelectMin(const std::vector<std::unique_ptr<RunReader>> &readers);
+
+  std::string NewRunPath();
+  void WriteEntry(std::ofstream &out, const IndexEntry &entry) const;
+
+  Type key_type_;
+  db_size_t key_size_;
+  std::string path_prefix_;
+
+  std::vector<IndexEntry> buffer_;
+  size_t buffer_bytes_ = 0;
+  size_t count_ = 0;
+  size_t run_count_ = 0;
+  size_t next_run_id_ = 0;
+  std::vector<std::string> runs_;
+  // 创建过的临时文件，析构时删除
+  std::vector<std::string> run_paths_;
+
+  // 输出阶段：没有写出有序段时直接输出内存中的索引项，否则归并剩余的段
+  size_t buffer_pos_ = 0;
+  std::vector<std::unique_ptr<RunReader>> readers_;
+};
+
+}  // namespace huadb
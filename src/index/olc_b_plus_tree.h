@@ -0,0 +1,417 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace huadb {
+
+// 内存中 B+ 树节点的大小（字节）
+static constexpr size_t OLC_NODE_SIZE = 4096;
+
+// 乐观锁耦合（Optimistic Lock Coupling）使用的节点版本号
+// 最低位表示节点已废弃（为节点回收预留），第二位表示节点被写锁定，每次写解锁后版本号增加
+// 读者不加锁：读取节点前记录版本号，读取后检查版本号是否变化，变化则从根节点重新开始
+class OlcLatch {
+ public:
+  // 等待写锁释放后返回当前版本号，节点已废弃时需要重新开始
+  uint64_t ReadLockOrRestart(bool &need_restart) const {
+    auto version = AwaitNodeUnlocked();
+    if (IsObsolete(version)) {
+      need_restart = true;
+    }
+    return version;
+  }
+  // 检查读取期间节点是否被修改，fence 保证读取节点内容发生在重新读取版本号之前
+  void ReadUnlockOrRestart(uint64_t start_version, bool &need_restart) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (start_version != version_.load(std::memory_order_relaxed)) {
+      need_restart = true;
+    }
+  }
+  // 将读取时的版本号升级为写锁，期间节点被修改时需要重新开始
+  void UpgradeToWriteLockOrRestart(uint64_t &version, bool &need_restart) {
+    if (version_.compare_exchange_strong(version, version + LOCKED_BIT)) {
+      version += LOCKED_BIT;
+    } else {
+      need_restart = true;
+    }
+  }
+  void WriteUnlock() { version_.fetch_add(LOCKED_BIT); }
+
+ private:
+  static constexpr uint64_t OBSOLETE_BIT = 0b01;
+  static constexpr uint64_t LOCKED_BIT = 0b10;
+
+  static bool IsLocked(uint64_t version) { return (version & LOCKED_BIT) != 0; }
+  static bool IsObsolete(uint64_t version) { return (version & OBSOLETE_BIT) != 0; }
+
+  uint64_t AwaitNodeUnlocked() const {
+    auto version = version_.load();
+    while (IsLocked(version)) {
+      std::this_thread::yield();
+      version = version_.load();
+    }
+    return version;
+  }
+
+  std::atomic<uint64_t> version_{0b100};
+};
+
+// 支持多线程并发访问的内存有序索引，节点使用乐观锁耦合
+// 查找和范围扫描不获取任何锁，插入和删除只锁定被修改的节点（分裂时还包括父节点），版本冲突时重新开始
+// 插入时自顶向下提前分裂已满的节点，因此任何时刻最多同时锁定两个节点
+// 删除不合并节点，节点一旦创建在树的生命周期内不会被释放
+// 读者可能读到正在被修改的键值，因此要求 Key 和 Value 可以平凡复制，读到的内容只有在版本号检查通过后才被使用
+template <typename Key, typename Value>
+class OlcBPlusTree {
+  static_assert(std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value>,
+                "OlcBPlusTree requires trivially copyable keys and values");
+
+ public:
+  OlcBPlusTree() : root_(new LeafNode()) {}
+  ~OlcBPlusTree() { FreeNode(root_.load()); }
+  OlcBPlusTree(const OlcBPlusTree &) = delete;
+  OlcBPlusTree &operator=(const OlcBPlusTree &) = delete;
+
+  // 插入键值对，键已存在时更新对应的值
+  void Insert(const Key &key, const Value &value) {
+    while (!TryInsert(key, value)) {
+    }
+  }
+
+  // 查找键对应的值
+  std::optional<Value> Lookup(const Key &key) const {
+    while (true) {
+      bool need_restart = false;
+      auto result = TryLookup(key, need_restart);
+      if (!need_restart) {
+        return result;
+      }
+    }
+  }
+
+  // 删除键，不存在时返回 false
+  bool Remove(const Key &key) {
+    while (true) {
+      bool need_restart = false;
+      auto removed = TryRemove(key, need_restart);
+      if (!need_restart) {
+        return removed;
+      }
+    }
+  }
+
+  // 按键的顺序返回从第一个不小于 key 的键开始的至多 limit 个键值对
+  std::vector<std::pair<Key, Value>> Scan(const Key &key, size_t limit) const {
+    while (true) {
+      bool need_restart = false;
+      auto result = TryScan(key, limit, need_restart);
+      if (!need_restart) {
+        return result;
+      }
+    }
+  }
+
+ private:
+  struct Node : OlcLatch {
+    explicit Node(bool is_leaf) : is_leaf_(is_leaf) {}
+    const bool is_leaf_;
+    uint16_t count_ = 0;
+  };
+
+  struct LeafNode : Node {
+    static constexpr size_t CAPACITY = (OLC_NODE_SIZE - sizeof(Node) - sizeof(void *)) / (sizeof(Key) + sizeof(Value));
+
+    LeafNode() : Node(true) {}
+    bool IsFull() const { return this->count_ == CAPACITY; }
+    // 第一个不小于 key 的位置
+    size_t LowerBound(const Key &key) const {
+      auto count = std::min<size_t>(this->count_, CAPACITY);
+      return std::lower_bound(keys_, keys_ + count, key) - keys_;
+    }
+    void Insert(const Key &key, const Value &value) {
+      auto pos = LowerBound(key);
+      if (pos < this->count_ && keys_[pos] == key) {
+        values_[pos] = value;
+        return;
+      }
+      std::move_backward(keys_ + pos, keys_ + this->count_, keys_ + this->count_ + 1);
+      std::move_backward(values_ + pos, values_ + this->count_, values_ + this->count_ + 1);
+      keys_[pos] = key;
+      values_[pos] = value;
+      this->count_++;
+    }
+    // 后一半键值对移动到新节点，返回新节点，separator 为留在本节点中的最大键
+    LeafNode *Split(Key &separator) {
+      auto right = new LeafNode();
+      auto mid = this->count_ / 2;
+      right->count_ = this->count_ - mid;
+      std::copy(keys_ + mid, keys_ + this->count_, right->keys_);
+      std::copy(values_ + mid, values_ + this->count_, right->values_);
+      right->next_ = next_;
+      this->count_ = mid;
+      next_ = right;
+      separator = keys_[mid - 1];
+      return right;
+    }
+
+    Key keys_[CAPACITY];
+    Value values_[CAPACITY];
+    // 右侧的叶节点，用于范围扫描
+    LeafNode *next_ = nullptr;
+  };
+
+  // 孩子 i 中的键位于 (keys_[i - 1], keys_[i]] 中
+  struct InnerNode : Node {
+    static constexpr size_t CAPACITY = (OLC_NODE_SIZE - sizeof(Node) - sizeof(Node *)) / (sizeof(Key) + sizeof(Node *));
+
+    InnerNode() : Node(false) {}
+    bool IsFull() const { return this->count_ == CAPACITY; }
+    size_t LowerBound(const Key &key) const {
+      auto count = std::min<size_t>(this->count_, CAPACITY);
+      return std::lower_bound(keys_, keys_ + count, key) - keys_;
+    }
+    // 子节点分裂后插入分隔键和新的右孩子
+    void Insert(const Key &separator, Node *right) {
+      auto pos = LowerBound(separator);
+      std::move_backward(keys_ + pos, keys_ + this->count_, keys_ + this->count_ + 1);
+      std::move_backward(children_ + pos + 1, children_ + this->count_ + 1, children_ + this->count_ + 2);
+      keys_[pos] = separator;
+      children_[pos + 1] = right;
+      this->count_++;
+    }
+    // 中间的键上移到父节点，其后的键和孩子移动到新节点
+    InnerNode *Split(Key &separator) {
+      auto right = new InnerNode();
+      auto mid = this->count_ / 2;
+      separator = keys_[mid];
+      right->count_ = this->count_ - mid - 1;
+      std::copy(keys_ + mid + 1, keys_ + this->count_, right->keys_);
+      std::copy(children_ + mid + 1, children_ + this->count_ + 1, right->children_);
+      this->count_ = mid;
+      return right;
+    }
+
+    Key keys_[CAPACITY];
+    Node *children_[CAPACITY + 1];
+  };
+
+  static void FreeNode(Node *node) {
+    if (!node->is_leaf_) {
+      auto inner = static_cast<InnerNode *>(node);
+      for (size_t i = 0; i <= inner->count_; i++) {
+        FreeNode(inner->children_[i]);
+      }
+      delete inner;
+    } else {
+      delete static_cast<LeafNode *>(node);
+    }
+  }
+
+  // 根节点分裂，树高加一，调用时持有原根节点的写锁
+  void MakeRoot(const Key &separator, Node *left, Node *right) {
+    auto root = new InnerNode();
+    root->count_ = 1;
+    root->keys_[0] = separator;
+    root->children_[0] = left;
+    root->children_[1] = right;
+    root_.store(root);
+  }
+
+  // 分裂已满的节点：锁定父节点和当前节点，分裂后解锁并从根节点重新开始
+  template <typename NodeType>
+  void SplitNode(NodeType *node, uint64_t &version, InnerNode *parent, uint64_t &parent_version,
+                 bool &need_restart) {
+    if (parent != nullptr) {
+      parent->UpgradeToWriteLockOrRestart(parent_version, need_restart);
+      if (need_restart) {
+        return;
+      }
+    }
+    node->UpgradeToWriteLockOrRestart(version, need_restart);
+    if (need_restart) {
+      if (parent != nullptr) {
+        parent->WriteUnlock();
+      }
+      return;
+    }
+    if (parent == nullptr && node != root_.load()) {
+      // 期间有其他线程生成了新的根节点
+      node->WriteUnlock();
+      need_restart = true;
+      return;
+    }
+    Key separator;
+    auto right = node->Split(separator);
+    if (parent != nullptr) {
+      parent->Insert(separator, right);
+    } else {
+      MakeRoot(separator, node, right);
+    }
+    node->WriteUnlock();
+    if (parent != nullptr) {
+      parent->WriteUnlock();
+    }
+    need_restart = true;
+  }
+
+  bool TryInsert(const Key &key, const Value &value) {
+    bool need_restart = false;
+    Node *node = root_.load();
+    auto version = node->ReadLockOrRestart(need_restart);
+    if (need_restart || node != root_.load()) {
+      return false;
+    }
+    InnerNode *parent = nullptr;
+    uint64_t parent_version = 0;
+    while (!node->is_leaf_) {
+      auto inner = static_cast<InnerNode *>(node);
+      if (inner->IsFull()) {
+        SplitNode(inner, version, parent, parent_version, need_restart);
+        return false;
+      }
+      if (parent != nullptr) {
+        parent->ReadUnlockOrRestart(parent_version, need_restart);
+        if (need_restart) {
+          return false;
+        }
+      }
+      parent = inner;
+      parent_version = version;
+      node = inner->children_[inner->LowerBound(key)];
+      // 先读取孩子的版本号再检查父节点，否则两次读取之间孩子可能分裂，key 已不在该孩子中
+      version = node->ReadLockOrRestart(need_restart);
+      if (need_restart) {
+        return false;
+      }
+      inner->ReadUnlockOrRestart(parent_version, need_restart);
+      if (need_restart) {
+        return false;
+      }
+    }
+    auto leaf = static_cast<LeafNode *>(node);
+    if (leaf->IsFull()) {
+      SplitNode(leaf, version, parent, parent_version, need_restart);
+      return false;
+    }
+    leaf->UpgradeToWriteLockOrRestart(version, need_restart);
+    if (need_restart) {
+      return false;
+    }
+    if (parent != nullptr) {
+      parent->ReadUnlockOrRestart(parent_version, need_restart);
+      if (need_restart) {
+        leaf->WriteUnlock();
+        return false;
+      }
+    }
+    leaf->Insert(key, value);
+    leaf->WriteUnlock();
+    return true;
+  }
+
+  // 不加锁地从根节点查找 key 所在的叶节点，返回时 version 为叶节点的版本号
+  LeafNode *FindLeaf(const Key &key, uint64_t &version, bool &need_restart) const {
+    Node *node = root_.load();
+    version = node->ReadLockOrRestart(need_restart);
+    if (need_restart || node != root_.load()) {
+      need_restart = true;
+      return nullptr;
+    }
+    while (!node->is_leaf_) {
+      auto inner = static_cast<InnerNode *>(node);
+      auto child = inner->children_[inner->LowerBound(key)];
+      // 与 TryInsert 相同，检查父节点版本号之前先读取孩子的版本号
+      auto child_version = child->ReadLockOrRestart(need_restart);
+      if (need_restart) {
+        return nullptr;
+      }
+      inner->ReadUnlockOrRestart(version, need_restart);
+      if (need_restart) {
+        return nullptr;
+      }
+      version = child_version;
+      node = child;
+    }
+    return static_cast<LeafNode *>(node);
+  }
+
+  std::optional<Value> TryLookup(const Key &key, bool &need_restart) const {
+    uint64_t version;
+    auto leaf = FindLeaf(key, version, need_restart);
+    if (need_restart) {
+      return std::nullopt;
+    }
+    std::optional<Value> result;
+    auto pos = leaf->LowerBound(key);
+    if (pos < std::min<size_t>(leaf->count_, LeafNode::CAPACITY) && leaf->keys_[pos] == key) {
+      result = leaf->values_[pos];
+    }
+    leaf->ReadUnlockOrRestart(version, need_restart);
+    return result;
+  }
+
+  bool TryRemove(const Key &key, bool &need_restart) {
+    uint64_t version;
+    auto leaf = FindLeaf(key, version, need_restart);
+    if (need_restart) {
+      return false;
+    }
+    leaf->UpgradeToWriteLockOrRestart(version, need_restart);
+    if (need_restart) {
+      return false;
+    }
+    auto pos = leaf->LowerBound(key);
+    bool found = pos < leaf->count_ && leaf->keys_[pos] == key;
+    if (found) {
+      std::move(leaf->keys_ + pos + 1, leaf->keys_ + leaf->count_, leaf->keys_ + pos);
+      std::move(leaf->values_ + pos + 1, leaf->values_ + leaf->count_, leaf->values_ + pos);
+      leaf->count_--;
+    }
+    leaf->WriteUnlock();
+    return found;
+  }
+
+  std::vector<std::pair<Key, Value>> TryScan(const Key &key, size_t limit, bool &need_restart) const {
+    std::vector<std::pair<Key, Value>> result;
+    uint64_t version;
+    auto leaf = FindLeaf(key, version, need_restart);
+    if (need_restart) {
+      return result;
+    }
+    auto pos = leaf->LowerBound(key);
+    while (true) {
+      // 先复制叶节点的内容，检查版本号通过后才加入结果
+      std::vector<std::pair<Key, Value>> batch;
+      auto count = std::min<size_t>(leaf->count_, LeafNode::CAPACITY);
+      for (; pos < count && result.size() + batch.size() < limit; pos++) {
+        batch.emplace_back(leaf->keys_[pos], leaf->values_[pos]);
+      }
+      auto next = leaf->next_;
+      leaf->ReadUnlockOrRestart(version, need_restart);
+      if (need_restart) {
+        return result;
+      }
+      result.insert(result.end(), batch.begin(), batch.end());
+      if (result.size() >= limit || next == nullptr) {
+        return result;
+      }
+      leaf = next;
+      pos = 0;
+      version = leaf->ReadLockOrRestart(need_restart);
+      if (need_restart) {
+        return result;
+      }
+    }
+  }
+
+  std::atomic<Node *> root_;
+};
+
+}  // namespace huadb
@@ -0,0 +1,52 @@
+#include "log/checkpointer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "log/log_manager.h"
+
+namespace huadb {
+
+Checkpointer::Checkpointer(BufferPool &buffer_pool, LogManager &log_manager)
+    : buffer_pool_(buffer_pool), log_manager_(log_manager), last_checkpoint_time_(std::chrono::steady_clock::now()) {}
+
+void Checkpointer::SetTimeout(uint32_t timeout) { timeout_ = timeout; }
+
+void Checkpointer::SetCompletionTarget(double completion_target) { completion_target_ = completion_target; }
+
+void Checkpointer::Step() {
+  if (timeout_ == 0) {
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  if (!in_progress_) {
+    if (now - last_checkpoint_time_ < std::chrono::seconds(timeout_)) {
+      return;
+    }
+    // 只写回开始时的脏页，之后变脏的页面留给下一次检查点
+    in_progress_ = true;
+    start_time_ = now;
+    pages_ = buffer_pool_.GetDirtyPages();
+    written_count_ = 0;
+  }
+  // 写回的页面数与经过的时间成正比，在 completion_target_ * timeout_ 秒时全部写回
+  std::chrono::duration<double> elapsed = now - start_time_;
+  double progress = std::min(1.0, elapsed.count() / (completion_target_ * timeout_));
+  auto target_count = static_cast<size_t>(std::ceil(progress * pages_.size()));
+  for (; written_count_ < target_count; written_count_++) {
+    buffer_pool_.WriteBackPage(pages_[written_count_].table_oid_, pages_[written_count_].page_id_);
+  }
+  if (written_count_ < pages_.size()) {
+    return;
+  }
+  // 模糊检查点只记录活跃事务表和脏页表，不等待日志刷盘
+  log_manager_.Checkpoint(true);
+  in_progress_ = false;
+  pages_.clear();
+  last_checkpoint_time_ = now;
+  checkpoint_count_++;
+}
+
+uint32_t Checkpointer::GetCheckpointCount() const { return checkpoint_count_; }
+
+}  // namespace huadb
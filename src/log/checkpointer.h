@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "common/constants.h"
+#include "common/types.h"
+#include "storage/buffer_pool.h"
+
+namespace huadb {
+
+class LogManager;
+
+// 检查点进程：每隔 checkpoint_timeout 秒开始一次检查点，在 checkpoint_completion_target * checkpoint_timeout 秒内
+// 分批写回开始时的脏页，写完后记录模糊检查点，推进恢复时重做的起点，同时避免集中刷脏造成的延迟抖动
+// 页面没有闩锁，写回不能与语句的执行并发，因此由数据库在语句之间调用 Step 完成写回，而不使用单独的线程
+class Checkpointer {
+ public:
+  Checkpointer(BufferPool &buffer_pool, LogManager &log_manager);
+
+  // 检查点间隔（秒），为 0 时关闭
+  void SetTimeout(uint32_t timeout);
+  // 写回脏页的时间占检查点间隔的比例
+  void SetCompletionTarget(double completion_target);
+
+  // 按照时间进度写回脏页，全部写回后记录检查点
+  void Step();
+
+  // 完成的检查点个数
+  uint32_t GetCheckpointCount() const;
+
+ private:
+  BufferPool &buffer_pool_;
+  LogManager &log_manager_;
+
+  uint32_t timeout_ = DEFAULT_CHECKPOINT_TIMEOUT;
+  double completion_target_ = DEFAULT_CHECKPOINT_COMPLETION_TARGET;
+
+  std::chrono::steady_clock::time_point last_checkpoint_time_;
+  // 进行中的检查点开始的时间、开始时的脏页以及已经写回的脏页个数
+  bool in_progress_ = false;
+  std::chrono::steady_clock::time_point start_time_;
+  std::vector<TablePageid> pages_;
+  size_t written_count_ = 0;
+
+  uint32_t checkpoint_count_ = 0;
+};
+
+}  // namespace huadb
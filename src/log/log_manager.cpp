@@ -1,12 +1,35 @@
 #include "log/log_manager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <map>
+
 #include "common/exceptions.h"
 #include "log/log_records/log_records.h"
+#include "log/redo_dispatcher.h"
 
 namespace huadb {
 
 LogManager::LogManager(Disk &disk, TransactionManager &transaction_manager, lsn_t next_lsn)
-    : disk_(disk), transaction_manager_(transaction_manager), next_lsn_(next_lsn), flushed_lsn_(next_lsn - 1) {}
+    : disk_(disk),
+      transaction_manager_(transaction_manager),
+      next_lsn_(next_lsn),
+      flushed_lsn_(next_lsn),
+      log_buffer_(std::make_unique<char[]>(LOG_BUFFER_SIZE)),
+      written_lsn_(next_lsn) {
+  disk_.PreallocateLog(next_lsn);
+  log_writer_ = std::thread(&LogManager::LogWriterLoop, this);
+}
+
+LogManager::~LogManager() {
+  {
+    std::unique_lock lock(group_commit_mutex_);
+    stop_log_writer_ = true;
+  }
+  flush_request_cv_.notify_one();
+  log_writer_.join();
+}
 
 void LogManager::SetBufferPool(std::shared_ptr<BufferPool> buffer_pool) { buffer_pool_ = std::move(buffer_pool); }
 
@@ -15,13 +38,31 @@ void LogManager::SetCatalog(std::shared_ptr<Catalog> catalog) { catalog_ = std::
 lsn_t LogManager::GetNextLSN() const { return next_lsn_; }
 
 void LogManager::Clear() {
-  std::unique_lock lock(log_buffer_mutex_);
-  log_buffer_.clear();
+  {
+    // 丢弃尚未刷盘的日志
+    std::unique_lock flush_lock(flush_mutex_);
+    written_lsn_ = flushed_lsn_.load();
+    next_lsn_ = flushed_lsn_.load();
+  }
+  std::unique_lock lock(group_commit_mutex_);
+  requested_lsn_ = NULL_LSN;
 }
 
 void LogManager::Flush() { Flush(NULL_LSN); }
 
+void LogManager::SetCommitDelay(uint32_t commit_delay) { commit_delay_ = commit_delay; }
+
+void LogManager::SetWalWriterDelay(uint32_t wal_writer_delay) { wal_writer_delay_ = wal_writer_delay; }
+
+void LogManager::SetRedoWorkers(size_t redo_workers) {
+  if (redo_workers == 0) {
+    throw DbException("redo_workers must be positive");
+  }
+  redo_workers_ = redo_workers;
+}
+
 void LogManager::SetDirty(oid_t oid, pageid_t page_id, lsn_t lsn) {
+  std::unique_lock lock(table_mutex_);
   if (dpt_.find({oid, page_id}) == dpt_.end()) {
     dpt_[{oid, page_id}] = lsn;
   }
@@ -29,201 +70,496 @@ void LogManager::SetDirty(oid_t oid, pageid_t page_id, lsn_t lsn) {
 
 lsn_t LogManager::AppendInsertLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t slot_id, db_size_t offset,
                                   db_size_t size, char *new_record) {
-  if (att_.find(xid) == att_.end()) {
-    throw DbException(std::to_string(xid) + " does not exist in att (in AppendInsertLog)");
-  }
-  auto log = std::make_shared<InsertLog>(NULL_LSN, xid, att_.at(xid), oid, page_id, slot_id, offset, size, new_record);
-  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
-  log->SetLSN(lsn);
-  att_[xid] = lsn;
+  std::optional<BeginLog> begin_log;
+  std::optional<InsertLog> log;
+  ReservedLogs reserved(*this);
+  lsn_t lsn;
   {
-    std::unique_lock lock(log_buffer_mutex_);
-    log_buffer_.push_back(std::move(log));
+    // 持有 table_mutex_ 时只分配 lsn 并更新活跃事务表和脏页表，序列化和复制日志在锁外进行
+    std::unique_lock table_lock(table_mutex_);
+    // 事务第一次修改数据时才写 Begin 日志，只读事务不会写日志
+    if (att_.find(xid) == att_.end()) {
+      begin_log = ReserveBeginLog(xid, reserved);
+    }
+    log.emplace(NULL_LSN, xid, att_.at(xid), oid, page_id, slot_id, offset, size, new_record);
+    lsn = reserved.Reserve(*log);
+    att_[xid] = lsn;
+    if (dpt_.find({oid, page_id}) == dpt_.end()) {
+      dpt_[{oid, page_id}] = lsn;
+    }
   }
-  if (dpt_.find({oid, page_id}) == dpt_.end()) {
-    dpt_[{oid, page_id}] = lsn;
+  if (begin_log) {
+    reserved.Write(*begin_log);
   }
+  reserved.Write(*log);
   return lsn;
 }
 
 lsn_t LogManager::AppendDeleteLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t slot_id) {
-  if (att_.find(xid) == att_.end()) {
-    throw DbException(std::to_string(xid) + " does not exist in att (in AppendDeleteLog)");
-  }
-  auto log = std::make_shared<DeleteLog>(NULL_LSN, xid, att_.at(xid), oid, page_id, slot_id);
-  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
-  log->SetLSN(lsn);
-  att_[xid] = lsn;
+  std::optional<BeginLog> begin_log;
+  std::optional<DeleteLog> log;
+  ReservedLogs reserved(*this);
+  lsn_t lsn;
   {
-    std::unique_lock lock(log_buffer_mutex_);
-    log_buffer_.push_back(std::move(log));
+    std::unique_lock table_lock(table_mutex_);
+    if (att_.find(xid) == att_.end()) {
+      begin_log = ReserveBeginLog(xid, reserved);
+    }
+    log.emplace(NULL_LSN, xid, att_.at(xid), oid, page_id, slot_id);
+    lsn = reserved.Reserve(*log);
+    att_[xid] = lsn;
+    if (dpt_.find({oid, page_id}) == dpt_.end()) {
+      dpt_[{oid, page_id}] = lsn;
+    }
   }
-  if (dpt_.find({oid, page_id}) == dpt_.end()) {
-    dpt_[{oid, page_id}] = lsn;
+  if (begin_log) {
+    reserved.Write(*begin_log);
   }
+  reserved.Write(*log);
   return lsn;
 }
 
 lsn_t LogManager::AppendNewPageLog(xid_t xid, oid_t oid, pageid_t prev_page_id, pageid_t page_id) {
-  if (xid != DDL_XID && att_.find(xid) == att_.end()) {
-    throw DbException(std::to_string(xid) + " does not exist in att (in AppendNewPageLog)");
+  std::optional<BeginLog> begin_log;
+  std::optional<NewPageLog> log;
+  ReservedLogs reserved(*this);
+  lsn_t lsn;
+  {
+    std::unique_lock table_lock(table_mutex_);
+    if (xid != DDL_XID && att_.find(xid) == att_.end()) {
+      begin_log = ReserveBeginLog(xid, reserved);
+    }
+    xid_t log_xid;
+    if (xid == DDL_XID) {
+      log_xid = NULL_XID;
+    } else {
+      log_xid = att_.at(xid);
+    }
+    log.emplace(NULL_LSN, xid, log_xid, oid, prev_page_id, page_id);
+    lsn = reserved.Reserve(*log);
+
+    if (xid != DDL_XID) {
+      att_[xid] = lsn;
+    }
+    if (dpt_.find({oid, page_id}) == dpt_.end()) {
+      dpt_[{oid, page_id}] = lsn;
+    }
+    if (prev_page_id != NULL_PAGE_ID && dpt_.find({oid, prev_page_id}) == dpt_.end()) {
+      dpt_[{oid, prev_page_id}] = lsn;
+    }
   }
-  xid_t log_xid;
-  if (xid == DDL_XID) {
-    log_xid = NULL_XID;
-  } else {
-    log_xid = att_.at(xid);
+  if (begin_log) {
+    reserved.Write(*begin_log);
   }
-  auto log = std::make_shared<NewPageLog>(NULL_LSN, xid, log_xid, oid, prev_page_id, page_id);
-  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
-  log->SetLSN(lsn);
+  reserved.Write(*log);
+  return lsn;
+}
 
-  if (xid != DDL_XID) {
-    att_[xid] = lsn;
-  }
+lsn_t LogManager::AppendIndexPageLog(xid_t xid, oid_t db_oid, oid_t oid,
+                                     std::vector<std::pair<pageid_t, std::vector<char>>> pages) {
+  // 索引日志只需重做，不加入事务的 undo 链
+  IndexPageLog log(NULL_LSN, xid, NULL_LSN, db_oid, oid, std::move(pages));
+  ReservedLogs reserved(*this);
+  lsn_t lsn;
   {
-    std::unique_lock lock(log_buffer_mutex_);
-    log_buffer_.push_back(std::move(log));
-  }
-  if (dpt_.find({oid, page_id}) == dpt_.end()) {
-    dpt_[{oid, page_id}] = lsn;
-  }
-  if (prev_page_id != NULL_PAGE_ID && dpt_.find({oid, prev_page_id}) == dpt_.end()) {
-    dpt_[{oid, prev_page_id}] = lsn;
+    std::unique_lock table_lock(table_mutex_);
+    lsn = reserved.Reserve(log);
+    for (const auto &[page_id, image] : log.GetPages()) {
+      if (dpt_.find({oid, page_id}) == dpt_.end()) {
+        dpt_[{oid, page_id}] = lsn;
+      }
+    }
   }
+  reserved.Write(log);
   return lsn;
 }
 
 lsn_t LogManager::AppendBeginLog(xid_t xid) {
+  std::optional<BeginLog> log;
+  ReservedLogs reserved(*this);
+  {
+    std::unique_lock table_lock(table_mutex_);
+    log = ReserveBeginLog(xid, reserved);
+  }
+  reserved.Write(*log);
+  return log->GetLSN();
+}
+
+BeginLog LogManager::ReserveBeginLog(xid_t xid, ReservedLogs &reserved) {
   if (att_.find(xid) != att_.end()) {
     throw DbException(std::to_string(xid) + " already exists in att");
   }
-  auto log = std::make_shared<BeginLog>(NULL_LSN, xid, NULL_LSN);
-  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
-  log->SetLSN(lsn);
+  BeginLog log(NULL_LSN, xid, NULL_LSN);
+  lsn_t lsn = reserved.Reserve(log);
   att_[xid] = lsn;
-  {
-    std::unique_lock lock(log_buffer_mutex_);
-    log_buffer_.push_back(std::move(log));
-  }
-  return lsn;
+  begin_lsns_[xid] = lsn;
+  return log;
 }
 
-lsn_t LogManager::AppendCommitLog(xid_t xid) {
-  if (att_.find(xid) == att_.end()) {
-    throw DbException(std::to_string(xid) + " does not exist in att (in AppendCommitLog)");
-  }
-  auto log = std::make_shared<CommitLog>(NULL_LSN, xid, att_.at(xid));
-  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
-  log->SetLSN(lsn);
+lsn_t LogManager::AppendCommitLog(xid_t xid, bool synchronous) {
+  std::optional<CommitLog> log;
+  lsn_t lsn;
   {
-    std::unique_lock lock(log_buffer_mutex_);
-    log_buffer_.push_back(std::move(log));
+    std::unique_lock table_lock(table_mutex_);
+    // 只读事务没有写过日志，提交时不需要写日志和刷盘
+    if (att_.find(xid) == att_.end()) {
+      return NULL_LSN;
+    }
+    log.emplace(NULL_LSN, xid, att_.at(xid));
+    lsn = ReserveLog(*log);
   }
-  Flush(lsn);
+  WriteLog(*log);
+  // 由日志写线程统一刷盘，同时提交的事务共用一次写入
+  // 异步提交不等待刷盘，故障时可能丢失最近提交的事务，但日志仍先于数据页刷盘，恢复后数据库保持一致
+  if (synchronous) {
+    WaitForFlush(lsn);
+  }
+  std::unique_lock table_lock(table_mutex_);
   att_.erase(xid);
+  begin_lsns_.erase(xid);
   return lsn;
 }
 
 lsn_t LogManager::AppendRollbackLog(xid_t xid) {
-  if (att_.find(xid) == att_.end()) {
-    throw DbException(std::to_string(xid) + " does not exist in att (in AppendRollbackLog)");
-  }
-  auto log = std::make_shared<RollbackLog>(NULL_LSN, xid, att_.at(xid));
-  lsn_t lsn = next_lsn_.fetch_add(log->GetSize(), std::memory_order_relaxed);
-  log->SetLSN(lsn);
+  std::optional<RollbackLog> log;
+  lsn_t lsn;
   {
-    std::unique_lock lock(log_buffer_mutex_);
-    log_buffer_.push_back(std::move(log));
+    std::unique_lock table_lock(table_mutex_);
+    if (att_.find(xid) == att_.end()) {
+      return NULL_LSN;
+    }
+    log.emplace(NULL_LSN, xid, att_.at(xid));
+    lsn = ReserveLog(*log);
   }
+  WriteLog(*log);
   Flush(lsn);
+  std::unique_lock table_lock(table_mutex_);
   att_.erase(xid);
+  begin_lsns_.erase(xid);
   return lsn;
 }
 
 lsn_t LogManager::Checkpoint(bool async) {
-  auto begin_checkpoint_log = std::make_shared<BeginCheckpointLog>(NULL_LSN, NULL_XID, NULL_LSN);
-  lsn_t begin_lsn = next_lsn_.fetch_add(begin_checkpoint_log->GetSize(), std::memory_order_relaxed);
-  begin_checkpoint_log->SetLSN(begin_lsn);
+  BeginCheckpointLog begin_checkpoint_log(NULL_LSN, NULL_XID, NULL_LSN);
+  lsn_t begin_lsn = AppendLog(begin_checkpoint_log);
+
+  // 模糊检查点：只记录活跃事务表和脏页表，不写回脏页
+  // 重做从脏页表中最小的 recLSN 开始，回滚还需要读取活跃事务的 Begin 日志之后的日志
+  CheckpointInfo checkpoint{begin_lsn, begin_lsn, begin_lsn, NULL_LSN};
+  std::optional<EndCheckpointLog> end_checkpoint_log;
   {
-    std::unique_lock lock(log_buffer_mutex_);
-    log_buffer_.push_back(std::move(begin_checkpoint_log));
+    std::unique_lock table_lock(table_mutex_);
+    end_checkpoint_log.emplace(NULL_LSN, NULL_XID, NULL_LSN, att_, dpt_);
+    checkpoint.end_lsn_ = ReserveLog(*end_checkpoint_log);
+    for (const auto &[table_page_id, lsn] : dpt_) {
+      checkpoint.redo_lsn_ = std::min(checkpoint.redo_lsn_, lsn);
+    }
+    checkpoint.min_lsn_ = checkpoint.redo_lsn_;
+    for (const auto &[xid, lsn] : begin_lsns_) {
+      checkpoint.min_lsn_ = std::min(checkpoint.min_lsn_, lsn);
+    }
+  }
+  WriteLog(*end_checkpoint_log);
+  if (async) {
+    // 不等待日志刷盘，由日志写线程刷盘后更新 Master Record
+    std::unique_lock lock(group_commit_mutex_);
+    pending_checkpoint_ = checkpoint;
+    if (requested_lsn_ == NULL_LSN || checkpoint.end_lsn_ > requested_lsn_) {
+      requested_lsn_ = checkpoint.end_lsn_;
+    }
+    flush_request_cv_.notify_one();
+    return checkpoint.end_lsn_;
   }
+  Flush(checkpoint.end_lsn_);
+  CompleteCheckpoint(checkpoint);
+  return checkpoint.end_lsn_;
+}
 
-  auto end_checkpoint_log = std::make_shared<EndCheckpointLog>(NULL_LSN, NULL_XID, NULL_LSN, att_, dpt_);
-  lsn_t end_lsn = next_lsn_.fetch_add(end_checkpoint_log->GetSize(), std::memory_order_relaxed);
-  end_checkpoint_log->SetLSN(end_lsn);
+void LogManager::CompleteCheckpoint(const CheckpointInfo &checkpoint) {
+  std::unique_lock flush_lock(flush_mutex_);
+  // 异步检查点完成前可能已经有更新的检查点
+  if (last_checkpoint_lsn_ != NULL_LSN && checkpoint.begin_lsn_ <= last_checkpoint_lsn_) {
+    return;
+  }
+  last_checkpoint_lsn_ = checkpoint.begin_lsn_;
   {
-    std::unique_lock lock(log_buffer_mutex_);
-    log_buffer_.push_back(std::move(end_checkpoint_log));
+    std::ofstream out(MASTER_RECORD_NAME);
+    out << checkpoint.begin_lsn_ << " " << checkpoint.redo_lsn_;
   }
-  Flush(end_lsn);
-  std::ofstream out(MASTER_RECORD_NAME);
-  out << begin_lsn;
-  return end_lsn;
+  // Master Record 更新后，min_lsn_ 之前的日志段不再需要
+  disk_.RecycleLog(checkpoint.min_lsn_, flushed_lsn_);
 }
 
 void LogManager::FlushPage(oid_t table_oid, pageid_t page_id, lsn_t page_lsn) {
   Flush(page_lsn);
+  std::unique_lock table_lock(table_mutex_);
   dpt_.erase({table_oid, page_id});
 }
 
 void LogManager::Rollback(xid_t xid) {
-  // 在 att_ 中查找事务 xid 的最后一条日志的 lsn
-  // 依次获取 lsn 的 prev_lsn_，直到 NULL_LSN
-  // 根据 lsn 和 flushed_lsn_ 的大小关系，判断日志在 buffer 中还是在磁盘中
-  // 若日志在 buffer 中，通过 log_buffer_ 获取日志
-  // 若日志在磁盘中，通过 disk_ 读取日志，count 参数可设置为 MAX_LOG_SIZE
+  // 其他连接追加日志时会修改 att_，在 table_mutex_ 中取出事务 xid 的最后一条日志的 lsn
+  lsn_t last_lsn;
+  {
+    std::unique_lock table_lock(table_mutex_);
+    auto entry = att_.find(xid);
+    // 只读事务没有修改数据，无需回滚
+    if (entry == att_.end()) {
+      return;
+    }
+    last_lsn = entry->second;
+  }
+  // 从 last_lsn 开始依次获取 lsn 的 prev_lsn_，直到 NULL_LSN
+  // 通过 ReadLog 读取日志，日志可能在 buffer 中，也可能已经刷到磁盘中，count 参数可设置为 MAX_LOG_SIZE
   // 通过 LogRecord::DeserializeFrom 函数解析日志
   // 调用日志的 Undo 函数
   // LAB 2 BEGIN
 }
 
-void LogManager::Recover() {
+void LogManager::Recover(bool instant) {
   Analyze();
+  if (instant) {
+    PrepareLazyRedo();
+    return;
+  }
   Redo();
   Undo();
 }
 
+void LogManager::RedoPage(oid_t table_oid, pageid_t page_id) {
+  if (pending_pages_.empty()) {
+    return;
+  }
+  auto entry = pending_pages_.find({table_oid, page_id});
+  if (entry != pending_pages_.end()) {
+    RedoGroup(entry->second);
+  }
+}
+
+void LogManager::RecoverStep() { LazyRedo(LAZY_REDO_BATCH_GROUPS); }
+
+void LogManager::FinishRecovery() { LazyRedo(std::numeric_limits<size_t>::max()); }
+
+size_t LogManager::GetPendingRedoPageCount() const { return pending_pages_.size(); }
+
 void LogManager::IncrementRedoCount() { redo_count_++; }
 
 uint32_t LogManager::GetRedoCount() const { return redo_count_; }
 
+uint32_t LogManager::GetFlushCount() const { return flush_count_; }
+
+uint32_t LogManager::GetRedoReadCount() const { return redo_read_count_; }
+
+size_t LogManager::GetLogSegmentCount() {
+  std::unique_lock flush_lock(flush_mutex_);
+  return disk_.GetLogSegmentCount();
+}
+
 void LogManager::Flush(lsn_t lsn) {
-  size_t max_log_size = 0;
-  lsn_t max_lsn = NULL_LSN;
+  // lsn 之前的日志已经刷盘时无需再写磁盘，如果 lsn 为 NULL_LSN，表示日志缓存中所有日志都需要刷盘
+  if (lsn != NULL_LSN && IsFlushed(lsn)) {
+    return;
+  }
+  std::unique_lock flush_lock(flush_mutex_);
+  // 已经写入日志缓存的日志一次性顺序写入磁盘，写入的同时其他线程仍可以向缓存的空闲部分追加日志
+  lsn_t begin = flushed_lsn_;
+  lsn_t end = written_lsn_.load(std::memory_order_acquire);
+  // 没有日志需要刷盘
+  if (begin == end) {
+    return;
+  }
+  // 缓存首尾相接，每次写入不超过缓存的尾部和一个日志段
+  for (lsn_t position = begin; position < end;) {
+    auto offset = position % LOG_BUFFER_SIZE;
+    auto count = std::min({end - position, LOG_BUFFER_SIZE - offset, LOG_SEGMENT_SIZE});
+    disk_.WriteLog(position, count, log_buffer_.get() + offset);
+    position += count;
+  }
+  FinishFlush(end);
+}
+
+void LogManager::FinishFlush(lsn_t end) {
+  flush_count_++;
+  flushed_lsn_ = end;
+
+  lsn_t next_lsn = FIRST_LSN;
+  if (disk_.FileExists(NEXT_LSN_NAME)) {
+    std::ifstream in(NEXT_LSN_NAME);
+    in >> next_lsn;
+  }
+  if (end > next_lsn) {
+    std::ofstream out(NEXT_LSN_NAME);
+    out << end;
+  }
+  // 唤醒等待刷盘的事务
   {
-    std::unique_lock lock(log_buffer_mutex_);
-    for (auto iterator = log_buffer_.cbegin(); iterator != log_buffer_.cend();) {
-      const auto &log_record = *iterator;
-      // 如果 lsn 为 NULL_LSN，表示 log_buffer_ 中所有日志都需要刷盘
-      if (lsn != NULL_LSN && log_record->GetLSN() > lsn) {
-        iterator++;
-        continue;
+    std::unique_lock lock(group_commit_mutex_);
+  }
+  flushed_cv_.notify_all();
+}
+
+lsn_t LogManager::AppendLog(LogRecord &log) {
+  lsn_t lsn = ReserveLog(log);
+  WriteLog(log);
+  return lsn;
+}
+
+lsn_t LogManager::ReserveLog(LogRecord &log) {
+  lsn_t lsn = next_lsn_.fetch_add(log.GetSize(), std::memory_order_relaxed);
+  log.SetLSN(lsn);
+  return lsn;
+}
+
+void LogManager::WriteLog(LogRecord &log) {
+  size_t size = log.GetSize();
+  lsn_t lsn = log.GetLSN();
+  bool published = false;
+  try {
+    if (size <= LOG_BUFFER_SIZE) {
+      WaitForSpace(lsn + size);
+      auto offset = lsn % LOG_BUFFER_SIZE;
+      if (offset + size <= LOG_BUFFER_SIZE) {
+        // 直接序列化到日志缓存中
+        log.SerializeTo(log_buffer_.get() + offset);
+      } else {
+        auto data = std::make_unique<char[]>(size);
+        log.SerializeTo(data.get());
+        CopyToLogBuffer(lsn, data.get(), size);
       }
-      auto log_size = log_record->GetSize();
-      auto log = std::make_unique<char[]>(log_size);
-      log_record->SerializeTo(log.get());
-      disk_.WriteLog(log_record->GetLSN(), log_size, log.get());
-      if (max_lsn == NULL_LSN || log_record->GetLSN() > max_lsn) {
-        max_lsn = log_record->GetLSN();
-        max_log_size = log_size;
+      // 按 lsn 顺序发布，保证 written_lsn_ 之前的日志都已完整写入缓存
+      while (written_lsn_.load(std::memory_order_acquire) != lsn) {
+        std::this_thread::yield();
       }
-      iterator = log_buffer_.erase(iterator);
+      written_lsn_.store(lsn + size, std::memory_order_release);
+    } else {
+      // 超过缓存大小的日志不经过缓存：之前的日志刷盘后，持有 flush_mutex_ 直接写入磁盘
+      // 整条日志写完后才更新 written_lsn_ 和 NEXT_LSN 文件，其他线程不会刷出或读到不完整的日志
+      auto data = std::make_unique<char[]>(size);
+      log.SerializeTo(data.get());
+      while (written_lsn_.load(std::memory_order_acquire) != lsn) {
+        std::this_thread::yield();
+      }
+      // 之后的日志在 written_lsn_ 更新前无法发布，刷盘后 flushed_lsn_ 等于 lsn
+      Flush(NULL_LSN);
+      std::unique_lock flush_lock(flush_mutex_);
+      disk_.WriteLog(lsn, size, data.get());
+      written_lsn_.store(lsn + size, std::memory_order_release);
+      published = true;
+      FinishFlush(lsn + size);
+    }
+  } catch (...) {
+    // 日志未能写入时用填充日志占满 [lsn, lsn + size) 并发布，再将异常抛给调用者
+    if (!published) {
+      WritePaddingLog(PaddingLog(lsn, log.GetXid(), log.GetPrevLSN(), size));
     }
+    throw;
+  }
+}
+
+void LogManager::WritePaddingLog(const PaddingLog &log) noexcept {
+  // 只写日志头，范围内其余字节为缓存或磁盘中的旧内容，读取日志时按大小跳过
+  char header[PaddingLog::HEADER_SIZE];
+  log.SerializeTo(header);
+  while (written_lsn_.load(std::memory_order_acquire) != log.GetLSN()) {
+    std::this_thread::yield();
+  }
+  WaitForSpace(log.GetLSN() + sizeof(header));
+  CopyToLogBuffer(log.GetLSN(), header, sizeof(header));
+  written_lsn_.store(log.GetLSN() + log.GetSize(), std::memory_order_release);
+}
+
+LogManager::ReservedLogs::ReservedLogs(LogManager &log_manager) : log_manager_(log_manager) {}
+
+LogManager::ReservedLogs::~ReservedLogs() {
+  for (size_t i = 0; i < count_; i++) {
+    log_manager_.WritePaddingLog(*paddings_[i]);
+  }
+}
+
+lsn_t LogManager::ReservedLogs::Reserve(LogRecord &log) {
+  assert(count_ < paddings_.size());
+  lsn_t lsn = log_manager_.ReserveLog(log);
+  paddings_[count_++].emplace(lsn, log.GetXid(), log.GetPrevLSN(), log.GetSize());
+  return lsn;
+}
+
+void LogManager::ReservedLogs::Write(LogRecord &log) {
+  assert(count_ > 0 && paddings_[0]->GetLSN() == log.GetLSN());
+  // WriteLog 失败时自行写入填充日志，先从待写入的日志中移除
+  paddings_[0] = std::move(paddings_[1]);
+  paddings_[1].reset();
+  count_--;
+  log_manager_.WriteLog(log);
+}
+
+void LogManager::WaitForSpace(lsn_t end) {
+  // 缓存中 [end - LOG_BUFFER_SIZE, end) 的旧日志都刷盘后才能覆盖
+  while (end > flushed_lsn_ + LOG_BUFFER_SIZE) {
+    Flush(NULL_LSN);
+    std::this_thread::yield();
+  }
+}
+
+void LogManager::CopyToLogBuffer(lsn_t lsn, const char *data, size_t count) {
+  auto offset = lsn % LOG_BUFFER_SIZE;
+  auto first = std::min(count, LOG_BUFFER_SIZE - offset);
+  memcpy(log_buffer_.get() + offset, data, first);
+  memcpy(log_buffer_.get(), data + first, count - first);
+}
+
+void LogManager::ReadLog(lsn_t lsn, size_t count, char *data) {
+  // 持有 flush_mutex_ 时缓存中尚未刷盘的日志不会被覆盖
+  std::unique_lock flush_lock(flush_mutex_);
+  if (lsn < flushed_lsn_) {
+    disk_.ReadLog(lsn, count, data);
+    return;
+  }
+  count = std::min(count, static_cast<size_t>(written_lsn_.load(std::memory_order_acquire) - lsn));
+  auto offset = lsn % LOG_BUFFER_SIZE;
+  auto first = std::min(count, LOG_BUFFER_SIZE - offset);
+  memcpy(data, log_buffer_.get() + offset, first);
+  memcpy(data + first, log_buffer_.get(), count - first);
+}
+
+bool LogManager::IsFlushed(lsn_t lsn) const { return lsn < flushed_lsn_; }
+
+void LogManager::WaitForFlush(lsn_t lsn) {
+  std::unique_lock lock(group_commit_mutex_);
+  if (requested_lsn_ == NULL_LSN || lsn > requested_lsn_) {
+    requested_lsn_ = lsn;
   }
-  // 如果 max_lsn 为 NULL_LSN，表示没有日志刷盘
-  // 如果 flushed_lsn_ 为 NULL_LSN，表示还没有日志刷过盘
-  if (max_lsn != NULL_LSN && (flushed_lsn_ == NULL_LSN || max_lsn > flushed_lsn_)) {
-    flushed_lsn_ = max_lsn;
-    lsn_t next_lsn = FIRST_LSN;
-    if (disk_.FileExists(NEXT_LSN_NAME)) {
-      std::ifstream in(NEXT_LSN_NAME);
-      in >> next_lsn;
+  flush_request_cv_.notify_one();
+  flushed_cv_.wait(lock, [&]() { return IsFlushed(lsn); });
+}
+
+void LogManager::LogWriterLoop() {
+  std::unique_lock lock(group_commit_mutex_);
+  while (true) {
+    // 没有刷盘请求时每隔 wal_writer_delay_ 毫秒刷盘一次，保证异步提交的事务及时持久化
+    bool requested = flush_request_cv_.wait_for(lock, std::chrono::milliseconds(wal_writer_delay_.load()), [&]() {
+      return stop_log_writer_ || (requested_lsn_ != NULL_LSN && !IsFlushed(requested_lsn_));
+    });
+    if (stop_log_writer_) {
+      return;
+    }
+    lock.unlock();
+    // 等待一段时间，让更多提交的事务加入同一次刷盘
+    if (auto commit_delay = commit_delay_.load(); requested && commit_delay > 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(commit_delay));
+    }
+    Flush(NULL_LSN);
+    // 空闲时预先分配之后的日志段，避免刷盘时创建文件
+    if (!requested) {
+      std::unique_lock flush_lock(flush_mutex_);
+      disk_.PreallocateLog(flushed_lsn_);
     }
-    if (flushed_lsn_ + max_log_size > next_lsn) {
-      std::ofstream out(NEXT_LSN_NAME);
-      out << (flushed_lsn_ + max_log_size);
+    lock.lock();
+    // 异步检查点的日志刷盘后更新 Master Record
+    if (pending_checkpoint_.has_value() && IsFlushed(pending_checkpoint_->end_lsn_)) {
+      auto checkpoint = *pending_checkpoint_;
+      pending_checkpoint_.reset();
+      lock.unlock();
+      CompleteCheckpoint(checkpoint);
+      lock.lock();
     }
   }
 }
@@ -239,21 +575,300 @@ void LogManager::Analyze() {
   } else {
     next_lsn_ = FIRST_LSN;
   }
-  flushed_lsn_ = next_lsn_ - 1;
+  flushed_lsn_ = next_lsn_.load();
+  written_lsn_ = next_lsn_.load();
   lsn_t checkpoint_lsn = 0;
 
   if (disk_.FileExists(MASTER_RECORD_NAME)) {
     std::ifstream in(MASTER_RECORD_NAME);
-    in >> checkpoint_lsn;
+    in >> checkpoint_lsn >> redo_lsn_;
   }
   // 根据 Checkpoint 日志恢复脏页表、活跃事务表等元信息
+  // Master Record 中的 redo_lsn_ 为检查点时脏页表中最小的 recLSN，分析阶段加入脏页表的页面的 recLSN 都比它大
   // 必要时调用 transaction_manager_.SetNextXid 来恢复事务 id
   // LAB 2 BEGIN
 }
 
 void LogManager::Redo() {
-  // 正序读取日志，调用日志记录的 Redo 函数
-  // LAB 2 BEGIN
+  // 从 redo_lsn_ 开始正序读取日志，调用日志记录的 Redo 函数
+  // 日志按访问的页面分发给工作线程，同一页面的日志由同一个工作线程按 lsn 顺序重做
+  // 每个工作线程使用独立的 buffer pool，重做结束后将页面写回磁盘
+  if (redo_lsn_ >= next_lsn_) {
+    return;
+  }
+  auto dirty_pages = SnapshotDirtyPages();
+  // 工作线程直接读写磁盘上的页面，先写回缓存中的页面
+  buffer_pool_->Flush(true);
+
+  std::vector<std::unique_ptr<BufferPool>> buffer_pools;
+  for (size_t i = 0; i < redo_workers_; i++) {
+    buffer_pools.push_back(std::make_unique<BufferPool>(disk_, *this));
+  }
+  auto flush_buffer_pools = [&]() {
+    for (auto &buffer_pool : buffer_pools) {
+      buffer_pool->Flush(true);
+    }
+  };
+  RedoDispatcher dispatcher(redo_workers_, [&](size_t worker, LogRecord &log) {
+    log.Redo(*buffer_pools[worker], *catalog_, *this);
+  });
+  // 每读取一段日志，先预读这段日志访问的页面，再逐条分发，分发后的日志由工作线程重做后释放
+  ScanRedoLogs([&](std::vector<std::shared_ptr<LogRecord>> &logs) {
+    PrefetchPages(logs, dirty_pages);
+    for (auto &log : logs) {
+      auto pages = GetRedoPages(*log);
+      if (pages.empty()) {
+        continue;
+      }
+      auto worker = dispatcher.GetWorker(pages[0].table_oid_, pages[0].page_id_);
+      bool single_worker = std::all_of(pages.begin(), pages.end(), [&](const TablePageid &page) {
+        return dispatcher.GetWorker(page.table_oid_, page.page_id_) == worker;
+      });
+      if (single_worker) {
+        dispatcher.Dispatch(worker, std::move(log));
+      } else {
+        // 涉及多个工作线程的页面时，等待之前的日志重做完成并写回，再由当前线程重做
+        dispatcher.Wait();
+        flush_buffer_pools();
+        log->Redo(*buffer_pool_, *catalog_, *this);
+        buffer_pool_->Flush(true);
+      }
+    }
+  });
+  dispatcher.Wait();
+  flush_buffer_pools();
+}
+
+void LogManager::ScanRedoLogs(const std::function<void(std::vector<std::shared_ptr<LogRecord>> &logs)> &callback) {
+  // buffer 中保存从 buffer_lsn 开始、尚未解析的日志，跨越读取边界的日志留到下一次读取后解析
+  std::vector<char> buffer;
+  lsn_t buffer_lsn = redo_lsn_;
+  for (lsn_t read_lsn = redo_lsn_; read_lsn < next_lsn_;) {
+    size_t unparsed = read_lsn - buffer_lsn;
+    size_t count = REDO_READ_SEGMENTS * LOG_SEGMENT_SIZE;
+    // 超过读取大小的日志一次读取完整
+    if (unparsed >= LogRecord::SIZE_PREFIX) {
+      count = std::max(count, LogRecord::ReadSize(buffer.data()) - unparsed);
+    }
+    count = std::min<size_t>(count, next_lsn_ - read_lsn);
+    buffer.resize(unparsed + count);
+    ReadLog(read_lsn, count, buffer.data() + unparsed);
+    redo_read_count_++;
+    read_lsn += count;
+
+    std::vector<std::shared_ptr<LogRecord>> logs;
+    size_t offset = 0;
+    while (offset + LogRecord::SIZE_PREFIX <= buffer.size()) {
+      auto size = LogRecord::ReadSize(buffer.data() + offset);
+      if (size < LogRecord::SIZE_PREFIX) {
+        throw DbException("invalid log size " + std::to_string(size) + " at lsn " +
+                          std::to_string(buffer_lsn + offset));
+      }
+      if (offset + size > buffer.size()) {
+        break;
+      }
+      logs.push_back(LogRecord::DeserializeFrom(buffer_lsn + offset, buffer.data() + offset));
+      offset += size;
+    }
+    buffer.erase(buffer.begin(), buffer.begin() + offset);
+    buffer_lsn += offset;
+    callback(logs);
+  }
+}
+
+std::shared_ptr<LogRecord> LogManager::ReadRedoLog(lsn_t lsn) {
+  // 先读取日志开头得到日志大小，再读取整条日志
+  // 即时恢复时日志写线程同时在写日志文件，通过 ReadLog 在 flush_mutex_ 保护下读取
+  std::vector<char> buffer(LogRecord::SIZE_PREFIX);
+  ReadLog(lsn, buffer.size(), buffer.data());
+  buffer.resize(LogRecord::ReadSize(buffer.data()));
+  ReadLog(lsn, buffer.size(), buffer.data());
+  return LogRecord::DeserializeFrom(lsn, buffer.data());
+}
+
+std::unordered_set<TablePageid> LogManager::SnapshotDirtyPages() {
+  std::unique_lock table_lock(table_mutex_);
+  std::unordered_set<TablePageid> dirty_pages;
+  for (const auto &[page, lsn] : dpt_) {
+    dirty_pages.insert(page);
+  }
+  return dirty_pages;
+}
+
+void LogManager::PrefetchPages(const std::vector<std::shared_ptr<LogRecord>> &logs,
+                               const std::unordered_set<TablePageid> &dirty_pages) {
+  // 同一文件的页面按页号排序后一起预读
+  std::map<std::string, std::vector<pageid_t>> files;
+  std::unordered_map<oid_t, oid_t> db_oids;
+  for (const auto &log : logs) {
+    for (const auto &page : GetRedoPages(*log)) {
+      if (!dirty_pages.empty() && dirty_pages.count(page) == 0) {
+        continue;
+      }
+      if (!catalog_->TableExists(page.table_oid_)) {
+        continue;
+      }
+      auto db_oid = db_oids.find(page.table_oid_);
+      if (db_oid == db_oids.end()) {
+        auto oid = log->GetType() == LogType::INDEX_PAGE ? dynamic_cast<const IndexPageLog &>(*log).GetDbOid()
+                                                          : catalog_->GetDatabaseOid(page.table_oid_);
+        db_oid = db_oids.emplace(page.table_oid_, oid).first;
+      }
+      files[Disk::GetFilePath(db_oid->second, page.table_oid_)].push_back(page.page_id_);
+    }
+  }
+  for (auto &[path, page_ids] : files) {
+    std::sort(page_ids.begin(), page_ids.end());
+    page_ids.erase(std::unique(page_ids.begin(), page_ids.end()), page_ids.end());
+    disk_.PrefetchPages(path, page_ids);
+  }
+}
+
+void LogManager::PrepareLazyRedo() {
+  lazy_recovery_ = true;
+  for (const auto &[xid, lsn] : att_) {
+    loser_xids_.push_back(xid);
+  }
+  // 用并查集合并同一条日志访问的页面，parent 的下标为页面组编号
+  std::vector<size_t> parent;
+  auto find = [&](size_t group) {
+    while (parent[group] != group) {
+      parent[group] = parent[parent[group]];
+      group = parent[group];
+    }
+    return group;
+  };
+  auto &lock_manager = transaction_manager_.GetLockManager();
+  auto dirty_pages = SnapshotDirtyPages();
+  std::vector<std::pair<lsn_t, size_t>> logs;
+  ScanRedoLogs([&](std::vector<std::shared_ptr<LogRecord>> &redo_logs) {
+    // 之后的语句和 RecoverStep 很快会访问这些页面，提前预读
+    PrefetchPages(redo_logs, dirty_pages);
+    for (auto &log : redo_logs) {
+      auto pages = GetRedoPages(*log);
+      if (pages.empty()) {
+        continue;
+      }
+      std::optional<size_t> group;
+      for (const auto &page : pages) {
+        auto [entry, inserted] = pending_pages_.try_emplace(page, parent.size());
+        if (inserted) {
+          parent.push_back(parent.size());
+        }
+        auto root = find(entry->second);
+        if (!group.has_value()) {
+          group = root;
+        } else {
+          parent[root] = *group;
+        }
+      }
+      // 活跃事务修改的记录在回滚前保持加锁
+      if (att_.find(log->GetXid()) != att_.end()) {
+        std::optional<Rid> rid;
+        if (log->GetType() == LogType::INSERT) {
+          const auto &insert_log = dynamic_cast<const InsertLog &>(*log);
+          rid = {insert_log.GetPageId(), insert_log.GetSlotId()};
+        } else if (log->GetType() == LogType::DELETE) {
+          const auto &delete_log = dynamic_cast<const DeleteLog &>(*log);
+          rid = {delete_log.GetPageId(), delete_log.GetSlotId()};
+        }
+        if (rid.has_value()) {
+          lock_manager.LockTable(log->GetXid(), LockType::IX, pages[0].table_oid_);
+          lock_manager.LockRow(log->GetXid(), LockType::X, pages[0].table_oid_, *rid);
+        }
+      }
+      logs.emplace_back(log->GetLSN(), *group);
+    }
+  });
+  redo_groups_.resize(parent.size());
+  for (const auto &[lsn, group] : logs) {
+    redo_groups_[find(group)].push_back(lsn);
+  }
+  // 尚未重做的页面加入脏页表，保证检查点不会越过它们的日志
+  for (auto &[page, group] : pending_pages_) {
+    group = find(group);
+    SetDirty(page.table_oid_, page.page_id_, redo_groups_[group].front());
+  }
+}
+
+void LogManager::RedoGroup(size_t group) {
+  auto lsns = std::move(redo_groups_[group]);
+  redo_groups_[group].clear();
+  // 逐条重新读取该组的日志并重做，同一时刻只保留一条日志
+  // 日志只访问自己涉及的页面，重做前先删除这些页面，重做时读取它们不会再次触发重做
+  std::vector<TablePageid> pages;
+  for (auto lsn : lsns) {
+    auto log = ReadRedoLog(lsn);
+    for (const auto &page : GetRedoPages(*log)) {
+      if (pending_pages_.erase(page) != 0) {
+        pages.push_back(page);
+      }
+    }
+    log->Redo(*buffer_pool_, *catalog_, *this);
+  }
+  // 页面已经包含日志的修改时重做不会弄脏页面，从脏页表中删除
+  auto dirty_pages = buffer_pool_->GetDirtyPages();
+  std::unique_lock table_lock(table_mutex_);
+  for (const auto &page : pages) {
+    if (std::find(dirty_pages.begin(), dirty_pages.end(), page) == dirty_pages.end()) {
+      dpt_.erase(page);
+    }
+  }
+}
+
+void LogManager::LazyRedo(size_t group_count) {
+  if (!lazy_recovery_) {
+    return;
+  }
+  for (; next_redo_group_ < redo_groups_.size() && group_count > 0; next_redo_group_++) {
+    if (!redo_groups_[next_redo_group_].empty()) {
+      RedoGroup(next_redo_group_);
+      group_count--;
+    }
+  }
+  if (next_redo_group_ < redo_groups_.size()) {
+    return;
+  }
+  lazy_recovery_ = false;
+  redo_groups_.clear();
+  next_redo_group_ = 0;
+  Undo();
+  for (auto xid : loser_xids_) {
+    transaction_manager_.GetLockManager().ReleaseLocks(xid);
+  }
+  loser_xids_.clear();
+}
+
+std::vector<TablePageid> LogManager::GetRedoPages(const LogRecord &log) {
+  switch (log.GetType()) {
+    case LogType::INSERT: {
+      const auto &insert_log = dynamic_cast<const InsertLog &>(log);
+      return {{insert_log.GetOid(), insert_log.GetPageId()}};
+    }
+    case LogType::DELETE: {
+      const auto &delete_log = dynamic_cast<const DeleteLog &>(log);
+      return {{delete_log.GetOid(), delete_log.GetPageId()}};
+    }
+    case LogType::NEW_PAGE: {
+      const auto &new_page_log = dynamic_cast<const NewPageLog &>(log);
+      std::vector<TablePageid> pages = {{new_page_log.GetOid(), new_page_log.GetPageId()}};
+      if (new_page_log.GetPrevPageId() != NULL_PAGE_ID) {
+        pages.push_back({new_page_log.GetOid(), new_page_log.GetPrevPageId()});
+      }
+      return pages;
+    }
+    case LogType::INDEX_PAGE: {
+      const auto &index_page_log = dynamic_cast<const IndexPageLog &>(log);
+      std::vector<TablePageid> pages;
+      for (const auto &[page_id, image] : index_page_log.GetPages()) {
+        pages.push_back({index_page_log.GetOid(), page_id});
+      }
+      return pages;
+    }
+    default:
+      // 其他日志不修改页面，无需重做
+      return {};
+  }
 }
 
 void LogManager::Undo() {
@@ -1,14 +1,22 @@
 #pragma once
 
+#include <array>
 #include <atomic>
-#include <list>
+#include <condition_variable>
+#include <functional>
 #include <mutex>
-#include <shared_mutex>
+#include <optional>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "catalog/catalog.h"
 #include "common/constants.h"
 #include "log/log_record.h"
+#include "log/log_records/begin_log.h"
+#include "log/log_records/padding_log.h"
 #include "storage/buffer_pool.h"
 #include "storage/disk.h"
 #include "transaction/transaction_manager.h"
@@ -18,6 +26,7 @@ namespace huadb {
 class LogManager {
  public:
   LogManager(Disk &disk, TransactionManager &transaction_manager, lsn_t next_lsn);
+  ~LogManager();
 
   void SetBufferPool(std::shared_ptr<BufferPool> buffer_pool);
   void SetCatalog(std::shared_ptr<Catalog> catalog);
@@ -30,6 +39,13 @@ class LogManager {
   // 将日志缓存刷盘
   void Flush();
 
+  // 组提交时日志写线程等待更多事务提交的时间（微秒）
+  void SetCommitDelay(uint32_t commit_delay);
+  // 日志写线程定期刷盘的间隔（毫秒）
+  void SetWalWriterDelay(uint32_t wal_writer_delay);
+  // 故障恢复时并行重做的工作线程数
+  void SetRedoWorkers(size_t redo_workers);
+
   // 将 {oid, page_id} 添加到脏页表
   void SetDirty(oid_t oid, pageid_t page_id, lsn_t lsn);
 
@@ -38,11 +54,15 @@ class LogManager {
                         char *new_record);
   lsn_t AppendDeleteLog(xid_t xid, oid_t oid, pageid_t page_id, slotid_t slot_id);
   lsn_t AppendNewPageLog(xid_t xid, oid_t oid, pageid_t prev_page_id, pageid_t page_id);
+  lsn_t AppendIndexPageLog(xid_t xid, oid_t db_oid, oid_t oid,
+                           std::vector<std::pair<pageid_t, std::vector<char>>> pages);
+  // 事务第一次写日志时才追加 Begin 日志，没有写过日志的只读事务提交或回滚时不写日志，返回 NULL_LSN
   lsn_t AppendBeginLog(xid_t xid);
-  lsn_t AppendCommitLog(xid_t xid);
+  // synchronous 为 false 时异步提交，提交日志写入日志缓存后立即返回，由日志写线程定期刷盘
+  lsn_t AppendCommitLog(xid_t xid, bool synchronous = true);
   lsn_t AppendRollbackLog(xid_t xid);
 
-  // async: 是否异步刷盘（高级功能）
+  // async: 是否异步刷盘，为 true 时不等待检查点日志刷盘，由日志写线程刷盘后更新 Master Record
   lsn_t Checkpoint(bool async = false);
 
   // 刷脏页，需维护脏页表
@@ -51,23 +71,108 @@ class LogManager {
   // 回滚单个事务
   void Rollback(xid_t xid);
 
-  // 故障恢复
-  void Recover();
+  // 故障恢复，instant 为 true 时即时恢复：分析阶段后立即返回，脏页在第一次访问时重做
+  // 剩余的页面由 RecoverStep 在语句之间逐批重做，全部重做后回滚活跃事务，回滚前活跃事务修改的记录保持加锁
+  void Recover(bool instant = false);
+  // 即时恢复时重做页面所在的页面组，由 buffer pool 在读取页面前调用
+  void RedoPage(oid_t table_oid, pageid_t page_id);
+  // 即时恢复时重做一批尚未访问的页面组，全部重做后执行回滚阶段
+  void RecoverStep();
+  // 完成即时恢复剩余的重做和回滚
+  void FinishRecovery();
+  // 即时恢复时尚未重做的页面数
+  size_t GetPendingRedoPageCount() const;
 
   // Redo 次数递增
   void IncrementRedoCount();
   // Redo 次数统计
   uint32_t GetRedoCount() const;
+  // 日志刷盘次数统计
+  uint32_t GetFlushCount() const;
+  // 恢复时读取日志的次数统计
+  uint32_t GetRedoReadCount() const;
+  // 日志段数统计
+  size_t GetLogSegmentCount();
 
  private:
   // 将 lsn 之前的日志刷到磁盘
   void Flush(lsn_t lsn);
+  // 日志写到 end 后更新已刷盘的位置和 NEXT_LSN 文件，并唤醒等待刷盘的事务，调用时需持有 flush_mutex_
+  void FinishFlush(lsn_t end);
+  // lsn 处的日志是否已经刷到磁盘
+  bool IsFlushed(lsn_t lsn) const;
+  // 分配 lsn 并将日志序列化到日志缓存中，返回日志的 lsn
+  lsn_t AppendLog(LogRecord &log);
+  // 为日志分配 lsn，与活跃事务表和脏页表的更新一起在 table_mutex_ 中进行，保证检查点看到的脏页表不遗漏日志
+  lsn_t ReserveLog(LogRecord &log);
+  // 将已分配 lsn 的日志写入日志缓存，不持有 table_mutex_，同一线程的日志按 lsn 顺序写入
+  // 写入失败时以填充日志发布 lsn 范围后再抛出异常，之后的日志不会一直等待 written_lsn_
+  void WriteLog(LogRecord &log);
+  // 写入填充日志并更新 written_lsn_，刷盘失败时无法继续写日志，进程终止
+  void WritePaddingLog(const PaddingLog &log) noexcept;
+  // 等待日志缓存中 end 之前的空间可用，必要时刷盘
+  void WaitForSpace(lsn_t end);
+  // 将 count 字节的日志复制到日志缓存中 lsn 对应的位置
+  void CopyToLogBuffer(lsn_t lsn, const char *data, size_t count);
+  // 读取 lsn 处的日志，日志可能在日志缓存中或磁盘中
+  void ReadLog(lsn_t lsn, size_t count, char *data);
+  // 通知日志写线程刷盘，并等待 lsn 之前的日志刷到磁盘
+  void WaitForFlush(lsn_t lsn);
+  // 日志写线程：将等待提交的事务的日志合并为一次写入
+  void LogWriterLoop();
+  // 一次追加中已分配 lsn、尚未写入的日志（最多为 Begin 日志和修改日志两条），记录为同样范围的填充日志
+  // 分配 lsn 后到写入前抛出异常时，析构函数写入这些填充日志，保证分配的 lsn 范围都会发布
+  class ReservedLogs {
+   public:
+    explicit ReservedLogs(LogManager &log_manager);
+    ~ReservedLogs();
+    // 分配 lsn，调用时需持有 table_mutex_
+    lsn_t Reserve(LogRecord &log);
+    // 按 lsn 顺序写入日志
+    void Write(LogRecord &log);
+
+   private:
+    LogManager &log_manager_;
+    std::array<std::optional<PaddingLog>, 2> paddings_;
+    size_t count_ = 0;
+  };
+  // 为事务第一次写日志时的 Begin 日志分配 lsn 并加入活跃事务表，调用时需持有 table_mutex_
+  // 返回的日志需在事务的其他日志之前通过 reserved.Write 写入
+  BeginLog ReserveBeginLog(xid_t xid, ReservedLogs &reserved);
+
+  struct CheckpointInfo {
+    lsn_t begin_lsn_;
+    // 重做阶段开始的 lsn
+    lsn_t redo_lsn_;
+    // 恢复需要的最早的日志，之前的日志段可以回收
+    lsn_t min_lsn_;
+    lsn_t end_lsn_;
+  };
+  // 检查点日志刷盘后，更新 Master Record 并回收日志段
+  void CompleteCheckpoint(const CheckpointInfo &checkpoint);
 
   // ARIES 相关函数
   // 分析阶段，恢复脏页表和活跃事务表
   void Analyze();
   // 重做阶段，恢复未刷盘的脏页
   void Redo();
+  // 日志重做时访问的页面
+  static std::vector<TablePageid> GetRedoPages(const LogRecord &log);
+  // 分段顺序读取并解析 [redo_lsn_, next_lsn_) 的日志，每次读取后将解析出的完整日志交给 callback
+  void ScanRedoLogs(const std::function<void(std::vector<std::shared_ptr<LogRecord>> &logs)> &callback);
+  // 从磁盘读取 lsn 处的一条日志
+  std::shared_ptr<LogRecord> ReadRedoLog(lsn_t lsn);
+  // 分析阶段结束时脏页表中的页面，重做期间工作线程写回页面会修改脏页表，预读时使用该快照
+  std::unordered_set<TablePageid> SnapshotDirtyPages();
+  // 按文件和页号顺序预读日志访问的页面，dirty_pages 非空时只预读其中的页面
+  void PrefetchPages(const std::vector<std::shared_ptr<LogRecord>> &logs,
+                     const std::unordered_set<TablePageid> &dirty_pages);
+  // 即时恢复：扫描需要重做的日志，按访问的页面分组，为活跃事务修改的记录加锁
+  void PrepareLazyRedo();
+  // 重做一个页面组的日志
+  void RedoGroup(size_t group);
+  // 重做 group_count 个页面组，全部重做后执行回滚阶段并释放活跃事务的锁
+  void LazyRedo(size_t group_count);
   // 恢复阶段，回滚所有活跃事务
   void Undo();
 
@@ -78,16 +183,57 @@ class LogManager {
 
   std::unordered_map<xid_t, lsn_t> att_;        // 活跃事务表
   std::unordered_map<TablePageid, lsn_t> dpt_;  // 脏页表
+  // 活跃事务的 Begin 日志的 lsn，用于确定可以回收的日志段
+  std::unordered_map<xid_t, lsn_t> begin_lsns_;
+  // 保护活跃事务表和脏页表
+  std::mutex table_mutex_;
 
   // 下一条日志的 lsn
   std::atomic<lsn_t> next_lsn_;
-  // 已经刷到磁盘的最大 lsn
-  lsn_t flushed_lsn_;
-
-  std::list<std::shared_ptr<LogRecord>> log_buffer_;
-  std::shared_mutex log_buffer_mutex_;
-
-  uint32_t redo_count_ = 0;
+  // 已经刷到磁盘的日志末尾，lsn 小于它的日志都已经在磁盘中
+  std::atomic<lsn_t> flushed_lsn_;
+
+  // 日志缓存，首尾相接，lsn 对应的日志存放在 lsn % LOG_BUFFER_SIZE 处
+  // [flushed_lsn_, written_lsn_) 为已经写入缓存、尚未刷盘的日志
+  std::unique_ptr<char[]> log_buffer_;
+  // 已经完整写入日志缓存的日志末尾
+  std::atomic<lsn_t> written_lsn_;
+  // 同一时刻只有一个线程写日志文件
+  std::mutex flush_mutex_;
+
+  // 组提交：提交的事务请求刷盘后在 flushed_cv_ 上等待，日志写线程在 flush_request_cv_ 上等待刷盘请求
+  std::thread log_writer_;
+  std::mutex group_commit_mutex_;
+  std::condition_variable flush_request_cv_;
+  std::condition_variable flushed_cv_;
+  // 请求刷盘的最大 lsn
+  lsn_t requested_lsn_ = NULL_LSN;
+  // 等待日志刷盘的异步检查点
+  std::optional<CheckpointInfo> pending_checkpoint_;
+  // Master Record 中记录的检查点
+  lsn_t last_checkpoint_lsn_ = NULL_LSN;
+  // 重做阶段开始的 lsn
+  lsn_t redo_lsn_ = FIRST_LSN;
+  bool stop_log_writer_ = false;
+  std::atomic<uint32_t> commit_delay_ = DEFAULT_COMMIT_DELAY;
+  std::atomic<uint32_t> wal_writer_delay_ = DEFAULT_WAL_WRITER_DELAY;
+  size_t redo_workers_ = DEFAULT_REDO_WORKERS;
+
+  // 即时恢复：日志访问的页面被合并为页面组，同时访问多个页面的日志使这些页面属于同一组
+  // 一个页面组的日志按 lsn 顺序一起重做，重做后从 pending_pages_ 中删除该组的页面
+  // redo_groups_ 只保存每组日志的 lsn，重做时再从磁盘读取日志，内存占用与日志条数而非日志大小成正比
+  bool lazy_recovery_ = false;
+  std::unordered_map<TablePageid, size_t> pending_pages_;
+  std::vector<std::vector<lsn_t>> redo_groups_;
+  // RecoverStep 下一个检查的页面组
+  size_t next_redo_group_ = 0;
+  // 等待回滚的活跃事务
+  std::vector<xid_t> loser_xids_;
+
+  // 并行重做时由多个工作线程递增
+  std::atomic<uint32_t> redo_count_ = 0;
+  std::atomic<uint32_t> flush_count_ = 0;
+  uint32_t redo_read_count_ = 0;
 };
 
 }  // namespace huadb
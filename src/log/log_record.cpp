@@ -7,13 +7,15 @@ namespace huadb {
 LogRecord::LogRecord(LogType type, lsn_t lsn, xid_t xid, lsn_t prev_lsn)
     : type_(type), lsn_(lsn), xid_(xid), prev_lsn_(prev_lsn) {
   // LSN 为日志记录在日志文件中的位置，无需占用空间
-  size_ = sizeof(type_) + sizeof(xid_) + sizeof(prev_lsn_);
+  size_ = sizeof(type_) + sizeof(size_) + sizeof(xid_) + sizeof(prev_lsn_);
 }
 
 size_t LogRecord::SerializeTo(char *data) const {
   size_t offset = 0;
   memcpy(data + offset, &type_, sizeof(type_));
   offset += sizeof(type_);
+  memcpy(data + offset, &size_, sizeof(size_));
+  offset += sizeof(size_);
   memcpy(data + offset, &xid_, sizeof(xid_));
   offset += sizeof(xid_);
   memcpy(data + offset, &prev_lsn_, sizeof(prev_lsn_));
@@ -26,26 +28,36 @@ std::shared_ptr<LogRecord> LogRecord::DeserializeFrom(lsn_t lsn, const char *dat
   memcpy(&type, data, sizeof(type));
   switch (type) {
     case LogType::INSERT:
-      return InsertLog::DeserializeFrom(lsn, data + sizeof(type));
+      return InsertLog::DeserializeFrom(lsn, data + SIZE_PREFIX);
     case LogType::DELETE:
-      return DeleteLog::DeserializeFrom(lsn, data + sizeof(type));
+      return DeleteLog::DeserializeFrom(lsn, data + SIZE_PREFIX);
     case LogType::NEW_PAGE:
-      return NewPageLog::DeserializeFrom(lsn, data + sizeof(type));
+      return NewPageLog::DeserializeFrom(lsn, data + SIZE_PREFIX);
     case LogType::BEGIN:
-      return BeginLog::DeserializeFrom(lsn, data + sizeof(type));
+      return BeginLog::DeserializeFrom(lsn, data + SIZE_PREFIX);
     case LogType::COMMIT:
-      return CommitLog::DeserializeFrom(lsn, data + sizeof(type));
+      return CommitLog::DeserializeFrom(lsn, data + SIZE_PREFIX);
     case LogType::ROLLBACK:
-      return RollbackLog::DeserializeFrom(lsn, data + sizeof(type));
+      return RollbackLog::DeserializeFrom(lsn, data + SIZE_PREFIX);
     case LogType::BEGIN_CHECKPOINT:
-      return BeginCheckpointLog::DeserializeFrom(lsn, data + sizeof(type));
+      return BeginCheckpointLog::DeserializeFrom(lsn, data + SIZE_PREFIX);
     case LogType::END_CHECKPOINT:
-      return EndCheckpointLog::DeserializeFrom(lsn, data + sizeof(type));
+      return EndCheckpointLog::DeserializeFrom(lsn, data + SIZE_PREFIX);
+    case LogType::INDEX_PAGE:
+      return IndexPageLog::DeserializeFrom(lsn, data + SIZE_PREFIX);
+    case LogType::PADDING:
+      return PaddingLog::DeserializeFrom(lsn, data + SIZE_PREFIX, ReadSize(data));
     default:
       throw DbException("Unknown log type in DeserializeFrom");
   }
 }
 
+size_t LogRecord::ReadSize(const char *data) {
+  uint32_t size;
+  memcpy(&size, data + sizeof(LogType), sizeof(size));
+  return size;
+}
+
 void LogRecord::Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn) {}
 
 void LogRecord::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {}
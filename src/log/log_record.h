@@ -22,6 +22,8 @@ enum class LogType : enum_t {
   NEW_PAGE,
   BEGIN_CHECKPOINT,
   END_CHECKPOINT,
+  INDEX_PAGE,
+  PADDING,
 };
 
 class LogRecord {
@@ -31,6 +33,9 @@ class LogRecord {
   // 序列化和反序列化
   virtual size_t SerializeTo(char *data) const;
   static std::shared_ptr<LogRecord> DeserializeFrom(lsn_t lsn, const char *data);
+  // 序列化的日志以类型和大小开头，读取前 SIZE_PREFIX 字节即可得到整条日志的大小，用于分段读取日志
+  static constexpr size_t SIZE_PREFIX = sizeof(LogType) + sizeof(uint32_t);
+  static size_t ReadSize(const char *data);
 
   // 撤销和重做，undo_next_lsn 用于高级功能中的补偿日式
   virtual void Undo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager, lsn_t undo_next_lsn);
@@ -16,6 +16,7 @@ class DeleteLog : public LogRecord {
 
   oid_t GetOid() const;
   pageid_t GetPageId() const;
+  slotid_t GetSlotId() const;
 
   std::string ToString() const override;
 
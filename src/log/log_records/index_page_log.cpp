@@ -0,0 +1,97 @@
+#include "log/log_records/index_page_log.h"
+
+#include "log/log_manager.h"
+
+namespace huadb {
+
+IndexPageLog::IndexPageLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t db_oid, oid_t oid,
+                           std::vector<std::pair<pageid_t, std::vector<char>>> pages)
+    : LogRecord(LogType::INDEX_PAGE, lsn, xid, prev_lsn), db_oid_(db_oid), oid_(oid), pages_(std::move(pages)) {
+  size_ += sizeof(db_oid_) + sizeof(oid_) + sizeof(db_size_t) + pages_.size() * (sizeof(pageid_t) + DB_PAGE_SIZE);
+}
+
+size_t IndexPageLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  memcpy(data + offset, &db_oid_, sizeof(db_oid_));
+  offset += sizeof(db_oid_);
+  memcpy(data + offset, &oid_, sizeof(oid_));
+  offset += sizeof(oid_);
+  db_size_t page_count = pages_.size();
+  memcpy(data + offset, &page_count, sizeof(page_count));
+  offset += sizeof(page_count);
+  for (const auto &[page_id, image] : pages_) {
+    memcpy(data + offset, &page_id, sizeof(page_id));
+    offset += sizeof(page_id);
+    memcpy(data + offset, image.data(), DB_PAGE_SIZE);
+    offset += DB_PAGE_SIZE;
+  }
+  assert(offset == size_);
+  return offset;
+}
+
+std::shared_ptr<IndexPageLog> IndexPageLog::DeserializeFrom(lsn_t lsn, const char *data) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  oid_t db_oid, oid;
+  db_size_t page_count;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  memcpy(&db_oid, data + offset, sizeof(db_oid));
+  offset += sizeof(db_oid);
+  memcpy(&oid, data + offset, sizeof(oid));
+  offset += sizeof(oid);
+  memcpy(&page_count, data + offset, sizeof(page_count));
+  offset += sizeof(page_count);
+  std::vector<std::pair<pageid_t, std::vector<char>>> pages;
+  for (db_size_t i = 0; i < page_count; i++) {
+    pageid_t page_id;
+    memcpy(&page_id, data + offset, sizeof(page_id));
+    offset += sizeof(page_id);
+    pages.emplace_back(page_id, std::vector<char>(data + offset, data + offset + DB_PAGE_SIZE));
+    offset += DB_PAGE_SIZE;
+  }
+  return std::make_shared<IndexPageLog>(lsn, xid, prev_lsn, db_oid, oid, std::move(pages));
+}
+
+void IndexPageLog::Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) {
+  // 如果 oid_ 不存在，表示该索引已经被删除，无需 redo
+  if (!catalog.TableExists(oid_)) {
+    return;
+  }
+  for (const auto &[page_id, image] : pages_) {
+    std::shared_ptr<Page> page;
+    bool is_new = false;
+    try {
+      page = buffer_pool.GetPage(db_oid_, oid_, page_id);
+    } catch (const DbException &) {
+      // 新分配的页面尚未写入磁盘
+      page = buffer_pool.NewPage(db_oid_, oid_, page_id);
+      is_new = true;
+    }
+    lsn_t page_lsn;
+    memcpy(&page_lsn, page->GetData(), sizeof(page_lsn));
+    if (!is_new && page_lsn >= lsn_) {
+      continue;
+    }
+    memcpy(page->GetData(), image.data(), DB_PAGE_SIZE);
+    memcpy(page->GetData(), &lsn_, sizeof(lsn_));
+    page->SetDirty();
+    log_manager.IncrementRedoCount();
+  }
+}
+
+oid_t IndexPageLog::GetDbOid() const { return db_oid_; }
+
+oid_t IndexPageLog::GetOid() const { return oid_; }
+
+const std::vector<std::pair<pageid_t, std::vector<char>>> &IndexPageLog::GetPages() const { return pages_; }
+
+std::string IndexPageLog::ToString() const {
+  return fmt::format("IndexPageLog\t\t[{}\tdb_oid: {}\toid: {}\tpage_count: {}]", LogRecord::ToString(), db_oid_,
+                     oid_, pages_.size());
+}
+
+}  // namespace huadb
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// 索引修改日志，记录一次索引操作涉及的所有页面的整页镜像（包括分裂和合并产生的页面），保证结构修改的原子性
+// 索引页面的修改只需重做，不加入事务的 undo 链：事务回滚后残留的索引项在回表时根据记录的删除标记过滤
+class IndexPageLog : public LogRecord {
+ public:
+  IndexPageLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, oid_t db_oid, oid_t oid,
+               std::vector<std::pair<pageid_t, std::vector<char>>> pages);
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<IndexPageLog> DeserializeFrom(lsn_t lsn, const char *data);
+
+  void Redo(BufferPool &buffer_pool, Catalog &catalog, LogManager &log_manager) override;
+
+  oid_t GetDbOid() const;
+  oid_t GetOid() const;
+  const std::vector<std::pair<pageid_t, std::vector<char>>> &GetPages() const;
+
+  std::string ToString() const override;
+
+ private:
+  oid_t db_oid_;
+  oid_t oid_;
+  std::vector<std::pair<pageid_t, std::vector<char>>> pages_;
+};
+
+}  // namespace huadb
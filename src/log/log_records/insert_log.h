@@ -18,6 +18,7 @@ class InsertLog : public LogRecord {
 
   oid_t GetOid() const;
   pageid_t GetPageId() const;
+  slotid_t GetSlotId() const;
 
   std::string ToString() const override;
 
@@ -5,6 +5,8 @@
 #include "log/log_records/commit_log.h"
 #include "log/log_records/delete_log.h"
 #include "log/log_records/end_checkpoint_log.h"
+#include "log/log_records/index_page_log.h"
 #include "log/log_records/insert_log.h"
 #include "log/log_records/new_page_log.h"
+#include "log/log_records/padding_log.h"
 #include "log/log_records/rollback_log.h"
@@ -0,0 +1,30 @@
+#include "log/log_records/padding_log.h"
+
+namespace huadb {
+
+PaddingLog::PaddingLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, size_t size)
+    : LogRecord(LogType::PADDING, lsn, xid, prev_lsn) {
+  assert(size >= size_);
+  size_ = size;
+}
+
+size_t PaddingLog::SerializeTo(char *data) const {
+  size_t offset = LogRecord::SerializeTo(data);
+  assert(offset == HEADER_SIZE);
+  return offset;
+}
+
+std::shared_ptr<PaddingLog> PaddingLog::DeserializeFrom(lsn_t lsn, const char *data, size_t size) {
+  xid_t xid;
+  lsn_t prev_lsn;
+  size_t offset = 0;
+  memcpy(&xid, data + offset, sizeof(xid));
+  offset += sizeof(xid);
+  memcpy(&prev_lsn, data + offset, sizeof(prev_lsn));
+  offset += sizeof(prev_lsn);
+  return std::make_shared<PaddingLog>(lsn, xid, prev_lsn, size);
+}
+
+std::string PaddingLog::ToString() const { return fmt::format("PaddingLog\t\t[{}]", LogRecord::ToString()); }
+
+}  // namespace huadb
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "log/log_record.h"
+
+namespace huadb {
+
+// 填充日志：已分配 lsn 的日志无法写入时占满其 lsn 范围，只写日志头，读取时按大小跳过
+// 保留原日志的 xid 和 prev_lsn，回滚时沿 prev_lsn 越过填充日志
+class PaddingLog : public LogRecord {
+ public:
+  PaddingLog(lsn_t lsn, xid_t xid, lsn_t prev_lsn, size_t size);
+
+  // 日志头的大小，填充日志只序列化日志头
+  static constexpr size_t HEADER_SIZE = SIZE_PREFIX + sizeof(xid_t) + sizeof(lsn_t);
+
+  size_t SerializeTo(char *data) const override;
+  static std::shared_ptr<PaddingLog> DeserializeFrom(lsn_t lsn, const char *data, size_t size);
+
+  std::string ToString() const override;
+};
+
+}  // namespace huadb
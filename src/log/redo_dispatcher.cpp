@@ -0,0 +1,76 @@
+#include "log/redo_dispatcher.h"
+
+namespace huadb {
+
+RedoDispatcher::RedoDispatcher(size_t worker_count, RedoFunction redo, size_t max_pending)
+    : redo_(std::move(redo)), workers_(worker_count), max_pending_(max_pending) {
+  for (size_t i = 0; i < worker_count; i++) {
+    workers_[i].thread_ = std::thread(&RedoDispatcher::WorkerLoop, this, i);
+  }
+}
+
+RedoDispatcher::~RedoDispatcher() {
+  {
+    std::unique_lock lock(mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.thread_.join();
+  }
+}
+
+size_t RedoDispatcher::GetWorkerCount() const { return workers_.size(); }
+
+size_t RedoDispatcher::GetWorker(oid_t table_oid, pageid_t page_id) const {
+  return std::hash<TablePageid>()({table_oid, page_id / REDO_PARTITION_PAGES}) % workers_.size();
+}
+
+void RedoDispatcher::Dispatch(size_t worker, std::shared_ptr<LogRecord> log) {
+  {
+    std::unique_lock lock(mutex_);
+    done_cv_.wait(lock, [&]() { return pending_ < max_pending_; });
+    workers_[worker].queue_.push_back(std::move(log));
+    pending_++;
+  }
+  work_cv_.notify_all();
+}
+
+void RedoDispatcher::Wait() {
+  std::unique_lock lock(mutex_);
+  done_cv_.wait(lock, [&]() { return pending_ == 0; });
+  if (exception_ != nullptr) {
+    auto exception = exception_;
+    exception_ = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+void RedoDispatcher::WorkerLoop(size_t worker) {
+  auto &queue = workers_[worker].queue_;
+  std::unique_lock lock(mutex_);
+  while (true) {
+    work_cv_.wait(lock, [&]() { return stop_ || !queue.empty(); });
+    if (queue.empty()) {
+      return;
+    }
+    auto log = std::move(queue.front());
+    queue.pop_front();
+    lock.unlock();
+    std::exception_ptr exception;
+    try {
+      redo_(worker, *log);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    lock.lock();
+    if (exception != nullptr && exception_ == nullptr) {
+      exception_ = exception;
+    }
+    if (--pending_ == 0 || pending_ + 1 == max_pending_) {
+      done_cv_.notify_all();
+    }
+  }
+}
+
+}  // namespace huadb
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/constants.h"
+#include "common/types.h"
+#include "log/log_record.h"
+
+namespace huadb {
+
+// 并行重做：恢复线程按 lsn 顺序读取日志并分发给工作线程，每个工作线程按分发顺序重做自己的日志
+// 同一页面的日志总是分发给同一个工作线程，因此每个页面的日志仍按 lsn 顺序重做
+class RedoDispatcher {
+ public:
+  // 工作线程 worker 重做日志 log
+  using RedoFunction = std::function<void(size_t worker, LogRecord &log)>;
+
+  // 已分发但尚未重做的日志达到 max_pending 时，Dispatch 等待工作线程重做
+  RedoDispatcher(size_t worker_count, RedoFunction redo, size_t max_pending = REDO_MAX_PENDING_LOGS);
+  ~RedoDispatcher();
+
+  size_t GetWorkerCount() const;
+  // 页面所属的工作线程，按 {table_oid, page_id / REDO_PARTITION_PAGES} 哈希分区
+  size_t GetWorker(oid_t table_oid, pageid_t page_id) const;
+  // 将日志加入工作线程 worker 的队列
+  void Dispatch(size_t worker, std::shared_ptr<LogRecord> log);
+  // 等待已分发的日志全部重做完成，工作线程抛出的异常在这里重新抛出
+  void Wait();
+
+ private:
+  struct Worker {
+    std::thread thread_;
+    std::deque<std::shared_ptr<LogRecord>> queue_;
+  };
+
+  void WorkerLoop(size_t worker);
+
+  RedoFunction redo_;
+  std::vector<Worker> workers_;
+  std::mutex mutex_;
+  // 队列非空或需要停止时唤醒工作线程
+  std::condition_variable work_cv_;
+  // 所有日志重做完成或队列不再满时唤醒等待的恢复线程
+  std::condition_variable done_cv_;
+  size_t max_pending_;
+  // 已分发但尚未重做完成的日志个数
+  size_t pending_ = 0;
+  bool stop_ = false;
+  std::exception_ptr exception_;
+};
+
+}  // namespace huadb
@@ -7,6 +7,8 @@
 namespace huadb {
 
 enum class AggregateType { AVG, COUNT_STAR, COUNT, SUM, MIN, MAX };
+// 哈希聚集在哈希表中维护每个分组；排序聚集的输入已按分组列排序，相同分组的记录相邻
+enum class AggregateStrategy { HASH, SORT };
 
 class AggregateOperator : public Operator {
  public:
@@ -20,17 +22,21 @@ class AggregateOperator : public Operator {
         is_distincts_(std::move(is_distincts)),
         aggregate_types_(std::move(aggregate_types)) {}
   std::string ToString(size_t indent_num = 0) const override {
-    return fmt::format("{}Aggregate:\n{}", std::string(indent_num * 2, ' '), children_[0]->ToString(indent_num + 1));
+    return fmt::format("{}{}Aggregate:{}\n{}", std::string(indent_num * 2, ' '),
+                       strategy_ == AggregateStrategy::HASH ? "Hash" : "Sort", annotation_,
+                       children_[0]->ToString(indent_num + 1));
   }
 
   const std::vector<std::shared_ptr<OperatorExpression>> &GetGroupBys() const { return group_bys_; }
   const std::vector<std::shared_ptr<OperatorExpression>> &GetAggregates() const { return aggregates_; }
   const std::vector<AggregateType> &GetAggregateTypes() const { return aggregate_types_; }
+  AggregateStrategy GetStrategy() const { return strategy_; }
 
   std::vector<std::shared_ptr<OperatorExpression>> group_bys_;
   std::vector<std::shared_ptr<OperatorExpression>> aggregates_;
   std::vector<bool> is_distincts_;
   std::vector<AggregateType> aggregate_types_;
+  AggregateStrategy strategy_ = AggregateStrategy::HASH;
 };
 
 }  // namespace huadb
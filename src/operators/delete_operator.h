@@ -12,7 +12,7 @@ class DeleteOperator : public Operator {
   DeleteOperator(std::shared_ptr<ColumnList> column_list, std::shared_ptr<Operator> child, oid_t oid)
       : Operator(OperatorType::DELETE, std::move(column_list), {std::move(child)}), oid_(oid) {}
   std::string ToString(size_t indent_num = 0) const override {
-    return fmt::format("{}DeleteOperator:\n{}", std::string(indent_num * 2, ' '),
+    return fmt::format("{}DeleteOperator:{}\n{}", std::string(indent_num * 2, ' '), annotation_,
                        children_[0]->ToString(indent_num + 1));
   }
 
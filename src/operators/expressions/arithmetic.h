@@ -10,7 +10,7 @@ enum class ArithmeticType { ADD, SUB, MUL, DIV };
 class Arithmetic : public OperatorExpression {
  public:
   Arithmetic(ArithmeticType type, std::shared_ptr<OperatorExpression> left, std::shared_ptr<OperatorExpression> right)
-      : OperatorExpression(OperatorExpressionType::ARITHMETIC, {std::move(left), std::move(right)}, Type::INT),
+      : OperatorExpression(OperatorExpressionType::ARITHMETIC, {left, right}, GetResultType(*left, *right)),
         type_(type) {}
 
   Value Evaluate(std::shared_ptr<const Record> record) override {
@@ -26,8 +26,14 @@ class Arithmetic : public OperatorExpression {
   }
 
   std::string ToString() const override { return fmt::format("{} {} {}", children_[0], type_, children_[1]); }
+  ArithmeticType GetArithmeticType() const { return type_; }
 
  private:
+  // 任一操作数为浮点数时结果为浮点数，否则为整数
+  static Type GetResultType(const OperatorExpression &left, const OperatorExpression &right) {
+    return left.GetValueType() == Type::DOUBLE || right.GetValueType() == Type::DOUBLE ? Type::DOUBLE : Type::INT;
+  }
+
   ArithmeticType type_;
   Value Compute(const Value &lhs, const Value &rhs) {
     if (lhs.IsNull() || rhs.IsNull()) {
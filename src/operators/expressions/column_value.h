@@ -23,6 +23,7 @@ class ColumnValue : public OperatorExpression {
   }
   std::string ToString() const override { return fmt::format("{}", name_); }
   size_t GetColumnIndex() const { return col_idx_; }
+  bool IsLeft() const { return is_left_; }
 
  private:
   size_t col_idx_;
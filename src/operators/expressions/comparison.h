@@ -1,12 +1,16 @@
 #pragma once
 
-#include <codecvt>
-#include <locale>
-#include <regex>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <unordered_set>
 
 #include "common/exceptions.h"
+#include "common/like_matcher.h"
 #include "fmt/format.h"
+#include "operators/expressions/const.h"
 #include "operators/expressions/expression.h"
+#include "operators/expressions/list.h"
 
 namespace huadb {
 
@@ -25,11 +29,24 @@ enum class ComparisonType {
   NOT_LIKE
 };
 
+// IN 列表中的常量不少于该数目时，预先建立哈希集合
+static constexpr size_t IN_LIST_HASH_THRESHOLD = 8;
+
 class Comparison : public OperatorExpression {
  public:
   Comparison(ComparisonType type, std::shared_ptr<OperatorExpression> left, std::shared_ptr<OperatorExpression> right)
       : OperatorExpression(OperatorExpressionType::COMPARISON, {std::move(left), std::move(right)}, Type::BOOL),
-        type_(type) {}
+        type_(type) {
+    if (type_ == ComparisonType::LIKE || type_ == ComparisonType::NOT_LIKE) {
+      // 模式为常量时只编译一次
+      auto pattern = std::dynamic_pointer_cast<Const>(children_[1]);
+      if (pattern != nullptr && !pattern->value_.IsNull() && TypeUtil::IsString(pattern->value_.GetType())) {
+        like_matcher_ = std::make_shared<LikeMatcher>(pattern->value_.GetValue<std::string>());
+      }
+    } else if (type_ == ComparisonType::IN || type_ == ComparisonType::NOT_IN) {
+      BuildInSet();
+    }
+  }
   Value Evaluate(std::shared_ptr<const Record> record) override {
     Value lhs = children_[0]->Evaluate(record);
     Value rhs = children_[1]->Evaluate(record);
@@ -42,9 +59,84 @@ class Comparison : public OperatorExpression {
   }
   std::string ToString() const override { return fmt::format("{} {} {}", children_[0], type_, children_[1]); }
   ComparisonType GetComparisonType() { return type_; }
+  // 模式为常量的 LIKE 比较预先编译的匹配器，其余情况返回 nullptr
+  std::shared_ptr<const LikeMatcher> GetLikeMatcher() const { return like_matcher_; }
 
  private:
   ComparisonType type_;
+  std::shared_ptr<const LikeMatcher> like_matcher_;
+  // IN 列表全部为同类型的非空常量时建立的哈希集合，in_set_type_ 为集合中值的类型
+  // 字符串集合中的 string_view 指向 List 中 Const 节点保存的值
+  Type in_set_type_ = Type::NULL_TYPE;
+  std::unordered_set<int32_t> int_set_;
+  std::unordered_set<double> double_set_;
+  std::unordered_set<std::string_view> string_set_;
+
+  void BuildInSet() {
+    auto list = std::dynamic_pointer_cast<List>(children_[1]);
+    if (list == nullptr || list->exprs_.size() < IN_LIST_HASH_THRESHOLD) {
+      return;
+    }
+    Type type = Type::NULL_TYPE;
+    for (const auto &expr : list->exprs_) {
+      auto constant = std::dynamic_pointer_cast<Const>(expr);
+      if (constant == nullptr || constant->value_.IsNull()) {
+        return;
+      }
+      auto value_type = constant->value_.GetType();
+      if (TypeUtil::IsString(value_type)) {
+        value_type = Type::VARCHAR;
+      }
+      if (value_type != Type::INT && value_type != Type::DOUBLE && value_type != Type::VARCHAR) {
+        return;
+      }
+      if (type != Type::NULL_TYPE && type != value_type) {
+        return;
+      }
+      type = value_type;
+    }
+    for (const auto &expr : list->exprs_) {
+      const auto &value = std::dynamic_pointer_cast<Const>(expr)->value_;
+      switch (type) {
+        case Type::INT:
+          int_set_.insert(value.GetValue<int32_t>());
+          break;
+        case Type::DOUBLE:
+          double_set_.insert(value.GetValue<double>());
+          break;
+        default:
+          string_set_.insert(value.GetValue<const char *>());
+          break;
+      }
+    }
+    in_set_type_ = type;
+  }
+
+  // 使用哈希集合判断 lhs 是否在 IN 列表中；lhs 的类型与集合不一致时返回 std::nullopt，按原有方式逐个比较
+  std::optional<bool> LookupInSet(const Value &lhs) const {
+    switch (lhs.GetType()) {
+      case Type::INT:
+        if (in_set_type_ == Type::INT) {
+          return int_set_.count(lhs.GetValue<int32_t>()) > 0;
+        }
+        break;
+      case Type::DOUBLE:
+        if (in_set_type_ == Type::DOUBLE) {
+          return double_set_.count(lhs.GetValue<double>()) > 0;
+        }
+        break;
+      case Type::CHAR:
+      case Type::VARCHAR:
+        if (in_set_type_ == Type::VARCHAR) {
+          return string_set_.count(lhs.GetValue<const char *>()) > 0;
+        }
+        break;
+      default:
+        break;
+    }
+    return std::nullopt;
+  }
+
   Value Compute(const Value &lhs, const Value &rhs) {
     if (lhs.IsNull() || rhs.IsNull()) {
       return Value();
@@ -72,23 +164,27 @@ class Comparison : public OperatorExpression {
       }
     } else if (type_ == ComparisonType::IN || type_ == ComparisonType::NOT_IN) {
       bool in_list = false;
-      for (const auto &value : rhs.GetValues()) {
-        switch (lhs.GetType()) {
-          case Type::INT:
-            in_list = lhs.GetValue<int32_t>() == value.GetValue<int32_t>();
-            break;
-          case Type::DOUBLE:
-            in_list = lhs.GetValue<double>() == value.GetValue<double>();
-            break;
-          case Type::CHAR:
-          case Type::VARCHAR:
-            in_list = lhs.GetValue<std::string>() == value.GetValue<std::string>();
+      if (auto found = LookupInSet(lhs)) {
+        in_list = *found;
+      } else {
+        for (const auto &value : rhs.GetValues()) {
+          switch (lhs.GetType()) {
+            case Type::INT:
+              in_list = lhs.GetValue<int32_t>() == value.GetValue<int32_t>();
+              break;
+            case Type::DOUBLE:
+              in_list = lhs.GetValue<double>() == value.GetValue<double>();
+              break;
+            case Type::CHAR:
+            case Type::VARCHAR:
+              in_list = lhs.GetValue<std::string>() == value.GetValue<std::string>();
+              break;
+            default:
+              throw DbException("Type unsupported for comparison operation (in)");
+          }
+          if (in_list) {
             break;
-          default:
-            throw DbException("Type unsupported for comparison operation (in)");
-        }
-        if (in_list) {
-          break;
+          }
         }
       }
       if (type_ == ComparisonType::IN) {
@@ -102,17 +198,10 @@ class Comparison : public OperatorExpression {
       if (!TypeUtil::IsString(lhs.GetType()) || !TypeUtil::IsString(rhs.GetType())) {
         throw DbException("LIKE operator only supports CHAR and VARCHAR types");
       }
-      // Inefficient implementation of LIKE operator with Chinese support
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wdeprecated-declarations"
-      std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
-#pragma clang diagnostic pop
-      std::string pattern_string = std::regex_replace(rhs.GetValue<std::string>(), std::regex("%"), ".*");
-      pattern_string = std::regex_replace(pattern_string, std::regex("_"), ".");
-      std::wstring w_pattern_string = converter.from_bytes(pattern_string);
-      std::wregex pattern(w_pattern_string);
-
-      bool matched = std::regex_match(converter.from_bytes(lhs.GetValue<std::string>()), pattern);
+      // 模式不是常量时，每次比较重新编译
+      bool matched = like_matcher_ != nullptr
+                         ? like_matcher_->Match(lhs.GetValue<const char *>())
+                         : LikeMatcher(rhs.GetValue<std::string>()).Match(lhs.GetValue<const char *>());
       if (type_ == ComparisonType::LIKE) {
         return Value(matched);
       } else if (type_ == ComparisonType::NOT_LIKE) {
@@ -1,63 +1,64 @@
 #pragma once
 
-#include "common/exceptions.h"
-#include "common/string_util.h"
-#include "common/type_util.h"
 #include "fmt/ranges.h"
+#include "function/function_registry.h"
 #include "operators/expressions/expression.h"
 
 namespace huadb {
 
 class FuncCall : public OperatorExpression {
  public:
+  // 构造时根据参数类型从注册表中选择重载，执行时不再按函数名分派
   FuncCall(std::string function_name, std::vector<std::shared_ptr<OperatorExpression>> args)
-      : OperatorExpression(OperatorExpressionType::FUNC_CALL, {}, GetReturnType(function_name), function_name),
+      : OperatorExpression(OperatorExpressionType::FUNC_CALL, {}, Type::NULL_TYPE, function_name),
         function_name_(std::move(function_name)),
-        args_(std::move(args)) {
-    if (function_name_ == "lower" || function_name_ == "upper" || function_name_ == "length") {
-      if (args_.size() != 1 || !TypeUtil::IsString(args_[0]->GetValueType())) {
-        throw DbException("Argument mismatch for function " + function_name_);
-      }
-    } else {
-      throw std::runtime_error("Unknown function name " + function_name_);
-    }
+        args_(std::move(args)),
+        overload_(&FunctionRegistry::GetInstance().Resolve(function_name_, GetArgTypes(args_))) {
+    value_type_ = overload_->return_type_;
+    arg_values_.resize(args_.size());
   }
   Value Evaluate(std::shared_ptr<const Record> record) override {
-    if (function_name_ == "lower") {
-      return Value(StringUtil::Lower(args_[0]->Evaluate(record).GetValue<std::string>()));
-    } else if (function_name_ == "upper") {
-      return Value(StringUtil::Upper(args_[0]->Evaluate(record).GetValue<std::string>()));
-    } else if (function_name_ == "length") {
-      return Value(static_cast<uint32_t>(args_[0]->Evaluate(record).GetValue<std::string>().size()));
+    for (size_t i = 0; i < args_.size(); i++) {
+      arg_values_[i] = args_[i]->Evaluate(record);
     }
-    throw std::runtime_error("Unknown function name " + function_name_);
+    return overload_->scalar_(arg_values_);
   }
   Value EvaluateJoin(std::shared_ptr<const Record> left, std::shared_ptr<const Record> right) override {
-    if (function_name_ == "lower") {
-      return Value(StringUtil::Lower(args_[0]->EvaluateJoin(left, right).GetValue<std::string>()));
-    } else if (function_name_ == "upper") {
-      return Value(StringUtil::Upper(args_[0]->EvaluateJoin(left, right).GetValue<std::string>()));
-    } else if (function_name_ == "length") {
-      return Value(static_cast<uint32_t>(args_[0]->EvaluateJoin(left, right).GetValue<std::string>().size()));
+    for (size_t i = 0; i < args_.size(); i++) {
+      arg_values_[i] = args_[i]->EvaluateJoin(left, right);
+    }
+    return overload_->scalar_(arg_values_);
+  }
+  // 批量求值：先逐列计算参数，再调用一次批量实现
+  std::vector<Value> EvaluateBatch(const std::vector<std::shared_ptr<const Record>> &records) {
+    std::vector<std::vector<Value>> columns(args_.size());
+    for (size_t i = 0; i < args_.size(); i++) {
+      columns[i].reserve(records.size());
+      for (const auto &record : records) {
+        columns[i].push_back(args_[i]->Evaluate(record));
+      }
     }
-    throw std::runtime_error("Unknown function name " + function_name_);
+    std::vector<Value> result;
+    overload_->batch_(columns, result);
+    return result;
   }
+  const FunctionOverload &GetOverload() const { return *overload_; }
   std::string ToString() const override { return fmt::format("{}({})", function_name_, args_); }
   std::string function_name_;
   std::vector<std::shared_ptr<OperatorExpression>> args_;
 
  private:
-  Type GetReturnType(const std::string &function_name) {
-    if (function_name == "lower") {
-      return Type::VARCHAR;
-    } else if (function_name == "upper") {
-      return Type::VARCHAR;
-    } else if (function_name == "length") {
-      return Type::INT;
-    } else {
-      throw std::runtime_error("Unknown function name " + function_name);
+  static std::vector<Type> GetArgTypes(const std::vector<std::shared_ptr<OperatorExpression>> &args) {
+    std::vector<Type> arg_types;
+    for (const auto &arg : args) {
+      arg_types.push_back(arg->GetValueType());
     }
+    return arg_types;
   }
+
+  const FunctionOverload *overload_;
+  // 复用的参数缓冲区，避免每行分配
+  std::vector<Value> arg_values_;
 };
 
 }  // namespace huadb
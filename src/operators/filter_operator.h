@@ -12,7 +12,7 @@ class FilterOperator : public Operator {
                  std::shared_ptr<OperatorExpression> predicate)
       : Operator(OperatorType::FILTER, std::move(column_list), {std::move(child)}), predicate_(std::move(predicate)) {}
   std::string ToString(size_t indent_num = 0) const override {
-    return fmt::format("{}Filter: {}\n{}", std::string(indent_num * 2, ' '), predicate_,
+    return fmt::format("{}Filter: {}{}\n{}", std::string(indent_num * 2, ' '), predicate_, annotation_,
                        children_[0]->ToString(indent_num + 1));
   }
 
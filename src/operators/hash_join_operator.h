@@ -19,7 +19,8 @@ class HashJoinOperator : public Operator {
         join_type_(join_type),
         Operator(OperatorType::HASHJOIN, std::move(column_list), {std::move(left), std::move(right)}) {}
   std::string ToString(size_t indent_num = 0) const override {
-    return fmt::format("{}HashJoin: left={} right={}\n{}\n{}", std::string(indent_num * 2, ' '), left_key_, right_key_,
+    return fmt::format("{}HashJoin: left={} right={}{}\n{}\n{}", std::string(indent_num * 2, ' '), left_key_,
+                       right_key_, annotation_,
                        children_[0]->ToString(indent_num + 1), children_[1]->ToString(indent_num + 1));
   }
   std::shared_ptr<OperatorExpression> left_key_;
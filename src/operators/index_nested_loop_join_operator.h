@@ -0,0 +1,42 @@
+#pragma once
+
+#include "binder/table_ref.h"
+#include "fmt/format.h"
+#include "operators/expressions/expression.h"
+#include "operators/operator.h"
+#include "operators/seqscan_operator.h"
+
+namespace huadb {
+
+// Index Nested Loop Join：外表为唯一的孩子节点，内表通过连接列上的索引查找匹配记录
+// outer_is_left_ 表示外表是否为原连接的左孩子，用于保持输出列的顺序
+class IndexNestedLoopJoinOperator : public Operator {
+ public:
+  IndexNestedLoopJoinOperator(std::shared_ptr<ColumnList> column_list, std::shared_ptr<Operator> outer,
+                              std::shared_ptr<const SeqScanOperator> inner, oid_t index_oid,
+                              std::shared_ptr<OperatorExpression> outer_key,
+                              std::shared_ptr<OperatorExpression> join_condition, JoinType join_type,
+                              bool outer_is_left)
+      : Operator(OperatorType::INDEXNESTEDLOOP, std::move(column_list), {std::move(outer)}),
+        inner_(std::move(inner)),
+        index_oid_(index_oid),
+        outer_key_(std::move(outer_key)),
+        join_condition_(std::move(join_condition)),
+        join_type_(join_type),
+        outer_is_left_(outer_is_left) {}
+  std::string ToString(size_t indent_num = 0) const override {
+    return fmt::format("{}IndexNestedLoopJoin: {}{}\n{}\n{}IndexProbe: {}", std::string(indent_num * 2, ' '),
+                       join_condition_, annotation_, children_[0]->ToString(indent_num + 1), std::string((indent_num + 1) * 2, ' '),
+                       inner_->GetTableNameOrAlias());
+  }
+
+  std::shared_ptr<const SeqScanOperator> inner_;
+  oid_t index_oid_;
+  // 外表记录上的连接键
+  std::shared_ptr<OperatorExpression> outer_key_;
+  std::shared_ptr<OperatorExpression> join_condition_;
+  JoinType join_type_;
+  bool outer_is_left_;
+};
+
+}  // namespace huadb
@@ -1,12 +1,51 @@
 #pragma once
 
+#include <optional>
+
+#include "common/value.h"
+#include "fmt/format.h"
 #include "operators/operator.h"
+#include "operators/seqscan_operator.h"
 
 namespace huadb {
 
+// 索引扫描的一侧边界，inclusive_ 表示是否包含边界值
+struct IndexScanBound {
+  Value value_;
+  bool inclusive_;
+};
+
+// 通过索引按键值顺序读取 [lower_, upper_] 范围内的记录，边界为空时表示该侧不受限制
+// 原有的过滤条件保留在上层 Filter 节点中，对读取的记录再次检查
 class IndexScanOperator : public Operator {
  public:
-  IndexScanOperator();
+  IndexScanOperator(std::shared_ptr<ColumnList> column_list, std::shared_ptr<const SeqScanOperator> scan,
+                    oid_t index_oid, std::string index_name, std::optional<IndexScanBound> lower,
+                    std::optional<IndexScanBound> upper)
+      : Operator(OperatorType::INDEXSCAN, std::move(column_list), {}),
+        scan_(std::move(scan)),
+        index_oid_(index_oid),
+        index_name_(std::move(index_name)),
+        lower_(std::move(lower)),
+        upper_(std::move(upper)) {}
+  std::string ToString(size_t indent_num = 0) const override {
+    std::string lower = lower_ ? fmt::format("{}{}", lower_->inclusive_ ? "[" : "(", lower_->value_.ToString())
+                               : std::string("(-inf");
+    std::string upper = upper_ ? fmt::format("{}{}", upper_->value_.ToString(), upper_->inclusive_ ? "]" : ")")
+                               : std::string("+inf)");
+    return fmt::format("{}IndexScan: {} using {} {}, {}{}", std::string(indent_num * 2, ' '),
+                       scan_->GetTableNameOrAlias(), index_name_, lower, upper, annotation_);
+  }
+
+  oid_t GetTableOid() const { return scan_->GetTableOid(); }
+  const std::string &GetTableName() const { return scan_->GetTableName(); }
+
+  // 被替换的顺序扫描节点，保存表的信息
+  std::shared_ptr<const SeqScanOperator> scan_;
+  oid_t index_oid_;
+  std::string index_name_;
+  std::optional<IndexScanBound> lower_;
+  std::optional<IndexScanBound> upper_;
 };
 
 }  // namespace huadb
@@ -14,7 +14,7 @@ class InsertOperator : public Operator {
         insert_columns_(std::move(insert_columns)),
         oid_(oid) {}
   std::string ToString(size_t indent_num = 0) const override {
-    return fmt::format("{}InsertOperator\n{}", std::string(indent_num * 2, ' '),
+    return fmt::format("{}InsertOperator{}\n{}", std::string(indent_num * 2, ' '), annotation_,
                        children_[0]->ToString(indent_num + 1));
   }
 
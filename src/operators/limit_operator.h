@@ -15,7 +15,7 @@ class LimitOperator : public Operator {
         limit_count_(limit_count),
         limit_offset_(limit_offset) {}
   std::string ToString(size_t indent_num = 0) const override {
-    return fmt::format("{}LimitOperator:\n{}", std::string(indent_num * 2, ' '),
+    return fmt::format("{}LimitOperator:{}\n{}", std::string(indent_num * 2, ' '), annotation_,
                        children_[0]->ToString(indent_num + 1));
   }
 
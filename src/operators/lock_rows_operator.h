@@ -15,7 +15,7 @@ class LockRowsOperator : public Operator {
         oid_(oid),
         lock_type_(lock_type) {}
   std::string ToString(size_t indent_num = 0) const override {
-    return fmt::format("{}LockRowsOperator:\n{}", std::string(indent_num * 2, ' '),
+    return fmt::format("{}LockRowsOperator:{}\n{}", std::string(indent_num * 2, ' '), annotation_,
                        children_[0]->ToString(indent_num + 1));
   }
 
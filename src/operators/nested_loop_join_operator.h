@@ -18,7 +18,7 @@ class NestedLoopJoinOperator : public Operator {
         join_type_(join_type),
         Operator(OperatorType::NESTEDLOOP, std::move(column_list), {std::move(left), std::move(right)}) {}
   std::string ToString(size_t indent_num = 0) const override {
-    return fmt::format("{}NestedLoopJoin: {}\n{}\n{}", std::string(indent_num * 2, ' '), join_condition_,
+    return fmt::format("{}NestedLoopJoin: {}{}\n{}\n{}", std::string(indent_num * 2, ' '), join_condition_, annotation_,
                        children_[0]->ToString(indent_num + 1), children_[1]->ToString(indent_num + 1));
   }
   std::shared_ptr<OperatorExpression> join_condition_;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "catalog/column_list.h"
@@ -12,6 +13,8 @@ enum class OperatorType {
   DELETE,
   FILTER,
   HASHJOIN,
+  INDEXNESTEDLOOP,
+  INDEXSCAN,
   INSERT,
   LIMIT,
   LOCK_ROWS,
@@ -38,6 +41,11 @@ class Operator {
   OperatorType type_;
   std::shared_ptr<ColumnList> column_list_;
   std::vector<std::shared_ptr<Operator>> children_;
+  // 代价模型估计的输出记录数和累计代价，未估计时为负数
+  double estimated_rows_ = -1;
+  double estimated_cost_ = -1;
+  // EXPLAIN (COSTS) 或 EXPLAIN (ANALYZE) 时附加在节点描述之后的信息
+  std::string annotation_;
 };
 
 }  // namespace huadb
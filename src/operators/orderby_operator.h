@@ -13,7 +13,8 @@ class OrderByOperator : public Operator {
                   std::vector<std::pair<OrderByType, std::shared_ptr<OperatorExpression>>> order_bys)
       : Operator(OperatorType::ORDERBY, std::move(column_list), {std::move(child)}), order_bys_(std::move(order_bys)) {}
   std::string ToString(size_t indent_num = 0) const override {
-    return fmt::format("{}Order:\n{}", std::string(indent_num * 2, ' '), children_[0]->ToString(indent_num + 1));
+    return fmt::format("{}Order:{}\n{}", std::string(indent_num * 2, ' '), annotation_,
+                       children_[0]->ToString(indent_num + 1));
   }
 
   std::vector<std::pair<OrderByType, std::shared_ptr<OperatorExpression>>> order_bys_;
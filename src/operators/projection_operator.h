@@ -16,7 +16,7 @@ class ProjectionOperator : public Operator {
                      std::vector<std::shared_ptr<OperatorExpression>> exprs)
       : Operator(OperatorType::PROJECTION, std::move(column_list), {std::move(child)}), exprs_(std::move(exprs)) {}
   std::string ToString(size_t indent_num = 0) const override {
-    return fmt::format("{}Projection: {}\n{}", std::string(indent_num * 2, ' '), exprs_,
+    return fmt::format("{}Projection: {}{}\n{}", std::string(indent_num * 2, ' '), exprs_, annotation_,
                        children_[0]->ToString(indent_num + 1));
   }
 
@@ -20,9 +20,9 @@ class SeqScanOperator : public Operator {
         has_lock_(has_lock) {}
   std::string ToString(size_t indent_num = 0) const override {
     if (alias_) {
-      return fmt::format("{}SeqScan: {} {}", std::string(indent_num * 2, ' '), table_name_, *alias_);
+      return fmt::format("{}SeqScan: {} {}{}", std::string(indent_num * 2, ' '), table_name_, *alias_, annotation_);
     } else {
-      return fmt::format("{}SeqScan: {}", std::string(indent_num * 2, ' '), table_name_);
+      return fmt::format("{}SeqScan: {}{}", std::string(indent_num * 2, ' '), table_name_, annotation_);
     }
   }
 
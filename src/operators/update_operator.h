@@ -15,7 +15,7 @@ class UpdateOperator : public Operator {
         oid_(oid),
         update_exprs_(std::move(update_exprs)) {}
   std::string ToString(size_t indent_num = 0) const override {
-    return fmt::format("{}UpdateOperator:\n{}", std::string(indent_num * 2, ' '),
+    return fmt::format("{}UpdateOperator:{}\n{}", std::string(indent_num * 2, ' '), annotation_,
                        children_[0]->ToString(indent_num + 1));
   }
 
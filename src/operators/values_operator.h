@@ -13,7 +13,7 @@ class ValuesOperator : public Operator {
                  std::vector<std::vector<std::shared_ptr<OperatorExpression>>> values)
       : Operator(OperatorType::VALUES, std::move(column_list), {}), values_(std::move(values)) {}
   std::string ToString(size_t indent_num = 0) const override {
-    return fmt::format("{}ValuesOperator", std::string(indent_num * 2, ' '));
+    return fmt::format("{}ValuesOperator{}", std::string(indent_num * 2, ' '), annotation_);
   }
   std::vector<std::vector<std::shared_ptr<OperatorExpression>>> values_;
 };
@@ -0,0 +1,609 @@
+#include "optimizer/cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "index/index.h"
+#include "operators/expressions/comparison.h"
+#include "operators/expressions/const.h"
+#include "operators/expressions/list.h"
+#include "operators/expressions/logic.h"
+#include "operators/expressions/null_test.h"
+#include "operators/operators.h"
+#include "table/record_header.h"
+#include "table/table_page.h"
+
+namespace huadb {
+
+namespace {
+
+// 表中一条记录占用的字节数，包括记录头和槽位
+double StoredWidth(const ColumnList &column_list) {
+  return CostModel::RecordWidth(column_list) + RECORD_HEADER_SIZE + sizeof(Slot);
+}
+
+// 外连接时需要保留的一侧至少输出全部记录
+double JoinRows(double left_rows, double right_rows, double selectivity, JoinType join_type) {
+  double rows = left_rows * right_rows * selectivity;
+  switch (join_type) {
+    case JoinType::LEFT:
+      return std::max(rows, left_rows);
+    case JoinType::RIGHT:
+      return std::max(rows, right_rows);
+    case JoinType::FULL:
+      return std::max(rows, left_rows + right_rows);
+    default:
+      return rows;
+  }
+}
+
+// 外表每次读入 JOIN_BLOCK_SIZE 字节的记录，返回外表的块数
+double OuterBlocks(double rows, double width) {
+  return std::max(1.0, std::ceil(rows * width / JOIN_BLOCK_SIZE));
+}
+
+// 在 plan 的子树中查找名称或别名为 name 的表，返回表名
+const std::string *FindTable(const Operator &plan, const std::string &name) {
+  switch (plan.GetType()) {
+    case OperatorType::SEQSCAN: {
+      const auto &scan = dynamic_cast<const SeqScanOperator &>(plan);
+      return scan.GetTableNameOrAlias() == name ? &scan.GetTableName() : nullptr;
+    }
+    case OperatorType::INDEXSCAN: {
+      const auto &scan = *dynamic_cast<const IndexScanOperator &>(plan).scan_;
+      return scan.GetTableNameOrAlias() == name ? &scan.GetTableName() : nullptr;
+    }
+    case OperatorType::INDEXNESTEDLOOP: {
+      const auto &inner = *dynamic_cast<const IndexNestedLoopJoinOperator &>(plan).inner_;
+      if (inner.GetTableNameOrAlias() == name) {
+        return &inner.GetTableName();
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  for (const auto &child : plan.GetChildren()) {
+    if (auto table = FindTable(*child, name)) {
+      return table;
+    }
+  }
+  return nullptr;
+}
+
+// column 所在的表名和列名，列名为 "表名或别名.列名" 的形式；找不到时表名为空指针
+std::pair<const std::string *, std::string> FindColumn(const ColumnValue &column, const Operator &input) {
+  const auto &name = column.name_;
+  auto pos = name.rfind('.');
+  if (pos == std::string::npos) {
+    return {nullptr, ""};
+  }
+  return {FindTable(input, name.substr(0, pos)), name.substr(pos + 1)};
+}
+
+}  // namespace
+
+CostModel::CostModel(Catalog &catalog) : catalog_(catalog) {}
+
+PlanCost CostModel::Estimate(const std::shared_ptr<Operator> &plan) const {
+  PlanCost cost;
+  switch (plan->GetType()) {
+    case OperatorType::SEQSCAN:
+      cost = EstimateSeqScan(*plan);
+      break;
+    case OperatorType::INDEXSCAN:
+      cost = EstimateIndexScan(*plan);
+      break;
+    case OperatorType::FILTER: {
+      const auto &child = plan->children_[0];
+      cost = Estimate(child);
+      auto selectivity = Selectivity(dynamic_cast<const FilterOperator &>(*plan).predicate_, *child);
+      cost.cpu_ += cost.rows_ * CPU_OPERATOR_COST;
+      if (child->GetType() == OperatorType::INDEXSCAN) {
+        // 索引扫描已经按部分条件过滤，过滤条件的选择率相对于整张表计算
+        PlanCost table_cost;
+        auto table_rows = TableRows(dynamic_cast<const IndexScanOperator &>(*child).GetTableName(), table_cost);
+        cost.rows_ = std::min(cost.rows_, table_rows * selectivity);
+      } else {
+        cost.rows_ *= selectivity;
+      }
+      break;
+    }
+    case OperatorType::PROJECTION:
+      cost = Estimate(plan->children_[0]);
+      cost.cpu_ += cost.rows_ * CPU_OPERATOR_COST * dynamic_cast<const ProjectionOperator &>(*plan).exprs_.size();
+      break;
+    case OperatorType::NESTEDLOOP:
+    case OperatorType::HASHJOIN:
+    case OperatorType::MERGEJOIN:
+      cost = EstimateJoin(*plan);
+      break;
+    case OperatorType::INDEXNESTEDLOOP:
+      cost = EstimateIndexJoin(*plan);
+      break;
+    case OperatorType::ORDERBY: {
+      const auto &child = plan->children_[0];
+      cost = SortCost(Estimate(child), RecordWidth(child->OutputColumns()),
+                      dynamic_cast<const OrderByOperator &>(*plan).order_bys_.size());
+      break;
+    }
+    case OperatorType::LIMIT: {
+      cost = Estimate(plan->children_[0]);
+      const auto &limit = dynamic_cast<const LimitOperator &>(*plan);
+      if (limit.limit_offset_) {
+        cost.rows_ = std::max(0.0, cost.rows_ - *limit.limit_offset_);
+      }
+      if (limit.limit_count_) {
+        cost.rows_ = std::min(cost.rows_, static_cast<double>(*limit.limit_count_));
+      }
+      break;
+    }
+    case OperatorType::AGGREGATE:
+      cost = EstimateAggregate(*plan);
+      break;
+    case OperatorType::VALUES:
+      cost.rows_ = dynamic_cast<const ValuesOperator &>(*plan).values_.size();
+      cost.cpu_ = cost.rows_ * CPU_TUPLE_COST;
+      break;
+    case OperatorType::LOCK_ROWS:
+      cost = Estimate(plan->children_[0]);
+      cost.cpu_ += cost.rows_ * CPU_TUPLE_COST;
+      break;
+    case OperatorType::INSERT:
+    case OperatorType::UPDATE:
+    case OperatorType::DELETE: {
+      // 修改的记录需要写回页面，输出一条记录表示修改的记录数
+      const auto &child = plan->children_[0];
+      cost = Estimate(child);
+      cost.pages_ += Pages(cost.rows_, StoredWidth(child->OutputColumns()));
+      cost.cpu_ += cost.rows_ * CPU_TUPLE_COST;
+      cost.rows_ = 1;
+      break;
+    }
+  }
+  plan->estimated_rows_ = cost.rows_;
+  plan->estimated_cost_ = cost.Total();
+  return cost;
+}
+
+PlanCost CostModel::EstimateSeqScan(const Operator &plan) const {
+  const auto &scan = dynamic_cast<const SeqScanOperator &>(plan);
+  PlanCost cost;
+  cost.rows_ = TableRows(scan.GetTableName(), cost);
+  cost.pages_ = Pages(cost.rows_, StoredWidth(scan.OutputColumns()));
+  // 记录数随提交增量更新，但删除的记录仍占用页面，顺序扫描至少读取表当前的全部页面
+  if (cost.has_statistics_) {
+    cost.pages_ = std::max<double>(cost.pages_, catalog_.GetTable(scan.GetTableOid())->GetPageCount());
+  }
+  cost.cpu_ = cost.rows_ * CPU_TUPLE_COST;
+  return cost;
+}
+
+PlanCost CostModel::EstimateIndexScan(const Operator &plan) const {
+  const auto &scan = dynamic_cast<const IndexScanOperator &>(plan);
+  auto index = catalog_.GetIndex(scan.index_oid_);
+  PlanCost cost;
+  auto table_rows = TableRows(scan.GetTableName(), cost);
+  bool equal = scan.lower_ && scan.upper_ && scan.lower_->inclusive_ && scan.upper_->inclusive_ &&
+               scan.lower_->value_.Equal(scan.upper_->value_);
+  auto selectivity = RangeSelectivity(scan.GetTableName(), index->GetColumnName(), equal, scan.lower_, scan.upper_);
+  cost.rows_ = table_rows * selectivity;
+  // 从根节点查找到第一个叶节点，沿叶节点读取范围内的索引项，每条匹配记录读取一个表页面
+  auto leaf_pages = std::ceil(table_rows / index->LeafCapacity());
+  cost.pages_ = IndexHeight(*index, table_rows) - 1 + std::max(1.0, std::ceil(leaf_pages * selectivity)) + cost.rows_;
+  cost.cpu_ = cost.rows_ * (CPU_INDEX_TUPLE_COST + CPU_TUPLE_COST);
+  return cost;
+}
+
+PlanCost CostModel::EstimateJoin(const Operator &plan) const {
+  const auto &left = plan.children_[0];
+  const auto &right = plan.children_[1];
+  auto left_cost = Estimate(left);
+  auto right_cost = Estimate(right);
+  PlanCost cost;
+  cost.has_statistics_ = left_cost.has_statistics_ && right_cost.has_statistics_;
+  cost.memory_ = std::max(left_cost.memory_, right_cost.memory_);
+  cost.cpu_ = left_cost.cpu_ + right_cost.cpu_;
+  auto left_width = RecordWidth(left->OutputColumns());
+  auto right_width = RecordWidth(right->OutputColumns());
+
+  switch (plan.GetType()) {
+    case OperatorType::NESTEDLOOP: {
+      const auto &join = dynamic_cast<const NestedLoopJoinOperator &>(plan);
+      cost.rows_ = JoinRows(left_cost.rows_, right_cost.rows_, Selectivity(join.join_condition_, plan),
+                            join.join_type_);
+      // 每个外表块扫描一遍内表；内表不是基本表时结果物化在内存中，只计算一次
+      auto blocks = OuterBlocks(left_cost.rows_, left_width);
+      if (right->GetType() == OperatorType::SEQSCAN) {
+        cost.pages_ = left_cost.pages_ + blocks * right_cost.pages_;
+        cost.cpu_ += (blocks - 1) * right_cost.cpu_;
+      } else {
+        cost.pages_ = left_cost.pages_ + right_cost.pages_;
+        cost.cpu_ += blocks * right_cost.rows_ * CPU_TUPLE_COST;
+        cost.memory_ = std::max(cost.memory_, right_cost.rows_ * right_width);
+      }
+      cost.memory_ = std::max<double>(cost.memory_, JOIN_BLOCK_SIZE);
+      cost.cpu_ += left_cost.rows_ * right_cost.rows_ * CPU_OPERATOR_COST;
+      break;
+    }
+    case OperatorType::HASHJOIN: {
+      // 右孩子建立哈希表，左孩子探测；哈希表超出内存时两侧按哈希值分区写出后再逐个分区连接
+      const auto &join = dynamic_cast<const HashJoinOperator &>(plan);
+      cost.rows_ = JoinRows(left_cost.rows_, right_cost.rows_,
+                            EqualJoinSelectivity(dynamic_cast<const ColumnValue &>(*join.left_key_),
+                                                 dynamic_cast<const ColumnValue &>(*join.right_key_), plan),
+                            join.join_type_);
+      cost.pages_ = left_cost.pages_ + right_cost.pages_;
+      auto table_size = right_cost.rows_ * right_width;
+      if (table_size > WORK_MEMORY_SIZE) {
+        cost.pages_ += 2 * (Pages(left_cost.rows_, left_width) + Pages(right_cost.rows_, right_width));
+      }
+      cost.memory_ = std::max(cost.memory_, std::min<double>(table_size, WORK_MEMORY_SIZE));
+      cost.cpu_ += (left_cost.rows_ + right_cost.rows_) * CPU_OPERATOR_COST + right_cost.rows_ * CPU_TUPLE_COST;
+      break;
+    }
+    case OperatorType::MERGEJOIN: {
+      // 两侧的输入已按连接键排序，各读取一遍
+      const auto &join = dynamic_cast<const MergeJoinOperator &>(plan);
+      cost.rows_ = JoinRows(left_cost.rows_, right_cost.rows_,
+                            EqualJoinSelectivity(dynamic_cast<const ColumnValue &>(*join.left_key_),
+                                                 dynamic_cast<const ColumnValue &>(*join.right_key_), plan),
+                            join.join_type_);
+      cost.pages_ = left_cost.pages_ + right_cost.pages_;
+      cost.cpu_ += (left_cost.rows_ + right_cost.rows_) * CPU_OPERATOR_COST;
+      break;
+    }
+    default:
+      throw DbException("Unknown join type in EstimateJoin");
+  }
+  cost.cpu_ += cost.rows_ * CPU_TUPLE_COST;
+  return cost;
+}
+
+PlanCost CostModel::EstimateIndexJoin(const Operator &plan) const {
+  const auto &join = dynamic_cast<const IndexNestedLoopJoinOperator &>(plan);
+  const auto &outer = join.children_[0];
+  auto cost = Estimate(outer);
+  auto outer_rows = cost.rows_;
+  auto inner_rows = TableRows(join.inner_->GetTableName(), cost);
+  auto index = catalog_.GetIndex(join.index_oid_);
+  auto selectivity = Selectivity(join.join_condition_, plan);
+  auto matched_rows = outer_rows * inner_rows * selectivity;
+  cost.rows_ = join.outer_is_left_ ? JoinRows(outer_rows, inner_rows, selectivity, join.join_type_)
+                                   : JoinRows(inner_rows, outer_rows, selectivity, join.join_type_);
+  // 每批外表记录按连接键排序后查找索引：内部节点每批读取一次，每条外表记录读取一个叶节点，每条匹配记录读取一个表页面
+  auto batches = OuterBlocks(outer_rows, RecordWidth(outer->OutputColumns()));
+  cost.pages_ += batches * (IndexHeight(*index, inner_rows) - 1) + outer_rows + matched_rows;
+  cost.cpu_ += outer_rows * CPU_INDEX_TUPLE_COST + matched_rows * (CPU_TUPLE_COST + CPU_OPERATOR_COST) +
+               cost.rows_ * CPU_TUPLE_COST;
+  cost.memory_ = std::max<double>(cost.memory_, JOIN_BLOCK_SIZE);
+  return cost;
+}
+
+PlanCost CostModel::EstimateAggregate(const Operator &plan) const {
+  const auto &aggregate = dynamic_cast<const AggregateOperator &>(plan);
+  const auto &child = aggregate.children_[0];
+  auto cost = Estimate(child);
+  auto input_rows = cost.rows_;
+  // 分组数为各分组列不同值个数之积，不超过输入的记录数
+  double groups = 1;
+  for (const auto &group_by : aggregate.group_bys_) {
+    auto column = std::dynamic_pointer_cast<ColumnValue>(group_by);
+    auto distinct = column == nullptr ? INVALID_DISTINCT : Distinct(*column, *child);
+    groups *= distinct == INVALID_DISTINCT ? 1 / DEFAULT_EQUALITY_SELECTIVITY : std::max<uint32_t>(distinct, 1);
+  }
+  if (!aggregate.group_bys_.empty()) {
+    groups = std::max(1.0, std::min(groups, input_rows));
+  }
+  cost.rows_ = groups;
+  cost.cpu_ += input_rows * CPU_OPERATOR_COST * (aggregate.group_bys_.size() + aggregate.aggregates_.size()) +
+               groups * CPU_TUPLE_COST;
+  if (aggregate.strategy_ == AggregateStrategy::HASH && !aggregate.group_bys_.empty()) {
+    // 每条输入记录计算一次分组列的哈希值
+    cost.cpu_ += input_rows * CPU_OPERATOR_COST;
+    // 哈希表超出内存时，输入按分组列的哈希值分区写出后逐个分区聚集
+    auto table_size = groups * RecordWidth(aggregate.OutputColumns());
+    if (table_size > WORK_MEMORY_SIZE) {
+      cost.pages_ += 2 * Pages(input_rows, RecordWidth(child->OutputColumns()));
+    }
+    cost.memory_ = std::max(cost.memory_, std::min<double>(table_size, WORK_MEMORY_SIZE));
+  }
+  return cost;
+}
+
+double CostModel::Selectivity(const std::shared_ptr<OperatorExpression> &predicate, const Operator &input) const {
+  switch (predicate->GetExprType()) {
+    case OperatorExpressionType::CONST: {
+      const auto &value = std::dynamic_pointer_cast<Const>(predicate)->value_;
+      if (value.IsNull() || value.GetType() != Type::BOOL) {
+        return value.IsNull() ? 0 : DEFAULT_SELECTIVITY;
+      }
+      return value.GetValue<bool>() ? 1 : 0;
+    }
+    case OperatorExpressionType::LOGIC: {
+      auto logic = std::dynamic_pointer_cast<Logic>(predicate);
+      auto lhs = Selectivity(logic->children_[0], input);
+      switch (logic->GetLogicType()) {
+        case LogicType::AND:
+          return lhs * Selectivity(logic->children_[1], input);
+        case LogicType::OR: {
+          auto rhs = Selectivity(logic->children_[1], input);
+          return lhs + rhs - lhs * rhs;
+        }
+        case LogicType::NOT:
+          return 1 - lhs;
+      }
+      break;
+    }
+    case OperatorExpressionType::NULL_TEST:
+      return std::dynamic_pointer_cast<NullTest>(predicate)->is_null_ ? DEFAULT_NULL_SELECTIVITY
+                                                                      : 1 - DEFAULT_NULL_SELECTIVITY;
+    case OperatorExpressionType::COMPARISON: {
+      auto comparison = std::dynamic_pointer_cast<Comparison>(predicate);
+      const auto &lhs = comparison->children_[0];
+      const auto &rhs = comparison->children_[1];
+      switch (comparison->GetComparisonType()) {
+        case ComparisonType::EQUAL:
+        case ComparisonType::NOT_EQUAL: {
+          auto lhs_column = std::dynamic_pointer_cast<ColumnValue>(lhs);
+          auto rhs_column = std::dynamic_pointer_cast<ColumnValue>(rhs);
+          double selectivity;
+          if (lhs_column != nullptr && rhs_column != nullptr) {
+            selectivity = EqualJoinSelectivity(*lhs_column, *rhs_column, input);
+          } else if (lhs_column != nullptr) {
+            selectivity = EqualSelectivity(lhs, rhs, input);
+          } else {
+            selectivity = EqualSelectivity(rhs, lhs, input);
+          }
+          return comparison->GetComparisonType() == ComparisonType::EQUAL ? selectivity : 1 - selectivity;
+        }
+        case ComparisonType::LESS:
+        case ComparisonType::LESS_EQUAL:
+        case ComparisonType::GREATER:
+        case ComparisonType::GREATER_EQUAL: {
+          // 统一为 "列 比较 常量" 的形式
+          auto type = comparison->GetComparisonType();
+          auto column = lhs;
+          auto constant = std::dynamic_pointer_cast<Const>(rhs);
+          if (constant == nullptr) {
+            column = rhs;
+            constant = std::dynamic_pointer_cast<Const>(lhs);
+            if (type == ComparisonType::LESS) {
+              type = ComparisonType::GREATER;
+            } else if (type == ComparisonType::LESS_EQUAL) {
+              type = ComparisonType::GREATER_EQUAL;
+            } else if (type == ComparisonType::GREATER) {
+              type = ComparisonType::LESS;
+            } else {
+              type = ComparisonType::LESS_EQUAL;
+            }
+          }
+          if (constant == nullptr) {
+            return DEFAULT_RANGE_SELECTIVITY;
+          }
+          std::optional<Value> bound = constant->value_;
+          bool inclusive = type == ComparisonType::LESS_EQUAL || type == ComparisonType::GREATER_EQUAL;
+          if (type == ComparisonType::LESS || type == ComparisonType::LESS_EQUAL) {
+            return ColumnRangeSelectivity(column, std::nullopt, false, bound, inclusive, input,
+                                          DEFAULT_RANGE_SELECTIVITY);
+          }
+          return ColumnRangeSelectivity(column, bound, inclusive, std::nullopt, false, input,
+                                        DEFAULT_RANGE_SELECTIVITY);
+        }
+        case ComparisonType::BETWEEN:
+        case ComparisonType::NOT_BETWEEN: {
+          double selectivity = DEFAULT_RANGE_SELECTIVITY * DEFAULT_RANGE_SELECTIVITY;
+          auto list = std::dynamic_pointer_cast<List>(rhs);
+          if (list != nullptr && list->exprs_.size() == 2) {
+            auto lower = std::dynamic_pointer_cast<Const>(list->exprs_[0]);
+            auto upper = std::dynamic_pointer_cast<Const>(list->exprs_[1]);
+            if (lower != nullptr && upper != nullptr) {
+              selectivity = ColumnRangeSelectivity(lhs, lower->value_, true, upper->value_, true, input, selectivity);
+            }
+          }
+          return comparison->GetComparisonType() == ComparisonType::BETWEEN ? selectivity : 1 - selectivity;
+        }
+        case ComparisonType::IN:
+        case ComparisonType::NOT_IN: {
+          // 列表中的每个值按一次等值比较估计
+          auto list = std::dynamic_pointer_cast<List>(rhs);
+          double selectivity = 0;
+          if (list == nullptr) {
+            selectivity = EqualSelectivity(lhs, nullptr, input);
+          } else {
+            for (const auto &expr : list->exprs_) {
+              selectivity += EqualSelectivity(lhs, expr, input);
+            }
+          }
+          selectivity = std::min(1.0, selectivity);
+          return comparison->GetComparisonType() == ComparisonType::IN ? selectivity : 1 - selectivity;
+        }
+        case ComparisonType::LIKE:
+        case ComparisonType::NOT_LIKE: {
+          // 不含通配符的模式等价于等值比较，以常量前缀开头的模式按范围条件估计
+          auto matcher = comparison->GetLikeMatcher();
+          double selectivity = DEFAULT_SELECTIVITY;
+          if (matcher != nullptr && matcher->GetKind() == LikeMatcher::Kind::EXACT) {
+            selectivity = EqualSelectivity(lhs, rhs, input);
+          } else if (matcher != nullptr && !matcher->GetPrefix().empty()) {
+            const auto &prefix = matcher->GetPrefix();
+            auto upper_bound = LikeMatcher::PrefixUpperBound(prefix);
+            std::optional<Value> upper;
+            if (upper_bound) {
+              upper = Value(*upper_bound);
+            }
+            selectivity = ColumnRangeSelectivity(lhs, Value(prefix), true, upper, false, input,
+                                                 DEFAULT_RANGE_SELECTIVITY * DEFAULT_RANGE_SELECTIVITY);
+          }
+          return comparison->GetComparisonType() == ComparisonType::LIKE ? selectivity : 1 - selectivity;
+        }
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return DEFAULT_SELECTIVITY;
+}
+
+double CostModel::RangeSelectivity(const std::string &table_name, const std::string &column_name, bool equal,
+                                   const std::optional<IndexScanBound> &lower,
+                                   const std::optional<IndexScanBound> &upper) const {
+  auto statistic = catalog_.GetColumnStatistic(table_name, column_name);
+  if (equal) {
+    if (statistic != nullptr && statistic->Comparable(lower->value_, false)) {
+      return statistic->EqualSelectivity(lower->value_);
+    }
+    auto distinct = catalog_.GetDistinct(table_name, column_name);
+    return (distinct == INVALID_DISTINCT || distinct == 0) ? DEFAULT_EQUALITY_SELECTIVITY : 1.0 / distinct;
+  }
+  if (statistic != nullptr && (!lower || statistic->Comparable(lower->value_, true)) &&
+      (!upper || statistic->Comparable(upper->value_, true))) {
+    std::optional<Value> lower_value;
+    std::optional<Value> upper_value;
+    if (lower) {
+      lower_value = lower->value_;
+    }
+    if (upper) {
+      upper_value = upper->value_;
+    }
+    return statistic->RangeSelectivity(lower_value, lower && lower->inclusive_, upper_value,
+                                       upper && upper->inclusive_);
+  }
+  double selectivity = 1;
+  if (lower) {
+    selectivity *= DEFAULT_RANGE_SELECTIVITY;
+  }
+  if (upper) {
+    selectivity *= DEFAULT_RANGE_SELECTIVITY;
+  }
+  return selectivity;
+}
+
+uint32_t CostModel::Distinct(const ColumnValue &column, const Operator &input) const {
+  auto [table, column_name] = FindColumn(column, input);
+  if (table == nullptr) {
+    return INVALID_DISTINCT;
+  }
+  return catalog_.GetDistinct(*table, column_name);
+}
+
+const ColumnStatistic *CostModel::Statistic(const std::shared_ptr<OperatorExpression> &expr,
+                                            const Operator &input) const {
+  auto column = std::dynamic_pointer_cast<ColumnValue>(expr);
+  if (column == nullptr) {
+    return nullptr;
+  }
+  auto [table, column_name] = FindColumn(*column, input);
+  if (table == nullptr) {
+    return nullptr;
+  }
+  return catalog_.GetColumnStatistic(*table, column_name);
+}
+
+double CostModel::RecordWidth(const ColumnList &column_list) {
+  double width = 0;
+  for (size_t i = 0; i < column_list.Length(); i++) {
+    width += column_list.GetColumn(i).GetMaxSize();
+  }
+  return width;
+}
+
+double CostModel::Pages(double rows, double width) {
+  if (rows <= 0) {
+    return 0;
+  }
+  return std::ceil(rows * width / (DB_PAGE_SIZE - PAGE_HEADER_SIZE));
+}
+
+PlanCost CostModel::SortCost(const PlanCost &input, double width, size_t key_count) {
+  PlanCost cost = input;
+  auto rows = input.rows_;
+  cost.cpu_ += rows * std::log2(std::max(rows, 2.0)) * CPU_OPERATOR_COST * std::max<size_t>(key_count, 1);
+  auto size = rows * width;
+  if (size > WORK_MEMORY_SIZE) {
+    // 每个顺串大小为 WORK_MEMORY_SIZE，每趟归并 INDEX_SORT_FAN_IN 个顺串，每趟读写全部数据各一次
+    auto runs = std::ceil(size / WORK_MEMORY_SIZE);
+    auto passes = std::ceil(std::log(runs) / std::log(static_cast<double>(INDEX_SORT_FAN_IN)));
+    cost.pages_ += 2 * Pages(rows, width) * std::max(passes, 1.0);
+  }
+  cost.memory_ = std::max(cost.memory_, std::min<double>(size, WORK_MEMORY_SIZE));
+  return cost;
+}
+
+double CostModel::TableRows(const std::string &table_name, PlanCost &cost) const {
+  auto cardinality = catalog_.GetCardinality(table_name);
+  if (cardinality == INVALID_CARDINALITY) {
+    cost.has_statistics_ = false;
+    return DEFAULT_CARDINALITY;
+  }
+  return cardinality;
+}
+
+double CostModel::IndexHeight(const Index &index, double rows) {
+  // 叶节点层之上每层的节点数按内部节点容量递减，直到只剩根节点
+  auto nodes = std::ceil(rows / index.LeafCapacity());
+  double height = 1;
+  while (nodes > 1) {
+    nodes = std::ceil(nodes / (index.InternalCapacity() + 1));
+    height++;
+  }
+  return height;
+}
+
+double CostModel::EqualJoinSelectivity(const ColumnValue &lhs, const ColumnValue &rhs, const Operator &input) const {
+  // 两侧都有高频值时按高频值匹配估计
+  auto lhs_column = std::make_shared<ColumnValue>(lhs);
+  auto rhs_column = std::make_shared<ColumnValue>(rhs);
+  auto lhs_statistic = Statistic(lhs_column, input);
+  auto rhs_statistic = Statistic(rhs_column, input);
+  if (lhs_statistic != nullptr && rhs_statistic != nullptr && lhs_statistic->distinct_ != INVALID_DISTINCT &&
+      rhs_statistic->distinct_ != INVALID_DISTINCT) {
+    return ColumnStatistic::JoinSelectivity(*lhs_statistic, *rhs_statistic);
+  }
+  // 假设不同值较少一侧的每个值都能在另一侧找到匹配
+  auto lhs_distinct = Distinct(lhs, input);
+  auto rhs_distinct = Distinct(rhs, input);
+  if (lhs_distinct == INVALID_DISTINCT && rhs_distinct == INVALID_DISTINCT) {
+    return DEFAULT_EQUALITY_SELECTIVITY;
+  }
+  uint32_t distinct;
+  if (lhs_distinct == INVALID_DISTINCT) {
+    distinct = rhs_distinct;
+  } else if (rhs_distinct == INVALID_DISTINCT) {
+    distinct = lhs_distinct;
+  } else {
+    distinct = std::max(lhs_distinct, rhs_distinct);
+  }
+  return 1.0 / std::max<uint32_t>(distinct, 1);
+}
+
+double CostModel::EqualSelectivity(const std::shared_ptr<OperatorExpression> &expr,
+                                   const std::shared_ptr<OperatorExpression> &other, const Operator &input) const {
+  auto column = std::dynamic_pointer_cast<ColumnValue>(expr);
+  if (column == nullptr) {
+    return DEFAULT_EQUALITY_SELECTIVITY;
+  }
+  // 与常量比较时根据高频值和直方图估计
+  auto constant = std::dynamic_pointer_cast<Const>(other);
+  auto statistic = Statistic(expr, input);
+  if (constant != nullptr && statistic != nullptr && statistic->Comparable(constant->value_, false)) {
+    return statistic->EqualSelectivity(constant->value_);
+  }
+  auto distinct = Distinct(*column, input);
+  return (distinct == INVALID_DISTINCT || distinct == 0) ? DEFAULT_EQUALITY_SELECTIVITY : 1.0 / distinct;
+}
+
+double CostModel::ColumnRangeSelectivity(const std::shared_ptr<OperatorExpression> &expr,
+                                         const std::optional<Value> &lower, bool lower_inclusive,
+                                         const std::optional<Value> &upper, bool upper_inclusive,
+                                         const Operator &input, double default_selectivity) const {
+  auto statistic = Statistic(expr, input);
+  if (statistic == nullptr || (lower && !statistic->Comparable(*lower, true)) ||
+      (upper && !statistic->Comparable(*upper, true))) {
+    return default_selectivity;
+  }
+  return statistic->RangeSelectivity(lower, lower_inclusive, upper, upper_inclusive);
+}
+
+}  // namespace huadb
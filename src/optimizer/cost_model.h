@@ -0,0 +1,98 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "catalog/catalog.h"
+#include "index/index.h"
+#include "operators/expressions/column_value.h"
+#include "operators/index_scan_operator.h"
+#include "operators/operator.h"
+
+namespace huadb {
+
+// 代价以读取一个页面为单位；缓冲池很小，顺序读取与随机读取均按一次磁盘访问计算
+// 处理一条记录的 CPU 代价
+static constexpr double CPU_TUPLE_COST = 0.01;
+// 处理一个索引项的 CPU 代价
+static constexpr double CPU_INDEX_TUPLE_COST = 0.005;
+// 计算一次比较、哈希等运算的 CPU 代价
+static constexpr double CPU_OPERATOR_COST = 0.0025;
+// 未收集统计信息的表按该记录数估计
+static constexpr double DEFAULT_CARDINALITY = 1000;
+// 缺少不同值个数时等值条件的选择率
+static constexpr double DEFAULT_EQUALITY_SELECTIVITY = 0.1;
+// 范围条件每一侧的选择率
+static constexpr double DEFAULT_RANGE_SELECTIVITY = 1.0 / 3;
+// IS NULL 的选择率
+static constexpr double DEFAULT_NULL_SELECTIVITY = 0.01;
+// 其余条件的选择率
+static constexpr double DEFAULT_SELECTIVITY = 1.0 / 3;
+
+// 查询计划的估计代价，包括全部子节点的代价
+struct PlanCost {
+  // 输出的记录数
+  double rows_ = 0;
+  // 读写的页面数，包括哈希表、排序超出内存时写出和读回的页面
+  double pages_ = 0;
+  // 处理记录和计算表达式的代价
+  double cpu_ = 0;
+  // 执行时同时占用的内存（字节）
+  double memory_ = 0;
+  // 涉及的表是否都收集了统计信息，为 false 时估计值只用于展示
+  bool has_statistics_ = true;
+
+  double Total() const { return pages_ + cpu_; }
+};
+
+// 根据系统表中的统计信息（表的记录数、列的不同值个数）估计查询计划的记录数和代价
+class CostModel {
+ public:
+  explicit CostModel(Catalog &catalog);
+
+  // 估计 plan 的代价，并记录到各节点的 estimated_rows_ 和 estimated_cost_ 中
+  PlanCost Estimate(const std::shared_ptr<Operator> &plan) const;
+  // 过滤条件在 input 输出的记录上的选择率
+  double Selectivity(const std::shared_ptr<OperatorExpression> &predicate, const Operator &input) const;
+  // 索引扫描范围的选择率，equal 表示上下界为同一个值
+  double RangeSelectivity(const std::string &table_name, const std::string &column_name, bool equal,
+                          const std::optional<IndexScanBound> &lower,
+                          const std::optional<IndexScanBound> &upper) const;
+  // input 输出的记录中 column 的不同值个数，缺少统计信息时返回 INVALID_DISTINCT
+  uint32_t Distinct(const ColumnValue &column, const Operator &input) const;
+
+  // 按各列的最大长度估计一条记录的字节数
+  static double RecordWidth(const ColumnList &column_list);
+  // 保存 rows 条宽度为 width 的记录需要的页面数
+  static double Pages(double rows, double width);
+  // 对 input 的输出排序后的代价，超出内存时按多趟外部归并排序估计
+  static PlanCost SortCost(const PlanCost &input, double width, size_t key_count);
+
+ private:
+  PlanCost EstimateSeqScan(const Operator &plan) const;
+  PlanCost EstimateIndexScan(const Operator &plan) const;
+  PlanCost EstimateJoin(const Operator &plan) const;
+  PlanCost EstimateIndexJoin(const Operator &plan) const;
+  PlanCost EstimateAggregate(const Operator &plan) const;
+
+  // 表的记录数，缺少统计信息时返回 DEFAULT_CARDINALITY
+  double TableRows(const std::string &table_name, PlanCost &cost) const;
+  // 按表的记录数和节点容量估计 B+ 树高度，避免在优化时读取索引页面
+  static double IndexHeight(const Index &index, double rows);
+  // 两列等值连接的选择率
+  double EqualJoinSelectivity(const ColumnValue &lhs, const ColumnValue &rhs, const Operator &input) const;
+  // 列 expr 与 other 等值比较的选择率，other 为常量时使用高频值和直方图
+  double EqualSelectivity(const std::shared_ptr<OperatorExpression> &expr,
+                          const std::shared_ptr<OperatorExpression> &other, const Operator &input) const;
+  // 列 expr 在 [lower, upper] 范围内的选择率，缺少直方图时返回 default_selectivity
+  double ColumnRangeSelectivity(const std::shared_ptr<OperatorExpression> &expr, const std::optional<Value> &lower,
+                                bool lower_inclusive, const std::optional<Value> &upper, bool upper_inclusive,
+                                const Operator &input, double default_selectivity) const;
+  // expr 为基本表的列时返回该列的统计信息，否则返回空指针
+  const ColumnStatistic *Statistic(const std::shared_ptr<OperatorExpression> &expr, const Operator &input) const;
+
+  Catalog &catalog_;
+};
+
+}  // namespace huadb
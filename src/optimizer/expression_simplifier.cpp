@@ -0,0 +1,422 @@
+#include "optimizer/expression_simplifier.h"
+
+namespace huadb {
+
+namespace {
+
+// 交换比较两侧时对应的比较类型
+ComparisonType Flip(ComparisonType type) {
+  switch (type) {
+    case ComparisonType::LESS:
+      return ComparisonType::GREATER;
+    case ComparisonType::LESS_EQUAL:
+      return ComparisonType::GREATER_EQUAL;
+    case ComparisonType::GREATER:
+      return ComparisonType::LESS;
+    case ComparisonType::GREATER_EQUAL:
+      return ComparisonType::LESS_EQUAL;
+    default:
+      return type;
+  }
+}
+
+// 取反后的比较类型；比较的一侧为空值时取反前后的结果均为空值，因此取反总是成立
+ComparisonType Negate(ComparisonType type) {
+  switch (type) {
+    case ComparisonType::EQUAL:
+      return ComparisonType::NOT_EQUAL;
+    case ComparisonType::NOT_EQUAL:
+      return ComparisonType::EQUAL;
+    case ComparisonType::LESS:
+      return ComparisonType::GREATER_EQUAL;
+    case ComparisonType::LESS_EQUAL:
+      return ComparisonType::GREATER;
+    case ComparisonType::GREATER:
+      return ComparisonType::LESS_EQUAL;
+    case ComparisonType::GREATER_EQUAL:
+      return ComparisonType::LESS;
+    case ComparisonType::BETWEEN:
+      return ComparisonType::NOT_BETWEEN;
+    case ComparisonType::NOT_BETWEEN:
+      return ComparisonType::BETWEEN;
+    case ComparisonType::IN:
+      return ComparisonType::NOT_IN;
+    case ComparisonType::NOT_IN:
+      return ComparisonType::IN;
+    case ComparisonType::LIKE:
+      return ComparisonType::NOT_LIKE;
+    case ComparisonType::NOT_LIKE:
+      return ComparisonType::LIKE;
+  }
+  throw DbException("Unknown comparison type");
+}
+
+bool IsSimpleComparison(ComparisonType type) {
+  switch (type) {
+    case ComparisonType::EQUAL:
+    case ComparisonType::NOT_EQUAL:
+    case ComparisonType::LESS:
+    case ComparisonType::LESS_EQUAL:
+    case ComparisonType::GREATER:
+    case ComparisonType::GREATER_EQUAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsNullConst(const std::shared_ptr<OperatorExpression> &expr) {
+  return expr->GetExprType() == OperatorExpressionType::CONST &&
+         std::dynamic_pointer_cast<Const>(expr)->value_.IsNull();
+}
+
+// 判断表达式的值是否一定为布尔类型
+bool IsBoolean(const std::shared_ptr<OperatorExpression> &expr) {
+  switch (expr->GetExprType()) {
+    case OperatorExpressionType::COMPARISON:
+    case OperatorExpressionType::LOGIC:
+    case OperatorExpressionType::NULL_TEST:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+std::shared_ptr<OperatorExpression> ExpressionSimplifier::Simplify(const std::shared_ptr<OperatorExpression> &expr,
+                                                                   bool predicate) {
+  std::shared_ptr<OperatorExpression> result = expr;
+  switch (expr->GetExprType()) {
+    case OperatorExpressionType::ARITHMETIC:
+      result = SimplifyArithmetic(expr);
+      break;
+    case OperatorExpressionType::COMPARISON:
+      result = SimplifyComparison(expr);
+      break;
+    case OperatorExpressionType::LOGIC:
+      if (std::dynamic_pointer_cast<Logic>(expr)->GetLogicType() == LogicType::NOT) {
+        result = SimplifyNot(expr);
+      } else {
+        result = SimplifyAndOr(expr, predicate);
+      }
+      break;
+    case OperatorExpressionType::NULL_TEST: {
+      auto null_test = std::dynamic_pointer_cast<NullTest>(expr);
+      auto arg = Simplify(null_test->arg_, false);
+      if (IsConst(arg)) {
+        result = std::make_shared<Const>(Value(std::dynamic_pointer_cast<Const>(arg)->value_.IsNull() ==
+                                               null_test->is_null_));
+      } else if (arg != null_test->arg_) {
+        result = std::make_shared<NullTest>(null_test->is_null_, arg);
+      }
+      break;
+    }
+    case OperatorExpressionType::TYPE_CAST: {
+      auto type_cast = std::dynamic_pointer_cast<TypeCast>(expr);
+      auto arg = Simplify(type_cast->arg_, false);
+      if (arg != type_cast->arg_) {
+        result = std::make_shared<TypeCast>(type_cast->cast_type_, arg);
+      }
+      if (IsConst(arg) && !IsNullConst(arg)) {
+        result = TryFold(result);
+      }
+      break;
+    }
+    case OperatorExpressionType::FUNC_CALL: {
+      auto func_call = std::dynamic_pointer_cast<FuncCall>(expr);
+      std::vector<std::shared_ptr<OperatorExpression>> args;
+      bool changed = false;
+      bool all_const = true;
+      for (const auto &arg : func_call->args_) {
+        args.push_back(Simplify(arg, false));
+        changed = changed || args.back() != arg;
+        all_const = all_const && IsConst(args.back()) && !IsNullConst(args.back());
+      }
+      if (changed) {
+        result = std::make_shared<FuncCall>(func_call->function_name_, std::move(args));
+      }
+      if (all_const) {
+        result = TryFold(result);
+      }
+      break;
+    }
+    case OperatorExpressionType::LIST: {
+      // 列表保持为 List 节点，只化简其中的元素，便于后续根据 BETWEEN / IN 的常量列表选择索引
+      auto list = std::dynamic_pointer_cast<List>(expr);
+      std::vector<std::shared_ptr<OperatorExpression>> exprs;
+      bool changed = false;
+      for (const auto &element : list->exprs_) {
+        exprs.push_back(Simplify(element, false));
+        changed = changed || exprs.back() != element;
+      }
+      if (changed) {
+        result = std::make_shared<List>(std::move(exprs));
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return result;
+}
+
+bool ExpressionSimplifier::IsTrue(const std::shared_ptr<OperatorExpression> &expr) {
+  if (!IsConst(expr)) {
+    return false;
+  }
+  const auto &value = std::dynamic_pointer_cast<Const>(expr)->value_;
+  return !value.IsNull() && value.GetType() == Type::BOOL && value.GetValue<bool>();
+}
+
+bool ExpressionSimplifier::IsFalseOrNull(const std::shared_ptr<OperatorExpression> &expr) {
+  if (!IsConst(expr)) {
+    return false;
+  }
+  const auto &value = std::dynamic_pointer_cast<Const>(expr)->value_;
+  return value.IsNull() || (value.GetType() == Type::BOOL && !value.GetValue<bool>());
+}
+
+std::shared_ptr<OperatorExpression> ExpressionSimplifier::SimplifyArithmetic(
+    const std::shared_ptr<OperatorExpression> &expr) {
+  auto arithmetic = std::dynamic_pointer_cast<Arithmetic>(expr);
+  auto lhs = Simplify(expr->children_[0], false);
+  auto rhs = Simplify(expr->children_[1], false);
+  if (IsNullConst(lhs) || IsNullConst(rhs)) {
+    return std::make_shared<Const>(Value());
+  }
+  std::shared_ptr<OperatorExpression> result = expr;
+  if (lhs != expr->children_[0] || rhs != expr->children_[1]) {
+    result = std::make_shared<Arithmetic>(arithmetic->GetArithmeticType(), lhs, rhs);
+  }
+  if (IsConst(lhs) && IsConst(rhs)) {
+    // 整数除以 0 留到执行时处理
+    const auto &divisor = std::dynamic_pointer_cast<Const>(rhs)->value_;
+    if (arithmetic->GetArithmeticType() == ArithmeticType::DIV && divisor.GetType() == Type::INT &&
+        divisor.GetValue<int32_t>() == 0) {
+      return result;
+    }
+    return TryFold(result);
+  }
+  return result;
+}
+
+std::shared_ptr<OperatorExpression> ExpressionSimplifier::SimplifyComparison(
+    const std::shared_ptr<OperatorExpression> &expr) {
+  auto comparison = std::dynamic_pointer_cast<Comparison>(expr);
+  auto type = comparison->GetComparisonType();
+  auto lhs = Simplify(expr->children_[0], false);
+  auto rhs = Simplify(expr->children_[1], false);
+  if (IsNullConst(lhs) || IsNullConst(rhs)) {
+    return std::make_shared<Const>(Value());
+  }
+  bool rhs_const = IsConst(rhs);
+  if (rhs->GetExprType() == OperatorExpressionType::LIST) {
+    rhs_const = true;
+    for (const auto &element : std::dynamic_pointer_cast<List>(rhs)->exprs_) {
+      rhs_const = rhs_const && IsConst(element);
+    }
+  }
+  std::shared_ptr<OperatorExpression> result = expr;
+  auto matcher = comparison->GetLikeMatcher();
+  if (matcher != nullptr && matcher->GetKind() == LikeMatcher::Kind::EXACT) {
+    // 不含通配符的 LIKE 等价于等值比较
+    type = type == ComparisonType::LIKE ? ComparisonType::EQUAL : ComparisonType::NOT_EQUAL;
+    result = std::make_shared<Comparison>(type, lhs, rhs);
+  }
+  if (IsSimpleComparison(type) && IsConst(lhs) && !rhs_const) {
+    // 常量统一放在比较的右侧
+    result = std::make_shared<Comparison>(Flip(type), rhs, lhs);
+  } else if (result == expr && (lhs != expr->children_[0] || rhs != expr->children_[1])) {
+    result = std::make_shared<Comparison>(type, lhs, rhs);
+  }
+  if (IsConst(lhs) && rhs_const) {
+    return TryFold(result);
+  }
+  return result;
+}
+
+std::shared_ptr<OperatorExpression> ExpressionSimplifier::SimplifyNot(const std::shared_ptr<OperatorExpression> &expr) {
+  auto arg = Simplify(expr->children_[0], false);
+  if (IsConst(arg)) {
+    const auto &value = std::dynamic_pointer_cast<Const>(arg)->value_;
+    if (value.IsNull()) {
+      return std::make_shared<Const>(Value());
+    }
+    if (value.GetType() == Type::BOOL) {
+      return std::make_shared<Const>(Value(!value.GetValue<bool>()));
+    }
+  }
+  switch (arg->GetExprType()) {
+    case OperatorExpressionType::COMPARISON: {
+      // NOT (x = 1) 改写为 x != 1
+      auto comparison = std::dynamic_pointer_cast<Comparison>(arg);
+      return std::make_shared<Comparison>(Negate(comparison->GetComparisonType()), arg->children_[0],
+                                          arg->children_[1]);
+    }
+    case OperatorExpressionType::NULL_TEST: {
+      auto null_test = std::dynamic_pointer_cast<NullTest>(arg);
+      return std::make_shared<NullTest>(!null_test->is_null_, null_test->arg_);
+    }
+    case OperatorExpressionType::LOGIC: {
+      // NOT NOT p 改写为 p
+      auto logic = std::dynamic_pointer_cast<Logic>(arg);
+      if (logic->GetLogicType() == LogicType::NOT && IsBoolean(arg->children_[0])) {
+        return arg->children_[0];
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  if (arg == expr->children_[0]) {
+    return expr;
+  }
+  return std::make_shared<Logic>(LogicType::NOT, arg);
+}
+
+std::shared_ptr<OperatorExpression> ExpressionSimplifier::SimplifyAndOr(const std::shared_ptr<OperatorExpression> &expr,
+                                                                        bool predicate) {
+  auto type = std::dynamic_pointer_cast<Logic>(expr)->GetLogicType();
+  std::vector<std::shared_ptr<OperatorExpression>> operands;
+  Flatten(expr, type, operands);
+  // 任一操作数为空值时结果为空值，因此 OR 的操作数不能按照 predicate 化简（空值与 false 对 OR 的结果不同）
+  bool operand_predicate = predicate && type == LogicType::AND;
+  std::vector<std::shared_ptr<OperatorExpression>> simplified;
+  for (const auto &operand : operands) {
+    auto result = Simplify(operand, operand_predicate);
+    Flatten(result, type, simplified);
+  }
+
+  std::vector<std::shared_ptr<OperatorExpression>> kept;
+  for (const auto &operand : simplified) {
+    if (IsNullConst(operand)) {
+      return std::make_shared<Const>(Value());
+    }
+    if (IsConst(operand) && operand->GetValueType() == Type::BOOL) {
+      bool value = std::dynamic_pointer_cast<Const>(operand)->value_.GetValue<bool>();
+      // TRUE AND p 与 FALSE OR p 均等价于 p
+      if (value == (type == LogicType::AND)) {
+        continue;
+      }
+      // 只判断真假时，FALSE AND p 恒为 false
+      if (type == LogicType::AND && predicate) {
+        return std::make_shared<Const>(Value(false));
+      }
+    }
+    bool duplicate = false;
+    for (const auto &other : kept) {
+      if (Equivalent(operand, other)) {
+        duplicate = true;
+        break;
+      }
+    }
+    if (!duplicate) {
+      kept.push_back(operand);
+    }
+  }
+  if (kept.empty()) {
+    return std::make_shared<Const>(Value(type == LogicType::AND));
+  }
+  // 重新组织为左深的二元 AND / OR
+  auto result = kept[0];
+  for (size_t i = 1; i < kept.size(); i++) {
+    result = std::make_shared<Logic>(type, result, kept[i]);
+  }
+  return result;
+}
+
+void ExpressionSimplifier::Flatten(const std::shared_ptr<OperatorExpression> &expr, LogicType type,
+                                   std::vector<std::shared_ptr<OperatorExpression>> &operands) {
+  if (expr->GetExprType() == OperatorExpressionType::LOGIC &&
+      std::dynamic_pointer_cast<Logic>(expr)->GetLogicType() == type) {
+    Flatten(expr->children_[0], type, operands);
+    Flatten(expr->children_[1], type, operands);
+  } else {
+    operands.push_back(expr);
+  }
+}
+
+std::shared_ptr<OperatorExpression> ExpressionSimplifier::TryFold(const std::shared_ptr<OperatorExpression> &expr) {
+  try {
+    return std::make_shared<Const>(expr->Evaluate(nullptr));
+  } catch (const std::exception &) {
+    return expr;
+  }
+}
+
+bool ExpressionSimplifier::Equivalent(const std::shared_ptr<OperatorExpression> &lhs,
+                                      const std::shared_ptr<OperatorExpression> &rhs) {
+  if (lhs == rhs) {
+    return true;
+  }
+  if (lhs->GetExprType() != rhs->GetExprType() || lhs->children_.size() != rhs->children_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs->children_.size(); i++) {
+    if (!Equivalent(lhs->children_[i], rhs->children_[i])) {
+      return false;
+    }
+  }
+  switch (lhs->GetExprType()) {
+    case OperatorExpressionType::CONST: {
+      const auto &lhs_value = std::dynamic_pointer_cast<Const>(lhs)->value_;
+      const auto &rhs_value = std::dynamic_pointer_cast<Const>(rhs)->value_;
+      if (lhs_value.IsNull() || rhs_value.IsNull()) {
+        return lhs_value.IsNull() && rhs_value.IsNull();
+      }
+      if (lhs_value.GetType() != rhs_value.GetType() || lhs_value.GetType() == Type::LIST ||
+          lhs_value.GetType() == Type::UINT) {
+        return false;
+      }
+      return lhs_value.Equal(rhs_value);
+    }
+    case OperatorExpressionType::COLUMN_VALUE: {
+      auto lhs_column = std::dynamic_pointer_cast<ColumnValue>(lhs);
+      auto rhs_column = std::dynamic_pointer_cast<ColumnValue>(rhs);
+      return lhs_column->GetColumnIndex() == rhs_column->GetColumnIndex() &&
+             lhs_column->IsLeft() == rhs_column->IsLeft();
+    }
+    case OperatorExpressionType::ARITHMETIC:
+      return std::dynamic_pointer_cast<Arithmetic>(lhs)->GetArithmeticType() ==
+             std::dynamic_pointer_cast<Arithmetic>(rhs)->GetArithmeticType();
+    case OperatorExpressionType::COMPARISON:
+      return std::dynamic_pointer_cast<Comparison>(lhs)->GetComparisonType() ==
+             std::dynamic_pointer_cast<Comparison>(rhs)->GetComparisonType();
+    case OperatorExpressionType::LOGIC:
+      return std::dynamic_pointer_cast<Logic>(lhs)->GetLogicType() ==
+             std::dynamic_pointer_cast<Logic>(rhs)->GetLogicType();
+    case OperatorExpressionType::NULL_TEST: {
+      auto lhs_test = std::dynamic_pointer_cast<NullTest>(lhs);
+      auto rhs_test = std::dynamic_pointer_cast<NullTest>(rhs);
+      return lhs_test->is_null_ == rhs_test->is_null_ && Equivalent(lhs_test->arg_, rhs_test->arg_);
+    }
+    case OperatorExpressionType::TYPE_CAST: {
+      auto lhs_cast = std::dynamic_pointer_cast<TypeCast>(lhs);
+      auto rhs_cast = std::dynamic_pointer_cast<TypeCast>(rhs);
+      return lhs_cast->cast_type_ == rhs_cast->cast_type_ && Equivalent(lhs_cast->arg_, rhs_cast->arg_);
+    }
+    case OperatorExpressionType::LIST: {
+      const auto &lhs_exprs = std::dynamic_pointer_cast<List>(lhs)->exprs_;
+      const auto &rhs_exprs = std::dynamic_pointer_cast<List>(rhs)->exprs_;
+      if (lhs_exprs.size() != rhs_exprs.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < lhs_exprs.size(); i++) {
+        if (!Equivalent(lhs_exprs[i], rhs_exprs[i])) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      // 函数调用和聚集函数不参与去重
+      return false;
+  }
+}
+
+bool ExpressionSimplifier::IsConst(const std::shared_ptr<OperatorExpression> &expr) {
+  return expr->GetExprType() == OperatorExpressionType::CONST;
+}
+
+}  // namespace huadb
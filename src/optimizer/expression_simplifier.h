@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "operators/expressions/expressions.h"
+
+namespace huadb {
+
+// 表达式化简：在执行前完成常量折叠、比较的规范化、恒真恒假条件的消除以及嵌套 AND / OR 的展开
+// 化简时不修改原有的表达式节点，需要改写的部分生成新的节点
+class ExpressionSimplifier {
+ public:
+  // predicate 为 true 时表达式只用于判断真假（过滤条件、连接条件），此时空值与 false 等价，可以进行更多化简
+  static std::shared_ptr<OperatorExpression> Simplify(const std::shared_ptr<OperatorExpression> &expr,
+                                                      bool predicate);
+  // 判断表达式是否为常量 true；为常量 false 或空值时，过滤条件不会选出任何记录
+  static bool IsTrue(const std::shared_ptr<OperatorExpression> &expr);
+  static bool IsFalseOrNull(const std::shared_ptr<OperatorExpression> &expr);
+
+ private:
+  static std::shared_ptr<OperatorExpression> SimplifyArithmetic(const std::shared_ptr<OperatorExpression> &expr);
+  static std::shared_ptr<OperatorExpression> SimplifyComparison(const std::shared_ptr<OperatorExpression> &expr);
+  static std::shared_ptr<OperatorExpression> SimplifyNot(const std::shared_ptr<OperatorExpression> &expr);
+  static std::shared_ptr<OperatorExpression> SimplifyAndOr(const std::shared_ptr<OperatorExpression> &expr,
+                                                           bool predicate);
+
+  // 展开同类型的嵌套 AND / OR，收集各个操作数
+  static void Flatten(const std::shared_ptr<OperatorExpression> &expr, LogicType type,
+                      std::vector<std::shared_ptr<OperatorExpression>> &operands);
+  // 所有子表达式均为常量时计算表达式的值，计算出错时不折叠，保留到执行时报错
+  static std::shared_ptr<OperatorExpression> TryFold(const std::shared_ptr<OperatorExpression> &expr);
+  // 判断两个表达式是否在结构上相同
+  static bool Equivalent(const std::shared_ptr<OperatorExpression> &lhs,
+                         const std::shared_ptr<OperatorExpression> &rhs);
+  static bool IsConst(const std::shared_ptr<OperatorExpression> &expr);
+};
+
+}  // namespace huadb
@@ -0,0 +1,203 @@
+#include "optimizer/join_order_enumerator.h"
+
+#include <algorithm>
+#include <string>
+
+#include "common/exceptions.h"
+
+namespace huadb {
+
+namespace {
+
+using RelationSet = JoinOrderEnumerator::RelationSet;
+
+RelationSet Single(size_t relation) { return RelationSet(1) << relation; }
+
+// 编号不大于 relation 的关系集合
+RelationSet UpTo(size_t relation) {
+  return relation + 1 >= MAX_JOIN_RELATIONS ? ~RelationSet(0) : Single(relation + 1) - 1;
+}
+
+size_t Lowest(RelationSet relations) { return __builtin_ctzll(relations); }
+
+size_t Count(RelationSet relations) { return __builtin_popcountll(relations); }
+
+}  // namespace
+
+JoinOrderEnumerator::JoinOrderEnumerator(std::vector<double> relation_rows)
+    : relation_rows_(std::move(relation_rows)), neighbors_(relation_rows_.size(), 0) {
+  if (relation_rows_.empty() || relation_rows_.size() > MAX_JOIN_RELATIONS) {
+    throw DbException("Join order enumeration supports 1 to " + std::to_string(MAX_JOIN_RELATIONS) + " relations");
+  }
+}
+
+void JoinOrderEnumerator::AddPredicate(RelationSet relations, double selectivity) {
+  predicates_.emplace_back(relations, selectivity);
+  for (auto rest = relations; rest != 0; rest &= rest - 1) {
+    auto relation = Lowest(rest);
+    neighbors_[relation] |= relations & ~Single(relation);
+  }
+  rows_.clear();
+}
+
+size_t JoinOrderEnumerator::EnumerateDP() {
+  auto relation_count = relation_rows_.size();
+  nodes_.clear();
+  best_.clear();
+  for (size_t i = 0; i < relation_count; i++) {
+    nodes_.push_back({Single(i), Rows(Single(i)), 0, i, 0, 0});
+    best_[Single(i)] = i;
+  }
+
+  // 按编号从大到小，以每个关系为起点枚举只包含编号不小于它的关系的连通子图，每个连通子图只出现一次
+  std::vector<RelationSet> subgraphs;
+  for (size_t i = relation_count; i-- > 0;) {
+    subgraphs.push_back(Single(i));
+    EnumerateCsgRec(Single(i), UpTo(i), subgraphs);
+  }
+  std::vector<std::pair<RelationSet, RelationSet>> pairs;
+  for (auto subgraph : subgraphs) {
+    EnumerateCmp(subgraph, pairs);
+  }
+  pair_count_ = pairs.size();
+  // 按合并后的关系个数从小到大处理，保证处理每个连接对时两侧的最优计划都已确定
+  std::stable_sort(pairs.begin(), pairs.end(), [](const auto &lhs, const auto &rhs) {
+    return Count(lhs.first | lhs.second) < Count(rhs.first | rhs.second);
+  });
+  for (const auto &[left, right] : pairs) {
+    Join(best_.at(left), best_.at(right));
+  }
+
+  // 各连通分量的最优计划之间只能做笛卡尔积
+  std::vector<size_t> components;
+  RelationSet visited = 0;
+  for (size_t i = 0; i < relation_count; i++) {
+    if ((visited & Single(i)) != 0) {
+      continue;
+    }
+    RelationSet component = Single(i);
+    for (RelationSet frontier = component; frontier != 0;) {
+      frontier = Neighbors(component, 0);
+      component |= frontier;
+    }
+    visited |= component;
+    components.push_back(best_.at(component));
+  }
+  return Greedy(std::move(components));
+}
+
+size_t JoinOrderEnumerator::EnumerateGreedy() {
+  nodes_.clear();
+  best_.clear();
+  std::vector<size_t> trees;
+  for (size_t i = 0; i < relation_rows_.size(); i++) {
+    nodes_.push_back({Single(i), Rows(Single(i)), 0, i, 0, 0});
+    best_[Single(i)] = i;
+    trees.push_back(i);
+  }
+  return Greedy(std::move(trees));
+}
+
+double JoinOrderEnumerator::Rows(RelationSet relations) {
+  if (rows_.find(relations) != rows_.end()) {
+    return rows_.at(relations);
+  }
+  double rows = 1;
+  for (auto rest = relations; rest != 0; rest &= rest - 1) {
+    rows *= relation_rows_[Lowest(rest)];
+  }
+  for (const auto &[predicate_relations, selectivity] : predicates_) {
+    if (Count(predicate_relations) > 1 && (predicate_relations & ~relations) == 0) {
+      rows *= selectivity;
+    }
+  }
+  rows_[relations] = rows;
+  return rows;
+}
+
+RelationSet JoinOrderEnumerator::Neighbors(RelationSet relations, RelationSet excluded) const {
+  RelationSet neighbors = 0;
+  for (auto rest = relations; rest != 0; rest &= rest - 1) {
+    neighbors |= neighbors_[Lowest(rest)];
+  }
+  return neighbors & ~relations & ~excluded;
+}
+
+void JoinOrderEnumerator::EnumerateCsgRec(RelationSet relations, RelationSet excluded,
+                                          std::vector<RelationSet> &subgraphs) const {
+  auto neighbors = Neighbors(relations, excluded);
+  if (neighbors == 0) {
+    return;
+  }
+  // 依次枚举邻居集合的非空子集，先输出全部扩展结果再递归，递归时排除本层的全部邻居以避免重复
+  for (RelationSet subset = neighbors; subset != 0; subset = (subset - 1) & neighbors) {
+    subgraphs.push_back(relations | subset);
+  }
+  for (RelationSet subset = neighbors; subset != 0; subset = (subset - 1) & neighbors) {
+    EnumerateCsgRec(relations | subset, excluded | neighbors, subgraphs);
+  }
+}
+
+void JoinOrderEnumerator::EnumerateCmp(RelationSet relations,
+                                       std::vector<std::pair<RelationSet, RelationSet>> &pairs) const {
+  // 补集只包含编号大于 relations 中最小编号的关系，每个无序连接对只枚举一次
+  auto excluded = UpTo(Lowest(relations)) | relations;
+  auto neighbors = Neighbors(relations, excluded);
+  std::vector<RelationSet> complements;
+  for (size_t i = MAX_JOIN_RELATIONS; i-- > 0;) {
+    if ((neighbors & Single(i)) == 0) {
+      continue;
+    }
+    complements.clear();
+    complements.push_back(Single(i));
+    EnumerateCsgRec(Single(i), excluded | (UpTo(i) & neighbors), complements);
+    for (auto complement : complements) {
+      pairs.emplace_back(relations, complement);
+    }
+  }
+}
+
+size_t JoinOrderEnumerator::Join(size_t left, size_t right) {
+  if (nodes_[right].rows_ < nodes_[left].rows_) {
+    std::swap(left, right);
+  }
+  auto relations = nodes_[left].relations_ | nodes_[right].relations_;
+  auto rows = Rows(relations);
+  auto cost = nodes_[left].cost_ + nodes_[right].cost_ + rows;
+  auto iter = best_.find(relations);
+  if (iter != best_.end() && nodes_[iter->second].cost_ <= cost) {
+    return iter->second;
+  }
+  nodes_.push_back({relations, rows, cost, 0, left, right});
+  best_[relations] = nodes_.size() - 1;
+  return nodes_.size() - 1;
+}
+
+size_t JoinOrderEnumerator::Greedy(std::vector<size_t> trees) {
+  while (trees.size() > 1) {
+    // 优先合并有连接条件的两棵子树，避免笛卡尔积
+    size_t best_i = 0;
+    size_t best_j = 0;
+    bool best_connected = false;
+    double best_rows = 0;
+    for (size_t i = 0; i < trees.size(); i++) {
+      for (size_t j = i + 1; j < trees.size(); j++) {
+        auto lhs = nodes_[trees[i]].relations_;
+        auto rhs = nodes_[trees[j]].relations_;
+        bool connected = (Neighbors(lhs, 0) & rhs) != 0;
+        auto rows = Rows(lhs | rhs);
+        if (best_j == 0 || (connected && !best_connected) || (connected == best_connected && rows < best_rows)) {
+          best_i = i;
+          best_j = j;
+          best_connected = connected;
+          best_rows = rows;
+        }
+      }
+    }
+    trees[best_i] = Join(trees[best_i], trees[best_j]);
+    trees.erase(trees.begin() + best_j);
+  }
+  return trees[0];
+}
+
+}  // namespace huadb
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace huadb {
+
+// 连接顺序枚举最多支持的关系个数
+static constexpr size_t MAX_JOIN_RELATIONS = 64;
+
+// 在连接图上选择连接顺序，代价为各个中间结果的记录数之和（C_out）
+// 关系集合用位图表示，第 i 位对应第 i 个关系
+class JoinOrderEnumerator {
+ public:
+  using RelationSet = uint64_t;
+
+  // 连接树的节点，叶节点对应一个关系
+  struct JoinNode {
+    RelationSet relations_;
+    // 估计的输出记录数
+    double rows_;
+    // 子树中各个中间结果的记录数之和
+    double cost_;
+    // 叶节点对应的关系编号
+    size_t relation_;
+    // 非叶节点的左右孩子在 GetNode 中的下标，左孩子的估计记录数不大于右孩子
+    size_t left_;
+    size_t right_;
+
+    bool IsLeaf() const { return (relations_ & (relations_ - 1)) == 0; }
+  };
+
+  // relation_rows 为各关系的估计记录数
+  explicit JoinOrderEnumerator(std::vector<double> relation_rows);
+
+  // 添加连接条件，relations 为条件涉及的关系集合，selectivity 为条件的选择率
+  void AddPredicate(RelationSet relations, double selectivity);
+
+  // DPccp：按连接图的连通子图及其连通补集枚举连接对，得到代价最小的浓密树（bushy tree）
+  // 连接图不连通时，各连通分量内部使用动态规划，分量之间按贪心算法做笛卡尔积
+  // 返回根节点的下标
+  size_t EnumerateDP();
+  // GOO（Greedy Operator Ordering）：每次合并估计结果最小的两棵有连接条件的子树，没有时才做笛卡尔积
+  size_t EnumerateGreedy();
+
+  const JoinNode &GetNode(size_t index) const { return nodes_[index]; }
+  // 关系集合连接结果的估计记录数
+  double Rows(RelationSet relations);
+  // 最近一次 EnumerateDP 枚举的连接对个数
+  size_t GetPairCount() const { return pair_count_; }
+
+ private:
+  // 与 relations 中的关系有连接条件、且不属于 relations 和 excluded 的关系
+  RelationSet Neighbors(RelationSet relations, RelationSet excluded) const;
+  // 以 relations 为起点，通过 excluded 之外的邻居扩展，枚举所有更大的连通子图
+  void EnumerateCsgRec(RelationSet relations, RelationSet excluded, std::vector<RelationSet> &subgraphs) const;
+  // 枚举与连通子图 relations 不相交且相邻的连通子图
+  void EnumerateCmp(RelationSet relations, std::vector<std::pair<RelationSet, RelationSet>> &pairs) const;
+  // 连接两棵子树，代价更小时替换 best_ 中的计划
+  size_t Join(size_t left, size_t right);
+  // 以 trees 为初始森林执行贪心合并
+  size_t Greedy(std::vector<size_t> trees);
+
+  std::vector<double> relation_rows_;
+  // 各关系通过连接条件相邻的关系集合
+  std::vector<RelationSet> neighbors_;
+  std::vector<std::pair<RelationSet, double>> predicates_;
+  std::vector<JoinNode> nodes_;
+  // 各关系集合代价最小的连接树
+  std::unordered_map<RelationSet, size_t> best_;
+  std::unordered_map<RelationSet, double> rows_;
+  size_t pair_count_ = 0;
+};
+
+}  // namespace huadb
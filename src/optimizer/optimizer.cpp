@@ -1,16 +1,83 @@
 #include "optimizer/optimizer.h"
 
+#include <functional>
+#include <unordered_map>
+
+#include "index/index.h"
+#include "operators/expressions/column_value.h"
+#include "operators/expressions/comparison.h"
+#include "operators/expressions/const.h"
+#include "operators/expressions/func_call.h"
+#include "operators/expressions/list.h"
+#include "operators/expressions/logic.h"
+#include "operators/operators.h"
+#include "optimizer/expression_simplifier.h"
+
 namespace huadb {
 
-Optimizer::Optimizer(Catalog &catalog, JoinOrderAlgorithm join_order_algorithm, bool enable_projection_pushdown)
+Optimizer::Optimizer(Catalog &catalog, JoinOrderAlgorithm join_order_algorithm, bool enable_projection_pushdown,
+                     bool enable_hash_join, bool enable_merge_join)
     : catalog_(catalog),
       join_order_algorithm_(join_order_algorithm),
-      enable_projection_pushdown_(enable_projection_pushdown) {}
+      enable_projection_pushdown_(enable_projection_pushdown),
+      enable_hash_join_(enable_hash_join),
+      enable_merge_join_(enable_merge_join),
+      cost_model_(catalog) {}
 
 std::shared_ptr<Operator> Optimizer::Optimize(std::shared_ptr<Operator> plan) {
+  plan = SimplifyExpressions(plan);
   plan = SplitPredicates(plan);
   plan = PushDown(plan);
   plan = ReorderJoin(plan);
+  // 修改语句在扫描的同时会修改索引，不使用索引扫描
+  bool allow_index_scan = plan->GetType() != OperatorType::INSERT && plan->GetType() != OperatorType::UPDATE &&
+                          plan->GetType() != OperatorType::DELETE;
+  plan = SelectPhysicalOperators(plan, allow_index_scan);
+  return plan;
+}
+
+std::shared_ptr<Operator> Optimizer::SimplifyExpressions(std::shared_ptr<Operator> plan) {
+  for (auto &child : plan->children_) {
+    child = SimplifyExpressions(child);
+  }
+  switch (plan->GetType()) {
+    case OperatorType::FILTER: {
+      auto filter = std::dynamic_pointer_cast<FilterOperator>(plan);
+      filter->predicate_ = ExpressionSimplifier::Simplify(filter->predicate_, true);
+      if (ExpressionSimplifier::IsTrue(filter->predicate_)) {
+        return plan->children_[0];
+      }
+      if (ExpressionSimplifier::IsFalseOrNull(filter->predicate_)) {
+        // 没有记录满足过滤条件，无需扫描下层节点
+        return std::make_shared<ValuesOperator>(plan->column_list_,
+                                                std::vector<std::vector<std::shared_ptr<OperatorExpression>>>());
+      }
+      break;
+    }
+    case OperatorType::PROJECTION: {
+      for (auto &expr : std::dynamic_pointer_cast<ProjectionOperator>(plan)->exprs_) {
+        expr = ExpressionSimplifier::Simplify(expr, false);
+      }
+      break;
+    }
+    case OperatorType::NESTEDLOOP: {
+      auto join = std::dynamic_pointer_cast<NestedLoopJoinOperator>(plan);
+      join->join_condition_ = ExpressionSimplifier::Simplify(join->join_condition_, true);
+      if (join->join_type_ == JoinType::INNER && ExpressionSimplifier::IsFalseOrNull(join->join_condition_)) {
+        return std::make_shared<ValuesOperator>(plan->column_list_,
+                                                std::vector<std::vector<std::shared_ptr<OperatorExpression>>>());
+      }
+      break;
+    }
+    case OperatorType::UPDATE: {
+      for (auto &expr : std::dynamic_pointer_cast<UpdateOperator>(plan)->update_exprs_) {
+        expr = ExpressionSimplifier::Simplify(expr, false);
+      }
+      break;
+    }
+    default:
+      break;
+  }
   return plan;
 }
 
@@ -81,10 +148,580 @@ std::shared_ptr<Operator> Optimizer::PushDownSeqScan(std::shared_ptr<Operator> p
   return plan;
 }
 
+namespace {
+
+// 收集 AND 连接的各个子条件
+void CollectConjuncts(const std::shared_ptr<OperatorExpression> &predicate,
+                      std::vector<std::shared_ptr<OperatorExpression>> &conjuncts) {
+  auto logic = std::dynamic_pointer_cast<Logic>(predicate);
+  if (logic != nullptr && logic->GetLogicType() == LogicType::AND) {
+    CollectConjuncts(logic->children_[0], conjuncts);
+    CollectConjuncts(logic->children_[1], conjuncts);
+  } else {
+    conjuncts.push_back(predicate);
+  }
+}
+
+// 连接区域中的一个关系
+struct JoinRelation {
+  std::shared_ptr<Operator> plan_;
+  // 关系的第一列在连接区域原输出中的下标
+  size_t offset_;
+};
+
+bool IsInnerJoin(const Operator &plan) {
+  return plan.GetType() == OperatorType::NESTEDLOOP &&
+         dynamic_cast<const NestedLoopJoinOperator &>(plan).join_type_ == JoinType::INNER;
+}
+
+// plan 是否为连接区域的根，即经过若干 Filter 后到达内连接
+bool IsJoinRegion(const Operator &plan) {
+  const auto *node = &plan;
+  while (node->GetType() == OperatorType::FILTER) {
+    node = node->children_[0].get();
+  }
+  return IsInnerJoin(*node);
+}
+
+// 将 expr 中的列替换为 rebind 的返回值，列以外的节点就地修改
+std::shared_ptr<OperatorExpression> RebindColumns(
+    std::shared_ptr<OperatorExpression> expr,
+    const std::function<std::shared_ptr<OperatorExpression>(const ColumnValue &)> &rebind) {
+  if (auto column = std::dynamic_pointer_cast<ColumnValue>(expr)) {
+    return rebind(*column);
+  }
+  for (auto &child : expr->children_) {
+    child = RebindColumns(child, rebind);
+  }
+  if (auto func_call = std::dynamic_pointer_cast<FuncCall>(expr)) {
+    for (auto &arg : func_call->args_) {
+      arg = RebindColumns(arg, rebind);
+    }
+  }
+  return expr;
+}
+
+std::shared_ptr<ColumnValue> MakeColumn(const ColumnValue &column, size_t col_idx, bool is_left) {
+  return std::make_shared<ColumnValue>(col_idx, column.GetValueType(), column.name_, column.GetSize(), is_left);
+}
+
+// 收集连接区域中的关系和条件，条件中的列改为按连接区域原输出的下标绑定
+void CollectJoinRegion(const std::shared_ptr<Operator> &plan, size_t offset, std::vector<JoinRelation> &relations,
+                       std::vector<std::shared_ptr<OperatorExpression>> &predicates) {
+  std::vector<std::shared_ptr<OperatorExpression>> conjuncts;
+  if (plan->GetType() == OperatorType::FILTER) {
+    CollectJoinRegion(plan->children_[0], offset, relations, predicates);
+    CollectConjuncts(std::dynamic_pointer_cast<FilterOperator>(plan)->predicate_, conjuncts);
+    for (auto &conjunct : conjuncts) {
+      predicates.push_back(RebindColumns(conjunct, [&](const ColumnValue &column) {
+        return MakeColumn(column, offset + column.GetColumnIndex(), true);
+      }));
+    }
+  } else if (IsInnerJoin(*plan)) {
+    auto left_width = plan->children_[0]->OutputColumns().Length();
+    CollectJoinRegion(plan->children_[0], offset, relations, predicates);
+    CollectJoinRegion(plan->children_[1], offset + left_width, relations, predicates);
+    CollectConjuncts(std::dynamic_pointer_cast<NestedLoopJoinOperator>(plan)->join_condition_, conjuncts);
+    for (auto &conjunct : conjuncts) {
+      if (ExpressionSimplifier::IsTrue(conjunct)) {
+        continue;
+      }
+      predicates.push_back(RebindColumns(conjunct, [&](const ColumnValue &column) {
+        return MakeColumn(column, offset + (column.IsLeft() ? 0 : left_width) + column.GetColumnIndex(), true);
+      }));
+    }
+  } else {
+    relations.push_back({plan, offset});
+  }
+}
+
+// 用 AND 连接多个条件
+std::shared_ptr<OperatorExpression> MakeConjunction(const std::vector<std::shared_ptr<OperatorExpression>> &conjuncts) {
+  std::shared_ptr<OperatorExpression> result;
+  for (const auto &conjunct : conjuncts) {
+    result = result == nullptr ? conjunct : std::make_shared<Logic>(LogicType::AND, result, conjunct);
+  }
+  return result;
+}
+
+}  // namespace
+
 std::shared_ptr<Operator> Optimizer::ReorderJoin(std::shared_ptr<Operator> plan) {
   // 通过 catalog_.GetCardinality 和 catalog_.GetDistinct 从系统表中读取表和列的元信息
   // 可根据 join_order_algorithm_ 变量的值选择不同的连接顺序选择算法，默认为 None，表示不进行连接顺序优化
-  // LAB 5 BEGIN
+  if (join_order_algorithm_ == JoinOrderAlgorithm::NONE) {
+    return plan;
+  }
+  if (IsJoinRegion(*plan)) {
+    return ReorderJoinRegion(std::move(plan));
+  }
+  for (auto &child : plan->children_) {
+    auto reordered = ReorderJoin(child);
+    // 上层为 Projection 时直接改写其表达式中的列，省去恢复列顺序的 Projection
+    if (plan->GetType() == OperatorType::PROJECTION && child->GetType() != OperatorType::PROJECTION &&
+        reordered->GetType() == OperatorType::PROJECTION) {
+      auto restore = std::dynamic_pointer_cast<ProjectionOperator>(reordered);
+      for (auto &expr : std::dynamic_pointer_cast<ProjectionOperator>(plan)->exprs_) {
+        expr = RebindColumns(expr, [&](const ColumnValue &column) { return restore->exprs_[column.GetColumnIndex()]; });
+      }
+      reordered = restore->children_[0];
+    }
+    child = std::move(reordered);
+  }
+  return plan;
+}
+
+std::shared_ptr<Operator> Optimizer::ReorderJoinRegion(std::shared_ptr<Operator> plan) {
+  std::vector<JoinRelation> relations;
+  std::vector<std::shared_ptr<OperatorExpression>> predicates;
+  CollectJoinRegion(plan, 0, relations, predicates);
+  if (relations.size() > MAX_JOIN_RELATIONS) {
+    return plan;
+  }
+  for (auto &relation : relations) {
+    relation.plan_ = ReorderJoin(relation.plan_);
+  }
+
+  // 每个条件涉及的关系集合
+  auto relation_of = [&](size_t col_idx) {
+    size_t relation = 0;
+    while (relation + 1 < relations.size() && relations[relation + 1].offset_ <= col_idx) {
+      relation++;
+    }
+    return relation;
+  };
+  std::vector<JoinOrderEnumerator::RelationSet> predicate_relations;
+  for (auto &predicate : predicates) {
+    JoinOrderEnumerator::RelationSet predicate_relation = 0;
+    predicate = RebindColumns(predicate, [&](const ColumnValue &column) {
+      predicate_relation |= JoinOrderEnumerator::RelationSet(1) << relation_of(column.GetColumnIndex());
+      return MakeColumn(column, column.GetColumnIndex(), true);
+    });
+    predicate_relations.push_back(predicate_relation);
+  }
+
+  // 只涉及一个关系的条件下推到该关系上方
+  for (size_t i = 0; i < relations.size(); i++) {
+    std::vector<std::shared_ptr<OperatorExpression>> local_predicates;
+    for (size_t j = 0; j < predicates.size(); j++) {
+      if (predicate_relations[j] == JoinOrderEnumerator::RelationSet(1) << i) {
+        local_predicates.push_back(RebindColumns(predicates[j], [&](const ColumnValue &column) {
+          return MakeColumn(column, column.GetColumnIndex() - relations[i].offset_, true);
+        }));
+      }
+    }
+    if (!local_predicates.empty()) {
+      auto &relation_plan = relations[i].plan_;
+      relation_plan = std::make_shared<FilterOperator>(std::make_shared<ColumnList>(relation_plan->OutputColumns()),
+                                                       relation_plan, MakeConjunction(local_predicates));
+    }
+  }
+
+  // 按过滤后的记录数和连接条件的选择率选择连接顺序
+  std::vector<double> relation_rows;
+  for (const auto &relation : relations) {
+    relation_rows.push_back(cost_model_.Estimate(relation.plan_).rows_);
+  }
+  JoinOrderEnumerator enumerator(std::move(relation_rows));
+  for (size_t j = 0; j < predicates.size(); j++) {
+    if ((predicate_relations[j] & (predicate_relations[j] - 1)) != 0) {
+      enumerator.AddPredicate(predicate_relations[j], cost_model_.Selectivity(predicates[j], *plan));
+    }
+  }
+  size_t root;
+  if (join_order_algorithm_ == JoinOrderAlgorithm::DP && relations.size() <= DP_JOIN_RELATIONS_LIMIT) {
+    root = enumerator.EnumerateDP();
+  } else {
+    root = enumerator.EnumerateGreedy();
+  }
+
+  // 按连接树自底向上生成连接，columns 记录输出的每一列在连接区域原输出中的下标
+  std::vector<bool> applied(predicates.size(), false);
+  std::function<std::shared_ptr<Operator>(size_t, std::vector<size_t> &)> build = [&](size_t index,
+                                                                                     std::vector<size_t> &columns) {
+    const auto &node = enumerator.GetNode(index);
+    if (node.IsLeaf()) {
+      const auto &relation = relations[node.relation_];
+      for (size_t i = 0; i < relation.plan_->OutputColumns().Length(); i++) {
+        columns.push_back(relation.offset_ + i);
+      }
+      return relation.plan_;
+    }
+    std::vector<size_t> left_columns;
+    std::vector<size_t> right_columns;
+    auto left = build(node.left_, left_columns);
+    auto right = build(node.right_, right_columns);
+    std::unordered_map<size_t, std::pair<size_t, bool>> positions;
+    for (size_t i = 0; i < left_columns.size(); i++) {
+      positions[left_columns[i]] = {i, true};
+    }
+    for (size_t i = 0; i < right_columns.size(); i++) {
+      positions[right_columns[i]] = {i, false};
+    }
+    std::vector<std::shared_ptr<OperatorExpression>> join_predicates;
+    for (size_t j = 0; j < predicates.size(); j++) {
+      if (!applied[j] && predicate_relations[j] != 0 && (predicate_relations[j] & ~node.relations_) == 0) {
+        applied[j] = true;
+        join_predicates.push_back(RebindColumns(predicates[j], [&](const ColumnValue &column) {
+          const auto &[col_idx, is_left] = positions.at(column.GetColumnIndex());
+          return MakeColumn(column, col_idx, is_left);
+        }));
+      }
+    }
+    auto join_condition = MakeConjunction(join_predicates);
+    if (join_condition == nullptr) {
+      join_condition = std::make_shared<Const>(Value(true));
+    }
+    auto column_list = std::make_shared<ColumnList>();
+    for (const auto &column : left->OutputColumns().GetColumns()) {
+      column_list->AddColumn(column);
+    }
+    for (const auto &column : right->OutputColumns().GetColumns()) {
+      column_list->AddColumn(column);
+    }
+    columns = std::move(left_columns);
+    columns.insert(columns.end(), right_columns.begin(), right_columns.end());
+    return std::shared_ptr<Operator>(std::make_shared<NestedLoopJoinOperator>(
+        std::move(column_list), std::move(left), std::move(right), std::move(join_condition)));
+  };
+  for (size_t j = 0; j < predicates.size(); j++) {
+    applied[j] = (predicate_relations[j] & (predicate_relations[j] - 1)) == 0 && predicate_relations[j] != 0;
+  }
+  std::vector<size_t> columns;
+  auto result = build(root, columns);
+
+  std::vector<size_t> positions(columns.size());
+  for (size_t i = 0; i < columns.size(); i++) {
+    positions[columns[i]] = i;
+  }
+  // 不涉及任何列的条件保留在连接区域的上方
+  std::vector<std::shared_ptr<OperatorExpression>> constant_predicates;
+  for (size_t j = 0; j < predicates.size(); j++) {
+    if (predicate_relations[j] == 0) {
+      constant_predicates.push_back(predicates[j]);
+    }
+  }
+  if (!constant_predicates.empty()) {
+    result = std::make_shared<FilterOperator>(std::make_shared<ColumnList>(result->OutputColumns()), result,
+                                              MakeConjunction(constant_predicates));
+  }
+  bool reordered = false;
+  for (size_t i = 0; i < columns.size(); i++) {
+    reordered = reordered || columns[i] != i;
+  }
+  if (!reordered) {
+    return result;
+  }
+  std::vector<std::shared_ptr<OperatorExpression>> exprs;
+  const auto &output_columns = plan->OutputColumns();
+  for (size_t i = 0; i < output_columns.Length(); i++) {
+    const auto &column = output_columns.GetColumn(i);
+    exprs.push_back(std::make_shared<ColumnValue>(positions[i], column.type_, column.name_, column.GetMaxSize()));
+  }
+  return std::make_shared<ProjectionOperator>(std::make_shared<ColumnList>(output_columns), std::move(result),
+                                              std::move(exprs));
+}
+
+std::shared_ptr<Operator> Optimizer::SelectPhysicalOperators(std::shared_ptr<Operator> plan, bool allow_index_scan) {
+  for (auto &child : plan->children_) {
+    child = SelectPhysicalOperators(child, allow_index_scan);
+  }
+  switch (plan->GetType()) {
+    case OperatorType::FILTER:
+      return allow_index_scan ? SelectIndexScan(std::move(plan)) : plan;
+    case OperatorType::NESTEDLOOP:
+      return SelectJoin(std::move(plan));
+    case OperatorType::AGGREGATE:
+      return SelectAggregate(std::move(plan));
+    default:
+      return plan;
+  }
+}
+
+std::shared_ptr<Operator> Optimizer::SelectJoin(std::shared_ptr<Operator> plan) {
+  auto join = std::dynamic_pointer_cast<NestedLoopJoinOperator>(plan);
+  // 连接条件需为两侧列的等值比较
+  auto condition = std::dynamic_pointer_cast<Comparison>(join->join_condition_);
+  if (condition == nullptr || condition->GetComparisonType() != ComparisonType::EQUAL) {
+    return plan;
+  }
+  auto lhs = std::dynamic_pointer_cast<ColumnValue>(condition->children_[0]);
+  auto rhs = std::dynamic_pointer_cast<ColumnValue>(condition->children_[1]);
+  if (lhs == nullptr || rhs == nullptr || lhs->IsLeft() == rhs->IsLeft() ||
+      lhs->GetValueType() != rhs->GetValueType()) {
+    return plan;
+  }
+  auto best_cost = cost_model_.Estimate(plan);
+  if (!best_cost.has_statistics_) {
+    return plan;
+  }
+  auto best_plan = plan;
+  auto consider = [&](std::shared_ptr<Operator> candidate) {
+    auto cost = cost_model_.Estimate(candidate);
+    if (cost.Total() < best_cost.Total()) {
+      best_plan = std::move(candidate);
+      best_cost = cost;
+    }
+  };
+
+  // 依次尝试以右孩子、左孩子作为内表，内表连接列上有索引时可以使用 Index Nested Loop Join
+  for (bool outer_is_left : {true, false}) {
+    const auto &outer = join->children_[outer_is_left ? 0 : 1];
+    const auto &inner = join->children_[outer_is_left ? 1 : 0];
+    if (inner->GetType() != OperatorType::SEQSCAN) {
+      continue;
+    }
+    // 外连接时只能以需要保留的一侧作为外表
+    if (join->join_type_ == JoinType::FULL || (join->join_type_ == JoinType::LEFT && !outer_is_left) ||
+        (join->join_type_ == JoinType::RIGHT && outer_is_left)) {
+      continue;
+    }
+    auto scan = std::dynamic_pointer_cast<const SeqScanOperator>(inner);
+    if (scan->HasLock()) {
+      continue;
+    }
+    const auto &inner_key = lhs->IsLeft() == outer_is_left ? rhs : lhs;
+    const auto &outer_key = lhs->IsLeft() == outer_is_left ? lhs : rhs;
+    for (const auto &index : catalog_.GetTableIndexes(scan->GetTableOid())) {
+      if (index->GetColumnIndex() == inner_key->GetColumnIndex()) {
+        consider(std::make_shared<IndexNestedLoopJoinOperator>(join->column_list_, outer, scan, index->GetOid(),
+                                                               outer_key, join->join_condition_, join->join_type_,
+                                                               outer_is_left));
+      }
+    }
+  }
+
+  const auto &left_key = lhs->IsLeft() ? lhs : rhs;
+  const auto &right_key = lhs->IsLeft() ? rhs : lhs;
+  if (enable_hash_join_) {
+    consider(std::make_shared<HashJoinOperator>(join->column_list_, join->children_[0], join->children_[1], left_key,
+                                                right_key, join->join_type_));
+  }
+  if (enable_merge_join_) {
+    consider(std::make_shared<MergeJoinOperator>(join->column_list_, SortBy(join->children_[0], {left_key}),
+                                                 SortBy(join->children_[1], {right_key}), left_key, right_key,
+                                                 join->join_type_));
+  }
+  return best_plan;
+}
+
+std::shared_ptr<Operator> Optimizer::SelectAggregate(std::shared_ptr<Operator> plan) {
+  auto aggregate = std::dynamic_pointer_cast<AggregateOperator>(plan);
+  if (aggregate->group_bys_.empty()) {
+    return plan;
+  }
+  auto hash_cost = cost_model_.Estimate(plan);
+  if (!hash_cost.has_statistics_) {
+    return plan;
+  }
+  // 排序聚集的输入需按分组列排序，输入已经有序或哈希表超出内存时可能更优
+  auto sort_aggregate = std::make_shared<AggregateOperator>(*aggregate);
+  sort_aggregate->strategy_ = AggregateStrategy::SORT;
+  sort_aggregate->children_[0] = SortBy(aggregate->children_[0], aggregate->group_bys_);
+  if (cost_model_.Estimate(sort_aggregate).Total() < hash_cost.Total()) {
+    return sort_aggregate;
+  }
+  return plan;
+}
+
+bool Optimizer::IsSortedBy(const Operator &plan, size_t column_idx) const {
+  switch (plan.GetType()) {
+    case OperatorType::INDEXSCAN: {
+      // 索引扫描按索引列的顺序输出
+      const auto &scan = dynamic_cast<const IndexScanOperator &>(plan);
+      return catalog_.GetIndex(scan.index_oid_)->GetColumnIndex() == column_idx;
+    }
+    case OperatorType::ORDERBY: {
+      const auto &order_by = dynamic_cast<const OrderByOperator &>(plan).order_bys_;
+      if (order_by.empty() || order_by[0].first == OrderByType::DESC) {
+        return false;
+      }
+      auto column = std::dynamic_pointer_cast<ColumnValue>(order_by[0].second);
+      return column != nullptr && column->GetColumnIndex() == column_idx;
+    }
+    case OperatorType::FILTER:
+    case OperatorType::LIMIT:
+    case OperatorType::LOCK_ROWS:
+      return IsSortedBy(*plan.children_[0], column_idx);
+    default:
+      return false;
+  }
+}
+
+std::shared_ptr<Operator> Optimizer::SortBy(std::shared_ptr<Operator> plan,
+                                            const std::vector<std::shared_ptr<OperatorExpression>> &keys) const {
+  if (keys.size() == 1) {
+    auto column = std::dynamic_pointer_cast<ColumnValue>(keys[0]);
+    if (column != nullptr && IsSortedBy(*plan, column->GetColumnIndex())) {
+      return plan;
+    }
+  }
+  std::vector<std::pair<OrderByType, std::shared_ptr<OperatorExpression>>> order_bys;
+  for (const auto &key : keys) {
+    order_bys.emplace_back(OrderByType::ASC, key);
+  }
+  auto column_list = std::make_shared<ColumnList>(plan->OutputColumns());
+  return std::make_shared<OrderByOperator>(std::move(column_list), std::move(plan), std::move(order_bys));
+}
+
+namespace {
+
+// 用新的边界收紧原有的下界或上界
+void TightenBound(std::optional<IndexScanBound> &bound, const Value &value, bool inclusive, bool is_lower) {
+  if (!bound) {
+    bound = IndexScanBound{value, inclusive};
+    return;
+  }
+  if (value.Equal(bound->value_)) {
+    bound->inclusive_ = bound->inclusive_ && inclusive;
+  } else if (is_lower ? value.Greater(bound->value_) : value.Less(bound->value_)) {
+    bound = IndexScanBound{value, inclusive};
+  }
+}
+
+}  // namespace
+
+std::shared_ptr<Operator> Optimizer::SelectIndexScan(std::shared_ptr<Operator> plan) {
+  if (plan->children_[0]->GetType() != OperatorType::SEQSCAN) {
+    return plan;
+  }
+  auto filter = std::dynamic_pointer_cast<FilterOperator>(plan);
+  auto scan = std::dynamic_pointer_cast<const SeqScanOperator>(plan->children_[0]);
+  if (scan->HasLock()) {
+    return plan;
+  }
+  auto indexes = catalog_.GetTableIndexes(scan->GetTableOid());
+  if (indexes.empty()) {
+    return plan;
+  }
+  std::vector<std::shared_ptr<OperatorExpression>> conjuncts;
+  CollectConjuncts(filter->predicate_, conjuncts);
+
+  // 有统计信息时与顺序扫描比较代价，否则只根据估计的选择率判断
+  auto seq_scan_cost = cost_model_.Estimate(plan->children_[0]);
+  bool has_statistics = seq_scan_cost.has_statistics_;
+  std::shared_ptr<Operator> best_scan;
+  double best_cost = seq_scan_cost.Total();
+  double best_selectivity = 1.0;
+  for (const auto &index : indexes) {
+    std::optional<IndexScanBound> lower, upper;
+    bool equal = false;
+    for (const auto &conjunct : conjuncts) {
+      // 只考虑索引列与同类型常量的比较
+      auto comparison = std::dynamic_pointer_cast<Comparison>(conjunct);
+      if (comparison == nullptr) {
+        continue;
+      }
+      auto column = std::dynamic_pointer_cast<ColumnValue>(comparison->children_[0]);
+      auto type = comparison->GetComparisonType();
+      if (type == ComparisonType::BETWEEN) {
+        auto list = std::dynamic_pointer_cast<List>(comparison->children_[1]);
+        if (column == nullptr || column->GetColumnIndex() != index->GetColumnIndex() || list == nullptr ||
+            list->exprs_.size() != 2) {
+          continue;
+        }
+        auto low = std::dynamic_pointer_cast<Const>(list->exprs_[0]);
+        auto high = std::dynamic_pointer_cast<Const>(list->exprs_[1]);
+        if (low == nullptr || high == nullptr || low->value_.IsNull() || high->value_.IsNull() ||
+            low->GetValueType() != column->GetValueType() || high->GetValueType() != column->GetValueType()) {
+          continue;
+        }
+        TightenBound(lower, low->value_, true, true);
+        TightenBound(upper, high->value_, true, false);
+        continue;
+      }
+      if (type == ComparisonType::LIKE) {
+        // 以常量前缀开头的模式转换为范围条件 [prefix, prefix 的上界)
+        auto matcher = comparison->GetLikeMatcher();
+        if (column == nullptr || column->GetColumnIndex() != index->GetColumnIndex() || matcher == nullptr ||
+            !TypeUtil::IsString(column->GetValueType()) || matcher->GetPrefix().empty()) {
+          continue;
+        }
+        Value prefix(matcher->GetPrefix(), column->GetValueType());
+        if (matcher->GetKind() == LikeMatcher::Kind::EXACT) {
+          equal = true;
+          TightenBound(lower, prefix, true, true);
+          TightenBound(upper, prefix, true, false);
+          continue;
+        }
+        TightenBound(lower, prefix, true, true);
+        if (auto bound = LikeMatcher::PrefixUpperBound(matcher->GetPrefix())) {
+          TightenBound(upper, Value(*bound, column->GetValueType()), false, false);
+        }
+        continue;
+      }
+      auto constant = std::dynamic_pointer_cast<Const>(comparison->children_[1]);
+      if (column == nullptr || constant == nullptr) {
+        // 常量在左侧时交换比较的方向
+        column = std::dynamic_pointer_cast<ColumnValue>(comparison->children_[1]);
+        constant = std::dynamic_pointer_cast<Const>(comparison->children_[0]);
+        switch (type) {
+          case ComparisonType::LESS:
+            type = ComparisonType::GREATER;
+            break;
+          case ComparisonType::LESS_EQUAL:
+            type = ComparisonType::GREATER_EQUAL;
+            break;
+          case ComparisonType::GREATER:
+            type = ComparisonType::LESS;
+            break;
+          case ComparisonType::GREATER_EQUAL:
+            type = ComparisonType::LESS_EQUAL;
+            break;
+          default:
+            break;
+        }
+      }
+      if (column == nullptr || constant == nullptr || column->GetColumnIndex() != index->GetColumnIndex() ||
+          constant->value_.IsNull() || constant->GetValueType() != column->GetValueType()) {
+        continue;
+      }
+      const auto &value = constant->value_;
+      switch (type) {
+        case ComparisonType::EQUAL:
+          equal = true;
+          TightenBound(lower, value, true, true);
+          TightenBound(upper, value, true, false);
+          break;
+        case ComparisonType::LESS:
+          TightenBound(upper, value, false, false);
+          break;
+        case ComparisonType::LESS_EQUAL:
+          TightenBound(upper, value, true, false);
+          break;
+        case ComparisonType::GREATER:
+          TightenBound(lower, value, false, true);
+          break;
+        case ComparisonType::GREATER_EQUAL:
+          TightenBound(lower, value, true, true);
+          break;
+        default:
+          break;
+      }
+    }
+    if (!lower && !upper) {
+      continue;
+    }
+    auto selectivity =
+        cost_model_.RangeSelectivity(scan->GetTableName(), index->GetColumnName(), equal, lower, upper);
+    auto candidate = std::make_shared<IndexScanOperator>(scan->column_list_, scan, index->GetOid(), index->GetName(),
+                                                         std::move(lower), std::move(upper));
+    if (has_statistics) {
+      auto cost = cost_model_.Estimate(candidate).Total();
+      if (cost < best_cost) {
+        best_scan = std::move(candidate);
+        best_cost = cost;
+      }
+    } else if (selectivity <= 1.0 / INDEX_SCAN_RATIO && (best_scan == nullptr || selectivity < best_selectivity)) {
+      best_scan = std::move(candidate);
+      best_selectivity = selectivity;
+    }
+  }
+  if (best_scan == nullptr) {
+    return plan;
+  }
+  // 保留 Filter 节点，对索引扫描读出的记录检查完整的过滤条件
+  plan->children_[0] = std::move(best_scan);
   return plan;
 }
 
@@ -1,19 +1,29 @@
 #pragma once
 
 #include "catalog/catalog.h"
+#include "operators/expressions/column_value.h"
 #include "operators/operator.h"
+#include "optimizer/cost_model.h"
+#include "optimizer/join_order_enumerator.h"
 
 namespace huadb {
 
 enum class JoinOrderAlgorithm { NONE, DP, GREEDY };
 static constexpr JoinOrderAlgorithm DEFAULT_JOIN_ORDER_ALGORITHM = JoinOrderAlgorithm::NONE;
+// 表缺少统计信息时，过滤条件的估计选择率不超过 1 / INDEX_SCAN_RATIO 则使用索引扫描代替顺序扫描
+static constexpr uint32_t INDEX_SCAN_RATIO = 5;
+// 连接的关系个数不超过该值时 DP 算法使用动态规划枚举，否则改用贪心算法
+static constexpr size_t DP_JOIN_RELATIONS_LIMIT = 12;
 
 class Optimizer {
  public:
-  Optimizer(Catalog &catalog, JoinOrderAlgorithm join_order_algorithm, bool enable_projection_pushdown);
+  Optimizer(Catalog &catalog, JoinOrderAlgorithm join_order_algorithm, bool enable_projection_pushdown,
+            bool enable_hash_join, bool enable_merge_join);
   std::shared_ptr<Operator> Optimize(std::shared_ptr<Operator> plan);
 
  private:
+  // 化简查询计划中的表达式；过滤条件恒为 true 时删除 Filter 节点，恒为 false 时以空结果代替整个子树
+  std::shared_ptr<Operator> SimplifyExpressions(std::shared_ptr<Operator> plan);
   std::shared_ptr<Operator> SplitPredicates(std::shared_ptr<Operator> plan);
   std::shared_ptr<Operator> PushDown(std::shared_ptr<Operator> plan);
   std::shared_ptr<Operator> PushDownFilter(std::shared_ptr<Operator> plan);
@@ -22,10 +32,33 @@ class Optimizer {
   std::shared_ptr<Operator> PushDownSeqScan(std::shared_ptr<Operator> plan);
 
   std::shared_ptr<Operator> ReorderJoin(std::shared_ptr<Operator> plan);
+  // 重新排列由内连接和其上方的 Filter 组成的连接区域，条件下推到涉及的关系都已连接的最低位置
+  // 新的连接顺序改变列的顺序时，在上方添加 Projection 恢复原来的列顺序
+  std::shared_ptr<Operator> ReorderJoinRegion(std::shared_ptr<Operator> plan);
+
+  // 自底向上根据代价模型选择物理算子，连接和聚集的代价基于子节点已经选择的算子估计
+  std::shared_ptr<Operator> SelectPhysicalOperators(std::shared_ptr<Operator> plan, bool allow_index_scan);
+  // 等值连接在 Nested Loop Join、Index Nested Loop Join、Hash Join 和 Sort Merge Join 中选择代价最小的算子
+  // 缺少统计信息时保留 Nested Loop Join
+  std::shared_ptr<Operator> SelectJoin(std::shared_ptr<Operator> plan);
+  // 过滤条件含有索引列与常量的比较时，比较索引扫描与顺序扫描的代价
+  // 缺少统计信息时，估计选择率足够低才使用索引扫描
+  std::shared_ptr<Operator> SelectIndexScan(std::shared_ptr<Operator> plan);
+  // 比较哈希聚集与排序聚集的代价
+  std::shared_ptr<Operator> SelectAggregate(std::shared_ptr<Operator> plan);
+
+  // plan 的输出是否已按第 column_idx 列升序排列
+  bool IsSortedBy(const Operator &plan, size_t column_idx) const;
+  // 输出未按 keys 排序时，在 plan 上方添加 Order 节点
+  std::shared_ptr<Operator> SortBy(std::shared_ptr<Operator> plan,
+                                   const std::vector<std::shared_ptr<OperatorExpression>> &keys) const;
 
   JoinOrderAlgorithm join_order_algorithm_;
   bool enable_projection_pushdown_;
+  bool enable_hash_join_;
+  bool enable_merge_join_;
   Catalog &catalog_;
+  CostModel cost_model_;
 };
 
 }  // namespace huadb
@@ -0,0 +1,85 @@
+#include "planner/plan_cache.h"
+
+#include <cctype>
+
+namespace huadb {
+
+PlanCache::PlanCache(size_t capacity) : capacity_(capacity) {}
+
+std::string PlanCache::Normalize(const std::string &sql) {
+  std::string result;
+  char quote = '\0';
+  bool pending_space = false;
+  for (char c : sql) {
+    if (quote != '\0') {
+      result.push_back(c);
+      if (c == quote) {
+        quote = '\0';
+      }
+      continue;
+    }
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      pending_space = !result.empty();
+      continue;
+    }
+    if (pending_space) {
+      result.push_back(' ');
+      pending_space = false;
+    }
+    if (c == '\'' || c == '"') {
+      quote = c;
+    }
+    result.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+  }
+  while (!result.empty() && (result.back() == ';' || result.back() == ' ')) {
+    result.pop_back();
+  }
+  return result;
+}
+
+std::shared_ptr<Operator> PlanCache::Get(const std::string &key, uint64_t version) {
+  auto iter = key2entry_.find(key);
+  if (iter == key2entry_.end()) {
+    miss_count_++;
+    return nullptr;
+  }
+  if (iter->second->version_ != version) {
+    entries_.erase(iter->second);
+    key2entry_.erase(iter);
+    miss_count_++;
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, iter->second);
+  hit_count_++;
+  return iter->second->plan_;
+}
+
+void PlanCache::Put(const std::string &key, std::shared_ptr<Operator> plan, uint64_t version) {
+  if (capacity_ == 0) {
+    return;
+  }
+  auto iter = key2entry_.find(key);
+  if (iter != key2entry_.end()) {
+    entries_.erase(iter->second);
+    key2entry_.erase(iter);
+  }
+  entries_.push_front({key, std::move(plan), version});
+  key2entry_[key] = entries_.begin();
+  if (entries_.size() > capacity_) {
+    key2entry_.erase(entries_.back().key_);
+    entries_.pop_back();
+  }
+}
+
+void PlanCache::Clear() {
+  entries_.clear();
+  key2entry_.clear();
+}
+
+size_t PlanCache::Size() const { return entries_.size(); }
+
+uint64_t PlanCache::GetHitCount() const { return hit_count_; }
+
+uint64_t PlanCache::GetMissCount() const { return miss_count_; }
+
+}  // namespace huadb
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "common/constants.h"
+#include "operators/operator.h"
+
+namespace huadb {
+
+// 按规范化后的 SQL 文本缓存优化后的查询计划，所有连接共享
+// 执行器不会修改查询计划，缓存的计划可以被多次执行
+// 计划生成时记录 catalog 的版本，表、索引或统计信息变化后版本不同，对应的计划视为过期
+class PlanCache {
+ public:
+  explicit PlanCache(size_t capacity = PLAN_CACHE_SIZE);
+
+  // 规范化 SQL 文本：字符串和带引号的标识符之外的内容转为小写，连续空白合并为一个空格，去掉首尾空白和分号
+  static std::string Normalize(const std::string &sql);
+
+  // 查找未过期的计划，不存在或已过期时返回空指针
+  std::shared_ptr<Operator> Get(const std::string &key, uint64_t version);
+  // 插入计划，超过容量时淘汰最久未使用的计划
+  void Put(const std::string &key, std::shared_ptr<Operator> plan, uint64_t version);
+  void Clear();
+
+  size_t Size() const;
+  uint64_t GetHitCount() const;
+  uint64_t GetMissCount() const;
+
+ private:
+  struct Entry {
+    std::string key_;
+    std::shared_ptr<Operator> plan_;
+    uint64_t version_;
+  };
+
+  size_t capacity_;
+  // 链表头部为最近使用的计划
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> key2entry_;
+  uint64_t hit_count_ = 0;
+  uint64_t miss_count_ = 0;
+};
+
+}  // namespace huadb
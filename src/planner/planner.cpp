@@ -39,7 +39,8 @@
 
 namespace huadb {
 
-Planner::Planner(ForceJoin force_join) : force_join_(force_join) {}
+Planner::Planner(ForceJoin force_join, std::vector<Value> parameters)
+    : force_join_(force_join), parameters_(std::move(parameters)) {}
 
 std::shared_ptr<Operator> Planner::PlanQuery(const Statement &stmt) {
   switch (stmt.type_) {
@@ -238,6 +239,13 @@ std::shared_ptr<OperatorExpression> Planner::PlanExpression(const Expression &ex
       const auto &const_expr = dynamic_cast<const ConstExpression &>(expr);
       return PlanConst(const_expr, children);
     }
+    case ExpressionType::PARAMETER: {
+      const auto &parameter_expr = dynamic_cast<const ParameterExpression &>(expr);
+      if (parameter_expr.index_ > parameters_.size()) {
+        throw DbException("No value supplied for parameter " + parameter_expr.ToString());
+      }
+      return std::make_shared<Const>(parameters_[parameter_expr.index_ - 1]);
+    }
     case ExpressionType::UNARY_OP: {
       const auto &unary_op_expr = dynamic_cast<const UnaryOpExpression &>(expr);
       return PlanUnaryOp(unary_op_expr, children);
@@ -679,28 +687,27 @@ std::shared_ptr<ColumnList> Planner::RenameColumnList(std::shared_ptr<const Colu
   return result;
 }
 
-void Planner::AddAggregateExpression(Expression &expr) {
+void Planner::AddAggregateExpression(const Expression &expr) {
   switch (expr.type_) {
     case ExpressionType::AGGREGATE: {
-      auto &agg_expr = dynamic_cast<AggregateExpression &>(expr);
-      aggregates_.push_back(std::make_unique<AggregateExpression>(
-          std::exchange(agg_expr, AggregateExpression(agg_expr.function_name_, agg_expr.is_distinct_,
-                                                      std::vector<std::unique_ptr<Expression>>{}))));
+      // 只记录聚集表达式的位置，不修改语句，预备语句可以多次生成查询计划
+      aggregates_.push_back(&dynamic_cast<const AggregateExpression &>(expr));
       return;
     }
     case ExpressionType::BINARY_OP: {
-      auto &binary_op_expr = dynamic_cast<BinaryOpExpression &>(expr);
+      const auto &binary_op_expr = dynamic_cast<const BinaryOpExpression &>(expr);
       AddAggregateExpression(*binary_op_expr.left_);
       AddAggregateExpression(*binary_op_expr.right_);
       return;
     }
     case ExpressionType::ALIAS: {
-      auto &alias_expr = dynamic_cast<AliasExpression &>(expr);
+      const auto &alias_expr = dynamic_cast<const AliasExpression &>(expr);
       AddAggregateExpression(*alias_expr.expr_);
       return;
     }
     case ExpressionType::COLUMN_REF:
     case ExpressionType::CONST:
+    case ExpressionType::PARAMETER:
       return;
     default:
       throw DbException("Unknown Expression type in agg");
@@ -711,6 +718,7 @@ void Planner::CheckAggregate(const Expression &expr, const std::unordered_set<st
   switch (expr.type_) {
     case ExpressionType::AGGREGATE:
     case ExpressionType::CONST:
+    case ExpressionType::PARAMETER:
       break;
     case ExpressionType::COLUMN_REF: {
       if (group_by_names.find(expr.ToString()) == group_by_names.end()) {
@@ -61,7 +61,8 @@ enum class ForceJoin { NONE, MERGE, HASH };
 
 class Planner {
  public:
-  Planner(ForceJoin force_join);
+  // parameters 为预备语句中参数 $1, $2, ... 的值
+  Planner(ForceJoin force_join, std::vector<Value> parameters = {});
 
   std::shared_ptr<Operator> PlanQuery(const Statement &stmt);
   std::shared_ptr<Operator> PlanInsert(const InsertStatement &stmt);
@@ -104,10 +105,11 @@ class Planner {
                                                       const std::vector<std::string> &col_names);
 
  private:
-  void AddAggregateExpression(Expression &expr);
+  void AddAggregateExpression(const Expression &expr);
   void CheckAggregate(const Expression &expr, const std::unordered_set<std::string> group_by_names);
   ForceJoin force_join_;
-  std::vector<std::unique_ptr<Expression>> aggregates_;
+  std::vector<Value> parameters_;
+  std::vector<const AggregateExpression *> aggregates_;
   std::vector<std::shared_ptr<OperatorExpression>> aggregate_exprs_;
   size_t next_aggregate_ = 0;
   std::unordered_multimap<std::string, std::shared_ptr<OperatorExpression>> aliases_;
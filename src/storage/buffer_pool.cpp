@@ -17,6 +17,10 @@ std::shared_ptr<Page> BufferPool::GetPage(oid_t db_oid, oid_t table_oid, pageid_
   if (page_id == NULL_PAGE_ID) {
     throw DbException("Invalid page id in BufferPool::GetPage");
   }
+  // 即时恢复时，页面第一次访问前先重做它的日志
+  if (db_oid != SYSTEM_DATABASE_OID) {
+    log_manager_.RedoPage(table_oid, page_id);
+  }
   auto &buffers = (db_oid == SYSTEM_DATABASE_OID) ? systable_buffers_ : buffers_;
   auto &hashmap = (db_oid == SYSTEM_DATABASE_OID) ? systable_hashmap_ : hashmap_;
   auto entry = hashmap.find({table_oid, page_id});
@@ -37,6 +41,10 @@ std::shared_ptr<Page> BufferPool::NewPage(oid_t db_oid, oid_t table_oid, pageid_
   if (page_id == NULL_PAGE_ID) {
     throw DbException("Invalid page id in BufferPool::NewPage");
   }
+  // 即时恢复时，页面第一次访问前先重做它的日志
+  if (db_oid != SYSTEM_DATABASE_OID) {
+    log_manager_.RedoPage(table_oid, page_id);
+  }
   auto page = std::make_shared<Page>();
   AddToBuffer(db_oid, table_oid, page_id, page);
   return page;
@@ -87,15 +95,39 @@ void BufferPool::FlushPage(size_t frame_id) {
   }
   auto &buffer_entry = buffers_[frame_id];
   if (buffer_entry.page_->IsDirty()) {
-    auto table_page = std::make_unique<TablePage>(buffer_entry.page_);
-    log_manager_.FlushPage(buffer_entry.table_oid_, buffer_entry.page_id_, table_page->GetPageLSN());
-    assert(buffer_entry.db_oid_ != SYSTEM_DATABASE_OID);
-    disk_.WritePage(Disk::GetFilePath(buffer_entry.db_oid_, buffer_entry.table_oid_), buffer_entry.page_id_,
-                    buffer_entry.page_->GetData());
+    WritePage(buffer_entry);
   }
   hashmap_.erase({buffer_entry.table_oid_, buffer_entry.page_id_});
 }
 
+std::vector<TablePageid> BufferPool::GetDirtyPages() const {
+  std::vector<TablePageid> pages;
+  for (const auto &buffer_entry : buffers_) {
+    if (buffer_entry.page_->IsDirty() && hashmap_.count({buffer_entry.table_oid_, buffer_entry.page_id_}) != 0) {
+      pages.push_back({buffer_entry.table_oid_, buffer_entry.page_id_});
+    }
+  }
+  return pages;
+}
+
+bool BufferPool::WriteBackPage(oid_t table_oid, pageid_t page_id) {
+  auto entry = hashmap_.find({table_oid, page_id});
+  if (entry == hashmap_.end() || !buffers_[entry->second].page_->IsDirty()) {
+    return false;
+  }
+  WritePage(buffers_[entry->second]);
+  buffers_[entry->second].page_->ClearDirty();
+  return true;
+}
+
+void BufferPool::WritePage(const BufferPoolEntry &buffer_entry) {
+  auto table_page = std::make_unique<TablePage>(buffer_entry.page_);
+  log_manager_.FlushPage(buffer_entry.table_oid_, buffer_entry.page_id_, table_page->GetPageLSN());
+  assert(buffer_entry.db_oid_ != SYSTEM_DATABASE_OID);
+  disk_.WritePage(Disk::GetFilePath(buffer_entry.db_oid_, buffer_entry.table_oid_), buffer_entry.page_id_,
+                  buffer_entry.page_->GetData());
+}
+
 void BufferPool::FlushSysTablePage(size_t frame_id) {
   auto &buffer_entry = systable_buffers_[frame_id];
   if (buffer_entry.page_->IsDirty()) {
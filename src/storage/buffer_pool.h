@@ -32,12 +32,18 @@ class BufferPool {
   void Flush(bool regular_only = false);
   // 清空 buffer pool，不刷脏，用于数据库故障模拟
   void Clear();
+  // 普通表缓存中的脏页
+  std::vector<TablePageid> GetDirtyPages() const;
+  // 将脏页写回磁盘并保留在缓存中，页面不在缓存中或不是脏页时返回 false
+  bool WriteBackPage(oid_t table_oid, pageid_t page_id);
 
  private:
   // 将页面加入 buffer pool
   void AddToBuffer(oid_t db_oid, oid_t table_oid, pageid_t page_id, std::shared_ptr<Page> page);
   // 将 buffer 中对应的页面刷到磁盘
   void FlushPage(size_t frame_id);
+  // 先将页面的日志刷盘，再将页面写到磁盘
+  void WritePage(const BufferPoolEntry &buffer_entry);
   // 将 systable_buffer 中对应的页面刷到磁盘
   void FlushSysTablePage(size_t frame_id);
 
@@ -1,11 +1,17 @@
 #include "storage/disk.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
+#include <vector>
 
 #include "common/constants.h"
 #include "common/exceptions.h"
 #include "common/string_util.h"
+#include "fmt/format.h"
 
 namespace huadb {
 
@@ -15,20 +21,13 @@ Disk::Disk() {
   }
   ChangeDirectory(BASE_PATH);
 
-  if (!FileExists(LOG_NAME)) {
-    CreateFile(LOG_NAME);
-    std::filesystem::resize_file(LOG_NAME, LOG_SEGMENT_SIZE);
-    log_segments = 1;
-  } else {
-    auto log_file_size = std::filesystem::file_size(LOG_NAME);
-    if (log_file_size / LOG_SEGMENT_SIZE == 0 || log_file_size % LOG_SEGMENT_SIZE != 0) {
-      throw DbException("log file size is not a multiple of segment size");
-    }
-    log_segments = log_file_size / LOG_SEGMENT_SIZE;
+  if (!DirectoryExists(LOG_NAME)) {
+    CreateDirectory(LOG_NAME);
   }
-  log_fs_.open(LOG_NAME, std::fstream::in | std::fstream::out | std::fstream::binary);
-  if (log_fs_.fail()) {
-    throw DbException("fstream failed in Disk::Disk");
+  for (const auto &entry : std::filesystem::directory_iterator(LOG_NAME)) {
+    if (std::filesystem::file_size(entry.path()) != LOG_SEGMENT_SIZE) {
+      throw DbException("log segment " + entry.path().string() + " size is not segment size");
+    }
   }
 }
 
@@ -56,25 +55,41 @@ bool Disk::EmptyFile(const std::string &path) {
   return std::filesystem::is_empty(path);
 }
 
+size_t Disk::FileSize(const std::string &path) {
+  if (!FileExists(path)) {
+    throw DbException("file " + path + " does not exist");
+  }
+  return std::filesystem::file_size(path);
+}
+
 void Disk::CreateFile(const std::string &path) { std::ofstream ofs(path); }
 
 void Disk::RemoveFile(const std::string &path) { std::filesystem::remove(path); }
 
 void Disk::OpenFile(const std::string &path) {
+  std::unique_lock lock(page_mutex_);
+  OpenFileInternal(path);
+}
+
+void Disk::CloseFile(const std::string &path) {
+  std::unique_lock lock(page_mutex_);
+  hashmap_.erase(path);
+}
+
+void Disk::OpenFileInternal(const std::string &path) {
   hashmap_[path] = std::fstream(path, std::fstream::in | std::fstream::out | std::fstream::binary);
   if (!hashmap_[path]) {
     throw DbException("file " + path + " does not exist");
   }
 }
 
-void Disk::CloseFile(const std::string &path) { hashmap_.erase(path); }
-
 void Disk::ReadPage(const std::string &path, pageid_t page_id, char *data) {
+  std::unique_lock lock(page_mutex_);
   if (GetOid(path).first != SYSTEM_DATABASE_OID) {
     access_count_++;
   }
   if (hashmap_.count(path) == 0) {
-    OpenFile(path);
+    OpenFileInternal(path);
   }
   auto &fs = hashmap_[path];
   if (fs.fail()) {
@@ -83,6 +98,8 @@ void Disk::ReadPage(const std::string &path, pageid_t page_id, char *data) {
   fs.seekg(page_id * DB_PAGE_SIZE);
   fs.read(data, DB_PAGE_SIZE);
   if (fs.gcount() != DB_PAGE_SIZE) {
+    // 读取尚未写入磁盘的页面时失败，清除错误状态，以免影响之后的读写
+    fs.clear();
     throw DbException(path + " read page " + std::to_string(page_id) + " failed: read " + std::to_string(fs.gcount()) +
                       " bytes, expected " + std::to_string(DB_PAGE_SIZE) + " bytes");
   }
@@ -92,8 +109,9 @@ void Disk::WritePage(const std::string &path, pageid_t page_id, const char *data
   if (!FileExists(path)) {
     return;
   }
+  std::unique_lock lock(page_mutex_);
   if (hashmap_.count(path) == 0) {
-    OpenFile(path);
+    OpenFileInternal(path);
   }
   if (GetOid(path).first != SYSTEM_DATABASE_OID) {
     access_count_++;
@@ -107,37 +125,141 @@ void Disk::WritePage(const std::string &path, pageid_t page_id, const char *data
   fs.flush();
 }
 
-void Disk::ReadLog(uint32_t offset, uint32_t count, char *data) {
-  if (log_fs_.fail()) {
-    throw DbException("fstream failed in Disk::ReadLog");
+void Disk::PrefetchPages(const std::string &path, const std::vector<pageid_t> &page_ids) {
+  prefetch_count_ += page_ids.size();
+#ifdef POSIX_FADV_WILLNEED
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
   }
-  log_fs_.seekg(offset);
-  log_fs_.read(data, count);
-  if (log_fs_.gcount() != count) {
-    throw DbException("read log failed (offset: " + std::to_string(offset) + ", count: " + std::to_string(count) +
-                      ", read: " + std::to_string(log_fs_.gcount()) + ")");
+  for (size_t i = 0; i < page_ids.size();) {
+    size_t j = i + 1;
+    while (j < page_ids.size() && page_ids[j] == page_ids[j - 1] + 1) {
+      j++;
+    }
+    posix_fadvise(fd, static_cast<off_t>(page_ids[i]) * DB_PAGE_SIZE, static_cast<off_t>(j - i) * DB_PAGE_SIZE,
+                  POSIX_FADV_WILLNEED);
+    i = j;
   }
+  close(fd);
+#endif
 }
 
-void Disk::WriteLog(uint32_t offset, uint32_t count, const char *data) {
-  if (log_fs_.fail()) {
-    throw DbException("fstream failed in Disk::WriteLog");
+void Disk::ReadLog(lsn_t offset, size_t count, char *data) {
+  // 跨越日志段的读写分成多次
+  while (count > 0) {
+    auto segment = offset / LOG_SEGMENT_SIZE;
+    auto segment_offset = offset % LOG_SEGMENT_SIZE;
+    auto segment_count = std::min(count, LOG_SEGMENT_SIZE - segment_offset);
+    if (log_segments_.count(segment) == 0 && !FileExists(GetLogSegmentPath(segment))) {
+      throw DbException("read log failed (offset: " + std::to_string(offset) + "): log segment " +
+                        std::to_string(segment) + " does not exist");
+    }
+    auto &fs = GetLogSegment(segment);
+    fs.seekg(segment_offset);
+    fs.read(data, segment_count);
+    if (static_cast<size_t>(fs.gcount()) != segment_count) {
+      throw DbException("read log failed (offset: " + std::to_string(offset) +
+                        ", count: " + std::to_string(segment_count) + ", read: " + std::to_string(fs.gcount()) + ")");
+    }
+    offset += segment_count;
+    data += segment_count;
+    count -= segment_count;
   }
-  if (offset + count > log_segments * LOG_SEGMENT_SIZE) {
-    log_segments++;
-    std::filesystem::resize_file(LOG_NAME, log_segments * LOG_SEGMENT_SIZE);
+}
+
+void Disk::WriteLog(lsn_t offset, size_t count, const char *data) {
+  while (count > 0) {
+    auto segment = offset / LOG_SEGMENT_SIZE;
+    auto segment_offset = offset % LOG_SEGMENT_SIZE;
+    auto segment_count = std::min(count, LOG_SEGMENT_SIZE - segment_offset);
+    auto &fs = GetLogSegment(segment);
+    fs.seekp(segment_offset);
+    fs.write(data, segment_count);
+    fs.flush();
+    offset += segment_count;
+    data += segment_count;
+    count -= segment_count;
   }
-  log_fs_.seekp(offset);
-  log_fs_.write(data, count);
-  log_fs_.flush();
+}
+
+void Disk::PreallocateLog(lsn_t next_lsn) {
+  auto segment = next_lsn / LOG_SEGMENT_SIZE;
+  for (auto i = segment; i <= segment + LOG_PREALLOCATED_SEGMENTS; i++) {
+    if (!FileExists(GetLogSegmentPath(i))) {
+      CreateLogSegment(i);
+    }
+  }
+}
+
+void Disk::RecycleLog(lsn_t min_lsn, lsn_t next_lsn) {
+  auto min_segment = min_lsn / LOG_SEGMENT_SIZE;
+  auto next_segment = next_lsn / LOG_SEGMENT_SIZE;
+  std::vector<uint64_t> segments;
+  for (const auto &entry : std::filesystem::directory_iterator(LOG_NAME)) {
+    auto segment = std::stoull(entry.path().filename().string(), nullptr, 16);
+    if (segment < min_segment) {
+      segments.push_back(segment);
+    }
+  }
+  std::sort(segments.begin(), segments.end());
+  // 空闲的日志段按编号从小到大重命名为之后缺少的日志段
+  auto target = next_segment + 1;
+  for (auto segment : segments) {
+    log_segments_.erase(segment);
+    while (target <= next_segment + LOG_PREALLOCATED_SEGMENTS && FileExists(GetLogSegmentPath(target))) {
+      target++;
+    }
+    if (target > next_segment + LOG_PREALLOCATED_SEGMENTS) {
+      RemoveFile(GetLogSegmentPath(segment));
+      continue;
+    }
+    std::filesystem::rename(GetLogSegmentPath(segment), GetLogSegmentPath(target));
+    // 清零旧日志，避免恢复时读到过期的日志
+    std::fstream fs(GetLogSegmentPath(target), std::fstream::in | std::fstream::out | std::fstream::binary);
+    std::vector<char> zeros(LOG_SEGMENT_SIZE);
+    fs.write(zeros.data(), LOG_SEGMENT_SIZE);
+  }
+}
+
+size_t Disk::GetLogSegmentCount() const {
+  return std::distance(std::filesystem::directory_iterator(LOG_NAME), std::filesystem::directory_iterator());
 }
 
 uint32_t Disk::GetAccessCount() const { return access_count_; }
 
+uint32_t Disk::GetPrefetchCount() const { return prefetch_count_; }
+
 std::string Disk::GetFilePath(oid_t db_oid, oid_t table_oid) {
   return std::to_string(db_oid) + "/" + std::to_string(table_oid);
 }
 
+std::string Disk::GetLogSegmentPath(uint64_t segment) { return fmt::format("{}/{:016X}", LOG_NAME, segment); }
+
+void Disk::CreateLogSegment(uint64_t segment) {
+  auto path = GetLogSegmentPath(segment);
+  CreateFile(path);
+  std::filesystem::resize_file(path, LOG_SEGMENT_SIZE);
+}
+
+std::fstream &Disk::GetLogSegment(uint64_t segment) {
+  auto iter = log_segments_.find(segment);
+  if (iter != log_segments_.end()) {
+    return iter->second;
+  }
+  auto path = GetLogSegmentPath(segment);
+  // 日志段一般已经预先分配，只有日志写入速度超过预分配速度时才在写日志时创建
+  if (!FileExists(path)) {
+    CreateLogSegment(segment);
+  }
+  auto &fs = log_segments_[segment];
+  fs.open(path, std::fstream::in | std::fstream::out | std::fstream::binary);
+  if (fs.fail()) {
+    throw DbException("fstream failed when opening log segment " + path);
+  }
+  return fs;
+}
+
 std::pair<oid_t, oid_t> Disk::GetOid(const std::string &path) {
   auto oids = StringUtil::Split(path, '/');
   return {std::stoi(oids[0]), std::stoi(oids[1])};
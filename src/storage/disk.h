@@ -1,9 +1,12 @@
 #pragma once
 
 #include <fstream>
+#include <map>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "common/types.h"
 
@@ -20,6 +23,7 @@ class Disk {
 
   static bool FileExists(const std::string &path);
   static bool EmptyFile(const std::string &path);
+  static size_t FileSize(const std::string &path);
 
   static void CreateFile(const std::string &path);
   static void RemoveFile(const std::string &path);
@@ -29,21 +33,42 @@ class Disk {
 
   void ReadPage(const std::string &path, pageid_t page_id, char *data);
   void WritePage(const std::string &path, pageid_t page_id, const char *data);
+  // 通知操作系统异步预读页面，page_ids 需按升序排列，连续的页面合并为一次预读
+  void PrefetchPages(const std::string &path, const std::vector<pageid_t> &page_ids);
 
-  void ReadLog(uint32_t offset, uint32_t count, char *data);
-  void WriteLog(uint32_t offset, uint32_t count, const char *data);
+  // 日志按 lsn 分段存放在 LOG_NAME 目录下，每个日志段为一个文件
+  void ReadLog(lsn_t offset, size_t count, char *data);
+  void WriteLog(lsn_t offset, size_t count, const char *data);
+  // 预先分配 next_lsn 所在的日志段及其后 LOG_PREALLOCATED_SEGMENTS 个日志段
+  void PreallocateLog(lsn_t next_lsn);
+  // 回收 min_lsn 所在日志段之前的日志段，重命名为 next_lsn 之后的日志段并清零，多余的日志段删除
+  void RecycleLog(lsn_t min_lsn, lsn_t next_lsn);
+  // 日志目录中的日志段数
+  size_t GetLogSegmentCount() const;
 
   uint32_t GetAccessCount() const;
+  // 预读的页面数统计
+  uint32_t GetPrefetchCount() const;
 
   static std::string GetFilePath(oid_t db_oid, oid_t table_oid);
+  static std::string GetLogSegmentPath(uint64_t segment);
 
  private:
   static std::pair<oid_t, oid_t> GetOid(const std::string &path);
+  // 调用时需持有 page_mutex_
+  void OpenFileInternal(const std::string &path);
   std::unordered_map<std::string, std::fstream> hashmap_;  // 文件路径到 fstream 的映射表
-  std::fstream log_fs_;
+  // 并行重做时多个线程同时读写页面，保护 hashmap_ 和 access_count_
+  std::mutex page_mutex_;
+  // 创建清零的日志段
+  static void CreateLogSegment(uint64_t segment);
+  // 打开日志段，不存在时创建
+  std::fstream &GetLogSegment(uint64_t segment);
+
+  std::map<uint64_t, std::fstream> log_segments_;  // 日志段编号到 fstream 的映射表
 
   uint32_t access_count_ = 0;  // 磁盘访问次数
-  uint32_t log_segments = 0;   // 日志段数
+  uint32_t prefetch_count_ = 0;  // 预读的页面数，只在恢复线程中修改
 };
 
 }  // namespace huadb
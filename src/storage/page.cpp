@@ -10,6 +10,8 @@ Page::~Page() { delete[] data_; }
 
 void Page::SetDirty() { is_dirty_ = true; }
 
+void Page::ClearDirty() { is_dirty_ = false; }
+
 bool Page::IsDirty() const { return is_dirty_; }
 
 char *Page::GetData() const { return data_; }
@@ -7,6 +7,7 @@ class Page {
   Page();
   ~Page();
   void SetDirty();
+  void ClearDirty();
   bool IsDirty() const;
   char *GetData() const;
 
@@ -1,5 +1,8 @@
 #include "table/table.h"
 
+#include <algorithm>
+
+#include "storage/disk.h"
 #include "table/table_page.h"
 
 namespace huadb {
@@ -15,6 +18,7 @@ Table::Table(BufferPool &buffer_pool, LogManager &log_manager, oid_t oid, oid_t
     first_page_id_ = NULL_PAGE_ID;
   } else {
     first_page_id_ = 0;
+    page_count_ = Disk::FileSize(Disk::GetFilePath(db_oid, oid)) / DB_PAGE_SIZE;
   }
 }
 
@@ -38,6 +42,7 @@ Rid Table::InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid, bo
     auto new_page = buffer_pool_.NewPage(db_oid_, oid_, first_page_id_);
     auto new_table_page = std::make_unique<TablePage>(new_page);
     new_table_page->Init();
+    page_count_ = std::max<pageid_t>(page_count_, 1);
   }
   // 使用 buffer_pool_ 获取页面
   pageid_t page_id = first_page_id_;
@@ -49,6 +54,7 @@ Rid Table::InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid, bo
     page_id++;
     page = buffer_pool_.GetPage(db_oid_, oid_, page_id);
     table_page = std::make_unique<TablePage>(page);
+    page_count_ = std::max(page_count_, page_id + 1);
   }
   // 如果 first_page_id_ 为 NULL_PAGE_ID，说明表还没有页面，需要创建新页面
   if (table_page->GetFreeSpaceSize() < record->GetSize() && table_page->GetNextPageId() == NULL_PAGE_ID) {
@@ -57,6 +63,7 @@ Rid Table::InsertRecord(std::shared_ptr<Record> record, xid_t xid, cid_t cid, bo
     table_page->SetNextPageId(page_id);
     table_page = std::make_unique<TablePage>(buffer_pool_.NewPage(db_oid_, oid_, page_id));
     table_page->Init();
+    page_count_ = std::max(page_count_, page_id + 1);
   }
   // 找到空间足够的页面后，通过 TablePage 插入记录
   slotid_t slot_id = table_page->InsertRecord(record, xid, cid);
@@ -89,6 +96,8 @@ void Table::UpdateRecordInPlace(const Record &record) {
 
 pageid_t Table::GetFirstPageId() const { return first_page_id_; }
 
+pageid_t Table::GetPageCount() const { return page_count_; }
+
 oid_t Table::GetOid() const { return oid_; }
 
 oid_t Table::GetDbOid() const { return db_oid_; }
@@ -26,6 +26,8 @@ class Table {
 
   // 获取表的第一个页面的页面号
   pageid_t GetFirstPageId() const;
+  // 表的页面数，页面号从 first_page_id_ 开始连续分配
+  pageid_t GetPageCount() const;
 
   oid_t GetOid() const;
   oid_t GetDbOid() const;
@@ -37,6 +39,7 @@ class Table {
   oid_t oid_;
   oid_t db_oid_;
   pageid_t first_page_id_;  // 第一个页面的页面号
+  pageid_t page_count_ = 0;  // 页面数，打开已有的表时按文件大小计算，插入记录时更新
   ColumnList column_list_;  // 表的 schema 信息
 };
 
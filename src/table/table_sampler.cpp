@@ -0,0 +1,64 @@
+#include "table/table_sampler.h"
+
+#include "table/table_page.h"
+
+namespace huadb {
+
+TableSampler::TableSampler(BufferPool &buffer_pool, std::shared_ptr<Table> table, size_t sample_rows, uint64_t seed)
+    : buffer_pool_(buffer_pool), table_(std::move(table)), sample_rows_(sample_rows), random_(seed) {}
+
+void TableSampler::Run(const std::function<void(const Record &)> &visitor) {
+  if (table_->GetFirstPageId() == NULL_PAGE_ID) {
+    return;
+  }
+  page_count_ = table_->GetPageCount();
+  std::uniform_real_distribution<double> uniform(0, 1);
+  pageid_t selected = 0;
+  for (pageid_t page_id = table_->GetFirstPageId(); page_id < table_->GetFirstPageId() + page_count_; page_id++) {
+    // 算法 S：剩余 remaining 个页面中还需选出 needed 个，当前页面以 needed / remaining 的概率被选中
+    auto needed = std::min<size_t>(sample_rows_, page_count_) - selected;
+    auto remaining = table_->GetFirstPageId() + page_count_ - page_id;
+    if (needed == 0) {
+      break;
+    }
+    if (needed < remaining && uniform(random_) * remaining >= needed) {
+      continue;
+    }
+    selected++;
+    pages_read_++;
+    auto table_page = std::make_unique<TablePage>(buffer_pool_.GetPage(table_->GetDbOid(), table_->GetOid(), page_id));
+    for (slotid_t slot_id = 0; slot_id < table_page->GetRecordCount(); slot_id++) {
+      auto record = table_page->GetRecord({page_id, slot_id}, table_->GetColumnList());
+      if (record->IsDeleted()) {
+        continue;
+      }
+      visitor(*record);
+      rows_read_++;
+      // 蓄水池抽样：第 rows_read_ 条记录以 sample_rows_ / rows_read_ 的概率替换蓄水池中随机的一条
+      if (sample_.size() < sample_rows_) {
+        sample_.push_back(std::move(record));
+      } else {
+        std::uniform_int_distribution<size_t> position(0, rows_read_ - 1);
+        auto pos = position(random_);
+        if (pos < sample_rows_) {
+          sample_[pos] = std::move(record);
+        }
+      }
+    }
+  }
+}
+
+const std::vector<std::shared_ptr<Record>> &TableSampler::GetSample() const { return sample_; }
+
+size_t TableSampler::GetRowsRead() const { return rows_read_; }
+
+bool TableSampler::IsFullScan() const { return pages_read_ == page_count_; }
+
+double TableSampler::EstimateRows() const {
+  if (pages_read_ == 0) {
+    return 0;
+  }
+  return static_cast<double>(rows_read_) / pages_read_ * page_count_;
+}
+
+}  // namespace huadb
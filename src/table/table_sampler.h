@@ -0,0 +1,43 @@
+#pragma once
+
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "storage/buffer_pool.h"
+#include "table/record.h"
+#include "table/table.h"
+
+namespace huadb {
+
+// ANALYZE 使用的两阶段采样：先按 Knuth 的算法 S 等概率选出至多 sample_rows 个页面，按页面号顺序读取；
+// 再对选中页面中的记录做蓄水池抽样，保留至多 sample_rows 条记录。读取的页面数和保留的记录数都不超过 sample_rows
+class TableSampler {
+ public:
+  TableSampler(BufferPool &buffer_pool, std::shared_ptr<Table> table, size_t sample_rows, uint64_t seed);
+
+  // 读取选中的页面，对每条未删除的记录调用一次 visitor
+  void Run(const std::function<void(const Record &)> &visitor);
+
+  // 蓄水池中保留的记录
+  const std::vector<std::shared_ptr<Record>> &GetSample() const;
+  // 读取的记录数
+  size_t GetRowsRead() const;
+  // 是否读取了表的全部页面
+  bool IsFullScan() const;
+  // 按选中页面的平均记录数估计表的记录数
+  double EstimateRows() const;
+
+ private:
+  BufferPool &buffer_pool_;
+  std::shared_ptr<Table> table_;
+  size_t sample_rows_;
+  std::mt19937_64 random_;
+
+  std::vector<std::shared_ptr<Record>> sample_;
+  size_t rows_read_ = 0;
+  pageid_t pages_read_ = 0;
+  pageid_t page_count_ = 0;
+};
+
+}  // namespace huadb
@@ -9,9 +9,6 @@ TableScan::TableScan(BufferPool &buffer_pool, std::shared_ptr<Table> table, Rid
 
 std::shared_ptr<Record> TableScan::GetNextRecord(xid_t xid, IsolationLevel isolation_level, cid_t cid,
                                                  const std::unordered_set<xid_t> &active_xids) {
-  // 根据事务隔离级别及活跃事务集合，判断记录是否可见
-  // LAB 3 BEGIN
-
   // LAB 1 BEGIN
   // 注意处理扫描空表的情况（rid_.page_id_ 为 NULL_PAGE_ID）
   if (rid_.page_id_ == NULL_PAGE_ID) {
@@ -31,11 +28,29 @@ std::shared_ptr<Record> TableScan::GetNextRecord(xid_t xid, IsolationLevel isola
     rid_.slot_id_ = 0;
   }
   // 判断记录是否已经被标记为删除，不再返回已经删除的数据
-  if (record->IsDeleted()) {
+  if (!IsVisible(*record, xid, isolation_level, cid, active_xids)) {
     // 即递归下去找下一记录
     return GetNextRecord(xid, isolation_level, cid, active_xids);
   }
   return record;
 }
 
+std::shared_ptr<Record> TableScan::GetRecord(const Rid &rid, xid_t xid, IsolationLevel isolation_level, cid_t cid,
+                                             const std::unordered_set<xid_t> &active_xids) {
+  auto page = buffer_pool_.GetPage(table_->GetDbOid(), table_->GetOid(), rid.page_id_);
+  auto record = TablePage(page).GetRecord(rid, table_->GetColumnList());
+  if (!IsVisible(*record, xid, isolation_level, cid, active_xids)) {
+    return nullptr;
+  }
+  record->SetRid(rid);
+  return record;
+}
+
+bool TableScan::IsVisible(const Record &record, xid_t xid, IsolationLevel isolation_level, cid_t cid,
+                          const std::unordered_set<xid_t> &active_xids) const {
+  // 根据事务隔离级别及活跃事务集合，判断记录是否可见
+  // LAB 3 BEGIN
+  return !record.IsDeleted();
+}
+
 }  // namespace huadb
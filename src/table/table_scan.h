@@ -1,6 +1,6 @@
 #pragma once
 
-#include <unordered_map>
+#include <unordered_set>
 
 #include "common/types.h"
 #include "storage/buffer_pool.h"
@@ -19,8 +19,16 @@ class TableScan {
   // 均为 Lab 3 相关参数
   std::shared_ptr<Record> GetNextRecord(xid_t xid = NULL_XID, IsolationLevel isolation_level = DEFAULT_ISOLATION_LEVEL,
                                         cid_t cid = NULL_CID, const std::unordered_set<xid_t> &active_xids = {});
+  // 读取 rid 对应的记录，记录对当前事务不可见时返回空指针，供索引扫描回表使用，参数同上
+  std::shared_ptr<Record> GetRecord(const Rid &rid, xid_t xid = NULL_XID,
+                                    IsolationLevel isolation_level = DEFAULT_ISOLATION_LEVEL, cid_t cid = NULL_CID,
+                                    const std::unordered_set<xid_t> &active_xids = {});
 
  private:
+  // 判断记录对当前事务是否可见
+  bool IsVisible(const Record &record, xid_t xid, IsolationLevel isolation_level, cid_t cid,
+                 const std::unordered_set<xid_t> &active_xids) const;
+
   BufferPool &buffer_pool_;
   std::shared_ptr<Table> table_;
   Rid rid_;  // 当前扫描到的记录的 rid
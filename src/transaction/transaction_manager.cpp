@@ -45,6 +45,7 @@ void TransactionManager::Commit(xid_t xid) {
   ReleaseLocks(xid);
   xid2cid_.erase(xid);
   xid2active_set_.erase(xid);
+  xid2modifications_.erase(xid);
 }
 
 void TransactionManager::Rollback(xid_t xid) {
@@ -57,6 +58,7 @@ void TransactionManager::Rollback(xid_t xid) {
   ReleaseLocks(xid);
   xid2cid_.erase(xid);
   xid2active_set_.erase(xid);
+  xid2modifications_.erase(xid);
 }
 
 std::unordered_set<xid_t> TransactionManager::GetSnapshot(xid_t xid) const {
@@ -74,6 +76,22 @@ std::unordered_set<xid_t> TransactionManager::GetActiveTransactions() const {
   return active_xids;
 }
 
+void TransactionManager::AddModifications(xid_t xid, oid_t table_oid, const TableModifications &modifications) {
+  auto &total = xid2modifications_[xid][table_oid];
+  total.inserted_ += modifications.inserted_;
+  total.updated_ += modifications.updated_;
+  total.deleted_ += modifications.deleted_;
+}
+
+std::unordered_map<oid_t, TableModifications> TransactionManager::GetModifications(xid_t xid) const {
+  if (xid2modifications_.find(xid) == xid2modifications_.end()) {
+    return {};
+  }
+  return xid2modifications_.at(xid);
+}
+
+LockManager &TransactionManager::GetLockManager() { return lock_manager_; }
+
 void TransactionManager::ReleaseLocks(xid_t xid) { lock_manager_.ReleaseLocks(xid); }
 
 }  // namespace huadb
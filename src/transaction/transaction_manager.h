@@ -36,6 +36,13 @@ class TransactionManager {
   // 获取活跃事务表
   std::unordered_set<xid_t> GetActiveTransactions() const;
 
+  // 累加事务对表的修改记录数，提交时用于更新统计信息
+  void AddModifications(xid_t xid, oid_t table_oid, const TableModifications &modifications);
+  // 获取事务对各表的修改记录数，事务提交或回滚后清除
+  std::unordered_map<oid_t, TableModifications> GetModifications(xid_t xid) const;
+
+  LockManager &GetLockManager();
+
  private:
   // 释放事务持有的锁
   void ReleaseLocks(xid_t xid);
@@ -44,6 +51,7 @@ class TransactionManager {
   std::atomic<xid_t> next_xid_ = 1;
   std::unordered_map<xid_t, cid_t> xid2cid_;
   std::unordered_map<xid_t, std::unordered_set<xid_t>> xid2active_set_;
+  std::unordered_map<xid_t, std::unordered_map<oid_t, TableModifications>> xid2modifications_;
 };
 
 }  // namespace huadb
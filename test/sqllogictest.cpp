@@ -70,8 +70,10 @@ bool Run(const fs::path &path) {
           } else if (statement.sql_.substr(0, 5) == "flush") {
             database->Flush();
           } else if (statement.sql_.substr(0, 7) == "restart") {
+            // restart instant 以即时恢复的方式重启：重做推迟到访问页面时和语句之间进行
+            bool instant_recovery = statement.sql_.substr(0, 15) == "restart instant";
             database.reset();
-            database = std::make_unique<huadb::DatabaseEngine>();
+            database = std::make_unique<huadb::DatabaseEngine>(instant_recovery);
             connections.clear();
           } else {
             connections[statement.connection_name_]->SendQuery(statement.sql_, writer);
@@ -0,0 +1,230 @@
+// 日志缓存的测试：多线程追加的日志在缓存首尾相接处、日志段边界处以及超过缓存大小时都能完整写入磁盘
+// 刷盘后从磁盘顺序解析全部日志，与追加时的内容对照；NEXT_LSN 文件中记录的位置必须是日志的边界
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "log/log_manager.h"
+#include "log/log_records/log_records.h"
+#include "storage/disk.h"
+#include "transaction/lock_manager.h"
+#include "transaction/transaction_manager.h"
+#include "unit_test.h"
+
+namespace {
+
+using namespace huadb;
+
+constexpr oid_t TEST_OID = 1;
+constexpr size_t THREAD_COUNT = 4;
+constexpr size_t LOGS_PER_THREAD = 3000;
+// 超过日志缓存大小的索引页面日志包含的页面数
+constexpr size_t OVERSIZED_PAGES = LOG_BUFFER_SIZE / DB_PAGE_SIZE + 64;
+
+struct Environment {
+  Environment() : transaction_manager(lock_manager, FIRST_XID), log_manager(disk, transaction_manager, FIRST_LSN) {}
+
+  Disk disk;
+  LockManager lock_manager;
+  TransactionManager transaction_manager;
+  LogManager log_manager;
+};
+
+// 页面内容由线程号、日志序号和页号决定，读回时据此检查
+std::vector<std::pair<pageid_t, std::vector<char>>> MakePages(size_t thread_id, size_t index, size_t count) {
+  std::vector<std::pair<pageid_t, std::vector<char>>> pages;
+  for (size_t i = 0; i < count; i++) {
+    std::vector<char> image(DB_PAGE_SIZE);
+    for (size_t j = 0; j < image.size(); j++) {
+      image[j] = static_cast<char>(thread_id * 31 + index * 7 + i * 3 + j);
+    }
+    pages.emplace_back(static_cast<pageid_t>(i), std::move(image));
+  }
+  return pages;
+}
+
+// 从磁盘顺序解析 [FIRST_LSN, end) 的全部日志
+std::map<lsn_t, std::shared_ptr<LogRecord>> ReadAllLogs(Disk &disk, lsn_t end) {
+  std::vector<char> buffer(end - FIRST_LSN);
+  disk.ReadLog(FIRST_LSN, buffer.size(), buffer.data());
+  std::map<lsn_t, std::shared_ptr<LogRecord>> logs;
+  for (lsn_t lsn = FIRST_LSN; lsn < end;) {
+    auto log = LogRecord::DeserializeFrom(lsn, buffer.data() + (lsn - FIRST_LSN));
+    UNIT_CHECK(log->GetSize() > 0);
+    lsn += log->GetSize();
+    logs.emplace(log->GetLSN(), std::move(log));
+  }
+  return logs;
+}
+
+lsn_t ReadNextLSN() {
+  lsn_t next_lsn = NULL_LSN;
+  std::ifstream in(NEXT_LSN_NAME);
+  in >> next_lsn;
+  return next_lsn;
+}
+
+// 多个线程同时追加大小不一的日志，总量为日志缓存的数倍，其中包含超过缓存大小的日志
+// 另一个线程不断刷盘并读取 NEXT_LSN 文件，刷出的位置不能落在日志中间
+void TestConcurrentAppend() {
+  Environment env;
+  struct Appended {
+    size_t thread_id_;
+    size_t index_;
+    size_t page_count_;
+  };
+  std::mutex appended_mutex;
+  std::map<lsn_t, Appended> appended;
+  // 每个线程的事务 undo 链：InsertLog 的 prev_lsn 应为本事务的上一条日志
+  std::vector<std::vector<lsn_t>> chains(THREAD_COUNT);
+
+  std::atomic<bool> stop = false;
+  std::vector<lsn_t> flushed_positions;
+  std::thread flusher([&]() {
+    while (!stop) {
+      env.log_manager.Flush();
+      flushed_positions.push_back(ReadNextLSN());
+    }
+  });
+
+  std::vector<std::thread> threads;
+  for (size_t thread_id = 0; thread_id < THREAD_COUNT; thread_id++) {
+    threads.emplace_back([&, thread_id]() {
+      xid_t xid = FIRST_XID + thread_id;
+      std::vector<char> record(512);
+      for (size_t i = 0; i < LOGS_PER_THREAD; i++) {
+        lsn_t lsn;
+        size_t page_count = 0;
+        if (i % 3 == 0) {
+          page_count = (thread_id == 0 && i % 1000 == 0) ? OVERSIZED_PAGES : 1 + i % 4;
+          lsn = env.log_manager.AppendIndexPageLog(xid, INVALID_OID, TEST_OID, MakePages(thread_id, i, page_count));
+        } else {
+          auto size = static_cast<db_size_t>(1 + (i * 37 + thread_id) % record.size());
+          lsn = env.log_manager.AppendInsertLog(xid, TEST_OID, static_cast<pageid_t>(i), static_cast<slotid_t>(i), 0,
+                                                size, record.data());
+          chains[thread_id].push_back(lsn);
+        }
+        std::unique_lock lock(appended_mutex);
+        appended[lsn] = {thread_id, i, page_count};
+      }
+      env.log_manager.AppendCommitLog(xid, false);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  stop = true;
+  flusher.join();
+  env.log_manager.Flush();
+
+  auto end = env.log_manager.GetNextLSN();
+  UNIT_CHECK(end - FIRST_LSN > 4 * LOG_BUFFER_SIZE);
+  UNIT_CHECK(ReadNextLSN() == end);
+  auto logs = ReadAllLogs(env.disk, end);
+
+  std::set<lsn_t> boundaries{end};
+  for (const auto &[lsn, log] : logs) {
+    boundaries.insert(lsn);
+  }
+  for (auto position : flushed_positions) {
+    UNIT_CHECK(position == NULL_LSN || boundaries.count(position) == 1);
+  }
+
+  for (const auto &[lsn, expected] : appended) {
+    auto entry = logs.find(lsn);
+    UNIT_CHECK(entry != logs.end());
+    if (entry == logs.end()) {
+      continue;
+    }
+    const auto &log = entry->second;
+    UNIT_CHECK(log->GetXid() == FIRST_XID + expected.thread_id_);
+    if (expected.page_count_ == 0) {
+      UNIT_CHECK(log->GetType() == LogType::INSERT);
+      UNIT_CHECK(std::dynamic_pointer_cast<InsertLog>(log)->GetSlotId() == expected.index_);
+      continue;
+    }
+    UNIT_CHECK(log->GetType() == LogType::INDEX_PAGE);
+    auto index_page_log = std::dynamic_pointer_cast<IndexPageLog>(log);
+    UNIT_CHECK(index_page_log != nullptr &&
+               index_page_log->GetPages() == MakePages(expected.thread_id_, expected.index_, expected.page_count_));
+  }
+  for (const auto &chain : chains) {
+    for (size_t i = 1; i < chain.size(); i++) {
+      UNIT_CHECK(logs.count(chain[i]) == 1 && logs.at(chain[i])->GetPrevLSN() == chain[i - 1]);
+    }
+  }
+}
+
+// 单条日志同时跨越日志缓存的尾部和日志段的边界
+void TestRecordAcrossSegmentBoundary() {
+  Environment env;
+  // 索引页面日志的大小为固定开销加上每个页面的大小
+  auto log_size = [](size_t page_count) {
+    return IndexPageLog(NULL_LSN, NULL_XID, NULL_LSN, INVALID_OID, TEST_OID, MakePages(0, 0, page_count)).GetSize();
+  };
+  auto one_page_size = log_size(1);
+  auto two_page_size = log_size(2);
+  auto page_size = two_page_size - one_page_size;
+  auto header_size = one_page_size - page_size;
+
+  // 先追加日志使下一条日志从距离段尾不足一个页面处开始
+  size_t index = 0;
+  while (env.log_manager.GetNextLSN() + header_size + page_size * 8 < LOG_SEGMENT_SIZE) {
+    env.log_manager.AppendIndexPageLog(NULL_XID, INVALID_OID, TEST_OID, MakePages(0, index++, 8));
+  }
+  while (env.log_manager.GetNextLSN() + one_page_size < LOG_SEGMENT_SIZE) {
+    env.log_manager.AppendIndexPageLog(NULL_XID, INVALID_OID, TEST_OID, MakePages(0, index++, 1));
+  }
+  auto lsn = env.log_manager.AppendIndexPageLog(NULL_XID, INVALID_OID, TEST_OID, MakePages(1, 0, 4));
+  UNIT_CHECK(lsn < LOG_SEGMENT_SIZE && lsn + one_page_size + 3 * page_size > LOG_SEGMENT_SIZE);
+  // 再追加一段日志，使缓存中跨越尾部的位置被新的日志覆盖
+  for (size_t i = 0; i < LOG_BUFFER_SIZE / one_page_size; i++) {
+    env.log_manager.AppendIndexPageLog(NULL_XID, INVALID_OID, TEST_OID, MakePages(2, i, 1));
+  }
+  env.log_manager.Flush();
+
+  auto logs = ReadAllLogs(env.disk, env.log_manager.GetNextLSN());
+  UNIT_CHECK(logs.count(lsn) == 1);
+  if (logs.count(lsn) == 1) {
+    auto log = std::dynamic_pointer_cast<IndexPageLog>(logs.at(lsn));
+    UNIT_CHECK(log != nullptr && log->GetPages() == MakePages(1, 0, 4));
+  }
+  UNIT_CHECK(env.disk.GetLogSegmentCount() >= 2);
+}
+
+// 填充日志只序列化日志头，解析时按日志头中的大小跳过整个范围，并保留原日志的 xid 和 prev_lsn
+void TestPaddingLog() {
+  constexpr size_t size = MAX_LOG_SIZE;
+  std::vector<char> buffer(size + PaddingLog::HEADER_SIZE, 'x');
+  PaddingLog padding(FIRST_LSN, FIRST_XID, FIRST_LSN - 1, size);
+  UNIT_CHECK(padding.SerializeTo(buffer.data()) == PaddingLog::HEADER_SIZE);
+  BeginLog(FIRST_LSN + size, FIRST_XID + 1, NULL_LSN).SerializeTo(buffer.data() + size);
+
+  auto log = LogRecord::DeserializeFrom(FIRST_LSN, buffer.data());
+  UNIT_CHECK(log->GetType() == LogType::PADDING && log->GetSize() == size);
+  UNIT_CHECK(log->GetXid() == FIRST_XID && log->GetPrevLSN() == FIRST_LSN - 1);
+  auto next = LogRecord::DeserializeFrom(FIRST_LSN + size, buffer.data() + log->GetSize());
+  UNIT_CHECK(next->GetType() == LogType::BEGIN && next->GetXid() == FIRST_XID + 1);
+}
+
+}  // namespace
+
+int main() {
+  auto directory = std::filesystem::current_path();
+  for (auto [name, test] : {std::pair{"record across segment boundary", TestRecordAcrossSegmentBoundary},
+                            std::pair{"concurrent append", TestConcurrentAppend},
+                            std::pair{"padding log", TestPaddingLog}}) {
+    // Disk 在 BASE_PATH 中创建数据库文件并切换工作目录，每个测试使用新的目录
+    std::filesystem::current_path(directory);
+    std::filesystem::remove_all(BASE_PATH);
+    huadb::unit_test::Run(name, test);
+  }
+  std::filesystem::current_path(directory);
+  std::filesystem::remove_all(BASE_PATH);
+  return huadb::unit_test::UnitTestResult();
+}
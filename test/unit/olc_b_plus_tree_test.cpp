@@ -0,0 +1,137 @@
+// 乐观锁耦合 B+ 树的多线程测试：与 std::map 实现的结果对照
+// 每个线程只修改属于自己的键（key % THREAD_COUNT == 线程号），同时查找和扫描整棵树
+// 自己的键只有本线程修改，因此查找和扫描到的结果必须与本线程的 std::map 完全一致
+// 其他线程的键可能正在被修改，只检查扫描结果有序且值与键对应
+
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "index/olc_b_plus_tree.h"
+#include "unit_test.h"
+
+namespace {
+
+using namespace huadb;
+
+constexpr uint64_t THREAD_COUNT = 8;
+constexpr uint64_t KEY_COUNT = 20000;
+constexpr size_t OPS_PER_THREAD = 50000;
+constexpr size_t SCAN_LIMIT = 64;
+
+using Tree = OlcBPlusTree<uint64_t, uint64_t>;
+
+// 值的高位保存键，低位保存修改次数，用于检查读到的值是否属于该键
+uint64_t MakeValue(uint64_t key, uint64_t version) { return key << 20 | version; }
+uint64_t KeyOfValue(uint64_t value) { return value >> 20; }
+
+std::vector<std::pair<uint64_t, uint64_t>> ToVector(const std::map<uint64_t, uint64_t> &map) {
+  return {map.begin(), map.end()};
+}
+
+void Worker(Tree &tree, uint64_t thread_id, std::map<uint64_t, uint64_t> &oracle) {
+  std::mt19937_64 rng(thread_id);
+  std::uniform_int_distribution<uint64_t> key_distribution(0, KEY_COUNT / THREAD_COUNT - 1);
+  for (size_t op = 0; op < OPS_PER_THREAD; op++) {
+    auto key = key_distribution(rng) * THREAD_COUNT + thread_id;
+    switch (rng() % 4) {
+      case 0: {
+        auto value = MakeValue(key, op);
+        tree.Insert(key, value);
+        oracle[key] = value;
+        break;
+      }
+      case 1: {
+        UNIT_CHECK(tree.Remove(key) == (oracle.erase(key) == 1));
+        break;
+      }
+      case 2: {
+        auto value = tree.Lookup(key);
+        auto iterator = oracle.find(key);
+        UNIT_CHECK(value.has_value() == (iterator != oracle.end()));
+        if (value && iterator != oracle.end()) {
+          UNIT_CHECK(*value == iterator->second);
+        }
+        break;
+      }
+      default: {
+        auto result = tree.Scan(key, SCAN_LIMIT);
+        // 扫描起点是自己的键，结果中自己的键必须与 oracle 中同一范围内的键一一对应
+        auto iterator = oracle.lower_bound(key);
+        for (size_t i = 0; i < result.size(); i++) {
+          const auto &[scanned_key, scanned_value] = result[i];
+          UNIT_CHECK(scanned_key >= key);
+          UNIT_CHECK(i == 0 || result[i - 1].first < scanned_key);
+          UNIT_CHECK(KeyOfValue(scanned_value) == scanned_key);
+          if (scanned_key % THREAD_COUNT != thread_id) {
+            continue;
+          }
+          UNIT_CHECK(iterator != oracle.end() && iterator->first == scanned_key &&
+                     iterator->second == scanned_value);
+          if (iterator != oracle.end()) {
+            ++iterator;
+          }
+        }
+        // 扫描结果不足 limit 时已到达树的末尾，oracle 中也不能有剩余的键
+        if (result.size() < SCAN_LIMIT) {
+          UNIT_CHECK(iterator == oracle.end());
+        }
+        break;
+      }
+    }
+  }
+}
+
+void TestConcurrentOperations() {
+  Tree tree;
+  std::vector<std::map<uint64_t, uint64_t>> oracles(THREAD_COUNT);
+  std::vector<std::thread> threads;
+  for (uint64_t i = 0; i < THREAD_COUNT; i++) {
+    threads.emplace_back(Worker, std::ref(tree), i, std::ref(oracles[i]));
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // 所有线程结束后，整棵树的内容与各线程 oracle 的并集相同
+  std::map<uint64_t, uint64_t> expected;
+  for (const auto &oracle : oracles) {
+    expected.insert(oracle.begin(), oracle.end());
+  }
+  auto result = tree.Scan(0, KEY_COUNT);
+  UNIT_CHECK(result == ToVector(expected));
+  for (uint64_t key = 0; key < KEY_COUNT; key++) {
+    auto iterator = expected.find(key);
+    auto value = tree.Lookup(key);
+    UNIT_CHECK(value.has_value() == (iterator != expected.end()));
+  }
+}
+
+// 单线程下先顺序插入再删除一半的键，检查分裂后节点中的键仍然有序完整
+void TestSplitAndRemove() {
+  Tree tree;
+  std::map<uint64_t, uint64_t> oracle;
+  for (uint64_t key = 0; key < KEY_COUNT; key++) {
+    auto reversed = KEY_COUNT - 1 - key;
+    tree.Insert(reversed, MakeValue(reversed, 0));
+    oracle[reversed] = MakeValue(reversed, 0);
+  }
+  for (uint64_t key = 0; key < KEY_COUNT; key += 2) {
+    UNIT_CHECK(tree.Remove(key));
+    UNIT_CHECK(!tree.Remove(key));
+    oracle.erase(key);
+  }
+  auto result = tree.Scan(0, KEY_COUNT);
+  UNIT_CHECK(result == ToVector(oracle));
+  auto tail = tree.Scan(KEY_COUNT - 4, SCAN_LIMIT);
+  UNIT_CHECK(tail.size() == 2);
+}
+
+}  // namespace
+
+int main() {
+  huadb::unit_test::Run("split and remove", TestSplitAndRemove);
+  huadb::unit_test::Run("concurrent operations", TestConcurrentOperations);
+  return huadb::unit_test::UnitTestResult();
+}
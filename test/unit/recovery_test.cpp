@@ -0,0 +1,282 @@
+// 故障恢复的测试：在若干张表上追加索引页面日志，刷盘后清空 buffer pool 模拟故障，恢复后检查磁盘上的页面
+// 重做阶段分段顺序读取日志并按段预读页面，分发给工作线程的日志数有上限
+// 并行重做的结果与单线程重做相同，涉及多个工作线程的日志和工作线程抛出的异常都能正确处理
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "common/exceptions.h"
+#include "fmt/format.h"
+#include "log/log_manager.h"
+#include "log/log_records/log_records.h"
+#include "log/redo_dispatcher.h"
+#include "storage/buffer_pool.h"
+#include "storage/disk.h"
+#include "transaction/lock_manager.h"
+#include "transaction/transaction_manager.h"
+#include "unit_test.h"
+
+namespace {
+
+using namespace huadb;
+
+constexpr size_t TABLE_COUNT = 3;
+constexpr pageid_t PAGES_PER_TABLE = 64;
+// 一次读取的日志量
+constexpr size_t READ_SIZE = REDO_READ_SEGMENTS * LOG_SEGMENT_SIZE;
+// 超过一次读取大小的索引页面日志包含的页面数
+constexpr size_t OVERSIZED_PAGES = READ_SIZE / DB_PAGE_SIZE + 16;
+
+// 测试开始时的工作目录，同一测试中需要多次重建数据目录时使用
+std::filesystem::path base_directory;
+
+struct Environment {
+  Environment()
+      : transaction_manager(lock_manager, FIRST_XID),
+        log_manager(disk, transaction_manager, FIRST_LSN),
+        buffer_pool(std::make_shared<BufferPool>(disk, log_manager)) {
+    log_manager.SetBufferPool(buffer_pool);
+    catalog = std::make_shared<Catalog>(*buffer_pool, log_manager);
+    log_manager.SetCatalog(catalog);
+    catalog->CreateSystemTables();
+    catalog->CreateDatabase("recovery_test", false);
+    catalog->ChangeDatabase("recovery_test");
+    for (size_t i = 0; i < TABLE_COUNT; i++) {
+      auto table_name = fmt::format("t{}", i);
+      catalog->CreateTable(table_name, ColumnList({ColumnDefinition("id", Type::INT)}));
+      oids.push_back(catalog->GetTableOid(table_name));
+    }
+    db_oid = catalog->GetDatabaseOid(oids[0]);
+  }
+
+  // 追加修改 pages 的索引页面日志，记录每个页面最后写入的内容
+  void Write(oid_t oid, const std::vector<pageid_t> &page_ids, char value) {
+    std::vector<std::pair<pageid_t, std::vector<char>>> pages;
+    for (auto page_id : page_ids) {
+      std::vector<char> image(DB_PAGE_SIZE, value);
+      pages.emplace_back(page_id, std::move(image));
+    }
+    auto lsn = log_manager.AppendIndexPageLog(FIRST_XID, db_oid, oid, std::move(pages));
+    for (auto page_id : page_ids) {
+      expected[{oid, page_id}] = {lsn, value};
+    }
+  }
+
+  void Crash() {
+    log_manager.AppendCommitLog(FIRST_XID);
+    log_manager.Flush();
+    buffer_pool->Clear();
+  }
+
+  // 磁盘上的页面应为最后一条日志写入的内容，页面开头为该日志的 lsn
+  void Check() {
+    std::vector<char> data(DB_PAGE_SIZE);
+    for (const auto &[page, value] : expected) {
+      disk.ReadPage(Disk::GetFilePath(db_oid, page.table_oid_), page.page_id_, data.data());
+      lsn_t page_lsn;
+      memcpy(&page_lsn, data.data(), sizeof(page_lsn));
+      UNIT_CHECK(page_lsn == value.first);
+      UNIT_CHECK(data[DB_PAGE_SIZE - 1] == value.second);
+    }
+  }
+
+  Disk disk;
+  LockManager lock_manager;
+  TransactionManager transaction_manager;
+  LogManager log_manager;
+  std::shared_ptr<BufferPool> buffer_pool;
+  std::shared_ptr<Catalog> catalog;
+  std::vector<oid_t> oids;
+  oid_t db_oid;
+  std::unordered_map<TablePageid, std::pair<lsn_t, char>> expected;
+};
+
+// 日志量为一次读取大小的数倍，其中一条日志超过一次读取的大小，日志在读取边界处被截断
+void TestChunkedRedo() {
+  Environment env;
+  for (size_t i = 0; env.log_manager.GetNextLSN() < READ_SIZE * 5 / 2; i++) {
+    if (i == 1000) {
+      std::vector<pageid_t> page_ids;
+      for (size_t page_id = 0; page_id < OVERSIZED_PAGES; page_id++) {
+        page_ids.push_back(static_cast<pageid_t>(page_id));
+      }
+      env.Write(env.oids[0], page_ids, 'x');
+      continue;
+    }
+    auto page_id = static_cast<pageid_t>(i / TABLE_COUNT % PAGES_PER_TABLE);
+    env.Write(env.oids[i % TABLE_COUNT], {page_id}, static_cast<char>(i));
+  }
+  env.Crash();
+  auto log_size = env.log_manager.GetNextLSN() - FIRST_LSN;
+
+  env.log_manager.Recover();
+  env.Check();
+  // 日志分段读取：读取次数不少于日志量除以一次读取的大小，超过读取大小的日志最多多读一次
+  auto chunks = (log_size + READ_SIZE - 1) / READ_SIZE;
+  UNIT_CHECK(env.log_manager.GetRedoReadCount() >= 3);
+  UNIT_CHECK(env.log_manager.GetRedoReadCount() <= chunks + 1);
+  // 每段日志访问的页面都经过预读
+  UNIT_CHECK(env.disk.GetPrefetchCount() >= env.expected.size());
+}
+
+// 即时恢复：页面组只记录日志的 lsn，第一次访问页面时从磁盘重新读取该组的日志并重做
+void TestLazyRedo() {
+  Environment env;
+  for (size_t i = 0; i < 20000; i++) {
+    auto oid = env.oids[i % TABLE_COUNT];
+    auto page_id = static_cast<pageid_t>(i / TABLE_COUNT % PAGES_PER_TABLE);
+    // 每张表的页面按分区两两合并为页面组
+    if (i % 7 == 0) {
+      env.Write(oid, {page_id, static_cast<pageid_t>(page_id ^ 1)}, static_cast<char>(i));
+    } else {
+      env.Write(oid, {page_id}, static_cast<char>(i));
+    }
+  }
+  env.Crash();
+
+  env.log_manager.Recover(true);
+  auto pending = env.log_manager.GetPendingRedoPageCount();
+  UNIT_CHECK(pending == env.expected.size());
+  auto [page, value] = *env.expected.find({env.oids[1], 5});
+  auto data = env.buffer_pool->GetPage(env.db_oid, page.table_oid_, page.page_id_)->GetData();
+  lsn_t page_lsn;
+  memcpy(&page_lsn, data, sizeof(page_lsn));
+  UNIT_CHECK(page_lsn == value.first);
+  UNIT_CHECK(data[DB_PAGE_SIZE - 1] == value.second);
+  // 页面 5 与页面 4 属于同一组，一起重做
+  UNIT_CHECK(env.log_manager.GetPendingRedoPageCount() == pending - 2);
+
+  env.log_manager.FinishRecovery();
+  UNIT_CHECK(env.log_manager.GetPendingRedoPageCount() == 0);
+  env.buffer_pool->Flush();
+  env.Check();
+}
+
+// 在新的数据目录中生成相同的日志，以 redo_workers 个工作线程恢复，返回恢复后各表文件的内容
+std::vector<std::string> RecoverWorkload(size_t redo_workers) {
+  std::filesystem::current_path(base_directory);
+  std::filesystem::remove_all(BASE_PATH);
+  Environment env;
+  RedoDispatcher dispatcher(DEFAULT_REDO_WORKERS, [](size_t worker, LogRecord &log) {});
+  for (size_t i = 0; i < 30000; i++) {
+    auto oid = env.oids[i % TABLE_COUNT];
+    auto page_id = static_cast<pageid_t>(i / TABLE_COUNT % PAGES_PER_TABLE);
+    if (i % 11 == 0) {
+      // 同时修改两个分区的页面，第二个页面所属的工作线程与第一个页面不同
+      auto other = static_cast<pageid_t>((page_id + REDO_PARTITION_PAGES) % PAGES_PER_TABLE);
+      while (dispatcher.GetWorker(oid, other) == dispatcher.GetWorker(oid, page_id)) {
+        other = static_cast<pageid_t>((other + REDO_PARTITION_PAGES) % PAGES_PER_TABLE);
+      }
+      env.Write(oid, {page_id, other}, static_cast<char>(i));
+    } else {
+      env.Write(oid, {page_id}, static_cast<char>(i));
+    }
+  }
+  env.Crash();
+
+  env.log_manager.SetRedoWorkers(redo_workers);
+  env.log_manager.Recover();
+  env.Check();
+  std::vector<std::string> files;
+  for (auto oid : env.oids) {
+    std::ifstream in(Disk::GetFilePath(env.db_oid, oid), std::ios::binary);
+    files.emplace_back(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  return files;
+}
+
+// 多张表、每张表多个分区的日志，单线程与多线程重做后的表文件完全相同
+void TestParallelRedo() {
+  auto serial = RecoverWorkload(1);
+  auto parallel = RecoverWorkload(DEFAULT_REDO_WORKERS);
+  UNIT_CHECK(serial.size() == TABLE_COUNT);
+  UNIT_CHECK(serial[0].size() >= PAGES_PER_TABLE * DB_PAGE_SIZE);
+  UNIT_CHECK(serial == parallel);
+}
+
+// 工作线程抛出的异常由 Wait 重新抛出，其余日志仍然被重做，之后的 Wait 不再抛出
+void TestDispatcherException() {
+  std::atomic<size_t> redone = 0;
+  RedoDispatcher dispatcher(DEFAULT_REDO_WORKERS, [&](size_t worker, LogRecord &log) {
+    if (log.GetXid() == FIRST_XID + 3) {
+      throw DbException("redo failed");
+    }
+    redone++;
+  });
+  for (size_t i = 0; i < 8; i++) {
+    dispatcher.Dispatch(i % DEFAULT_REDO_WORKERS, std::make_shared<BeginLog>(FIRST_LSN, FIRST_XID + i, NULL_LSN));
+  }
+  bool thrown = false;
+  try {
+    dispatcher.Wait();
+  } catch (const DbException &e) {
+    thrown = std::string(e.what()) == "redo failed";
+  }
+  UNIT_CHECK(thrown);
+  UNIT_CHECK(redone == 7);
+  dispatcher.Wait();
+}
+
+// 未重做的日志达到上限时 Dispatch 等待工作线程
+void TestDispatcherBackpressure() {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool released = false;
+  std::atomic<size_t> redone = 0;
+  RedoDispatcher dispatcher(
+      1,
+      [&](size_t worker, LogRecord &log) {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&]() { return released; });
+        redone++;
+      },
+      2);
+  dispatcher.Dispatch(0, std::make_shared<BeginLog>(FIRST_LSN, FIRST_XID, NULL_LSN));
+  dispatcher.Dispatch(0, std::make_shared<BeginLog>(FIRST_LSN, FIRST_XID + 1, NULL_LSN));
+  std::atomic<bool> dispatched = false;
+  std::thread dispatcher_thread([&]() {
+    dispatcher.Dispatch(0, std::make_shared<BeginLog>(FIRST_LSN, FIRST_XID + 2, NULL_LSN));
+    dispatched = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  UNIT_CHECK(!dispatched);
+  {
+    std::unique_lock lock(mutex);
+    released = true;
+  }
+  cv.notify_all();
+  dispatcher_thread.join();
+  dispatcher.Wait();
+  UNIT_CHECK(dispatched);
+  UNIT_CHECK(redone == 3);
+}
+
+}  // namespace
+
+int main() {
+  auto directory = std::filesystem::current_path();
+  base_directory = directory;
+  for (auto [name, test] :
+       {std::pair{"chunked redo", TestChunkedRedo}, std::pair{"lazy redo", TestLazyRedo},
+        std::pair{"parallel redo", TestParallelRedo}, std::pair{"dispatcher exception", TestDispatcherException},
+        std::pair{"dispatcher backpressure", TestDispatcherBackpressure}}) {
+    // Disk 在 BASE_PATH 中创建数据库文件并切换工作目录，每个测试使用新的目录
+    std::filesystem::current_path(directory);
+    std::filesystem::remove_all(BASE_PATH);
+    huadb::unit_test::Run(name, test);
+  }
+  std::filesystem::current_path(directory);
+  std::filesystem::remove_all(BASE_PATH);
+  return huadb::unit_test::UnitTestResult();
+}
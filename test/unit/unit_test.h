@@ -0,0 +1,43 @@
+#pragma once
+
+// C++ 单元测试使用的简单断言，检查失败时输出位置并记录失败，main 返回 UnitTestResult() 作为退出码
+// 用于 sqllogictest 无法覆盖的场景，如多线程访问和故障恢复的内部状态
+
+#include <atomic>
+#include <cstdio>
+#include <exception>
+
+#include "fmt/format.h"
+
+namespace huadb::unit_test {
+
+inline std::atomic<size_t> failure_count{0};
+
+inline void Fail(const char *file, int line, const char *expression) {
+  failure_count++;
+  fmt::print(stderr, "{}:{}: check failed: {}\n", file, line, expression);
+}
+
+// 依次运行测试函数，测试抛出异常时同样视为失败
+template <typename Func>
+void Run(const char *name, Func func) {
+  auto failures = failure_count.load();
+  try {
+    func();
+  } catch (const std::exception &e) {
+    failure_count++;
+    fmt::print(stderr, "{}: unexpected exception: {}\n", name, e.what());
+  }
+  fmt::print("{} {}\n", failure_count == failures ? "PASS" : "FAIL", name);
+}
+
+inline int UnitTestResult() { return failure_count == 0 ? 0 : 1; }
+
+}  // namespace huadb::unit_test
+
+#define UNIT_CHECK(expression)                               \
+  do {                                                       \
+    if (!(expression)) {                                     \
+      huadb::unit_test::Fail(__FILE__, __LINE__, #expression); \
+    }                                                        \
+  } while (0)